@@ -0,0 +1,32 @@
+#ifndef EAI_PROTOCOL_BENCHMARK_HEADER
+#define EAI_PROTOCOL_BENCHMARK_HEADER
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/*!
+ * @brief monotonic timestamp in nanoseconds
+ */
+static inline uint64_t benchmarkNow(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/*!
+ * @brief print one result line: name, iterations, nanoseconds per iteration
+ */
+static inline void benchmarkReport(const char *name, uint64_t iterations, uint64_t elapsedNs) {
+    printf("%-48s %10llu iterations %12.1f ns/op\n", name, (unsigned long long)iterations,
+           (double)elapsedNs / (double)iterations);
+}
+
+/*!
+ * @brief keep the compiler from optimizing away a computed value
+ */
+static inline void benchmarkKeep(const void *value) {
+    __asm__ volatile("" : : "g"(value) : "memory");
+}
+
+#endif /* EAI_PROTOCOL_BENCHMARK_HEADER */
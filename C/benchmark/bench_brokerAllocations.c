@@ -0,0 +1,120 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "eaip/brokerMock/Broker.h"
+
+#define MAX_DEVICES 100000
+#define FILTERS_PER_DEVICE 2
+
+/*
+ * Counts the calls to the allocator made by the broker mock while a fleet subscribes, churns its
+ * subscriptions and is torn down. The allocator is wrapped at link time (`-Wl,--wrap=malloc`).
+ */
+
+/* region ALLOCATION COUNTER */
+
+static size_t allocations;
+static size_t releases;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *pointer, size_t size);
+void __real_free(void *pointer);
+
+void *__wrap_malloc(size_t size) {
+    allocations++;
+    return __real_malloc(size);
+}
+void *__wrap_calloc(size_t count, size_t size) {
+    allocations++;
+    return __real_calloc(count, size);
+}
+void *__wrap_realloc(void *pointer, size_t size) {
+    allocations++;
+    return __real_realloc(pointer, size);
+}
+void __wrap_free(void *pointer) {
+    releases += pointer != NULL;
+    __real_free(pointer);
+}
+
+static void reportAllocations(const char *name, size_t operations, size_t count) {
+    printf("%-48s %10zu calls       %12.2f per op\n", name, count,
+           (double)count / (double)operations);
+}
+
+/* endregion ALLOCATION COUNTER */
+
+static const char *filters[FILTERS_PER_DEVICE] = {"DO", "DATA/+"};
+
+static void handleMessage(brokerClient_t *client, char *topic, const uint8_t *payload,
+                          size_t length) {
+    benchmarkKeep(client);
+    benchmarkKeep(topic);
+    benchmarkKeep(payload);
+    benchmarkKeep(&length);
+}
+
+static void benchmarkChurn(char (*topics)[48], size_t devices) {
+    size_t count = devices * FILTERS_PER_DEVICE;
+    broker_t broker;
+    brokerClient_t *fleet, *monitor;
+    char name[64];
+    brokerInit(&broker);
+    brokerConnect(&broker, "fleet", NULL, &fleet);
+    brokerConnect(&broker, "monitor", NULL, &monitor);
+    for (size_t index = 0; index < count; index++) {
+        snprintf(topics[index], sizeof(topics[index]), "eaip://fleet/device-%zu/%s",
+                 index / FILTERS_PER_DEVICE, filters[index % FILTERS_PER_DEVICE]);
+    }
+
+    allocations = 0;
+    uint64_t start = benchmarkNow();
+    for (size_t index = 0; index < count; index++) {
+        brokerSubscribe(fleet, topics[index], &handleMessage);
+    }
+    uint64_t elapsed = benchmarkNow() - start;
+    snprintf(name, sizeof(name), "subscribe, %zu filters", count);
+    benchmarkReport(name, count, elapsed);
+    reportAllocations(name, count, allocations);
+
+    /* the monitor keeps every filter in the tree, so only the records are churned */
+    for (size_t index = 0; index < count; index++) {
+        brokerSubscribe(monitor, topics[index], &handleMessage);
+    }
+    allocations = 0;
+    releases = 0;
+    start = benchmarkNow();
+    for (size_t index = 0; index < count; index++) {
+        brokerUnsubscribe(fleet, topics[index]);
+        brokerSubscribe(fleet, topics[index], &handleMessage);
+    }
+    elapsed = benchmarkNow() - start;
+    snprintf(name, sizeof(name), "unsubscribe + subscribe, %zu filters", count);
+    benchmarkReport(name, count, elapsed);
+    reportAllocations(name, count, allocations + releases);
+
+    releases = 0;
+    start = benchmarkNow();
+    brokerFree(&broker);
+    elapsed = benchmarkNow() - start;
+    snprintf(name, sizeof(name), "teardown, %zu subscriptions", 2 * count);
+    benchmarkReport(name, 2 * count, elapsed);
+    reportAllocations(name, 2 * count, releases);
+}
+
+int main(void) {
+    char(*topics)[48] = calloc(MAX_DEVICES * FILTERS_PER_DEVICE, sizeof(*topics));
+    if (topics == NULL) {
+        return 1;
+    }
+
+    for (size_t devices = 1000; devices <= MAX_DEVICES; devices *= 10) {
+        benchmarkChurn(topics, devices);
+    }
+    free(topics);
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Benchmark.h"
+#include "eaip/brokerMock/Broker.h"
+
+#define SUBSCRIBERS 64
+#define PUBLISHERS 4
+#define MESSAGES_PER_PUBLISHER 5000
+#define HANDLER_WORK 2000
+
+/*
+ * Every publisher streams numbered messages to its own topic, every subscriber follows all
+ * topics with a handler doing some work. Throughput is measured until all messages were handled,
+ * once with handlers running on the publishing threads and once per size of the worker pool.
+ */
+
+typedef struct subscriber {
+    int next[PUBLISHERS];
+    size_t violations[PUBLISHERS];
+} subscriber_t;
+
+static atomic_size_t handled;
+
+static void handleData(brokerClient_t *client, char *topic, const uint8_t *payload,
+                       __attribute__((unused)) size_t length) {
+    subscriber_t *subscriber = client->userData;
+    int publisher = topic[strlen("eaip://fleet/publisher-")] - '0';
+    int sequence = atoi((const char *)payload);
+    if (sequence != subscriber->next[publisher]) {
+        subscriber->violations[publisher]++;
+    }
+    subscriber->next[publisher] = sequence + 1;
+
+    /* stands in for decoding and processing the message */
+    uint32_t hash = 0x811c9dc5u;
+    for (int round = 0; round < HANDLER_WORK; round++) {
+        hash = (hash ^ (uint32_t)round) * 0x01000193u;
+    }
+    benchmarkKeep(&hash);
+    atomic_fetch_add_explicit(&handled, 1, memory_order_relaxed);
+}
+
+typedef struct publisher {
+    brokerClient_t *client;
+    int id;
+} publisher_t;
+
+static void *runPublisher(void *argument) {
+    publisher_t *publisher = argument;
+    char topic[48];
+    char payload[16];
+    snprintf(topic, sizeof(topic), "eaip://fleet/publisher-%d/DATA", publisher->id);
+    for (int index = 0; index < MESSAGES_PER_PUBLISHER; index++) {
+        snprintf(payload, sizeof(payload), "%d", index);
+        brokerPublish(publisher->client, topic, (const uint8_t *)payload, strlen(payload), false);
+    }
+    return NULL;
+}
+
+static void benchmarkDelivery(size_t workers) {
+    broker_t broker;
+    brokerClient_t *clients[SUBSCRIBERS];
+    subscriber_t subscribers[SUBSCRIBERS] = {0};
+    publisher_t publishers[PUBLISHERS];
+    pthread_t threads[PUBLISHERS];
+    char name[64];
+
+    brokerInit(&broker);
+    if (workers > 0) {
+        brokerStartWorkers(&broker, workers);
+    }
+    for (size_t index = 0; index < SUBSCRIBERS; index++) {
+        brokerConnect(&broker, "subscriber", &subscribers[index], &clients[index]);
+        brokerSubscribe(clients[index], "eaip://fleet/+/DATA", &handleData);
+    }
+    for (int index = 0; index < PUBLISHERS; index++) {
+        publishers[index].id = index;
+        brokerConnect(&broker, "publisher", NULL, &publishers[index].client);
+    }
+
+    atomic_store(&handled, 0);
+    uint64_t start = benchmarkNow();
+    for (int index = 0; index < PUBLISHERS; index++) {
+        pthread_create(&threads[index], NULL, &runPublisher, &publishers[index]);
+    }
+    for (int index = 0; index < PUBLISHERS; index++) {
+        pthread_join(threads[index], NULL);
+    }
+    brokerFlush(&broker);
+    uint64_t elapsed = benchmarkNow() - start;
+
+    size_t violations = 0;
+    for (size_t index = 0; index < SUBSCRIBERS; index++) {
+        for (int publisher = 0; publisher < PUBLISHERS; publisher++) {
+            violations += subscribers[index].violations[publisher];
+        }
+    }
+    if (workers == 0) {
+        snprintf(name, sizeof(name), "inline, %d publishers", PUBLISHERS);
+    } else {
+        snprintf(name, sizeof(name), "%zu workers, %d publishers", workers, PUBLISHERS);
+    }
+    benchmarkReport(name, atomic_load(&handled), elapsed);
+    if (violations > 0) {
+        printf("  %zu messages out of order\n", violations);
+    }
+    brokerFree(&broker);
+}
+
+int main(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    printf("%ld cores\n", cores);
+
+    benchmarkDelivery(0);
+    for (size_t workers = 1; workers <= 2 * (size_t)(cores > 0 ? cores : 1); workers *= 2) {
+        benchmarkDelivery(workers);
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "eaip/brokerMock/Broker.h"
+
+#define MAX_DEVICES 100000
+
+/*
+ * A fleet of virtual devices in one broker: every device registers its offline STATUS as last
+ * will and waits for DO commands, a monitor follows the STATUS of all devices. The connection of
+ * every device is then lost at once.
+ */
+
+static size_t commands;
+static size_t statusUpdates;
+
+static void handleCommand(brokerClient_t *client, char *topic, const uint8_t *payload,
+                          size_t length) {
+    benchmarkKeep(client);
+    benchmarkKeep(topic);
+    benchmarkKeep(payload);
+    commands += length > 0;
+}
+
+static void handleStatus(brokerClient_t *client, char *topic, const uint8_t *payload,
+                         size_t length) {
+    benchmarkKeep(client);
+    benchmarkKeep(topic);
+    benchmarkKeep(payload);
+    statusUpdates += length > 0;
+}
+
+static void benchmarkFleet(brokerClient_t **devices, size_t count) {
+    broker_t broker;
+    brokerClient_t *monitor;
+    char topic[128]; /* the longest topic the broker mock accepts, room for any name */
+    char name[64];
+    brokerInit(&broker);
+    brokerSetRetainedMemoryLimit(&broker, 64u * 1024u * 1024u);
+    brokerConnect(&broker, "monitor", NULL, &monitor);
+    brokerSubscribe(monitor, "eaip://fleet/+/STATUS", &handleStatus);
+
+    uint64_t start = benchmarkNow();
+    for (size_t index = 0; index < count; index++) {
+        snprintf(name, sizeof(name), "device-%zu", index);
+        brokerConnect(&broker, name, NULL, &devices[index]);
+        snprintf(topic, sizeof(topic), "eaip://fleet/%s/STATUS", name);
+        brokerSetWill(devices[index], topic, "OFFLINE", true);
+        snprintf(topic, sizeof(topic), "eaip://fleet/%s/DO", name);
+        brokerSubscribe(devices[index], topic, &handleCommand);
+        snprintf(topic, sizeof(topic), "eaip://fleet/%s/STATUS", name);
+        brokerPublish(devices[index], topic, (const uint8_t *)"ONLINE", 6, true);
+    }
+    snprintf(name, sizeof(name), "connect, %zu devices", count);
+    benchmarkReport(name, count, benchmarkNow() - start);
+
+    commands = 0;
+    start = benchmarkNow();
+    for (size_t index = 0; index < count; index++) {
+        snprintf(topic, sizeof(topic), "eaip://fleet/device-%zu/DO", index);
+        brokerPublish(monitor, topic, (const uint8_t *)"MEASURE", 7, false);
+    }
+    snprintf(name, sizeof(name), "DO to every device, %zu devices", count);
+    benchmarkReport(name, commands, benchmarkNow() - start);
+
+    statusUpdates = 0;
+    start = benchmarkNow();
+    for (size_t index = 0; index < count; index++) {
+        brokerDisconnect(devices[index], false);
+    }
+    snprintf(name, sizeof(name), "connection loss, %zu devices", count);
+    benchmarkReport(name, statusUpdates, benchmarkNow() - start);
+
+    brokerFree(&broker);
+}
+
+int main(void) {
+    brokerClient_t **devices = calloc(MAX_DEVICES, sizeof(brokerClient_t *));
+    if (devices == NULL) {
+        return 1;
+    }
+
+    for (size_t count = 1000; count <= MAX_DEVICES; count *= 10) {
+        benchmarkFleet(devices, count);
+    }
+    free(devices);
+    return 0;
+}
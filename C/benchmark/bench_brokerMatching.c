@@ -0,0 +1,128 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "eaip/brokerMock/Broker.h"
+#include "eaip/endpoint/CommunicationEndpoint.h"
+
+#define MAX_SUBSCRIPTIONS 100000
+#define PUBLICATIONS 100000
+
+static const char *commands[] = {"START", "STOP", "DO", "DATA"};
+
+/* region REFERENCE */
+
+/* linear scan over all subscriptions, as the broker mock matched topics so far */
+static bool subscribedTopicIsSame(const char *subscription, const char *topic) {
+    while (*subscription && *topic) {
+        if (*subscription == '#') {
+            return true;
+        } else if (*subscription == '+') {
+            while (*topic && *topic != '/') {
+                topic++;
+            }
+            subscription++;
+        } else if (*subscription == *topic) {
+            subscription++;
+            topic++;
+        } else {
+            return false;
+        }
+        if (*topic == '/' && *subscription != '/' && *subscription != '#') {
+            return false;
+        }
+    }
+    return *subscription == '#' || (*subscription == '\0' && *topic == '\0');
+}
+
+static size_t linearMatch(const char *topic) {
+    size_t matches = 0;
+    for (subscriptions_t *current = subscriptions; current != NULL; current = current->next) {
+        matches += subscribedTopicIsSame(current->subscription->topic, topic);
+    }
+    return matches;
+}
+
+/* endregion REFERENCE */
+
+static size_t delivered;
+
+static void countMessage(char *topic, char *message) {
+    benchmarkKeep(topic);
+    benchmarkKeep(message);
+    delivered++;
+}
+
+static void formatTopic(char *topic, size_t size, size_t device, size_t command) {
+    snprintf(topic, size, "eaip://fleet/device-%zu/%s/sensor", device, commands[command]);
+}
+
+/*! @brief a fleet of devices, each subscribed to START/STOP/DO/DATA of one data source */
+static void subscribeFleet(size_t count) {
+    char topic[64];
+    subscribe("eaip://fleet/+/STATUS", &countMessage);
+    subscribe("eaip://fleet/device-0/#", &countMessage);
+    for (size_t index = 0; index < count; index++) {
+        formatTopic(topic, sizeof(topic), index / 4, index % 4);
+        subscribe(topic, &countMessage);
+    }
+}
+
+static void benchmarkSubscriptions(size_t count) {
+    char topics[256][64];
+    char name[64];
+    uint32_t state = 0x2545F491u;
+    for (size_t index = 0; index < 256; index++) {
+        state = state * 1664525u + 1013904223u;
+        formatTopic(topics[index], sizeof(topics[index]), (state >> 8) % (count / 4), index % 4);
+    }
+
+    uint64_t start = benchmarkNow();
+    subscribeFleet(count);
+    snprintf(name, sizeof(name), "subscribe, %zu subscriptions", count);
+    benchmarkReport(name, count, benchmarkNow() - start);
+
+    delivered = 0;
+    start = benchmarkNow();
+    for (size_t index = 0; index < PUBLICATIONS; index++) {
+        publish(topics[index % 256], "1", false);
+    }
+    snprintf(name, sizeof(name), "publish, %zu subscriptions", count);
+    benchmarkReport(name, PUBLICATIONS, benchmarkNow() - start);
+    benchmarkKeep(&delivered);
+
+    size_t iterations = PUBLICATIONS * 100 / count;
+    size_t matches = 0;
+    start = benchmarkNow();
+    for (size_t index = 0; index < iterations; index++) {
+        matches += linearMatch(topics[index % 256]);
+    }
+    snprintf(name, sizeof(name), "linear scan, %zu subscriptions", count);
+    benchmarkReport(name, iterations, benchmarkNow() - start);
+    benchmarkKeep(&matches);
+
+    char topic[64];
+    start = benchmarkNow();
+    for (size_t index = 0; index < count; index++) {
+        formatTopic(topic, sizeof(topic), index / 4, index % 4);
+        unsubscribe(topic);
+    }
+    snprintf(name, sizeof(name), "unsubscribe, %zu subscriptions", count);
+    benchmarkReport(name, count, benchmarkNow() - start);
+
+    /* a simulated reconnect subscribes everything again */
+    start = benchmarkNow();
+    subscribeFleet(count);
+    snprintf(name, sizeof(name), "resubscribe, %zu subscriptions", count);
+    benchmarkReport(name, count, benchmarkNow() - start);
+
+    resetSubscriptions();
+}
+
+int main(void) {
+    for (size_t count = 100; count <= MAX_SUBSCRIPTIONS; count *= 10) {
+        benchmarkSubscriptions(count);
+    }
+    return 0;
+}
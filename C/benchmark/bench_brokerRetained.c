@@ -0,0 +1,110 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "eaip/brokerMock/Broker.h"
+#include "eaip/endpoint/CommunicationEndpoint.h"
+
+#define MAX_DEVICES 100000
+#define TOPICS_PER_DEVICE 4
+
+static const char *levels[TOPICS_PER_DEVICE] = {"STATUS", "DATA/temperature", "DATA/humidity",
+                                                "DATA/pressure"};
+
+/* region REFERENCE */
+
+/* full scan over all retained topics with the matcher the broker mock used so far */
+static bool subscribedTopicIsSame(const char *subscription, const char *topic) {
+    while (*subscription && *topic) {
+        if (*subscription == '#') {
+            return true;
+        } else if (*subscription == '+') {
+            while (*topic && *topic != '/') {
+                topic++;
+            }
+            subscription++;
+        } else if (*subscription == *topic) {
+            subscription++;
+            topic++;
+        } else {
+            return false;
+        }
+        if (*topic == '/' && *subscription != '/' && *subscription != '#') {
+            return false;
+        }
+    }
+    return *subscription == '#' || (*subscription == '\0' && *topic == '\0');
+}
+
+/* endregion REFERENCE */
+
+static char (*topics)[48];
+static size_t delivered;
+
+static void countMessage(char *topic, char *message) {
+    benchmarkKeep(topic);
+    benchmarkKeep(message);
+    delivered++;
+}
+
+static void benchmarkFleet(size_t devices) {
+    size_t count = devices * TOPICS_PER_DEVICE;
+    char name[64];
+
+    uint64_t start = benchmarkNow();
+    for (size_t index = 0; index < count; index++) {
+        snprintf(topics[index], sizeof(topics[index]), "eaip://fleet/device-%zu/%s",
+                 index / TOPICS_PER_DEVICE, levels[index % TOPICS_PER_DEVICE]);
+        publish(topics[index], "ONLINE;type:enV5", true);
+    }
+    snprintf(name, sizeof(name), "retain, %zu retained", count);
+    benchmarkReport(name, count, benchmarkNow() - start);
+
+    delivered = 0;
+    start = benchmarkNow();
+    subscribe("eaip://fleet/+/STATUS", &countMessage);
+    snprintf(name, sizeof(name), "discover +/STATUS, %zu retained", count);
+    benchmarkReport(name, delivered, benchmarkNow() - start);
+
+    size_t matches = 0;
+    start = benchmarkNow();
+    for (size_t index = 0; index < count; index++) {
+        matches += subscribedTopicIsSame("eaip://fleet/+/STATUS", topics[index]);
+    }
+    snprintf(name, sizeof(name), "full scan +/STATUS, %zu retained", count);
+    benchmarkReport(name, matches, benchmarkNow() - start);
+
+    delivered = 0;
+    start = benchmarkNow();
+    subscribe("eaip://fleet/device-42/#", &countMessage);
+    snprintf(name, sizeof(name), "subscribe device/#, %zu retained", count);
+    benchmarkReport(name, 1, benchmarkNow() - start);
+    benchmarkKeep(&delivered);
+
+    matches = 0;
+    start = benchmarkNow();
+    for (size_t index = 0; index < count; index++) {
+        matches += subscribedTopicIsSame("eaip://fleet/device-42/#", topics[index]);
+    }
+    snprintf(name, sizeof(name), "full scan device/#, %zu retained", count);
+    benchmarkReport(name, 1, benchmarkNow() - start);
+    benchmarkKeep(&matches);
+
+    resetSubscriptions();
+}
+
+int main(void) {
+    topics = calloc(MAX_DEVICES * TOPICS_PER_DEVICE, sizeof(*topics));
+    if (topics == NULL) {
+        return 1;
+    }
+    setRetainedMemoryLimit(64u * 1024u * 1024u);
+
+    for (size_t devices = 1000; devices <= MAX_DEVICES; devices *= 10) {
+        benchmarkFleet(devices);
+    }
+    free(topics);
+    return 0;
+}
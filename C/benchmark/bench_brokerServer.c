@@ -0,0 +1,196 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Benchmark.h"
+#include "eaip/brokerServer/BrokerServer.h"
+
+#define ROUND_TRIPS 2000
+#define STREAMED_MESSAGES 100000
+#define STREAM_BATCH 64
+
+/*
+ * Measures the loopback broker over real sockets: the round trip of a message through the broker
+ * back to its publisher, and the throughput of a publisher streaming DATA to a subscriber. Both
+ * are run with and without Nagle's algorithm on the broker and the clients.
+ */
+
+static brokerServer_t server;
+
+static void *runServer(__attribute__((unused)) void *argument) {
+    brokerServerRun(&server);
+    return NULL;
+}
+
+/* region RAW MQTT CLIENT */
+
+static bool receiveBytes(int socket, uint8_t *data, size_t length) {
+    while (length > 0) {
+        ssize_t received = recv(socket, data, length, 0);
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        length -= (size_t)received;
+    }
+    return true;
+}
+
+/*! @brief receive a packet whose remaining length is below 128, discarding its body */
+static bool receivePacket(int socket, uint8_t *type) {
+    uint8_t header[2];
+    uint8_t body[128];
+    if (!receiveBytes(socket, header, 2) || !receiveBytes(socket, body, header[1])) {
+        return false;
+    }
+    *type = header[0];
+    return true;
+}
+
+static size_t buildPacket(uint8_t *packet, uint8_t type, const char *topic, const char *message,
+                          bool withPacketId) {
+    size_t topicLength = strlen(topic);
+    size_t messageLength = strlen(message);
+    size_t length = 2 + topicLength + messageLength + (withPacketId ? 3 : 0);
+    packet[0] = type;
+    packet[1] = (uint8_t)length;
+    uint8_t *body = packet + 2;
+    if (withPacketId) {
+        body[0] = 0;
+        body[1] = 1;
+        body += 2;
+    }
+    body[0] = 0;
+    body[1] = (uint8_t)topicLength;
+    memcpy(body + 2, topic, topicLength);
+    memcpy(body + 2 + topicLength, message, messageLength);
+    if (withPacketId) {
+        body[2 + topicLength] = 0; /* requested QoS of SUBSCRIBE */
+    }
+    return 2 + length;
+}
+
+static int connectClient(const char *id, bool noDelay) {
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address = {.sin_family = AF_INET,
+                                  .sin_port = htons(brokerServerGetPort(&server)),
+                                  .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    int enabled = noDelay;
+    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+    if (0 != connect(client, (struct sockaddr *)&address, sizeof(address))) {
+        close(client);
+        return -1;
+    }
+
+    uint8_t packet[64] = {0x10, 0, 0, 4, 'M', 'Q', 'T', 'T', 4, 0x02, 0, 60};
+    size_t idLength = strlen(id);
+    packet[12] = 0;
+    packet[13] = (uint8_t)idLength;
+    memcpy(packet + 14, id, idLength);
+    packet[1] = (uint8_t)(12 + idLength);
+    uint8_t type;
+    send(client, packet, 14 + idLength, MSG_NOSIGNAL);
+    if (!receivePacket(client, &type) || type != 0x20) {
+        close(client);
+        return -1;
+    }
+    return client;
+}
+
+static bool subscribeClient(int client, const char *filter) {
+    uint8_t packet[64];
+    uint8_t type;
+    send(client, packet, buildPacket(packet, 0x82, filter, "", true), MSG_NOSIGNAL);
+    return receivePacket(client, &type) && type == 0x90;
+}
+
+/* endregion RAW MQTT CLIENT */
+
+static void benchmarkRoundTrip(bool noDelay) {
+    int client = connectClient("enV5", noDelay);
+    if (client < 0 || !subscribeClient(client, "eaip://local/enV5/DATA/+")) {
+        printf("round trip: client failed\n");
+        return;
+    }
+
+    uint8_t packet[64];
+    size_t length = buildPacket(packet, 0x30, "eaip://local/enV5/DATA/value", "42.0", false);
+    uint64_t start = benchmarkNow();
+    for (size_t index = 0; index < ROUND_TRIPS; index++) {
+        uint8_t type;
+        send(client, packet, length, MSG_NOSIGNAL);
+        receivePacket(client, &type);
+    }
+    benchmarkReport(noDelay ? "round trip, TCP_NODELAY" : "round trip, Nagle", ROUND_TRIPS,
+                    benchmarkNow() - start);
+    close(client);
+}
+
+static void benchmarkStream(bool noDelay) {
+    int publisher = connectClient("enV5", noDelay);
+    int subscriber = connectClient("monitor", noDelay);
+    if (publisher < 0 || subscriber < 0 || !subscribeClient(subscriber, "eaip://local/+/DATA/+")) {
+        printf("stream: client failed\n");
+        return;
+    }
+
+    uint8_t batch[STREAM_BATCH * 64];
+    size_t length = 0;
+    for (size_t index = 0; index < STREAM_BATCH; index++) {
+        length += buildPacket(batch + length, 0x30, "eaip://local/enV5/DATA/value", "42.0", false);
+    }
+    size_t packetLength = length / STREAM_BATCH;
+
+    uint64_t start = benchmarkNow();
+    size_t received = 0;
+    uint8_t buffer[65536];
+    for (size_t sent = 0; sent < STREAMED_MESSAGES; sent += STREAM_BATCH) {
+        send(publisher, batch, length, MSG_NOSIGNAL);
+        /* keep at most a few batches in flight, the broker closes clients that do not read */
+        while ((sent + STREAM_BATCH - received / packetLength) > 8 * STREAM_BATCH) {
+            ssize_t result = recv(subscriber, buffer, sizeof(buffer), 0);
+            if (result <= 0) {
+                printf("stream: connection lost\n");
+                return;
+            }
+            received += (size_t)result;
+        }
+    }
+    while (received < STREAMED_MESSAGES * packetLength) {
+        ssize_t result = recv(subscriber, buffer, sizeof(buffer), 0);
+        if (result <= 0) {
+            printf("stream: connection lost\n");
+            return;
+        }
+        received += (size_t)result;
+    }
+    benchmarkReport(noDelay ? "stream QoS 0, TCP_NODELAY" : "stream QoS 0, Nagle",
+                    STREAMED_MESSAGES, benchmarkNow() - start);
+    close(publisher);
+    close(subscriber);
+}
+
+int main(void) {
+    for (int nagle = 0; nagle <= 1; nagle++) {
+        pthread_t thread;
+        if (EAIP_COM_NO_ERROR != brokerServerInit(&server, 0, nagle == 0)) {
+            return 1;
+        }
+        pthread_create(&thread, NULL, &runServer, NULL);
+
+        benchmarkRoundTrip(nagle == 0);
+        benchmarkStream(nagle == 0);
+
+        brokerServerStop(&server);
+        pthread_join(thread, NULL);
+        brokerServerFree(&server);
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <stdio.h>
+
+#include "Benchmark.h"
+#include "eaip/protocol/Commander.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Session.h"
+
+#define BASE_URL "eaip://local-net"
+#define ITERATIONS 200000
+
+/*
+ * Keeps `pending` requests to a slow device in flight while requests to a fast device are issued
+ * and completed, or cancelled, one at a time. The request of the fast device is always the newest
+ * one, so the cost of matching its reply, or its token, must not grow with the requests in flight.
+ */
+
+static eaipCommunicationErrorCodes discardMessage(__attribute__((unused)) char *topic,
+                                                  __attribute__((unused)) char *message,
+                                                  __attribute__((unused)) bool retain) {
+    return EAIP_COM_NO_ERROR;
+}
+
+static void countCompletion(__attribute__((unused)) eaipCommandResult_t result,
+                            __attribute__((unused)) char *message, void *userData) {
+    (*(size_t *)userData)++;
+}
+
+static void benchmarkCommander(size_t pending) {
+    eaiProtocol_t config = {.publish = &discardMessage, .baseUrl = BASE_URL, .deviceId = "bench"};
+    eaipSession_t session;
+    eaipCommander_t commander;
+    eaipSessionInit(&session, config);
+    eaipCommanderInit(&commander, &session, pending + 1, 10, 0);
+
+    size_t completed = 0;
+    char command[32];
+    for (size_t index = 0; index < pending; index++) {
+        snprintf(command, sizeof(command), "measure-%zu", index);
+        eaipPubRequest_t slow = {.deviceId = "slow", .dataId = command, .data = ""};
+        eaipCommanderRequest(&commander, slow, 60000, &countCompletion, &completed, NULL);
+    }
+
+    eaipPubRequest_t fast = {.deviceId = "fast", .dataId = "measure", .data = ""};
+    char name[64];
+    uint64_t start = benchmarkNow();
+    for (size_t index = 0; index < ITERATIONS; index++) {
+        eaipCommanderRequest(&commander, fast, 60000, &countCompletion, &completed, NULL);
+        eaipCommanderDispatch(&commander, BASE_URL "/fast/DONE/measure", "1");
+    }
+    snprintf(name, sizeof(name), "request + dispatch, %zu pending", pending);
+    benchmarkReport(name, ITERATIONS, benchmarkNow() - start);
+
+    uint32_t token;
+    start = benchmarkNow();
+    for (size_t index = 0; index < ITERATIONS; index++) {
+        eaipCommanderRequest(&commander, fast, 60000, &countCompletion, &completed, &token);
+        eaipCommanderCancel(&commander, token);
+    }
+    snprintf(name, sizeof(name), "request + cancel, %zu pending", pending);
+    benchmarkReport(name, ITERATIONS, benchmarkNow() - start);
+
+    benchmarkKeep(&completed);
+    eaipCommanderFree(&commander);
+    eaipSessionFree(&session);
+}
+
+int main(void) {
+    benchmarkCommander(16);
+    benchmarkCommander(256);
+    benchmarkCommander(4096);
+    return 0;
+}
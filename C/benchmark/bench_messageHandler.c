@@ -0,0 +1,82 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "eaip/brokerMock/Broker.h"
+#include "eaip/protocol/Protocol.h"
+
+#define BASE_URL "eaip://local-net"
+#define DEVICES 16
+#define MESSAGES 1000000
+
+/*
+ * Delivers DATA of several devices through the broker mock to a monitor subscribed to
+ * `<baseUrl>/+/DATA/+`, once with a `messageHandler` and once with an `eaipMessageViewHandler`.
+ * Both handlers sum up the lengths of device-ID, data-ID and payload. The first one has to measure
+ * and split the strings again and keeps its state in globals, the second one gets the views.
+ */
+
+static size_t total;
+
+static void handleMessage(char *topic, char *message) {
+    /* what a handler needs to find the parts of the topic */
+    char *deviceId = topic + strlen(BASE_URL) + 1;
+    char *dataId = strrchr(topic, '/') + 1;
+    size_t deviceIdLength = (size_t)(strchr(deviceId, '/') - deviceId);
+    total += deviceIdLength + strlen(dataId) + strlen(message);
+}
+
+static void handleView(const eaipMessageView_t *message, void *userData) {
+    size_t *sum = userData;
+    *sum += message->deviceId.length + message->dataId.length + message->length;
+}
+
+static void benchmarkHandler(bool view) {
+    broker_t broker;
+    brokerClient_t *device, *monitor;
+    brokerInit(&broker);
+    brokerConnect(&broker, "device", NULL, &device);
+    brokerConnect(&broker, "monitor", NULL, &monitor);
+
+    eaiProtocol_t config = {
+        .baseUrl = BASE_URL,
+        .deviceId = "monitor",
+        .endpoint = {&brokerEndpointInterface, monitor},
+    };
+    eaipViewSubscription_t subscription;
+    eaipSubRequest_t request = {.targetId = "+",
+                                .dataId = "+",
+                                .handler = &handleMessage,
+                                .viewHandler = &handleView,
+                                .userData = &total};
+    if (view) {
+        eaipSubscribeView(config, DATA, request, &subscription);
+    } else {
+        eaipSubscribeData(config, request);
+    }
+
+    char topics[DEVICES][64];
+    for (size_t index = 0; index < DEVICES; index++) {
+        snprintf(topics[index], sizeof(topics[index]), BASE_URL "/sensor-%zu/DATA/temperature",
+                 index);
+    }
+
+    total = 0;
+    uint64_t start = benchmarkNow();
+    for (size_t index = 0; index < MESSAGES; index++) {
+        brokerPublish(device, topics[index % DEVICES], (const uint8_t *)"21.5", 4, false);
+    }
+    benchmarkReport(view ? "eaipMessageViewHandler" : "messageHandler", MESSAGES,
+                    benchmarkNow() - start);
+    benchmarkKeep(&total);
+    brokerFree(&broker);
+}
+
+int main(void) {
+    benchmarkHandler(false);
+    benchmarkHandler(true);
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "eaip/brokerServer/BrokerServer.h"
+#include "eaip/endpoint/MqttEndpoint.h"
+
+#define ROUND_TRIPS 2000
+#define STREAMED_MESSAGES 100000
+#define IN_FLIGHT 1024
+
+/*
+ * Measures the MQTT endpoint against the loopback broker: the round trip of a message back to its
+ * publisher, and the throughput of a publisher streaming DATA to a subscriber while writing the
+ * send ring after every message or after a batch of messages.
+ */
+
+static brokerServer_t server;
+static size_t received;
+
+static void *runServer(__attribute__((unused)) void *argument) {
+    brokerServerRun(&server);
+    return NULL;
+}
+
+static void handleMessage(char *topic, const uint8_t *payload, size_t length) {
+    benchmarkKeep(topic);
+    benchmarkKeep(payload);
+    benchmarkKeep(&length);
+    received++;
+}
+
+static bool connectEndpoint(mqttEndpoint_t *endpoint, const char *id) {
+    return EAIP_COM_NO_ERROR == mqttEndpointInit(endpoint) &&
+           EAIP_COM_NO_ERROR ==
+               mqttEndpointConnect(endpoint, "127.0.0.1", brokerServerGetPort(&server), id);
+}
+
+/*! @brief poll until `count` messages arrived, gives up after a second without progress */
+static bool awaitReceived(mqttEndpoint_t *publisher, mqttEndpoint_t *subscriber, size_t count) {
+    size_t idle = 0;
+    while (received < count && idle < 1000) {
+        size_t before = received;
+        if (publisher != subscriber && EAIP_COM_NO_ERROR != mqttEndpointPoll(publisher, 0)) {
+            return false;
+        }
+        if (EAIP_COM_NO_ERROR != mqttEndpointPoll(subscriber, 1)) {
+            return false;
+        }
+        idle = received == before ? idle + 1 : 0;
+    }
+    return received >= count;
+}
+
+static void benchmarkRoundTrip(void) {
+    mqttEndpoint_t endpoint;
+    if (!connectEndpoint(&endpoint, "enV5")) {
+        printf("round trip: endpoint failed\n");
+        return;
+    }
+    mqttEndpointSubscribeBinary(&endpoint, "eaip://local/enV5/DATA/+", &handleMessage);
+
+    received = 0;
+    uint64_t start = benchmarkNow();
+    for (size_t index = 0; index < ROUND_TRIPS; index++) {
+        mqttEndpointPublish(&endpoint, "eaip://local/enV5/DATA/value", (const uint8_t *)"42.0", 4,
+                            false);
+        if (!awaitReceived(&endpoint, &endpoint, index + 1)) {
+            printf("round trip: connection lost\n");
+            break;
+        }
+    }
+    benchmarkReport("round trip", ROUND_TRIPS, benchmarkNow() - start);
+    mqttEndpointDisconnect(&endpoint);
+    mqttEndpointFree(&endpoint);
+}
+
+static void benchmarkStream(size_t batch) {
+    mqttEndpoint_t publisher, subscriber;
+    char name[64];
+    if (!connectEndpoint(&publisher, "enV5") || !connectEndpoint(&subscriber, "monitor")) {
+        printf("stream: endpoint failed\n");
+        return;
+    }
+    mqttEndpointSubscribeBinary(&subscriber, "eaip://local/+/DATA/+", &handleMessage);
+    /* the own message of the subscriber proves the broker handled its SUBSCRIBE */
+    mqttEndpointPublish(&subscriber, "eaip://local/monitor/DATA/ready", NULL, 0, false);
+    received = 0;
+    if (!awaitReceived(&subscriber, &subscriber, 1)) {
+        printf("stream: subscription failed\n");
+        return;
+    }
+
+    received = 0;
+    uint64_t start = benchmarkNow();
+    for (size_t sent = 0; sent < STREAMED_MESSAGES; sent += batch) {
+        for (size_t index = 0; index < batch; index++) {
+            mqttEndpointPublish(&publisher, "eaip://local/enV5/DATA/value",
+                                (const uint8_t *)"42.0", 4, false);
+        }
+        mqttEndpointPoll(&publisher, 0);
+        mqttEndpointPoll(&subscriber, 0);
+        if (sent + batch > IN_FLIGHT && !awaitReceived(&publisher, &subscriber, sent - IN_FLIGHT)) {
+            printf("stream: connection lost\n");
+            return;
+        }
+    }
+    if (!awaitReceived(&publisher, &subscriber, STREAMED_MESSAGES)) {
+        printf("stream: connection lost\n");
+        return;
+    }
+    snprintf(name, sizeof(name), "stream QoS 0, written every %zu messages", batch);
+    benchmarkReport(name, STREAMED_MESSAGES, benchmarkNow() - start);
+
+    mqttEndpointDisconnect(&publisher);
+    mqttEndpointDisconnect(&subscriber);
+    mqttEndpointFree(&publisher);
+    mqttEndpointFree(&subscriber);
+}
+
+int main(void) {
+    pthread_t thread;
+    if (EAIP_COM_NO_ERROR != brokerServerInit(&server, 0, true)) {
+        return 1;
+    }
+    pthread_create(&thread, NULL, &runServer, NULL);
+
+    benchmarkRoundTrip();
+    benchmarkStream(1);
+    benchmarkStream(64);
+
+    brokerServerStop(&server);
+    pthread_join(thread, NULL);
+    brokerServerFree(&server);
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "eaip/protocol/Number.h"
+#include "eaip/protocol/Protocol.h"
+
+#define VALUE_COUNT 4096
+#define VECTOR_LENGTH 64
+
+/* region REFERENCE */
+
+/* libc implementation used by publishers and consumers so far */
+static size_t libcFormatVector(char *buffer, size_t bufferSize, const float *values,
+                               size_t count) {
+    size_t length = 0;
+    for (size_t index = 0; index < count && length < bufferSize; index++) {
+        length += (size_t)snprintf(buffer + length, bufferSize - length,
+                                   index == 0 ? "%.9g" : ",%.9g", (double)values[index]);
+    }
+    return length;
+}
+
+static size_t libcParseVector(const char *buffer, float *values, size_t capacity) {
+    size_t count = 0;
+    char *end = (char *)buffer;
+    while (count < capacity && *end != '\0') {
+        values[count++] = strtof(end, &end);
+        if (*end == ',') {
+            end++;
+        }
+    }
+    return count;
+}
+
+/* endregion REFERENCE */
+
+static float values[VALUE_COUNT];
+
+static void createValues(void) {
+    uint32_t state = 0x2545F491u;
+    for (size_t index = 0; index < VALUE_COUNT; index++) {
+        /* sensor-like values: a few significant digits across several magnitudes */
+        state = state * 1664525u + 1013904223u;
+        float magnitude = (float)(1u << (state >> 28));
+        values[index] = ((float)(int32_t)(state % 200001u) - 100000.0f) / 1000.0f * magnitude;
+    }
+}
+
+static void benchmarkScalar(void) {
+    char buffer[EAIP_NUMBER_BUFFER_SIZE + 8];
+    uint64_t iterations = 2000000;
+    float parsed = 0;
+
+    uint64_t start = benchmarkNow();
+    for (uint64_t iteration = 0; iteration < iterations; iteration++) {
+        snprintf(buffer, sizeof(buffer), "%f", (double)values[iteration % VALUE_COUNT]);
+        benchmarkKeep(buffer);
+    }
+    benchmarkReport("snprintf %f", iterations, benchmarkNow() - start);
+
+    start = benchmarkNow();
+    for (uint64_t iteration = 0; iteration < iterations; iteration++) {
+        snprintf(buffer, sizeof(buffer), "%.9g", (double)values[iteration % VALUE_COUNT]);
+        benchmarkKeep(buffer);
+    }
+    benchmarkReport("snprintf %.9g", iterations, benchmarkNow() - start);
+
+    start = benchmarkNow();
+    for (uint64_t iteration = 0; iteration < iterations; iteration++) {
+        eaipFormatFloat(buffer, values[iteration % VALUE_COUNT]);
+        benchmarkKeep(buffer);
+    }
+    benchmarkReport("eaipFormatFloat", iterations, benchmarkNow() - start);
+
+    char texts[VALUE_COUNT][EAIP_NUMBER_BUFFER_SIZE];
+    size_t lengths[VALUE_COUNT];
+    for (size_t index = 0; index < VALUE_COUNT; index++) {
+        lengths[index] = eaipFormatFloat(texts[index], values[index]);
+    }
+
+    start = benchmarkNow();
+    for (uint64_t iteration = 0; iteration < iterations; iteration++) {
+        parsed = strtof(texts[iteration % VALUE_COUNT], NULL);
+        benchmarkKeep(&parsed);
+    }
+    benchmarkReport("strtof", iterations, benchmarkNow() - start);
+
+    start = benchmarkNow();
+    for (uint64_t iteration = 0; iteration < iterations; iteration++) {
+        size_t index = iteration % VALUE_COUNT;
+        eaipScanFloat(texts[index], lengths[index], &parsed);
+        benchmarkKeep(&parsed);
+    }
+    benchmarkReport("eaipScanFloat", iterations, benchmarkNow() - start);
+}
+
+static void benchmarkVector(void) {
+    char buffer[VECTOR_LENGTH * EAIP_NUMBER_BUFFER_SIZE];
+    float parsed[VECTOR_LENGTH];
+    uint64_t iterations = 50000;
+    size_t count = 0;
+    char name[64];
+
+    uint64_t start = benchmarkNow();
+    for (uint64_t iteration = 0; iteration < iterations; iteration++) {
+        const float *vector = &values[(iteration * VECTOR_LENGTH) % VALUE_COUNT];
+        libcFormatVector(buffer, sizeof(buffer), vector, VECTOR_LENGTH);
+        benchmarkKeep(buffer);
+    }
+    snprintf(name, sizeof(name), "snprintf vector (%d values)", VECTOR_LENGTH);
+    benchmarkReport(name, iterations, benchmarkNow() - start);
+
+    start = benchmarkNow();
+    for (uint64_t iteration = 0; iteration < iterations; iteration++) {
+        const float *vector = &values[(iteration * VECTOR_LENGTH) % VALUE_COUNT];
+        eaipWriter_t writer;
+        eaipWriterInit(&writer, buffer, sizeof(buffer));
+        eaipWriteFloatVector(&writer, vector, VECTOR_LENGTH);
+        eaipWriterFinish(&writer);
+        benchmarkKeep(buffer);
+    }
+    snprintf(name, sizeof(name), "eaipWriteFloatVector (%d values)", VECTOR_LENGTH);
+    benchmarkReport(name, iterations, benchmarkNow() - start);
+
+    size_t length = strlen(buffer);
+    start = benchmarkNow();
+    for (uint64_t iteration = 0; iteration < iterations; iteration++) {
+        count = libcParseVector(buffer, parsed, VECTOR_LENGTH);
+        benchmarkKeep(parsed);
+    }
+    snprintf(name, sizeof(name), "strtof vector (%zu values)", count);
+    benchmarkReport(name, iterations, benchmarkNow() - start);
+
+    start = benchmarkNow();
+    for (uint64_t iteration = 0; iteration < iterations; iteration++) {
+        eaipParseDataVector(buffer, length, parsed, VECTOR_LENGTH, &count);
+        benchmarkKeep(parsed);
+    }
+    snprintf(name, sizeof(name), "eaipParseDataVector (%zu values)", count);
+    benchmarkReport(name, iterations, benchmarkNow() - start);
+}
+
+int main(void) {
+    createValues();
+    benchmarkScalar();
+    benchmarkVector();
+    return 0;
+}
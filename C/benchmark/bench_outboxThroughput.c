@@ -0,0 +1,106 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "Benchmark.h"
+#include "eaip/protocol/Outbox.h"
+#include "eaip/protocol/Protocol.h"
+
+#define MESSAGES_PER_PRODUCER 500000
+#define MAX_PRODUCERS 16
+
+static atomic_bool producing;
+
+static eaipCommunicationErrorCodes discardMessage(char *topic, char *message, bool retain) {
+    benchmarkKeep(topic);
+    benchmarkKeep(message);
+    benchmarkKeep(&retain);
+    return EAIP_COM_NO_ERROR;
+}
+
+/* region REFERENCE */
+
+/* a transport shared by all workers, serialized by a mutex */
+static pthread_mutex_t transportLock = PTHREAD_MUTEX_INITIALIZER;
+
+static void *publishLocked(__attribute__((unused)) void *argument) {
+    for (size_t index = 0; index < MESSAGES_PER_PRODUCER; index++) {
+        pthread_mutex_lock(&transportLock);
+        discardMessage("eaip://local-net/worker/DATA/result", "0.231", false);
+        pthread_mutex_unlock(&transportLock);
+    }
+    return NULL;
+}
+
+/* endregion REFERENCE */
+
+static void *publishQueued(void *argument) {
+    eaipOutbox_t *outbox = argument;
+    for (size_t index = 0; index < MESSAGES_PER_PRODUCER; index++) {
+        eaipOutboxPublish(outbox, "eaip://local-net/worker/DATA/result", "0.231", false);
+    }
+    return NULL;
+}
+
+static void *drainQueued(void *argument) {
+    eaipOutbox_t *outbox = argument;
+    while (atomic_load(&producing) || eaipOutboxCount(outbox) > 0) {
+        if (0 == eaipOutboxDrain(outbox, 64)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void benchmarkProducers(size_t producers) {
+    pthread_t threads[MAX_PRODUCERS];
+    uint64_t messages = (uint64_t)producers * MESSAGES_PER_PRODUCER;
+    char name[64];
+
+    uint64_t start = benchmarkNow();
+    for (size_t index = 0; index < producers; index++) {
+        pthread_create(&threads[index], NULL, &publishLocked, NULL);
+    }
+    for (size_t index = 0; index < producers; index++) {
+        pthread_join(threads[index], NULL);
+    }
+    snprintf(name, sizeof(name), "mutex around publish, %zu producers", producers);
+    benchmarkReport(name, messages, benchmarkNow() - start);
+
+    eaiProtocol_t config = {.publish = &discardMessage};
+    eaipOutbox_t outbox;
+    eaipOutboxInitMultiProducer(&outbox, config, 1024, 64, EAIP_OVERFLOW_BLOCK);
+    atomic_store(&producing, true);
+
+    pthread_t consumer;
+    start = benchmarkNow();
+    pthread_create(&consumer, NULL, &drainQueued, &outbox);
+    for (size_t index = 0; index < producers; index++) {
+        pthread_create(&threads[index], NULL, &publishQueued, &outbox);
+    }
+    for (size_t index = 0; index < producers; index++) {
+        pthread_join(threads[index], NULL);
+    }
+    atomic_store(&producing, false);
+    pthread_join(consumer, NULL);
+    snprintf(name, sizeof(name), "multi-producer outbox, %zu producers", producers);
+    benchmarkReport(name, messages, benchmarkNow() - start);
+
+    eaipOutboxFree(&outbox);
+}
+
+int main(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t maxProducers = cores < 4 ? 4 : (size_t)cores;
+    if (maxProducers > MAX_PRODUCERS) {
+        maxProducers = MAX_PRODUCERS;
+    }
+    printf("%ld online cores\n", cores);
+
+    for (size_t producers = 1; producers <= maxProducers; producers *= 2) {
+        benchmarkProducers(producers);
+    }
+    return 0;
+}
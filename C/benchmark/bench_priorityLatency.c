@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "eaip/protocol/Outbox.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Scheduler.h"
+
+/*
+ * The transport is simulated by a virtual clock advancing with every published byte, so the
+ * measured latency only depends on the queueing order and not on the host.
+ */
+#define NS_PER_BYTE 1000u /* 8 Mbit/s */
+#define BULK_CAPACITY 64
+#define CONTROL_INTERVAL 16
+#define CONTROL_MESSAGES 10000
+#define CONTROL_TOPIC "eaip://local-net/enV5/DO/stop"
+#define BULK_TOPIC "eaip://local-net/enV5/DATA/accel"
+
+#define BULK_MESSAGE                                                                               \
+    "[0.231,0.118,0.942,0.412,0.073,0.661,0.587,0.301,0.845,0.129,0.336,0.778,0.054,0.913,"       \
+    "0.267,0.490]"
+
+static uint64_t linkTime;
+static uint64_t latencies[CONTROL_MESSAGES];
+static size_t received;
+
+static eaipCommunicationErrorCodes transmit(char *topic, char *message, bool retain) {
+    benchmarkKeep(&retain);
+    linkTime += (uint64_t)(strlen(topic) + strlen(message)) * NS_PER_BYTE;
+    if (0 == strcmp(topic, CONTROL_TOPIC) && received < CONTROL_MESSAGES) {
+        latencies[received++] = linkTime - strtoull(message, NULL, 10);
+    }
+    return EAIP_COM_NO_ERROR;
+}
+
+static int compareLatencies(const void *first, const void *second) {
+    uint64_t a = *(const uint64_t *)first;
+    uint64_t b = *(const uint64_t *)second;
+    return (a > b) - (a < b);
+}
+
+static void reportLatencies(const char *name) {
+    qsort(latencies, received, sizeof(uint64_t), &compareLatencies);
+    printf("%-48s %10zu messages p50 %8.2f ms p99 %8.2f ms\n", name, received,
+           (double)latencies[received / 2] / 1e6, (double)latencies[received * 99 / 100] / 1e6);
+}
+
+/*! @brief the control message carries the virtual time it was queued at */
+static const char *timestamp(void) {
+    static char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%llu", (unsigned long long)linkTime);
+    return buffer;
+}
+
+static void benchmarkFifo(eaiProtocol_t config) {
+    eaipOutbox_t outbox;
+    eaipOutboxInit(&outbox, config, BULK_CAPACITY, EAIP_OUTBOX_RECORD_SIZE,
+                   EAIP_OVERFLOW_DROP_NEWEST);
+    linkTime = 0;
+    received = 0;
+
+    for (size_t step = 0; received < CONTROL_MESSAGES; step++) {
+        if (step % CONTROL_INTERVAL == 0) {
+            eaipOutboxPublish(&outbox, CONTROL_TOPIC, timestamp(), false);
+        }
+        while (eaipOutboxCount(&outbox) < BULK_CAPACITY) {
+            eaipOutboxPublish(&outbox, BULK_TOPIC, BULK_MESSAGE, false);
+        }
+        eaipOutboxDrain(&outbox, 1);
+    }
+
+    reportLatencies("single FIFO outbox, saturated");
+    eaipOutboxFree(&outbox);
+}
+
+static void benchmarkScheduler(eaiProtocol_t config) {
+    eaipScheduler_t scheduler;
+    size_t lane;
+    eaipSchedulerInit(&scheduler, config, 16, EAIP_OUTBOX_RECORD_SIZE);
+    eaipSchedulerAddBulkLane(&scheduler, BULK_CAPACITY, 1, EAIP_OVERFLOW_DROP_NEWEST, &lane);
+    linkTime = 0;
+    received = 0;
+
+    for (size_t step = 0; received < CONTROL_MESSAGES; step++) {
+        if (step % CONTROL_INTERVAL == 0) {
+            eaipSchedulerPublishControl(&scheduler, CONTROL_TOPIC, timestamp(), false);
+        }
+        /* keep the bulk lane saturated, it refuses messages once it is full */
+        while (EAIP_COM_NO_ERROR ==
+               eaipSchedulerPublishBulk(&scheduler, lane, BULK_TOPIC, BULK_MESSAGE)) {
+        }
+        eaipSchedulerDrain(&scheduler, 1);
+    }
+
+    reportLatencies("scheduler control lane, saturated");
+    eaipSchedulerFree(&scheduler);
+}
+
+int main(void) {
+    eaiProtocol_t config = {.publish = &transmit};
+    benchmarkFifo(config);
+    benchmarkScheduler(config);
+    return 0;
+}
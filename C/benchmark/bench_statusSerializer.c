@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "eaip/protocol/Protocol.h"
+
+#define DEVICE_ID "bench-device"
+/* large enough for the widest `size_t` index */
+#define FIELD_ID_SIZE 32
+#define FIELD_DATA_SIZE 64
+
+/* region REFERENCE */
+
+/* previous implementation: one `strcat` per token, each rescanning the buffer */
+static void strcatStatus(char *statusBuffer, char *deviceId, eaipDeviceState_t status) {
+    sprintf(statusBuffer, "%s:%s;", "ID", deviceId);
+    strcat(statusBuffer, "TYPE:");
+    strcat(statusBuffer, status.deviceType == NODE ? "enV5" : "APPLICATION");
+    strcat(statusBuffer, ";");
+    strcat(statusBuffer, "STATE:");
+    strcat(statusBuffer, status.deviceState == ONLINE ? "ONLINE" : "OFFLINE");
+    strcat(statusBuffer, ";");
+
+    eaipStateDataField_t *next = status.additionalFields;
+    while (next != NULL) {
+        strcat(statusBuffer, next->id);
+        strcat(statusBuffer, ":");
+        strcat(statusBuffer, next->data);
+        strcat(statusBuffer, ";");
+        next = next->next;
+    }
+}
+
+/* endregion REFERENCE */
+
+static eaipStateDataField_t *createFields(size_t count) {
+    if (count == 0) {
+        return NULL;
+    }
+
+    eaipStateDataField_t *fields = calloc(count, sizeof(eaipStateDataField_t));
+    for (size_t index = 0; index < count; index++) {
+        fields[index].id = calloc(FIELD_ID_SIZE, sizeof(char));
+        fields[index].data = calloc(FIELD_DATA_SIZE, sizeof(char));
+        snprintf(fields[index].id, FIELD_ID_SIZE, "SOURCE%zu", index);
+        snprintf(fields[index].data, FIELD_DATA_SIZE, "sensor-%zu,unit-%zu", index, index);
+        fields[index].next = index + 1 < count ? &fields[index + 1] : NULL;
+    }
+    return fields;
+}
+
+static void freeFields(eaipStateDataField_t *fields, size_t count) {
+    for (size_t index = 0; index < count; index++) {
+        free(fields[index].id);
+        free(fields[index].data);
+    }
+    free(fields);
+}
+
+static void runBenchmark(size_t fieldCount) {
+    eaipStateDataField_t *fields = createFields(fieldCount);
+    eaipDeviceState_t status = {
+        .deviceType = NODE, .deviceState = ONLINE, .additionalFields = fields};
+
+    size_t bufferSize = 64 + fieldCount * 48;
+    char *buffer = calloc(bufferSize, sizeof(char));
+    uint64_t iterations = 2000000 / (fieldCount + 1) + 10;
+    char name[64];
+
+    uint64_t start = benchmarkNow();
+    for (uint64_t iteration = 0; iteration < iterations; iteration++) {
+        strcatStatus(buffer, DEVICE_ID, status);
+        benchmarkKeep(buffer);
+    }
+    snprintf(name, sizeof(name), "strcat chain (%zu fields)", fieldCount);
+    benchmarkReport(name, iterations, benchmarkNow() - start);
+
+    start = benchmarkNow();
+    for (uint64_t iteration = 0; iteration < iterations; iteration++) {
+        eaipSerializeStatus(buffer, bufferSize, DEVICE_ID, status, NULL);
+        benchmarkKeep(buffer);
+    }
+    snprintf(name, sizeof(name), "eaipSerializeStatus (%zu fields)", fieldCount);
+    benchmarkReport(name, iterations, benchmarkNow() - start);
+
+    free(buffer);
+    freeFields(fields, fieldCount);
+}
+
+int main(void) {
+    size_t fieldCounts[] = {0, 10, 100, 500, 1000};
+    for (size_t index = 0; index < sizeof(fieldCounts) / sizeof(fieldCounts[0]); index++) {
+        runBenchmark(fieldCounts[index]);
+    }
+    return 0;
+}
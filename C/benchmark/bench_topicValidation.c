@@ -0,0 +1,62 @@
+#include <regex.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "Benchmark.h"
+#include "eaip/brokerMock/TopicValidation.h"
+
+#define ITERATIONS 200000
+
+static const char *topics[] = {
+    "eaip://local-net/enV5/DATA/accelerometer",
+    "eaip://local-net/enV5/STATUS",
+    "eaip://local-net/monitor/DO/measure/temperature",
+    "eaip://local-net/enV5/DATA/a-very-long-data-identifier-for-the-inference-result/0",
+};
+#define TOPIC_COUNT (sizeof(topics) / sizeof(topics[0]))
+
+/* region REFERENCE */
+
+/* regular expression compiled on every call, as the broker mock did so far */
+#define REGEX_MQTT_PUBLISH                                                                         \
+    "^(\\/?[a-zA-Z0-9_\\!$&'()*,.:;=?@%~-]+(\\/[a-zA-Z0-9_\\!$&'()*,.:;=?@%~-]*)*\\/?$)"
+
+static bool regexIsValidForPublish(const char *topic) {
+    regex_t regex;
+    regcomp(&regex, REGEX_MQTT_PUBLISH, REG_EXTENDED);
+    bool valid = 0 == regexec(&regex, topic, 0, NULL, 0);
+    regfree(&regex);
+    return valid;
+}
+
+/* endregion REFERENCE */
+
+int main(void) {
+    bool valid = true;
+
+    uint64_t start = benchmarkNow();
+    for (size_t iteration = 0; iteration < ITERATIONS / 100; iteration++) {
+        valid &= regexIsValidForPublish(topics[iteration % TOPIC_COUNT]);
+    }
+    benchmarkReport("regcomp + regexec per topic", ITERATIONS / 100, benchmarkNow() - start);
+
+    regex_t regex;
+    regcomp(&regex, REGEX_MQTT_PUBLISH, REG_EXTENDED);
+    start = benchmarkNow();
+    for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+        valid &= 0 == regexec(&regex, topics[iteration % TOPIC_COUNT], 0, NULL, 0);
+    }
+    benchmarkReport("regexec, compiled once", ITERATIONS, benchmarkNow() - start);
+    regfree(&regex);
+
+    start = benchmarkNow();
+    for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+        const char *topic = topics[iteration % TOPIC_COUNT];
+        benchmarkKeep(topic);
+        valid &= topicIsValidForPublish(topic, strlen(topic));
+    }
+    benchmarkReport("topicIsValidForPublish", ITERATIONS, benchmarkNow() - start);
+
+    benchmarkKeep(&valid);
+    return valid ? 0 : 1;
+}
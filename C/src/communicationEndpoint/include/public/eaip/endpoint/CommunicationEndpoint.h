@@ -2,15 +2,20 @@
 #define EAI_PROTOCOL_COMMUNICATION_ENDPOINT_HEADER
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 typedef enum {
     EAIP_COM_NO_ERROR = 0x00,
     EAIP_COM_GENERIC_ERROR = 0x01,
     EAIP_COM_BROKER_NOT_REACHABLE = 0x02,
+    EAIP_COM_OUT_OF_MEMORY = 0x03,
+    EAIP_COM_NOT_SUPPORTED = 0x04,
     EAIP_COM_TOPIC_TO_LONG = 0x11,
     EAIP_COM_INVALID_TOPIC = 0x12,
     EAIP_COM_TOPIC_ALREADY_SUBSCRIBED = 0x13,
+    EAIP_COM_INVALID_MESSAGE = 0x21,
+    EAIP_COM_MESSAGE_TO_LONG = 0x22,
 } eaipCommunicationErrorCodes;
 
 eaipCommunicationErrorCodes publish(char *topic, char *data,
@@ -18,4 +23,83 @@ eaipCommunicationErrorCodes publish(char *topic, char *data,
 eaipCommunicationErrorCodes subscribe(char *topic, void (*handle)(char *topic, char *message));
 eaipCommunicationErrorCodes unsubscribe(char *topic);
 
+/* region BINARY */
+
+/*!
+ * Optional binary-safe variants of `publish` and `subscribe`.
+ * The payload is passed with an explicit length and may contain `\0` bytes.
+ */
+
+eaipCommunicationErrorCodes publishBinary(char *topic, const uint8_t *payload, size_t length,
+                                          bool retain);
+eaipCommunicationErrorCodes subscribeBinary(char *topic,
+                                            void (*handle)(char *topic, const uint8_t *payload,
+                                                           size_t length));
+
+/* endregion BINARY */
+
+/* region VIEW */
+
+/*!
+ * Optional variant of `subscribe` whose handler gets the lengths of topic and payload, which the
+ * endpoint knows anyway, and a pointer given on subscription. Handlers neither have to scan the
+ * message again nor keep their state in globals.
+ */
+
+/*!
+ * @brief function pointer for handler to process a received message
+ *
+ * @param userData[void *] pointer given on subscription
+ * @param topic[char *] topic of the message, `\0` terminated
+ * @param topicLength[size_t] length of the topic
+ * @param payload[uint8_t *] received payload, may contain `\0` bytes
+ * @param length[size_t] length of the payload
+ */
+typedef void (*eaipViewHandler)(void *userData, const char *topic, size_t topicLength,
+                                const uint8_t *payload, size_t length);
+
+eaipCommunicationErrorCodes subscribeView(char *topic, eaipViewHandler handle, void *userData);
+
+/* endregion VIEW */
+
+/* region ENDPOINT INTERFACE */
+
+/*!
+ * The functions above are global, so an implementation can only keep its state, e.g. the broker
+ * connection, in globals. An endpoint pairs the same functions with a context passed to every
+ * call instead, which allows one process to drive any number of connections.
+ */
+
+/*!
+ * @brief functions of an endpoint implementation, the binary and view variants are optional
+ */
+typedef struct eaipEndpointInterface {
+    eaipCommunicationErrorCodes (*publish)(void *context, char *topic, char *data, bool retain);
+    eaipCommunicationErrorCodes (*subscribe)(void *context, char *topic,
+                                             void (*handle)(char *topic, char *message));
+    eaipCommunicationErrorCodes (*unsubscribe)(void *context, char *topic);
+    eaipCommunicationErrorCodes (*publishBinary)(void *context, char *topic,
+                                                 const uint8_t *payload, size_t length,
+                                                 bool retain);
+    eaipCommunicationErrorCodes (*subscribeBinary)(void *context, char *topic,
+                                                   void (*handle)(char *topic,
+                                                                  const uint8_t *payload,
+                                                                  size_t length));
+    eaipCommunicationErrorCodes (*subscribeView)(void *context, char *topic,
+                                                 eaipViewHandler handle, void *userData);
+} eaipEndpointInterface_t;
+
+/*!
+ * @brief an endpoint implementation and the state it operates on
+ *
+ * @param interface[eaipEndpointInterface_t *] functions of the implementation, NULL if unset
+ * @param context[void *] passed as first argument to the functions of `interface`
+ */
+typedef struct eaipEndpoint {
+    const eaipEndpointInterface_t *interface;
+    void *context;
+} eaipEndpoint_t;
+
+/* endregion ENDPOINT INTERFACE */
+
 #endif /* EAI_PROTOCOL_COMMUNICATION_ENDPOINT_HEADER */
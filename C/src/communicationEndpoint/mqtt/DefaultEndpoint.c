@@ -0,0 +1,61 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "eaip/endpoint/CommunicationEndpoint.h"
+#include "eaip/endpoint/MqttEndpoint.h"
+
+/* Kept apart from MqttEndpoint.c, so endpoints can be linked next to another implementation. */
+
+static mqttEndpoint_t *defaultEndpoint = NULL;
+
+void mqttEndpointSetDefault(mqttEndpoint_t *endpoint) {
+    defaultEndpoint = endpoint;
+}
+
+eaipCommunicationErrorCodes publish(char *topic, char *data, bool retain) {
+    if (defaultEndpoint == NULL) {
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    return mqttEndpointPublish(defaultEndpoint, topic, (const uint8_t *)data,
+                               data == NULL ? 0 : strlen(data), retain);
+}
+
+eaipCommunicationErrorCodes publishBinary(char *topic, const uint8_t *payload, size_t length,
+                                          bool retain) {
+    if (defaultEndpoint == NULL) {
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    return mqttEndpointPublish(defaultEndpoint, topic, payload, length, retain);
+}
+
+eaipCommunicationErrorCodes subscribe(char *topic, void (*handle)(char *topic, char *message)) {
+    if (defaultEndpoint == NULL) {
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    return mqttEndpointSubscribe(defaultEndpoint, topic, handle);
+}
+
+eaipCommunicationErrorCodes subscribeBinary(char *topic,
+                                            void (*handle)(char *topic, const uint8_t *payload,
+                                                           size_t length)) {
+    if (defaultEndpoint == NULL) {
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    return mqttEndpointSubscribeBinary(defaultEndpoint, topic, handle);
+}
+
+eaipCommunicationErrorCodes subscribeView(char *topic, eaipViewHandler handle, void *userData) {
+    if (defaultEndpoint == NULL) {
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    return mqttEndpointSubscribeView(defaultEndpoint, topic, handle, userData);
+}
+
+eaipCommunicationErrorCodes unsubscribe(char *topic) {
+    if (defaultEndpoint == NULL) {
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    return mqttEndpointUnsubscribe(defaultEndpoint, topic);
+}
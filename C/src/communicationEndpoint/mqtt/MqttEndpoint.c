@@ -0,0 +1,760 @@
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "eaip/endpoint/CommunicationEndpoint.h"
+#include "eaip/endpoint/MqttEndpoint.h"
+
+#define MAX_HEADER 5 /*! packet type and up to four bytes of remaining length */
+#define MAX_REMAINING_LENGTH 268435455
+#define MAX_PARTS 4  /*! two segments of the send ring and the two parts of a packet */
+
+#define CONNECT 0x10
+#define CONNACK 0x20
+#define PUBLISH 0x30
+#define PUBACK 0x40
+#define SUBSCRIBE 0x82
+#define SUBACK 0x90
+#define UNSUBSCRIBE 0xA2
+#define UNSUBACK 0xB0
+#define PINGREQ 0xC0
+#define PINGRESP 0xD0
+#define DISCONNECT 0xE0
+
+static uint64_t now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000 + (uint64_t)time.tv_nsec / 1000000;
+}
+
+static void closeConnection(mqttEndpoint_t *endpoint) {
+    if (endpoint->socket >= 0) {
+        close(endpoint->socket);
+    }
+    endpoint->socket = -1;
+    endpoint->sendStart = 0;
+    endpoint->sendLength = 0;
+    endpoint->receiveLength = 0;
+}
+
+/* region TOPICS */
+
+static eaipCommunicationErrorCodes validateTopic(const char *topic, bool filter) {
+    if (topic == NULL || topic[0] == '\0') {
+        return EAIP_COM_INVALID_TOPIC;
+    }
+    size_t length = strnlen(topic, EAIP_MQTT_MAX_TOPIC_LENGTH + 1);
+    if (length > EAIP_MQTT_MAX_TOPIC_LENGTH) {
+        return EAIP_COM_TOPIC_TO_LONG;
+    }
+    for (size_t index = 0; index < length; index++) {
+        if (topic[index] != '+' && topic[index] != '#') {
+            continue;
+        }
+        bool startsLevel = index == 0 || topic[index - 1] == '/';
+        bool endsLevel = index + 1 == length || topic[index + 1] == '/';
+        if (!filter || !startsLevel || !endsLevel || (topic[index] == '#' && index + 1 != length)) {
+            return EAIP_COM_INVALID_TOPIC;
+        }
+    }
+    return EAIP_COM_NO_ERROR;
+}
+
+static bool topicMatches(const char *filter, const char *topic) {
+    for (;;) {
+        if (filter[0] == '#') {
+            return true;
+        }
+        if (filter[0] == '+') {
+            while (*topic != '\0' && *topic != '/') {
+                topic++;
+            }
+            filter++;
+        } else {
+            while (*filter != '\0' && *filter != '/') {
+                if (*filter++ != *topic++) {
+                    return false;
+                }
+            }
+            if (*topic != '\0' && *topic != '/') {
+                return false;
+            }
+        }
+        if (*filter == '\0' || *topic == '\0') {
+            /* "a/#" also matches its parent "a" */
+            return *filter == *topic || 0 == strcmp(filter, "/#");
+        }
+        filter++;
+        topic++;
+    }
+}
+
+/* endregion TOPICS */
+
+/* region OUTPUT */
+
+static size_t ringSegments(const mqttEndpoint_t *endpoint, struct iovec *segments) {
+    if (endpoint->sendLength == 0) {
+        return 0;
+    }
+    size_t firstLength = EAIP_MQTT_SEND_BYTES - endpoint->sendStart;
+    if (firstLength >= endpoint->sendLength) {
+        segments[0] = (struct iovec){endpoint->send + endpoint->sendStart, endpoint->sendLength};
+        return 1;
+    }
+    segments[0] = (struct iovec){endpoint->send + endpoint->sendStart, firstLength};
+    segments[1] = (struct iovec){endpoint->send, endpoint->sendLength - firstLength};
+    return 2;
+}
+
+static void copyToRing(mqttEndpoint_t *endpoint, const uint8_t *data, size_t length) {
+    size_t end = (endpoint->sendStart + endpoint->sendLength) % EAIP_MQTT_SEND_BYTES;
+    size_t firstLength = EAIP_MQTT_SEND_BYTES - end < length ? EAIP_MQTT_SEND_BYTES - end : length;
+    memcpy(endpoint->send + end, data, firstLength);
+    memcpy(endpoint->send, data + firstLength, length - firstLength);
+    endpoint->sendLength += length;
+}
+
+static size_t partsLength(const struct iovec *parts, size_t count) {
+    size_t length = 0;
+    for (size_t index = 0; index < count; index++) {
+        length += parts[index].iov_len;
+    }
+    return length;
+}
+
+/*! @brief advance `parts` past `written` bytes, drops parts that were written completely */
+static size_t consumeParts(struct iovec *parts, size_t count, size_t written) {
+    size_t first = 0;
+    while (first < count && written >= parts[first].iov_len) {
+        written -= parts[first++].iov_len;
+    }
+    memmove(parts, parts + first, (count - first) * sizeof(struct iovec));
+    count -= first;
+    if (count > 0) {
+        parts[0].iov_base = (uint8_t *)parts[0].iov_base + written;
+        parts[0].iov_len -= written;
+    }
+    return count;
+}
+
+/*!
+ * @brief write the send ring followed by the parts of a packet, with one `writev` per attempt
+ *
+ * The rest of the packet is copied into the ring as soon as it fits, so the memory of the parts
+ * may be reused after returning.
+ *
+ * @param packet[struct iovec *] up to two parts of a packet, modified while writing
+ * @param untilEmpty[bool] whether to return only once the ring is empty
+ * @param wait[bool] whether to wait for the socket to become writable, returns otherwise
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_BROKER_NOT_REACHABLE if the connection was lost or the broker does not read
+ */
+static eaipCommunicationErrorCodes writeOut(mqttEndpoint_t *endpoint, struct iovec *packet,
+                                            size_t parts, bool untilEmpty, bool wait) {
+    for (;;) {
+        size_t available = EAIP_MQTT_SEND_BYTES - endpoint->sendLength;
+        if (parts > 0 && partsLength(packet, parts) <= available) {
+            for (size_t index = 0; index < parts; index++) {
+                copyToRing(endpoint, packet[index].iov_base, packet[index].iov_len);
+            }
+            parts = 0;
+        }
+        if ((parts == 0 && !untilEmpty) || (parts == 0 && endpoint->sendLength == 0)) {
+            return EAIP_COM_NO_ERROR;
+        }
+
+        struct iovec iov[MAX_PARTS];
+        size_t count = ringSegments(endpoint, iov);
+        if (parts > 0) {
+            memcpy(iov + count, packet, parts * sizeof(struct iovec));
+        }
+        ssize_t written = writev(endpoint->socket, iov, (int)(count + parts));
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd writable = {.fd = endpoint->socket, .events = POLLOUT};
+            if (!wait && parts == 0) {
+                return EAIP_COM_NO_ERROR;
+            }
+            if (poll(&writable, 1, EAIP_MQTT_TIMEOUT_MS) > 0) {
+                continue;
+            }
+        }
+        if (written < 0) {
+            closeConnection(endpoint);
+            return EAIP_COM_BROKER_NOT_REACHABLE;
+        }
+
+        endpoint->lastSent = now();
+        size_t fromRing = (size_t)written < endpoint->sendLength ? (size_t)written
+                                                                  : endpoint->sendLength;
+        endpoint->sendStart = (endpoint->sendStart + fromRing) % EAIP_MQTT_SEND_BYTES;
+        endpoint->sendLength -= fromRing;
+        if (endpoint->sendLength == 0) {
+            endpoint->sendStart = 0;
+        }
+        parts = consumeParts(packet, parts, (size_t)written - fromRing);
+    }
+}
+
+static size_t encodeRemainingLength(uint8_t *target, size_t length) {
+    size_t used = 0;
+    do {
+        uint8_t digit = length % 128;
+        length /= 128;
+        target[used++] = length > 0 ? digit | 0x80 : digit;
+    } while (length > 0);
+    return used;
+}
+
+/*!
+ * @brief queue a packet, it is written without being copied if it does not fit into the ring
+ *
+ * @param head[uint8_t *] variable header and start of the payload, preceded by `MAX_HEADER` free
+ *                        bytes for the fixed header
+ * @param tail[uint8_t *] rest of the payload, may be NULL
+ */
+static eaipCommunicationErrorCodes queuePacket(mqttEndpoint_t *endpoint, uint8_t type,
+                                               uint8_t *head, size_t headLength,
+                                               const uint8_t *tail, size_t tailLength) {
+    if (endpoint->socket < 0) {
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    if (tailLength > MAX_REMAINING_LENGTH - headLength) {
+        return EAIP_COM_MESSAGE_TO_LONG;
+    }
+    uint8_t header[MAX_HEADER];
+    size_t headerLength = 1 + encodeRemainingLength(header + 1, headLength + tailLength);
+    header[0] = type;
+    memcpy(head - headerLength, header, headerLength);
+
+    struct iovec packet[2] = {{head - headerLength, headerLength + headLength},
+                              {(uint8_t *)tail, tailLength}};
+    return writeOut(endpoint, packet, tailLength > 0 ? 2 : 1, false, true);
+}
+
+static size_t putString(uint8_t *target, const char *text) {
+    size_t length = strlen(text);
+    target[0] = (uint8_t)(length >> 8);
+    target[1] = (uint8_t)length;
+    memcpy(target + 2, text, length);
+    return 2 + length;
+}
+
+static uint16_t nextPacketId(mqttEndpoint_t *endpoint) {
+    if (++endpoint->nextPacketId == 0) {
+        endpoint->nextPacketId = 1;
+    }
+    return endpoint->nextPacketId;
+}
+
+static eaipCommunicationErrorCodes queueSubscription(mqttEndpoint_t *endpoint,
+                                                     mqttSubscription_t *subscription,
+                                                     bool subscribe) {
+    uint8_t packet[MAX_HEADER + 2 + 2 + EAIP_MQTT_MAX_TOPIC_LENGTH + 1];
+    uint8_t *body = packet + MAX_HEADER;
+    uint16_t packetId = nextPacketId(endpoint);
+    body[0] = (uint8_t)(packetId >> 8);
+    body[1] = (uint8_t)packetId;
+    size_t length = 2 + putString(body + 2, subscription->filter);
+    if (subscribe) {
+        subscription->packetId = packetId;
+        body[length++] = 0; /* requested QoS */
+    }
+    return queuePacket(endpoint, subscribe ? SUBSCRIBE : UNSUBSCRIBE, body, length, NULL, 0);
+}
+
+/* endregion OUTPUT */
+
+/* region INPUT */
+
+static void dispatchMessage(mqttEndpoint_t *endpoint, char *topic, size_t topicLength,
+                            uint8_t *payload, size_t length) {
+    /* the receive buffer has one spare byte, so even the last message can be terminated */
+    uint8_t following = payload[length];
+    payload[length] = '\0';
+    for (size_t index = 0; index < EAIP_MQTT_MAX_SUBSCRIPTIONS && endpoint->socket >= 0; index++) {
+        mqttSubscription_t *subscription = &endpoint->subscriptions[index];
+        if (!subscription->used || !topicMatches(subscription->filter, topic)) {
+            continue;
+        }
+        if (subscription->handleView != NULL) {
+            subscription->handleView(subscription->userData, topic, topicLength, payload, length);
+        } else if (subscription->handleBinary != NULL) {
+            subscription->handleBinary(topic, payload, length);
+        } else {
+            subscription->handle(topic, (char *)payload);
+        }
+    }
+    payload[length] = following;
+}
+
+static bool handlePublish(mqttEndpoint_t *endpoint, uint8_t flags, uint8_t *body,
+                          size_t length) {
+    uint8_t qos = (flags >> 1) & 0x03;
+    if (qos > 1 || length < 2) {
+        return false;
+    }
+    size_t topicLength = (size_t)(body[0] << 8 | body[1]);
+    size_t headerLength = 2 + topicLength + (qos > 0 ? 2 : 0);
+    if (topicLength > EAIP_MQTT_MAX_TOPIC_LENGTH || headerLength > length) {
+        return false;
+    }
+    if (qos == 1) {
+        uint8_t acknowledge[MAX_HEADER + 2];
+        memcpy(acknowledge + MAX_HEADER, body + 2 + topicLength, 2);
+        queuePacket(endpoint, PUBACK, acknowledge + MAX_HEADER, 2, NULL, 0);
+    }
+
+    /* move the topic over the second byte of its length to terminate it in place */
+    memmove(body + 1, body + 2, topicLength);
+    body[1 + topicLength] = '\0';
+    dispatchMessage(endpoint, (char *)body + 1, topicLength, body + headerLength,
+                    length - headerLength);
+    return true;
+}
+
+static bool handlePacket(mqttEndpoint_t *endpoint, uint8_t type, uint8_t *body, size_t length) {
+    switch (type & 0xF0) {
+    case PUBLISH:
+        return handlePublish(endpoint, type & 0x0F, body, length);
+    case SUBACK:
+        if (length < 3) {
+            return false;
+        }
+        for (size_t index = 0; index < EAIP_MQTT_MAX_SUBSCRIPTIONS; index++) {
+            mqttSubscription_t *subscription = &endpoint->subscriptions[index];
+            if (subscription->used && body[2] == 0x80 &&
+                subscription->packetId == (uint16_t)(body[0] << 8 | body[1])) {
+                subscription->used = false;
+            }
+        }
+        return true;
+    case CONNACK:
+    case UNSUBACK:
+    case PINGRESP:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*!
+ * @brief split off the next complete packet from the receive buffer
+ *
+ * @return size of the packet including its header, 0 if incomplete, SIZE_MAX if malformed or
+ *         larger than the receive buffer
+ */
+static size_t nextPacket(const mqttEndpoint_t *endpoint, size_t start, size_t *headerLength) {
+    size_t length = 0;
+    size_t available = endpoint->receiveLength - start;
+    for (size_t index = 1; index < MAX_HEADER; index++) {
+        if (index >= available) {
+            return 0;
+        }
+        uint8_t digit = endpoint->receive[start + index];
+        length |= (size_t)(digit & 0x7F) << (7 * (index - 1));
+        if ((digit & 0x80) == 0) {
+            *headerLength = index + 1;
+            return *headerLength + length > EAIP_MQTT_RECEIVE_BYTES ? SIZE_MAX
+                                                                     : *headerLength + length;
+        }
+    }
+    return SIZE_MAX;
+}
+
+/*!
+ * @brief handle all complete packets in the receive buffer
+ *
+ * @param connecting[bool] whether the first packet has to be an accepting CONNACK
+ */
+static eaipCommunicationErrorCodes handleInput(mqttEndpoint_t *endpoint, bool connecting) {
+    size_t start = 0;
+    while (endpoint->socket >= 0) {
+        size_t headerLength = 0;
+        size_t packetLength = nextPacket(endpoint, start, &headerLength);
+        if (packetLength == SIZE_MAX) {
+            /* malformed or never fitting into the receive buffer */
+            closeConnection(endpoint);
+            return EAIP_COM_BROKER_NOT_REACHABLE;
+        }
+        if (packetLength == 0 || packetLength > endpoint->receiveLength - start) {
+            break;
+        }
+        uint8_t *packet = endpoint->receive + start;
+        bool valid;
+        if (connecting) {
+            valid = packet[0] == CONNACK && packetLength == 4 && packet[3] == 0x00;
+            connecting = false;
+        } else {
+            valid = handlePacket(endpoint, packet[0], packet + headerLength,
+                                 packetLength - headerLength);
+        }
+        if (!valid) {
+            closeConnection(endpoint);
+            return EAIP_COM_BROKER_NOT_REACHABLE;
+        }
+        start += packetLength;
+    }
+    if (endpoint->socket < 0) {
+        return EAIP_COM_BROKER_NOT_REACHABLE; /* closed by a handler */
+    }
+
+    memmove(endpoint->receive, endpoint->receive + start, endpoint->receiveLength - start);
+    endpoint->receiveLength -= start;
+    return connecting ? EAIP_COM_GENERIC_ERROR : EAIP_COM_NO_ERROR;
+}
+
+static eaipCommunicationErrorCodes receivePackets(mqttEndpoint_t *endpoint) {
+    ssize_t received = recv(endpoint->socket, endpoint->receive + endpoint->receiveLength,
+                            EAIP_MQTT_RECEIVE_BYTES - endpoint->receiveLength, 0);
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        return EAIP_COM_NO_ERROR;
+    }
+    if (received <= 0) {
+        closeConnection(endpoint);
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    endpoint->receiveLength += (size_t)received;
+    endpoint->lastReceived = now();
+    return EAIP_COM_NO_ERROR;
+}
+
+/* endregion INPUT */
+
+/* region CONNECTION */
+
+static int openSocket(const char *host, uint16_t port) {
+    char service[6];
+    snprintf(service, sizeof(service), "%u", port);
+    struct addrinfo hints = {.ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM};
+    struct addrinfo *addresses;
+    if (0 != getaddrinfo(host, service, &hints, &addresses)) {
+        return -1;
+    }
+
+    int opened = -1;
+    for (struct addrinfo *address = addresses; address != NULL && opened < 0;
+         address = address->ai_next) {
+        opened = socket(address->ai_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (opened < 0) {
+            continue;
+        }
+        int error = 0;
+        socklen_t errorLength = sizeof(error);
+        struct pollfd connected = {.fd = opened, .events = POLLOUT};
+        if (0 != connect(opened, address->ai_addr, address->ai_addrlen) &&
+            (errno != EINPROGRESS || poll(&connected, 1, EAIP_MQTT_TIMEOUT_MS) <= 0 ||
+             0 != getsockopt(opened, SOL_SOCKET, SO_ERROR, &error, &errorLength) || error != 0)) {
+            close(opened);
+            opened = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+
+    if (opened >= 0) {
+        /* packets are batched by the endpoint, Nagle's algorithm would only delay them */
+        int enabled = 1;
+        setsockopt(opened, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+    }
+    return opened;
+}
+
+static eaipCommunicationErrorCodes queueConnect(mqttEndpoint_t *endpoint, const char *clientId) {
+    uint8_t packet[MAX_HEADER + 10 + 3 * (2 + EAIP_MQTT_MAX_TOPIC_LENGTH)];
+    uint8_t *body = packet + MAX_HEADER;
+    size_t length = putString(body, "MQTT");
+    bool will = endpoint->willMessage != NULL;
+    uint8_t flags = 0x02; /* clean session */
+    if (will) {
+        flags |= endpoint->willRetain ? 0x24 : 0x04;
+    }
+    body[length++] = 4; /* protocol level of MQTT 3.1.1 */
+    body[length++] = flags;
+    body[length++] = (uint8_t)(EAIP_MQTT_KEEP_ALIVE >> 8);
+    body[length++] = (uint8_t)EAIP_MQTT_KEEP_ALIVE;
+    length += putString(body + length, clientId);
+    if (!will) {
+        return queuePacket(endpoint, CONNECT, body, length, NULL, 0);
+    }
+    length += putString(body + length, endpoint->willTopic);
+    size_t messageLength = strlen(endpoint->willMessage);
+    body[length++] = (uint8_t)(messageLength >> 8);
+    body[length++] = (uint8_t)messageLength;
+    return queuePacket(endpoint, CONNECT, body, length, (const uint8_t *)endpoint->willMessage,
+                       messageLength);
+}
+
+static eaipCommunicationErrorCodes awaitConnack(mqttEndpoint_t *endpoint) {
+    uint64_t deadline = now() + EAIP_MQTT_TIMEOUT_MS;
+    for (;;) {
+        uint64_t current = now();
+        struct pollfd readable = {.fd = endpoint->socket, .events = POLLIN};
+        if (current >= deadline || poll(&readable, 1, (int)(deadline - current)) <= 0 ||
+            EAIP_COM_NO_ERROR != receivePackets(endpoint)) {
+            closeConnection(endpoint);
+            return EAIP_COM_BROKER_NOT_REACHABLE;
+        }
+        eaipCommunicationErrorCodes result = handleInput(endpoint, true);
+        if (result != EAIP_COM_GENERIC_ERROR) {
+            return result;
+        }
+    }
+}
+
+eaipCommunicationErrorCodes mqttEndpointInit(mqttEndpoint_t *endpoint) {
+    memset(endpoint, 0, sizeof(mqttEndpoint_t));
+    endpoint->socket = -1;
+    endpoint->send = malloc(EAIP_MQTT_SEND_BYTES);
+    endpoint->receive = malloc(EAIP_MQTT_RECEIVE_BYTES + 1);
+    if (endpoint->send == NULL || endpoint->receive == NULL) {
+        mqttEndpointFree(endpoint);
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+    return EAIP_COM_NO_ERROR;
+}
+
+eaipCommunicationErrorCodes mqttEndpointSetWill(mqttEndpoint_t *endpoint, const char *topic,
+                                                const char *message, bool retain) {
+    eaipCommunicationErrorCodes result = validateTopic(topic, false);
+    if (result != EAIP_COM_NO_ERROR) {
+        return result;
+    }
+    if (message == NULL || strlen(message) > UINT16_MAX) {
+        return EAIP_COM_INVALID_MESSAGE;
+    }
+    char *copy = strdup(message);
+    if (copy == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+    free(endpoint->willMessage);
+    endpoint->willMessage = copy;
+    strcpy(endpoint->willTopic, topic);
+    endpoint->willRetain = retain;
+    return EAIP_COM_NO_ERROR;
+}
+
+eaipCommunicationErrorCodes mqttEndpointConnect(mqttEndpoint_t *endpoint, const char *host,
+                                                uint16_t port, const char *clientId) {
+    closeConnection(endpoint);
+    if (clientId == NULL || strlen(clientId) > EAIP_MQTT_MAX_TOPIC_LENGTH) {
+        return EAIP_COM_GENERIC_ERROR;
+    }
+    endpoint->socket = openSocket(host, port);
+    if (endpoint->socket < 0) {
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    endpoint->lastSent = now();
+    endpoint->lastReceived = endpoint->lastSent;
+
+    eaipCommunicationErrorCodes result = queueConnect(endpoint, clientId);
+    for (size_t index = 0; index < EAIP_MQTT_MAX_SUBSCRIPTIONS && result == EAIP_COM_NO_ERROR;
+         index++) {
+        if (endpoint->subscriptions[index].used) {
+            result = queueSubscription(endpoint, &endpoint->subscriptions[index], true);
+        }
+    }
+    if (result == EAIP_COM_NO_ERROR) {
+        result = mqttEndpointFlush(endpoint);
+    }
+    if (result == EAIP_COM_NO_ERROR) {
+        result = awaitConnack(endpoint);
+    }
+    return result;
+}
+
+eaipCommunicationErrorCodes mqttEndpointPoll(mqttEndpoint_t *endpoint, int timeoutMs) {
+    if (endpoint->socket < 0) {
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    uint64_t current = now();
+    if (current - endpoint->lastReceived > EAIP_MQTT_KEEP_ALIVE * 1500) {
+        closeConnection(endpoint); /* not even a PINGRESP arrived */
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    if (current - endpoint->lastSent >= EAIP_MQTT_KEEP_ALIVE * 1000) {
+        uint8_t ping[MAX_HEADER];
+        queuePacket(endpoint, PINGREQ, ping + MAX_HEADER, 0, NULL, 0);
+    }
+    if (EAIP_COM_NO_ERROR != writeOut(endpoint, NULL, 0, true, false)) {
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+
+    struct pollfd events = {.fd = endpoint->socket,
+                            .events = POLLIN | (endpoint->sendLength > 0 ? POLLOUT : 0)};
+    int ready = poll(&events, 1, timeoutMs);
+    if (ready < 0 && errno != EINTR) {
+        closeConnection(endpoint);
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    if (ready > 0 && (events.revents & (POLLIN | POLLHUP | POLLERR))) {
+        eaipCommunicationErrorCodes result = receivePackets(endpoint);
+        if (result == EAIP_COM_NO_ERROR) {
+            result = handleInput(endpoint, false);
+        }
+        if (result != EAIP_COM_NO_ERROR) {
+            return result;
+        }
+    }
+    return writeOut(endpoint, NULL, 0, true, false);
+}
+
+eaipCommunicationErrorCodes mqttEndpointFlush(mqttEndpoint_t *endpoint) {
+    if (endpoint->socket < 0) {
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    return writeOut(endpoint, NULL, 0, true, true);
+}
+
+eaipCommunicationErrorCodes mqttEndpointPublish(mqttEndpoint_t *endpoint, const char *topic,
+                                                const uint8_t *payload, size_t length,
+                                                bool retain) {
+    eaipCommunicationErrorCodes result = validateTopic(topic, false);
+    if (result != EAIP_COM_NO_ERROR) {
+        return result;
+    }
+    uint8_t packet[MAX_HEADER + 2 + EAIP_MQTT_MAX_TOPIC_LENGTH];
+    size_t topicLength = putString(packet + MAX_HEADER, topic);
+    return queuePacket(endpoint, PUBLISH | (retain ? 0x01 : 0x00), packet + MAX_HEADER,
+                       topicLength, payload, length);
+}
+
+static eaipCommunicationErrorCodes addSubscription(mqttEndpoint_t *endpoint, const char *topic,
+                                                   mqttSubscription_t subscription) {
+    eaipCommunicationErrorCodes result = validateTopic(topic, true);
+    if (result != EAIP_COM_NO_ERROR) {
+        return result;
+    }
+    mqttSubscription_t *slot = NULL;
+    for (size_t index = 0; index < EAIP_MQTT_MAX_SUBSCRIPTIONS; index++) {
+        mqttSubscription_t *existing = &endpoint->subscriptions[index];
+        if (existing->used && 0 == strcmp(existing->filter, topic)) {
+            return EAIP_COM_TOPIC_ALREADY_SUBSCRIBED;
+        }
+        if (!existing->used && slot == NULL) {
+            slot = existing;
+        }
+    }
+    if (slot == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    *slot = subscription;
+    strcpy(slot->filter, topic);
+    slot->used = true;
+    if (endpoint->socket < 0) {
+        return EAIP_COM_NO_ERROR; /* subscribed by `mqttEndpointConnect` */
+    }
+    return queueSubscription(endpoint, slot, true);
+}
+
+eaipCommunicationErrorCodes mqttEndpointSubscribe(mqttEndpoint_t *endpoint, const char *topic,
+                                                  void (*handle)(char *topic, char *message)) {
+    return addSubscription(endpoint, topic, (mqttSubscription_t){.handle = handle});
+}
+
+eaipCommunicationErrorCodes
+mqttEndpointSubscribeBinary(mqttEndpoint_t *endpoint, const char *topic,
+                            void (*handle)(char *topic, const uint8_t *payload, size_t length)) {
+    return addSubscription(endpoint, topic, (mqttSubscription_t){.handleBinary = handle});
+}
+
+eaipCommunicationErrorCodes mqttEndpointSubscribeView(mqttEndpoint_t *endpoint, const char *topic,
+                                                      eaipViewHandler handle, void *userData) {
+    return addSubscription(endpoint, topic,
+                           (mqttSubscription_t){.handleView = handle, .userData = userData});
+}
+
+eaipCommunicationErrorCodes mqttEndpointUnsubscribe(mqttEndpoint_t *endpoint, const char *topic) {
+    for (size_t index = 0; topic != NULL && index < EAIP_MQTT_MAX_SUBSCRIPTIONS; index++) {
+        mqttSubscription_t *subscription = &endpoint->subscriptions[index];
+        if (subscription->used && 0 == strcmp(subscription->filter, topic)) {
+            subscription->used = false;
+            if (endpoint->socket < 0) {
+                return EAIP_COM_NO_ERROR;
+            }
+            return queueSubscription(endpoint, subscription, false);
+        }
+    }
+    return EAIP_COM_INVALID_TOPIC;
+}
+
+void mqttEndpointDisconnect(mqttEndpoint_t *endpoint) {
+    uint8_t disconnect[MAX_HEADER];
+    if (EAIP_COM_NO_ERROR ==
+        queuePacket(endpoint, DISCONNECT, disconnect + MAX_HEADER, 0, NULL, 0)) {
+        mqttEndpointFlush(endpoint);
+    }
+    closeConnection(endpoint);
+}
+
+void mqttEndpointFree(mqttEndpoint_t *endpoint) {
+    closeConnection(endpoint);
+    free(endpoint->send);
+    free(endpoint->receive);
+    free(endpoint->willMessage);
+    endpoint->send = NULL;
+    endpoint->receive = NULL;
+    endpoint->willMessage = NULL;
+}
+
+/* endregion CONNECTION */
+
+/* region ENDPOINT INTERFACE */
+
+static eaipCommunicationErrorCodes endpointPublish(void *context, char *topic, char *data,
+                                                   bool retain) {
+    return mqttEndpointPublish(context, topic, (const uint8_t *)data,
+                               data == NULL ? 0 : strlen(data), retain);
+}
+
+static eaipCommunicationErrorCodes endpointSubscribe(void *context, char *topic,
+                                                     void (*handle)(char *topic, char *message)) {
+    return mqttEndpointSubscribe(context, topic, handle);
+}
+
+static eaipCommunicationErrorCodes endpointUnsubscribe(void *context, char *topic) {
+    return mqttEndpointUnsubscribe(context, topic);
+}
+
+static eaipCommunicationErrorCodes endpointPublishBinary(void *context, char *topic,
+                                                         const uint8_t *payload, size_t length,
+                                                         bool retain) {
+    return mqttEndpointPublish(context, topic, payload, length, retain);
+}
+
+static eaipCommunicationErrorCodes
+endpointSubscribeBinary(void *context, char *topic,
+                        void (*handle)(char *topic, const uint8_t *payload, size_t length)) {
+    return mqttEndpointSubscribeBinary(context, topic, handle);
+}
+
+static eaipCommunicationErrorCodes endpointSubscribeView(void *context, char *topic,
+                                                         eaipViewHandler handle, void *userData) {
+    return mqttEndpointSubscribeView(context, topic, handle, userData);
+}
+
+const eaipEndpointInterface_t mqttEndpointInterface = {
+    .publish = &endpointPublish,
+    .subscribe = &endpointSubscribe,
+    .unsubscribe = &endpointUnsubscribe,
+    .publishBinary = &endpointPublishBinary,
+    .subscribeBinary = &endpointSubscribeBinary,
+    .subscribeView = &endpointSubscribeView,
+};
+
+/* endregion ENDPOINT INTERFACE */
@@ -0,0 +1,268 @@
+#ifndef EAI_PROTOCOL_MQTT_ENDPOINT_HEADER
+#define EAI_PROTOCOL_MQTT_ENDPOINT_HEADER
+
+/*!
+ * MQTT 3.1.1 client implementing the communication endpoint over POSIX sockets (Linux only)
+ *
+ * The endpoint is a single-threaded, non-blocking event loop. `mqttEndpointPublish` encodes a
+ * packet into a fixed send ring and returns, the ring is written with a single `writev` the next
+ * time the loop runs. A packet that does not fit into the ring is written together with the ring
+ * in one `writev` straight from the memory of the caller. Received packets are parsed in place:
+ * handlers get the topic and payload as pointers into the receive buffer, nothing is copied.
+ *
+ * Only QoS 0 is used for publishing and subscribing. Once connected, the endpoint allocates no
+ * memory.
+ *
+ * ```c
+ * mqttEndpoint_t endpoint;
+ * mqttEndpointInit(&endpoint);
+ * mqttEndpointConnect(&endpoint, "localhost", 1883, "enV5");
+ * mqttEndpointSubscribe(&endpoint, "eaip://enV5/DO/+", &handleCommand);
+ * for (;;) {
+ *     mqttEndpointPublish(&endpoint, "eaip://enV5/DATA/value", payload, length, false);
+ *     mqttEndpointPoll(&endpoint, 10); // writes queued packets and calls handlers
+ * }
+ * ```
+ *
+ * IMPORTANT: An endpoint must only be used by one thread. Handlers are called from
+ *            `mqttEndpointPoll` and must not call `mqttEndpointPoll`, `mqttEndpointConnect` or
+ *            `mqttEndpointFree` themselves.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eaip/endpoint/CommunicationEndpoint.h"
+
+/*!
+ * @brief size of the send ring, packets that do not fit are written without being copied
+ */
+#ifndef EAIP_MQTT_SEND_BYTES
+#define EAIP_MQTT_SEND_BYTES (16 * 1024)
+#endif
+
+/*!
+ * @brief size of the receive buffer, receiving a larger packet closes the connection
+ */
+#ifndef EAIP_MQTT_RECEIVE_BYTES
+#define EAIP_MQTT_RECEIVE_BYTES (64 * 1024)
+#endif
+
+/*!
+ * @brief maximum number of subscriptions of an endpoint
+ */
+#ifndef EAIP_MQTT_MAX_SUBSCRIPTIONS
+#define EAIP_MQTT_MAX_SUBSCRIPTIONS 32
+#endif
+
+/*!
+ * @brief maximum length of topics and topic filters
+ */
+#ifndef EAIP_MQTT_MAX_TOPIC_LENGTH
+#define EAIP_MQTT_MAX_TOPIC_LENGTH 128
+#endif
+
+/*!
+ * @brief keep alive interval in seconds announced to the broker
+ */
+#ifndef EAIP_MQTT_KEEP_ALIVE
+#define EAIP_MQTT_KEEP_ALIVE 60
+#endif
+
+/*!
+ * @brief milliseconds to wait for the broker while connecting or while the send ring is full
+ */
+#ifndef EAIP_MQTT_TIMEOUT_MS
+#define EAIP_MQTT_TIMEOUT_MS 5000
+#endif
+
+/*!
+ * @brief a subscription of an endpoint, exactly one of the handlers is set
+ *
+ * @param packetId[uint16_t] identifier of the SUBSCRIBE packet, a refused subscription is removed
+ *                           when its SUBACK arrives
+ */
+typedef struct mqttSubscription {
+    char filter[EAIP_MQTT_MAX_TOPIC_LENGTH + 1];
+    void (*handle)(char *topic, char *message);
+    void (*handleBinary)(char *topic, const uint8_t *payload, size_t length);
+    eaipViewHandler handleView;
+    void *userData;
+    uint16_t packetId;
+    bool used;
+} mqttSubscription_t;
+
+/*!
+ * @brief struct holding the state of an endpoint
+ *
+ * @param send[uint8_t *] ring of `EAIP_MQTT_SEND_BYTES` holding encoded packets not written yet
+ * @param sendStart[size_t] offset of the first byte not written yet
+ * @param sendLength[size_t] number of bytes not written yet
+ * @param receive[uint8_t *] `EAIP_MQTT_RECEIVE_BYTES` and one byte to terminate text messages
+ * @param receiveLength[size_t] number of bytes received but not handled yet
+ * @param lastSent[uint64_t] monotonic milliseconds of the last write, for PINGREQ
+ * @param lastReceived[uint64_t] monotonic milliseconds of the last read, to detect a lost broker
+ *
+ * IMPORTANT: All fields are managed by the `mqttEndpoint*` functions and must not be modified by
+ *            the user.
+ */
+typedef struct mqttEndpoint {
+    int socket;
+    uint8_t *send;
+    size_t sendStart;
+    size_t sendLength;
+    uint8_t *receive;
+    size_t receiveLength;
+    uint16_t nextPacketId;
+    uint64_t lastSent;
+    uint64_t lastReceived;
+    char willTopic[EAIP_MQTT_MAX_TOPIC_LENGTH + 1];
+    char *willMessage;
+    bool willRetain;
+    mqttSubscription_t subscriptions[EAIP_MQTT_MAX_SUBSCRIPTIONS];
+} mqttEndpoint_t;
+
+/*!
+ * @brief initialize an endpoint and allocate its buffers
+ *
+ * @return 0 if no error occurred, EAIP_COM_OUT_OF_MEMORY otherwise
+ */
+eaipCommunicationErrorCodes mqttEndpointInit(mqttEndpoint_t *endpoint);
+
+/*!
+ * @brief set the last will, which the broker publishes if the connection is lost
+ *
+ * Has to be called before `mqttEndpointConnect`.
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_TOPIC_TO_LONG or EAIP_COM_INVALID_TOPIC if the topic is not valid,
+ *         EAIP_COM_INVALID_MESSAGE if the message is NULL or longer than 65535 bytes,
+ *         EAIP_COM_OUT_OF_MEMORY if the message could not be copied
+ */
+eaipCommunicationErrorCodes mqttEndpointSetWill(mqttEndpoint_t *endpoint, const char *topic,
+                                                const char *message, bool retain);
+
+/*!
+ * @brief connect to a broker and wait for its CONNACK
+ *
+ * Subscriptions made before are sent to the broker again, which allows to reconnect after
+ * `EAIP_COM_BROKER_NOT_REACHABLE` was returned.
+ *
+ * @param host[const char *] host name or address of the broker
+ * @param port[uint16_t] TCP port of the broker
+ * @param clientId[const char *] client identifier, a clean session is requested
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_GENERIC_ERROR if the client identifier is longer than
+ *         `EAIP_MQTT_MAX_TOPIC_LENGTH`,
+ *         EAIP_COM_BROKER_NOT_REACHABLE if the broker could not be reached or refused the client
+ */
+eaipCommunicationErrorCodes mqttEndpointConnect(mqttEndpoint_t *endpoint, const char *host,
+                                                uint16_t port, const char *clientId);
+
+/*!
+ * @brief run the event loop once
+ *
+ * Writes queued packets, waits up to `timeoutMs` for packets from the broker and calls the
+ * handlers of all received messages. Packets queued by handlers are written before returning.
+ *
+ * @param timeoutMs[int] milliseconds to wait for packets, 0 returns immediately
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_BROKER_NOT_REACHABLE if the connection was lost
+ */
+eaipCommunicationErrorCodes mqttEndpointPoll(mqttEndpoint_t *endpoint, int timeoutMs);
+
+/*!
+ * @brief write all queued packets, waiting up to `EAIP_MQTT_TIMEOUT_MS` for the socket
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_BROKER_NOT_REACHABLE if the connection was lost or the broker does not read
+ */
+eaipCommunicationErrorCodes mqttEndpointFlush(mqttEndpoint_t *endpoint);
+
+/*!
+ * @brief queue a message, see `publishBinary`
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_TOPIC_TO_LONG or EAIP_COM_INVALID_TOPIC if the topic is not valid,
+ *         EAIP_COM_MESSAGE_TO_LONG if the packet would exceed the MQTT limit of 256 MiB,
+ *         EAIP_COM_BROKER_NOT_REACHABLE if the endpoint is not connected
+ */
+eaipCommunicationErrorCodes mqttEndpointPublish(mqttEndpoint_t *endpoint, const char *topic,
+                                                const uint8_t *payload, size_t length,
+                                                bool retain);
+
+/*!
+ * @brief subscribe to a topic filter, see `subscribe`
+ *
+ * Every subscription whose filter matches the topic of a received message is called. A
+ * subscription made while not connected is sent by `mqttEndpointConnect`.
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_TOPIC_TO_LONG or EAIP_COM_INVALID_TOPIC if the filter is not valid,
+ *         EAIP_COM_TOPIC_ALREADY_SUBSCRIBED if the filter is already subscribed,
+ *         EAIP_COM_OUT_OF_MEMORY if `EAIP_MQTT_MAX_SUBSCRIPTIONS` are in use,
+ *         EAIP_COM_BROKER_NOT_REACHABLE if the connection was lost while sending SUBSCRIBE
+ */
+eaipCommunicationErrorCodes mqttEndpointSubscribe(mqttEndpoint_t *endpoint, const char *topic,
+                                                  void (*handle)(char *topic, char *message));
+
+/*!
+ * @brief subscribe to a topic filter with a handler receiving the payload and its length
+ */
+eaipCommunicationErrorCodes
+mqttEndpointSubscribeBinary(mqttEndpoint_t *endpoint, const char *topic,
+                            void (*handle)(char *topic, const uint8_t *payload, size_t length));
+
+/*!
+ * @brief subscribe to a topic filter with a handler receiving the lengths and `userData`
+ */
+eaipCommunicationErrorCodes mqttEndpointSubscribeView(mqttEndpoint_t *endpoint, const char *topic,
+                                                      eaipViewHandler handle, void *userData);
+
+/*!
+ * @brief remove the subscription of a topic filter
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_INVALID_TOPIC if the filter is not subscribed,
+ *         EAIP_COM_BROKER_NOT_REACHABLE if the connection was lost while sending UNSUBSCRIBE
+ */
+eaipCommunicationErrorCodes mqttEndpointUnsubscribe(mqttEndpoint_t *endpoint, const char *topic);
+
+/*!
+ * @brief write all queued packets and DISCONNECT, the broker discards the last will
+ */
+void mqttEndpointDisconnect(mqttEndpoint_t *endpoint);
+
+/*!
+ * @brief close the connection without DISCONNECT and release the endpoint
+ *
+ * The broker publishes the last will of a connected endpoint.
+ */
+void mqttEndpointFree(mqttEndpoint_t *endpoint);
+
+/*!
+ * @brief communication endpoint functions of an endpoint, the context is a `mqttEndpoint_t *`
+ *
+ * Allows a process to drive several connections, e.g. as shards of a sharded endpoint:
+ * `config.endpoint = (eaipEndpoint_t){&mqttEndpointInterface, &endpoint};`
+ */
+extern const eaipEndpointInterface_t mqttEndpointInterface;
+
+/* region DEFAULT ENDPOINT */
+
+/*!
+ * @brief bind `publish`, `subscribe`, `unsubscribe` and their variants to an endpoint
+ *
+ * Linking `eaip_endpoint_mqtt` provides the functions of "eaip/endpoint/CommunicationEndpoint.h".
+ * They return EAIP_COM_BROKER_NOT_REACHABLE until an endpoint is set.
+ *
+ * @param endpoint[mqttEndpoint_t *] endpoint used by the functions, NULL to unbind
+ */
+void mqttEndpointSetDefault(mqttEndpoint_t *endpoint);
+
+/* endregion DEFAULT ENDPOINT */
+
+#endif /* EAI_PROTOCOL_MQTT_ENDPOINT_HEADER */
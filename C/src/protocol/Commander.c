@@ -0,0 +1,335 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/protocol/Buffer.h"
+#include "eaip/protocol/Commander.h"
+#include "eaip/protocol/Hash.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Session.h"
+#include "eaip/protocol/Transport.h"
+
+#define DONE_FILTER "+/" EAIP_TOPIC_NAME_DONE "/#"
+#define WHEEL_MASK (EAIP_TIMER_WHEEL_SLOTS - 1)
+
+_Static_assert((EAIP_TIMER_WHEEL_SLOTS & WHEEL_MASK) == 0,
+               "EAIP_TIMER_WHEEL_SLOTS has to be a power of two");
+
+/* region PENDING REQUESTS */
+
+static uint32_t hashCommand(const char *target, size_t targetLength, const char *command,
+                            size_t commandLength) {
+    uint32_t hash = hashUpdate32(FNV32_OFFSET_BASIS, target, targetLength);
+    hash = hashUpdate32(hash, "/", 1);
+    return hashUpdate32(hash, command, commandLength);
+}
+
+static bool matchesCommand(const eaipCommand_t *command, uint32_t hash, const char *target,
+                           size_t targetLength, const char *name, size_t nameLength) {
+    return command->hash == hash && command->targetLength == targetLength &&
+           command->commandLength == nameLength &&
+           0 == memcmp(command->target, target, targetLength) &&
+           0 == memcmp(command->command, name, nameLength);
+}
+
+/*! @return link to the oldest pending request for target and command, to NULL if there is none */
+static eaipCommand_t **findOldest(eaipCommander_t *commander, uint32_t hash, const char *target,
+                                  size_t targetLength, const char *name, size_t nameLength) {
+    eaipCommand_t **link = &commander->buckets[hash & commander->bucketMask];
+    while (*link != NULL &&
+           !matchesCommand(*link, hash, target, targetLength, name, nameLength)) {
+        link = &(*link)->keyNext;
+    }
+    return link;
+}
+
+static void indexCommand(eaipCommander_t *commander, eaipCommand_t *command) {
+    eaipCommand_t **link = findOldest(commander, command->hash, command->target,
+                                      command->targetLength, command->command,
+                                      command->commandLength);
+    if (*link == NULL) {
+        *link = command;
+        command->sameNewest = command;
+        return;
+    }
+    eaipCommand_t *newest = (*link)->sameNewest;
+    newest->sameNext = command;
+    command->samePrevious = newest;
+    (*link)->sameNewest = command;
+}
+
+static void unindexCommand(eaipCommander_t *commander, eaipCommand_t *command) {
+    if (command->samePrevious != NULL) {
+        command->samePrevious->sameNext = command->sameNext;
+        if (command->sameNext != NULL) {
+            command->sameNext->samePrevious = command->samePrevious;
+        } else {
+            eaipCommand_t *oldest = *findOldest(commander, command->hash, command->target,
+                                                command->targetLength, command->command,
+                                                command->commandLength);
+            oldest->sameNewest = command->samePrevious;
+        }
+        return;
+    }
+
+    /* the oldest request of its command, the next one takes its place in the bucket */
+    eaipCommand_t **link = findOldest(commander, command->hash, command->target,
+                                      command->targetLength, command->command,
+                                      command->commandLength);
+    eaipCommand_t *next = command->sameNext;
+    if (next != NULL) {
+        next->samePrevious = NULL;
+        next->keyNext = command->keyNext;
+        next->sameNewest = command->sameNewest;
+        *link = next;
+    } else {
+        *link = command->keyNext;
+    }
+}
+
+/*! @brief true if `time` is not later than `now`, robust against the wrap around of `now` */
+static bool hasElapsed(uint32_t time, uint32_t now) {
+    return (uint32_t)(now - time) < UINT32_C(0x80000000);
+}
+
+static void startTimer(eaipCommander_t *commander, eaipCommand_t *command) {
+    eaipCommand_t **slot =
+        &commander->wheel[(command->deadline / commander->resolution) & WHEEL_MASK];
+    command->timerPrevious = NULL;
+    command->timerNext = *slot;
+    if (*slot != NULL) {
+        (*slot)->timerPrevious = command;
+    }
+    *slot = command;
+}
+
+static void stopTimer(eaipCommander_t *commander, eaipCommand_t *command) {
+    if (command->timerPrevious != NULL) {
+        command->timerPrevious->timerNext = command->timerNext;
+    } else {
+        commander->wheel[(command->deadline / commander->resolution) & WHEEL_MASK] =
+            command->timerNext;
+    }
+    if (command->timerNext != NULL) {
+        command->timerNext->timerPrevious = command->timerPrevious;
+    }
+}
+
+static void appendCommand(eaipCommander_t *commander, eaipCommand_t *command) {
+    command->previous = commander->newest;
+    command->next = NULL;
+    if (commander->newest != NULL) {
+        commander->newest->next = command;
+    } else {
+        commander->oldest = command;
+    }
+    commander->newest = command;
+    commander->count++;
+    startTimer(commander, command);
+    indexCommand(commander, command);
+}
+
+static void removeCommand(eaipCommander_t *commander, eaipCommand_t *command) {
+    stopTimer(commander, command);
+    unindexCommand(commander, command);
+    if (command->previous != NULL) {
+        command->previous->next = command->next;
+    } else {
+        commander->oldest = command->next;
+    }
+    if (command->next != NULL) {
+        command->next->previous = command->previous;
+    } else {
+        commander->newest = command->previous;
+    }
+    commander->count--;
+
+    free(command->target);
+    memset(command, 0, sizeof(eaipCommand_t));
+    command->next = commander->unused;
+    commander->unused = command;
+}
+
+/*!
+ * @brief remove a request and call its handler
+ *
+ * The entry is released before the handler is called, so the handler may issue new requests.
+ */
+static void completeCommand(eaipCommander_t *commander, eaipCommand_t *command,
+                            eaipCommandResult_t result, char *message) {
+    eaipCompletionHandler handler = command->handler;
+    void *userData = command->userData;
+    removeCommand(commander, command);
+    handler(result, message, userData);
+}
+
+/* endregion PENDING REQUESTS */
+
+eaipCommunicationErrorCodes eaipCommanderInit(eaipCommander_t *commander,
+                                              const eaipSession_t *session, size_t capacity,
+                                              uint32_t resolution, uint32_t now) {
+    uint32_t indexBits = 0;
+    while (((size_t)1 << indexBits) < capacity) {
+        indexBits++;
+    }
+    if (indexBits >= 32) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    eaipCommand_t *commands = calloc(capacity, sizeof(eaipCommand_t));
+    eaipCommand_t **buckets = calloc((size_t)1 << indexBits, sizeof(eaipCommand_t *));
+    if ((capacity > 0 && commands == NULL) || buckets == NULL) {
+        free(commands);
+        free(buckets);
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    memset(commander, 0, sizeof(eaipCommander_t));
+    commander->session = session;
+    commander->commands = commands;
+    commander->capacity = capacity;
+    commander->resolution = resolution > 0 ? resolution : 1;
+    commander->now = now;
+    commander->indexBits = indexBits;
+    commander->buckets = buckets;
+    commander->bucketMask = ((size_t)1 << indexBits) - 1;
+
+    for (size_t index = capacity; index > 0; index--) {
+        commands[index - 1].next = commander->unused;
+        commander->unused = &commands[index - 1];
+    }
+    return EAIP_COM_NO_ERROR;
+}
+
+void eaipCommanderFree(eaipCommander_t *commander) {
+    while (commander->oldest != NULL) {
+        completeCommand(commander, commander->oldest, EAIP_COMMAND_CANCELLED, NULL);
+    }
+    free(commander->commands);
+    free(commander->buckets);
+    memset(commander, 0, sizeof(eaipCommander_t));
+}
+
+eaipCommunicationErrorCodes eaipCommanderSubscribe(const eaipCommander_t *commander,
+                                                   messageHandler handler) {
+    const eaipSession_t *session = commander->session;
+    TOPIC_BUFFER(topic, session->baseUrlLength + sizeof(DONE_FILTER));
+    memcpy(topic, session->requester, session->baseUrlLength);
+    memcpy(topic + session->baseUrlLength, DONE_FILTER, sizeof(DONE_FILTER));
+
+    return transportSubscribe(&session->config, topic, handler);
+}
+
+eaipCommunicationErrorCodes eaipCommanderUnsubscribe(const eaipCommander_t *commander) {
+    const eaipSession_t *session = commander->session;
+    TOPIC_BUFFER(topic, session->baseUrlLength + sizeof(DONE_FILTER));
+    memcpy(topic, session->requester, session->baseUrlLength);
+    memcpy(topic + session->baseUrlLength, DONE_FILTER, sizeof(DONE_FILTER));
+
+    return transportUnsubscribe(&session->config, topic);
+}
+
+eaipCommunicationErrorCodes eaipCommanderRequest(eaipCommander_t *commander,
+                                                 eaipPubRequest_t request, uint32_t timeout,
+                                                 eaipCompletionHandler handler, void *userData,
+                                                 uint32_t *token) {
+    eaipCommand_t *command = commander->unused;
+    if (command == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    size_t targetLength = strlen(request.deviceId);
+    size_t commandLength = strlen(request.dataId);
+
+    /* layout: `<target>\0<command>\0` */
+    char *buffer = calloc(targetLength + commandLength + 2, sizeof(char));
+    if (buffer == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+    memcpy(buffer, request.deviceId, targetLength);
+    memcpy(buffer + targetLength + 1, request.dataId, commandLength);
+
+    commander->unused = command->next;
+    /* the generation keeps tokens unique, the index finds the entry of a token */
+    if (++commander->generation >= UINT32_C(1) << (32 - commander->indexBits)) {
+        commander->generation = 1;
+    }
+    *command = (eaipCommand_t){
+        .token = commander->generation << commander->indexBits |
+                 (uint32_t)(command - commander->commands),
+        .hash = hashCommand(request.deviceId, targetLength, request.dataId, commandLength),
+        .deadline = commander->now + timeout,
+        .target = buffer,
+        .targetLength = targetLength,
+        .command = buffer + targetLength + 1,
+        .commandLength = commandLength,
+        .handler = handler,
+        .userData = userData,
+    };
+    uint32_t issued = command->token;
+
+    /* register before publishing, the reply may be delivered before `publish` returns */
+    appendCommand(commander, command);
+
+    eaipCommunicationErrorCodes result = eaipSessionPublishDo(commander->session, request);
+    if (result != EAIP_COM_NO_ERROR) {
+        if (command->token == issued) {
+            removeCommand(commander, command);
+        }
+        return result;
+    }
+
+    if (token != NULL) {
+        *token = issued;
+    }
+    return EAIP_COM_NO_ERROR;
+}
+
+bool eaipCommanderCancel(eaipCommander_t *commander, uint32_t token) {
+    size_t index = token & (((uint32_t)1 << commander->indexBits) - 1);
+    if (token == 0 || index >= commander->capacity || commander->commands[index].token != token) {
+        return false;
+    }
+    completeCommand(commander, &commander->commands[index], EAIP_COMMAND_CANCELLED, NULL);
+    return true;
+}
+
+void eaipCommanderTick(eaipCommander_t *commander, uint32_t now) {
+    uint32_t first = commander->now / commander->resolution;
+    uint32_t slots = now / commander->resolution - first;
+    if (slots >= EAIP_TIMER_WHEEL_SLOTS) {
+        slots = EAIP_TIMER_WHEEL_SLOTS - 1;
+    }
+    commander->now = now;
+
+    for (uint32_t offset = 0; offset <= slots; offset++) {
+        eaipCommand_t **slot = &commander->wheel[(first + offset) & WHEEL_MASK];
+        eaipCommand_t *command = *slot;
+        while (command != NULL) {
+            if (hasElapsed(command->deadline, now)) {
+                /* the handler may have changed the slot, start over */
+                completeCommand(commander, command, EAIP_COMMAND_TIMEOUT, NULL);
+                command = *slot;
+            } else {
+                command = command->timerNext;
+            }
+        }
+    }
+}
+
+bool eaipCommanderDispatch(eaipCommander_t *commander, char *topic, char *message) {
+    eaipTopicView_t view;
+    if (EAIP_COM_NO_ERROR != eaipDecodeTopic(commander->session, topic, strlen(topic), &view) ||
+        view.type != DONE) {
+        return false;
+    }
+
+    uint32_t hash = hashCommand(view.deviceId.data, view.deviceId.length, view.dataId.data,
+                                view.dataId.length);
+    eaipCommand_t *oldest = *findOldest(commander, hash, view.deviceId.data, view.deviceId.length,
+                                        view.dataId.data, view.dataId.length);
+    if (oldest == NULL) {
+        return false;
+    }
+    completeCommand(commander, oldest, EAIP_COMMAND_DONE, message);
+    return true;
+}
@@ -0,0 +1,520 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "eaip/protocol/Number.h"
+#include "eaip/protocol/Writer.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define EAIP_NUMBER_SWAR 1
+#else
+#define EAIP_NUMBER_SWAR 0
+#endif
+
+/* region HELPER */
+
+static const double powersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                     1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                     1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/*! multiply by 10^exponent, every step is rounded once which is far below float precision */
+static double scaleByPowerOfTen(double value, int exponent) {
+    while (exponent > 22) {
+        value *= 1e22;
+        exponent -= 22;
+    }
+    while (exponent < -22) {
+        value /= 1e22;
+        exponent += 22;
+    }
+    return exponent >= 0 ? value * powersOfTen[exponent] : value / powersOfTen[-exponent];
+}
+
+static float floatFromBits(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static bool isDigit(char character) {
+    return character >= '0' && character <= '9';
+}
+
+static size_t writeDigits(char *buffer, uint64_t value) {
+    char digits[20];
+    size_t count = 0;
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    for (size_t index = 0; index < count; index++) {
+        buffer[index] = digits[count - 1 - index];
+    }
+    return count;
+}
+
+/* endregion HELPER */
+
+/* region EXACT COMPARISON */
+
+/* 256 bits hold `digits * 10^exponent` and the rounding midpoints of every float exactly */
+#define WIDE_WORDS 8
+
+typedef struct wide {
+    uint32_t words[WIDE_WORDS];
+} wide_t;
+
+static void wideInit(wide_t *wide, uint64_t value) {
+    memset(wide, 0, sizeof(wide_t));
+    wide->words[0] = (uint32_t)value;
+    wide->words[1] = (uint32_t)(value >> 32);
+}
+
+static void wideMultiply(wide_t *wide, uint32_t factor) {
+    uint64_t carry = 0;
+    for (size_t index = 0; index < WIDE_WORDS; index++) {
+        uint64_t product = (uint64_t)wide->words[index] * factor + carry;
+        wide->words[index] = (uint32_t)product;
+        carry = product >> 32;
+    }
+}
+
+static void wideMultiplyByPowerOfFive(wide_t *wide, int exponent) {
+    for (; exponent >= 13; exponent -= 13) {
+        wideMultiply(wide, 1220703125u); /* 5^13 */
+    }
+    for (; exponent > 0; exponent--) {
+        wideMultiply(wide, 5);
+    }
+}
+
+static void wideShiftLeft(wide_t *wide, int shift) {
+    int wordShift = shift / 32;
+    int bitShift = shift % 32;
+    for (int index = WIDE_WORDS - 1; index >= 0; index--) {
+        int source = index - wordShift;
+        uint32_t word = source >= 0 ? wide->words[source] << bitShift : 0;
+        if (bitShift != 0 && source > 0) {
+            word |= wide->words[source - 1] >> (32 - bitShift);
+        }
+        wide->words[index] = word;
+    }
+}
+
+/*! @return sign of `digits * 10^exponent - midpoint * 2^binaryExponent` */
+static int compareExactly(uint64_t digits, int exponent, uint64_t midpoint, int binaryExponent) {
+    wide_t decimal;
+    wide_t binary;
+    wideInit(&decimal, digits);
+    wideInit(&binary, midpoint);
+    if (exponent >= 0) {
+        wideMultiplyByPowerOfFive(&decimal, exponent);
+    } else {
+        wideMultiplyByPowerOfFive(&binary, -exponent);
+    }
+    if (exponent >= binaryExponent) {
+        wideShiftLeft(&decimal, exponent - binaryExponent);
+    } else {
+        wideShiftLeft(&binary, binaryExponent - exponent);
+    }
+
+    for (int index = WIDE_WORDS - 1; index >= 0; index--) {
+        if (decimal.words[index] != binary.words[index]) {
+            return decimal.words[index] < binary.words[index] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/* endregion EXACT COMPARISON */
+
+/* region FORMAT */
+
+/*!
+ * rounding interval of a positive finite float, the midpoints to its neighbours are
+ * `lowerMidpoint * 2^lowerExponent` and `upperMidpoint * 2^upperExponent`
+ */
+typedef struct interval {
+    double exact;
+    double lowerHalf;
+    double upperHalf;
+    uint64_t lowerMidpoint;
+    int lowerExponent;
+    uint64_t upperMidpoint;
+    int upperExponent;
+    bool evenSignificand;
+} interval_t;
+
+static void intervalInit(interval_t *interval, uint32_t bits) {
+    int biasedExponent = (int)(bits >> 23);
+    uint64_t significand = bits & 0x007FFFFFu;
+    int binaryExponent = -149;
+    if (biasedExponent != 0) {
+        significand |= 0x00800000u;
+        binaryExponent = biasedExponent - 150;
+    }
+
+    interval->exact = floatFromBits(bits);
+    interval->lowerHalf = (interval->exact - floatFromBits(bits - 1)) / 2;
+    interval->upperHalf = bits + 1 == 0x7F800000u
+                              ? interval->lowerHalf
+                              : (floatFromBits(bits + 1) - interval->exact) / 2;
+    interval->upperMidpoint = 2 * significand + 1;
+    interval->upperExponent = binaryExponent - 1;
+    if ((bits & 0x007FFFFFu) == 0 && biasedExponent > 1) {
+        /* the float below a power of two is twice as close */
+        interval->lowerMidpoint = 4 * significand - 1;
+        interval->lowerExponent = binaryExponent - 2;
+    } else {
+        interval->lowerMidpoint = 2 * significand - 1;
+        interval->lowerExponent = binaryExponent - 1;
+    }
+    interval->evenSignificand = (bits & 1) == 0;
+}
+
+/*!
+ * check if `candidate * 10^exponent` rounds to the float, candidates close to a midpoint are
+ * compared exactly
+ *
+ * @return distance to the float, negative if the candidate rounds to another float
+ */
+static double candidateDistance(const interval_t *interval, uint64_t candidate, int exponent) {
+    double difference = scaleByPowerOfTen((double)candidate, exponent) - interval->exact;
+    bool above = difference >= 0;
+    double distance = above ? difference : -difference;
+    double half = above ? interval->upperHalf : interval->lowerHalf;
+
+    /* the scaled candidate is off by far less than a millionth of the interval */
+    if (distance <= half - half * 1e-6) {
+        return distance;
+    }
+    if (distance >= half + half * 1e-6) {
+        return -1;
+    }
+
+    int sign = above ? -compareExactly(candidate, exponent, interval->upperMidpoint,
+                                       interval->upperExponent)
+                     : compareExactly(candidate, exponent, interval->lowerMidpoint,
+                                      interval->lowerExponent);
+    /* a midpoint rounds to the even float */
+    return sign > 0 || (sign == 0 && interval->evenSignificand) ? distance : -1;
+}
+
+/*!
+ * Find the shortest `digits * 10^exponent` inside the rounding interval of a positive finite
+ * float. Nine significant digits always suffice for a float, so at most nine precisions are
+ * checked. The correctly rounded digits may round to a neighbour while the truncated or the
+ * incremented digits do not, so both are checked and the closer one is taken.
+ */
+static void shortestDigits(uint32_t bits, uint64_t *digits, int *exponent) {
+    interval_t interval;
+    intervalInit(&interval, bits);
+
+    int biasedExponent = (int)(bits >> 23);
+    int leading = (biasedExponent == 0 ? -149 : biasedExponent - 127) * 30103 / 100000;
+    while (scaleByPowerOfTen(interval.exact, 8 - leading) < 1e8) {
+        leading--;
+    }
+    while (scaleByPowerOfTen(interval.exact, 8 - leading) >= 1e9) {
+        leading++;
+    }
+
+    for (int precision = 1; precision <= 9; precision++) {
+        double scaled = scaleByPowerOfTen(interval.exact, precision - 1 - leading);
+        uint64_t below = (uint64_t)scaled;
+        uint64_t candidate = (uint64_t)(scaled + 0.5);
+        int candidateExponent = leading - precision + 1;
+
+        double belowDistance = candidateDistance(&interval, below, candidateExponent);
+        double aboveDistance = candidateDistance(&interval, below + 1, candidateExponent);
+        bool accepted = belowDistance >= 0 || aboveDistance >= 0;
+        if (accepted) {
+            bool belowIsCloser =
+                aboveDistance < 0 || (belowDistance >= 0 && belowDistance <= aboveDistance);
+            candidate = belowIsCloser ? below : below + 1;
+        }
+
+        if (precision == 9 || accepted) {
+            while (candidate != 0 && candidate % 10 == 0) {
+                candidate /= 10;
+                candidateExponent++;
+            }
+            *digits = candidate;
+            *exponent = candidateExponent;
+            return;
+        }
+    }
+}
+
+/*! write `digits * 10^exponent` in fixed notation for moderate magnitudes, scientific otherwise */
+static size_t writeDecimal(char *buffer, uint64_t digits, int exponent) {
+    char text[20];
+    int count = (int)writeDigits(text, digits);
+    int leading = exponent + count - 1;
+    char *cursor = buffer;
+
+    if (leading >= -4 && leading < 9) {
+        if (leading < 0) {
+            *cursor++ = '0';
+            *cursor++ = '.';
+            for (int zero = -1; zero > leading; zero--) {
+                *cursor++ = '0';
+            }
+            memcpy(cursor, text, (size_t)count);
+            cursor += count;
+        } else if (count <= leading + 1) {
+            memcpy(cursor, text, (size_t)count);
+            cursor += count;
+            for (int zero = count; zero <= leading; zero++) {
+                *cursor++ = '0';
+            }
+        } else {
+            memcpy(cursor, text, (size_t)leading + 1);
+            cursor += leading + 1;
+            *cursor++ = '.';
+            memcpy(cursor, text + leading + 1, (size_t)(count - leading - 1));
+            cursor += count - leading - 1;
+        }
+    } else {
+        *cursor++ = text[0];
+        if (count > 1) {
+            *cursor++ = '.';
+            memcpy(cursor, text + 1, (size_t)count - 1);
+            cursor += count - 1;
+        }
+        *cursor++ = 'e';
+        if (leading < 0) {
+            *cursor++ = '-';
+            leading = -leading;
+        }
+        cursor += writeDigits(cursor, (uint64_t)leading);
+    }
+
+    return (size_t)(cursor - buffer);
+}
+
+size_t eaipFormatFloat(char *buffer, float value) {
+    char *cursor = buffer;
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    if ((bits & 0x7F800000u) == 0x7F800000u && (bits & 0x007FFFFFu) != 0) {
+        memcpy(cursor, "nan", 4);
+        return 3;
+    }
+    if ((bits & 0x80000000u) != 0) {
+        *cursor++ = '-';
+        bits &= 0x7FFFFFFFu;
+    }
+
+    if (bits == 0x7F800000u) {
+        memcpy(cursor, "inf", 3);
+        cursor += 3;
+    } else if (bits == 0) {
+        *cursor++ = '0';
+    } else {
+        uint64_t digits;
+        int exponent;
+        shortestDigits(bits, &digits, &exponent);
+        cursor += writeDecimal(cursor, digits, exponent);
+    }
+
+    *cursor = '\0';
+    return (size_t)(cursor - buffer);
+}
+
+size_t eaipFormatInt(char *buffer, int32_t value) {
+    char *cursor = buffer;
+    uint32_t magnitude = (uint32_t)value;
+    if (value < 0) {
+        *cursor++ = '-';
+        magnitude = 0u - magnitude;
+    }
+
+    cursor += writeDigits(cursor, magnitude);
+    *cursor = '\0';
+    return (size_t)(cursor - buffer);
+}
+
+void eaipWriteFloatVector(eaipWriter_t *writer, const float *values, size_t count) {
+    char number[EAIP_NUMBER_BUFFER_SIZE];
+    for (size_t index = 0; index < count; index++) {
+        if (index > 0) {
+            eaipWriterAppendChar(writer, ',');
+        }
+
+        if (writer->length + EAIP_NUMBER_BUFFER_SIZE < writer->capacity) {
+            /* enough space left: format in place instead of copying */
+            writer->length += eaipFormatFloat(writer->buffer + writer->length, values[index]);
+        } else {
+            eaipWriterAppend(writer, number, eaipFormatFloat(number, values[index]));
+        }
+    }
+}
+
+/* endregion FORMAT */
+
+/* region SCAN */
+
+#if EAIP_NUMBER_SWAR
+static bool isEightDigits(uint64_t chunk) {
+    return (((chunk & 0xF0F0F0F0F0F0F0F0u) |
+             (((chunk + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4)) ==
+            0x3333333333333333u);
+}
+
+/*! combine eight ASCII digits in one word with three multiplications */
+static uint32_t parseEightDigits(uint64_t chunk) {
+    const uint64_t mask = 0x000000FF000000FFu;
+    const uint64_t lowFactors = 100u + (1000000ull << 32);
+    const uint64_t highFactors = 1u + (10000ull << 32);
+
+    chunk -= 0x3030303030303030u;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & mask) * lowFactors) + (((chunk >> 16) & mask) * highFactors)) >> 32;
+    return (uint32_t)chunk;
+}
+#endif
+
+/*!
+ * Append the leading digits of `text` to `mantissa`. Digits exceeding 19 significant places are
+ * counted in `dropped` instead.
+ */
+static size_t scanDigits(const char *text, size_t length, uint64_t *mantissa, size_t *dropped) {
+    size_t index = 0;
+#if EAIP_NUMBER_SWAR
+    while (length - index >= 8 && *mantissa < 100000000000u) {
+        uint64_t chunk;
+        memcpy(&chunk, text + index, sizeof(chunk));
+        if (!isEightDigits(chunk)) {
+            break;
+        }
+        *mantissa = *mantissa * 100000000u + parseEightDigits(chunk);
+        index += 8;
+    }
+#endif
+
+    for (; index < length && isDigit(text[index]); index++) {
+        if (*mantissa < 1000000000000000000u) {
+            *mantissa = *mantissa * 10 + (uint64_t)(text[index] - '0');
+        } else {
+            (*dropped)++;
+        }
+    }
+    return index;
+}
+
+static bool startsWithIgnoringCase(const char *text, size_t length, const char *literal) {
+    size_t literalLength = strlen(literal);
+    if (length < literalLength) {
+        return false;
+    }
+    for (size_t index = 0; index < literalLength; index++) {
+        if ((text[index] | 0x20) != literal[index]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t eaipScanFloat(const char *text, size_t length, float *value) {
+    size_t index = 0;
+    bool negative = false;
+    if (index < length && (text[index] == '-' || text[index] == '+')) {
+        negative = text[index] == '-';
+        index++;
+    }
+
+    if (startsWithIgnoringCase(text + index, length - index, "nan")) {
+        *value = negative ? -NAN : NAN;
+        return index + 3;
+    }
+    if (startsWithIgnoringCase(text + index, length - index, "inf")) {
+        *value = negative ? -INFINITY : INFINITY;
+        index += 3;
+        if (startsWithIgnoringCase(text + index, length - index, "inity")) {
+            index += 5;
+        }
+        return index;
+    }
+
+    uint64_t mantissa = 0;
+    size_t dropped = 0;
+    size_t integerDigits = scanDigits(text + index, length - index, &mantissa, &dropped);
+    long exponent = (long)dropped;
+    index += integerDigits;
+
+    size_t fractionDigits = 0;
+    if (index < length && text[index] == '.') {
+        dropped = 0;
+        fractionDigits = scanDigits(text + index + 1, length - index - 1, &mantissa, &dropped);
+        exponent -= (long)(fractionDigits - dropped);
+        index += 1 + fractionDigits;
+    }
+
+    if (integerDigits == 0 && fractionDigits == 0) {
+        return 0;
+    }
+
+    if (index < length && (text[index] | 0x20) == 'e') {
+        size_t cursor = index + 1;
+        bool negativeExponent = false;
+        if (cursor < length && (text[cursor] == '-' || text[cursor] == '+')) {
+            negativeExponent = text[cursor] == '-';
+            cursor++;
+        }
+
+        long explicitExponent = 0;
+        size_t exponentStart = cursor;
+        for (; cursor < length && isDigit(text[cursor]); cursor++) {
+            if (explicitExponent < 100000) {
+                explicitExponent = explicitExponent * 10 + (text[cursor] - '0');
+            }
+        }
+
+        /* a trailing `e` without digits is not part of the number */
+        if (cursor > exponentStart) {
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+            index = cursor;
+        }
+    }
+
+    double result = 0.0;
+    if (mantissa != 0) {
+        /* beyond these bounds every float is either 0 or infinite */
+        exponent = exponent < -400 ? -400 : exponent > 400 ? 400 : exponent;
+        result = scaleByPowerOfTen((double)mantissa, (int)exponent);
+    }
+
+    *value = (float)(negative ? -result : result);
+    return index;
+}
+
+size_t eaipScanInt(const char *text, size_t length, int32_t *value) {
+    size_t index = 0;
+    bool negative = false;
+    if (index < length && (text[index] == '-' || text[index] == '+')) {
+        negative = text[index] == '-';
+        index++;
+    }
+
+    size_t start = index;
+    uint64_t magnitude = 0;
+    for (; index < length && isDigit(text[index]); index++) {
+        magnitude = magnitude * 10 + (uint64_t)(text[index] - '0');
+        if (magnitude > 2147483648u) {
+            return 0;
+        }
+    }
+
+    if (index == start || (!negative && magnitude > INT32_MAX)) {
+        return 0;
+    }
+
+    *value = (int32_t)(negative ? -(int64_t)magnitude : (int64_t)magnitude);
+    return index;
+}
+
+/* endregion SCAN */
@@ -0,0 +1,345 @@
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/protocol/Outbox.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Session.h"
+#include "eaip/protocol/Transport.h"
+
+/* region RING */
+
+#define NOT_READING SIZE_MAX
+
+static char *getRecord(const eaipOutbox_t *outbox, size_t counter) {
+    return outbox->records + (counter & (outbox->capacity - 1)) * outbox->recordSize;
+}
+
+/*!
+ * @brief wait for or make room for the record at `tail` according to the overflow policy
+ *
+ * @return the record at `tail`, NULL if the new message has to be dropped
+ */
+static char *reserveExclusive(eaipOutbox_t *outbox, size_t tail) {
+    size_t head = atomic_load_explicit(&outbox->head, memory_order_acquire);
+    while (tail - head >= outbox->capacity) {
+        switch (outbox->policy) {
+        case EAIP_OVERFLOW_DROP_NEWEST:
+            atomic_fetch_add_explicit(&outbox->dropped, 1, memory_order_relaxed);
+            return NULL;
+        case EAIP_OVERFLOW_DROP_OLDEST:
+            if (atomic_compare_exchange_weak_explicit(&outbox->head, &head, head + 1,
+                                                      memory_order_acq_rel,
+                                                      memory_order_acquire)) {
+                atomic_fetch_add_explicit(&outbox->dropped, 1, memory_order_relaxed);
+                head++;
+            }
+            break;
+        case EAIP_OVERFLOW_BLOCK:
+        default:
+            EAIP_OUTBOX_YIELD();
+            head = atomic_load_explicit(&outbox->head, memory_order_acquire);
+            break;
+        }
+    }
+
+    /* the consumer claims a record before copying it, the claimed record must not be reused yet */
+    size_t reading = atomic_load_explicit(&outbox->reading, memory_order_acquire);
+    if (reading != NOT_READING && tail - reading >= outbox->capacity) {
+        atomic_fetch_add_explicit(&outbox->dropped, 1, memory_order_relaxed);
+        return NULL;
+    }
+    return getRecord(outbox, tail);
+}
+
+/*!
+ * @brief move the oldest record to `scratch` for `EAIP_OVERFLOW_DROP_OLDEST`
+ *
+ * The record is claimed by advancing `head` before it is copied, so the producer can neither drop
+ * nor overwrite it during the copy.
+ *
+ * @return false if the outbox is empty
+ */
+static bool claimOldest(eaipOutbox_t *outbox) {
+    for (;;) {
+        size_t head = atomic_load_explicit(&outbox->head, memory_order_acquire);
+        if (head == atomic_load_explicit(&outbox->tail, memory_order_acquire)) {
+            return false;
+        }
+        atomic_store_explicit(&outbox->reading, head, memory_order_relaxed);
+        if (atomic_compare_exchange_strong_explicit(&outbox->head, &head, head + 1,
+                                                    memory_order_acq_rel,
+                                                    memory_order_acquire)) {
+            memcpy(outbox->scratch, getRecord(outbox, head), outbox->recordSize);
+            atomic_store_explicit(&outbox->reading, NOT_READING, memory_order_release);
+            outbox->pending = true;
+            return true;
+        }
+        /* the producer dropped the record first */
+        atomic_store_explicit(&outbox->reading, NOT_READING, memory_order_relaxed);
+    }
+}
+
+/*!
+ * @brief claim the next free record among concurrent producers
+ *
+ * The sequence number of a record equals its position while it is free, the position + 1 once it
+ * was filled, and the position of the next round once it was drained.
+ *
+ * @return the claimed record, NULL if the new message has to be dropped
+ */
+static char *reserveShared(eaipOutbox_t *outbox, size_t *position) {
+    size_t tail = atomic_load_explicit(&outbox->tail, memory_order_relaxed);
+    for (;;) {
+        size_t sequence = atomic_load_explicit(&outbox->sequences[tail & (outbox->capacity - 1)],
+                                               memory_order_acquire);
+        size_t lag = tail - sequence;
+        if (lag == 0) {
+            if (atomic_compare_exchange_weak_explicit(&outbox->tail, &tail, tail + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                *position = tail;
+                return getRecord(outbox, tail);
+            }
+        } else if (lag <= outbox->capacity) {
+            /* the record still holds a message of the previous round */
+            if (outbox->policy == EAIP_OVERFLOW_DROP_NEWEST) {
+                atomic_fetch_add_explicit(&outbox->dropped, 1, memory_order_relaxed);
+                return NULL;
+            }
+            EAIP_OUTBOX_YIELD();
+            tail = atomic_load_explicit(&outbox->tail, memory_order_relaxed);
+        } else {
+            /* another producer claimed the record first */
+            tail = atomic_load_explicit(&outbox->tail, memory_order_relaxed);
+        }
+    }
+}
+
+static char *reserveRecord(eaipOutbox_t *outbox, size_t *position) {
+    if (outbox->sequences != NULL) {
+        return reserveShared(outbox, position);
+    }
+    *position = atomic_load_explicit(&outbox->tail, memory_order_relaxed);
+    return reserveExclusive(outbox, *position);
+}
+
+static void commitRecord(eaipOutbox_t *outbox, size_t position) {
+    if (outbox->sequences != NULL) {
+        atomic_store_explicit(&outbox->sequences[position & (outbox->capacity - 1)],
+                              position + 1, memory_order_release);
+    } else {
+        atomic_store_explicit(&outbox->tail, position + 1, memory_order_release);
+    }
+}
+
+static eaipCommunicationErrorCodes publishRecord(const eaipOutbox_t *outbox, char *record) {
+    char *topic = record + 1;
+    char *message = topic + strlen(topic) + 1;
+    return transportPublish(&outbox->config, topic, message, record[0] != 0);
+}
+
+/* endregion RING */
+
+eaipCommunicationErrorCodes eaipOutboxInit(eaipOutbox_t *outbox, eaiProtocol_t config,
+                                           size_t capacity, size_t recordSize,
+                                           eaipOverflowPolicy_t policy) {
+    size_t ringSize = 1;
+    while (ringSize < capacity) {
+        ringSize <<= 1;
+    }
+
+    char *records = calloc(ringSize, recordSize);
+    char *scratch = calloc(1, recordSize);
+    if (records == NULL || scratch == NULL) {
+        free(records);
+        free(scratch);
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    outbox->config = config;
+    outbox->records = records;
+    outbox->capacity = ringSize;
+    outbox->recordSize = recordSize;
+    outbox->policy = policy;
+    atomic_init(&outbox->head, 0);
+    atomic_init(&outbox->tail, 0);
+    atomic_init(&outbox->dropped, 0);
+    atomic_init(&outbox->reading, NOT_READING);
+    outbox->scratch = scratch;
+    outbox->pending = false;
+    outbox->sequences = NULL;
+    return EAIP_COM_NO_ERROR;
+}
+
+eaipCommunicationErrorCodes eaipOutboxInitMultiProducer(eaipOutbox_t *outbox,
+                                                        eaiProtocol_t config, size_t capacity,
+                                                        size_t recordSize,
+                                                        eaipOverflowPolicy_t policy) {
+    if (policy == EAIP_OVERFLOW_DROP_OLDEST) {
+        /* producers would have to synchronize with the consumer on every record */
+        return EAIP_COM_NOT_SUPPORTED;
+    }
+
+    eaipCommunicationErrorCodes result =
+        eaipOutboxInit(outbox, config, capacity, recordSize, policy);
+    if (result != EAIP_COM_NO_ERROR) {
+        return result;
+    }
+
+    outbox->sequences = calloc(outbox->capacity, sizeof(atomic_size_t));
+    if (outbox->sequences == NULL) {
+        eaipOutboxFree(outbox);
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+    for (size_t index = 0; index < outbox->capacity; index++) {
+        atomic_init(&outbox->sequences[index], index);
+    }
+    return EAIP_COM_NO_ERROR;
+}
+
+void eaipOutboxFree(eaipOutbox_t *outbox) {
+    free(outbox->records);
+    free(outbox->scratch);
+    free(outbox->sequences);
+    outbox->records = NULL;
+    outbox->scratch = NULL;
+    outbox->sequences = NULL;
+    outbox->capacity = 0;
+    outbox->pending = false;
+}
+
+eaipCommunicationErrorCodes eaipOutboxPublish(eaipOutbox_t *outbox, const char *topic,
+                                              const char *message, bool retain) {
+    size_t topicLength = strlen(topic);
+    size_t messageLength = strlen(message);
+    if (topicLength + messageLength + 3 > outbox->recordSize) {
+        return EAIP_COM_MESSAGE_TO_LONG;
+    }
+
+    size_t position;
+    char *record = reserveRecord(outbox, &position);
+    if (record == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    record[0] = (char)retain;
+    memcpy(record + 1, topic, topicLength + 1);
+    memcpy(record + topicLength + 2, message, messageLength + 1);
+
+    commitRecord(outbox, position);
+    return EAIP_COM_NO_ERROR;
+}
+
+eaipCommunicationErrorCodes eaipOutboxPublishData(eaipOutbox_t *outbox,
+                                                  const eaipSession_t *session,
+                                                  eaipPubRequest_t request) {
+    size_t prefixLength = session->prefixLengths[DATA];
+    size_t dataIdLength = strlen(request.dataId);
+    size_t dataLength = strlen(request.data);
+    size_t topicLength = prefixLength + dataIdLength;
+    if (topicLength + dataLength + 3 > outbox->recordSize) {
+        return EAIP_COM_MESSAGE_TO_LONG;
+    }
+
+    size_t position;
+    char *record = reserveRecord(outbox, &position);
+    if (record == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    record[0] = (char)false;
+    memcpy(record + 1, session->prefixes[DATA], prefixLength);
+    memcpy(record + 1 + prefixLength, request.dataId, dataIdLength);
+    record[topicLength + 1] = '\0';
+    memcpy(record + topicLength + 2, request.data, dataLength + 1);
+
+    commitRecord(outbox, position);
+    return EAIP_COM_NO_ERROR;
+}
+
+size_t eaipOutboxDrain(eaipOutbox_t *outbox, size_t limit) {
+    size_t published = 0;
+
+    while (published < limit) {
+        if (outbox->sequences != NULL) {
+            size_t head = atomic_load_explicit(&outbox->head, memory_order_relaxed);
+            atomic_size_t *sequence = &outbox->sequences[head & (outbox->capacity - 1)];
+            if (atomic_load_explicit(sequence, memory_order_acquire) != head + 1) {
+                break; /* empty, or the producer of the next record is not done yet */
+            }
+            if (EAIP_COM_NO_ERROR != publishRecord(outbox, getRecord(outbox, head))) {
+                break;
+            }
+            atomic_store_explicit(sequence, head + outbox->capacity, memory_order_release);
+            atomic_store_explicit(&outbox->head, head + 1, memory_order_release);
+            published++;
+            continue;
+        }
+
+        if (outbox->policy != EAIP_OVERFLOW_DROP_OLDEST) {
+            /* the producer never touches `head`, records can be published in place */
+            size_t head = atomic_load_explicit(&outbox->head, memory_order_relaxed);
+            if (head == atomic_load_explicit(&outbox->tail, memory_order_acquire)) {
+                break;
+            }
+            if (EAIP_COM_NO_ERROR != publishRecord(outbox, getRecord(outbox, head))) {
+                break;
+            }
+            atomic_store_explicit(&outbox->head, head + 1, memory_order_release);
+            published++;
+            continue;
+        }
+
+        if (!outbox->pending && !claimOldest(outbox)) {
+            break;
+        }
+        if (EAIP_COM_NO_ERROR != publishRecord(outbox, outbox->scratch)) {
+            break;
+        }
+        outbox->pending = false;
+        published++;
+    }
+
+    return published;
+}
+
+size_t eaipOutboxPeekLength(const eaipOutbox_t *outbox) {
+    eaipOutbox_t *mutableOutbox = (eaipOutbox_t *)outbox;
+    size_t head = atomic_load_explicit(&mutableOutbox->head, memory_order_acquire);
+    const char *record;
+
+    if (outbox->sequences != NULL) {
+        atomic_size_t *sequence = &mutableOutbox->sequences[head & (outbox->capacity - 1)];
+        if (atomic_load_explicit(sequence, memory_order_acquire) != head + 1) {
+            return 0;
+        }
+        record = getRecord(outbox, head);
+    } else if (outbox->policy == EAIP_OVERFLOW_DROP_OLDEST) {
+        /* the producer may overwrite the oldest record at any time, it is measured in `scratch` */
+        if (!outbox->pending && !claimOldest(mutableOutbox)) {
+            return 0;
+        }
+        record = outbox->scratch;
+    } else if (head != atomic_load_explicit(&mutableOutbox->tail, memory_order_acquire)) {
+        record = getRecord(outbox, head);
+    } else {
+        return 0;
+    }
+
+    size_t topicLength = strnlen(record + 1, outbox->recordSize - 2);
+    size_t messageLength =
+        strnlen(record + topicLength + 2, outbox->recordSize - topicLength - 2);
+    return topicLength + messageLength;
+}
+
+size_t eaipOutboxCount(const eaipOutbox_t *outbox) {
+    size_t head = atomic_load_explicit(&((eaipOutbox_t *)outbox)->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&((eaipOutbox_t *)outbox)->tail, memory_order_acquire);
+    return tail - head;
+}
+
+size_t eaipOutboxDropped(const eaipOutbox_t *outbox) {
+    return atomic_load_explicit(&((eaipOutbox_t *)outbox)->dropped, memory_order_relaxed);
+}
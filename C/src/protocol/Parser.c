@@ -1,17 +1,37 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "eaip/protocol/Number.h"
 #include "eaip/protocol/Parser.h"
 #include "eaip/protocol/Protocol.h"
 
 /* region TOPIC */
 
-#define TOPIC_STATUS "STATUS"
-#define TOPIC_START "START"
-#define TOPIC_STOP "STOP"
-#define TOPIC_DATA "DATA"
-#define TOPIC_DO "DO"
-#define TOPIC_DONE "DONE"
+#define TOPIC_STATUS EAIP_TOPIC_NAME_STATUS
+#define TOPIC_START EAIP_TOPIC_NAME_START
+#define TOPIC_STOP EAIP_TOPIC_NAME_STOP
+#define TOPIC_DATA EAIP_TOPIC_NAME_DATA
+#define TOPIC_DO EAIP_TOPIC_NAME_DO
+#define TOPIC_DONE EAIP_TOPIC_NAME_DONE
+
+static const char *const topicNames[EAIP_TOPIC_TYPES] = {
+    [STATUS] = TOPIC_STATUS, [START] = TOPIC_START, [STOP] = TOPIC_STOP,
+    [DATA] = TOPIC_DATA,     [DO] = TOPIC_DO,       [DONE] = TOPIC_DONE,
+};
+static const size_t topicNameLengths[EAIP_TOPIC_TYPES] = {
+    [STATUS] = sizeof(TOPIC_STATUS) - 1, [START] = sizeof(TOPIC_START) - 1,
+    [STOP] = sizeof(TOPIC_STOP) - 1,     [DATA] = sizeof(TOPIC_DATA) - 1,
+    [DO] = sizeof(TOPIC_DO) - 1,         [DONE] = sizeof(TOPIC_DONE) - 1,
+};
+
+const char *getTopicName(topic_t topic) {
+    return topicNames[topic];
+}
+
+size_t getTopicNameLength(topic_t topic) {
+    return topicNameLengths[topic];
+}
 
 size_t getTopicLength(topic_t topic, char *baseUrl, char *deviceId, char *dataId) {
     size_t length = strlen(baseUrl) + strlen(deviceId);
@@ -67,6 +87,110 @@ void parseTopic(char *topicBuffer, topic_t topic, char *baseUrl, char *deviceId,
     }
 }
 
+size_t getOwnTopicLength(const eaipSession_t *session, topic_t topic, size_t dataIdLength) {
+    if (topic == STATUS) {
+        return session->prefixLengths[STATUS] + 1;
+    }
+    return session->prefixLengths[topic] + dataIdLength + 1;
+}
+
+void parseOwnTopic(char *topicBuffer, const eaipSession_t *session, topic_t topic,
+                   const char *dataId, size_t dataIdLength) {
+    memcpy(topicBuffer, session->prefixes[topic], session->prefixLengths[topic]);
+    topicBuffer += session->prefixLengths[topic];
+
+    if (topic != STATUS) {
+        memcpy(topicBuffer, dataId, dataIdLength);
+        topicBuffer += dataIdLength;
+    }
+    *topicBuffer = '\0';
+}
+
+size_t getForeignTopicLength(const eaipSession_t *session, topic_t topic, size_t deviceIdLength,
+                             size_t dataIdLength) {
+    size_t length = session->baseUrlLength + deviceIdLength + topicNameLengths[topic] + 2;
+
+    if (topic != STATUS) {
+        length += dataIdLength + 1;
+    }
+
+    return length;
+}
+
+void parseForeignTopic(char *topicBuffer, const eaipSession_t *session, topic_t topic,
+                       const char *deviceId, size_t deviceIdLength, const char *dataId,
+                       size_t dataIdLength) {
+    memcpy(topicBuffer, session->requester, session->baseUrlLength);
+    topicBuffer += session->baseUrlLength;
+
+    memcpy(topicBuffer, deviceId, deviceIdLength);
+    topicBuffer += deviceIdLength;
+    *topicBuffer++ = '/';
+
+    memcpy(topicBuffer, topicNames[topic], topicNameLengths[topic]);
+    topicBuffer += topicNameLengths[topic];
+
+    if (topic != STATUS) {
+        *topicBuffer++ = '/';
+        memcpy(topicBuffer, dataId, dataIdLength);
+        topicBuffer += dataIdLength;
+    }
+    *topicBuffer = '\0';
+}
+
+static bool decodeTopicName(const char *name, size_t length, topic_t *topic) {
+    for (topic_t candidate = STATUS; candidate <= DONE; candidate++) {
+        if (topicNameLengths[candidate] == length &&
+            0 == memcmp(topicNames[candidate], name, length)) {
+            *topic = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+eaipCommunicationErrorCodes eaipDecodeTopic(const eaipSession_t *session, const char *topic,
+                                            size_t length, eaipTopicView_t *view) {
+    const char *end = topic + length;
+
+    if (length <= session->baseUrlLength ||
+        0 != memcmp(topic, session->requester, session->baseUrlLength)) {
+        return EAIP_COM_INVALID_TOPIC;
+    }
+    const char *deviceId = topic + session->baseUrlLength;
+
+    const char *deviceIdEnd = memchr(deviceId, '/', (size_t)(end - deviceId));
+    if (deviceIdEnd == NULL || deviceIdEnd == deviceId) {
+        return EAIP_COM_INVALID_TOPIC;
+    }
+    const char *type = deviceIdEnd + 1;
+
+    const char *typeEnd = memchr(type, '/', (size_t)(end - type));
+    if (typeEnd == NULL) {
+        typeEnd = end;
+    }
+    if (!decodeTopicName(type, (size_t)(typeEnd - type), &view->type)) {
+        return EAIP_COM_INVALID_TOPIC;
+    }
+
+    if (view->type == STATUS) {
+        if (typeEnd != end) {
+            return EAIP_COM_INVALID_TOPIC;
+        }
+        view->dataId = (eaipStringView_t){.data = end, .length = 0};
+    } else {
+        if (typeEnd == end || typeEnd + 1 == end) {
+            return EAIP_COM_INVALID_TOPIC;
+        }
+        view->dataId =
+            (eaipStringView_t){.data = typeEnd + 1, .length = (size_t)(end - typeEnd - 1)};
+    }
+
+    view->deviceId =
+        (eaipStringView_t){.data = deviceId, .length = (size_t)(deviceIdEnd - deviceId)};
+    return EAIP_COM_NO_ERROR;
+}
+
 /* endregion TOPIC */
 
 /* region STATUS */
@@ -81,70 +205,254 @@ void parseTopic(char *topicBuffer, topic_t topic, char *baseUrl, char *deviceId,
 #define STATE_ONLINE "ONLINE"
 #define STATE_OFFLINE "OFFLINE"
 
-size_t getStatusLength(char *deviceId, eaipDeviceState_t status) {
-    size_t length = strlen(FIELD_NAME_ID) + strlen(deviceId) + strlen(FIELD_NAME_TYPE) +
-                    strlen(FIELD_NAME_STATE) + 7;
+#define TYPE_APPLICATION_SHORT "APP"
+#define TYPE_NODE_ALIAS "NODE"
 
+void eaipWriteStatus(eaipWriter_t *writer, const char *deviceId, eaipDeviceState_t status) {
+    eaipWriterAppend(writer, FIELD_NAME_ID ":", sizeof(FIELD_NAME_ID));
+    eaipWriterAppendString(writer, deviceId);
+
+    eaipWriterAppend(writer, ";" FIELD_NAME_TYPE ":", sizeof(FIELD_NAME_TYPE) + 1);
     switch (status.deviceType) {
     case APPLICATION:
-        length += strlen(TYPE_APPLICATION);
+        eaipWriterAppend(writer, TYPE_APPLICATION, sizeof(TYPE_APPLICATION) - 1);
         break;
     case NODE:
-        length += strlen(TYPE_NODE);
+        eaipWriterAppend(writer, TYPE_NODE, sizeof(TYPE_NODE) - 1);
         break;
     }
 
+    eaipWriterAppend(writer, ";" FIELD_NAME_STATE ":", sizeof(FIELD_NAME_STATE) + 1);
     switch (status.deviceState) {
     case OFFLINE:
-        length += strlen(STATE_OFFLINE);
+        eaipWriterAppend(writer, STATE_OFFLINE, sizeof(STATE_OFFLINE) - 1);
         break;
     case ONLINE:
-        length += strlen(STATE_ONLINE);
+        eaipWriterAppend(writer, STATE_ONLINE, sizeof(STATE_ONLINE) - 1);
         break;
     }
+    eaipWriterAppendChar(writer, ';');
 
     eaipStateDataField_t *next = status.additionalFields;
     while (next != NULL) {
-        length += strlen(next->id) + strlen(next->data) + 2;
+        eaipWriterAppendString(writer, next->id);
+        eaipWriterAppendChar(writer, ':');
+        eaipWriterAppendString(writer, next->data);
+        eaipWriterAppendChar(writer, ';');
         next = next->next;
     }
+}
 
-    return length;
+size_t eaipSerializeStatus(char *buffer, size_t bufferSize, const char *deviceId,
+                           eaipDeviceState_t status, bool *truncated) {
+    eaipWriter_t writer;
+    eaipWriterInit(&writer, buffer, bufferSize);
+    eaipWriteStatus(&writer, deviceId, status);
+
+    if (truncated != NULL) {
+        *truncated = eaipWriterTruncated(&writer);
+    }
+    return eaipWriterFinish(&writer);
 }
 
-void parseStatus(char *statusBuffer, char *deviceId, eaipDeviceState_t status) {
-    sprintf(statusBuffer, "%s:%s;", FIELD_NAME_ID, deviceId);
+char *serializeStatus(char *buffer, size_t bufferSize, const char *deviceId,
+                      eaipDeviceState_t status) {
+    eaipWriter_t writer;
+    eaipWriterInit(&writer, buffer, bufferSize);
+    eaipWriteStatus(&writer, deviceId, status);
 
-    strcat(statusBuffer, FIELD_NAME_TYPE ":");
-    switch (status.deviceType) {
-    case APPLICATION:
-        strcat(statusBuffer, TYPE_APPLICATION);
-        break;
-    case NODE:
-        strcat(statusBuffer, TYPE_NODE);
-        break;
+    if (eaipWriterTruncated(&writer)) {
+#ifdef EAIP_STACK_BOUNDED
+        return NULL;
+#else
+        /* rare case: status does not fit the scratch buffer, serialize again with exact size */
+        size_t requiredSize = writer.length + 1;
+        buffer = calloc(requiredSize, sizeof(char));
+        if (buffer == NULL) {
+            return NULL;
+        }
+        eaipWriterInit(&writer, buffer, requiredSize);
+        eaipWriteStatus(&writer, deviceId, status);
+#endif
     }
-    strcat(statusBuffer, ";");
 
-    strcat(statusBuffer, FIELD_NAME_STATE ":");
-    switch (status.deviceState) {
-    case OFFLINE:
-        strcat(statusBuffer, STATE_OFFLINE);
-        break;
-    case ONLINE:
-        strcat(statusBuffer, STATE_ONLINE);
-        break;
+    eaipWriterFinish(&writer);
+    return buffer;
+}
+
+static bool viewEquals(eaipStringView_t view, const char *literal, size_t literalLength) {
+    return view.length == literalLength && 0 == memcmp(view.data, literal, literalLength);
+}
+
+void eaipStatusIteratorInit(eaipStatusIterator_t *iterator, const char *message, size_t length) {
+    iterator->cursor = message;
+    iterator->end = message + length;
+}
+
+bool eaipStatusIteratorNext(eaipStatusIterator_t *iterator, eaipStatusField_t *field) {
+    while (iterator->cursor < iterator->end) {
+        const char *start = iterator->cursor;
+        const char *fieldEnd = memchr(start, ';', (size_t)(iterator->end - start));
+        if (fieldEnd == NULL) {
+            fieldEnd = iterator->end;
+            iterator->cursor = iterator->end;
+        } else {
+            iterator->cursor = fieldEnd + 1;
+        }
+
+        if (fieldEnd == start) {
+            continue;
+        }
+
+        const char *separator = memchr(start, ':', (size_t)(fieldEnd - start));
+        if (separator == NULL) {
+            field->key = (eaipStringView_t){.data = start, .length = (size_t)(fieldEnd - start)};
+            field->value = (eaipStringView_t){.data = fieldEnd, .length = 0};
+        } else {
+            field->key = (eaipStringView_t){.data = start, .length = (size_t)(separator - start)};
+            field->value = (eaipStringView_t){.data = separator + 1,
+                                              .length = (size_t)(fieldEnd - separator - 1)};
+        }
+        return true;
     }
-    strcat(statusBuffer, ";");
+    return false;
+}
 
-    eaipStateDataField_t *next = status.additionalFields;
-    while (next != NULL) {
-        strcat(statusBuffer, next->id);
-        strcat(statusBuffer, ":");
-        strcat(statusBuffer, next->data);
-        strcat(statusBuffer, ";");
-        next = next->next;
+static bool parseDeviceType(eaipStringView_t value, deviceType_t *deviceType) {
+    if (viewEquals(value, TYPE_NODE, sizeof(TYPE_NODE) - 1) ||
+        viewEquals(value, TYPE_NODE_ALIAS, sizeof(TYPE_NODE_ALIAS) - 1)) {
+        *deviceType = NODE;
+    } else if (viewEquals(value, TYPE_APPLICATION_SHORT, sizeof(TYPE_APPLICATION_SHORT) - 1) ||
+               viewEquals(value, TYPE_APPLICATION, sizeof(TYPE_APPLICATION) - 1)) {
+        *deviceType = APPLICATION;
+    } else {
+        return false;
     }
+    return true;
+}
+
+static bool parseDeviceState(eaipStringView_t value, deviceState_t *deviceState) {
+    if (viewEquals(value, STATE_ONLINE, sizeof(STATE_ONLINE) - 1)) {
+        *deviceState = ONLINE;
+    } else if (viewEquals(value, STATE_OFFLINE, sizeof(STATE_OFFLINE) - 1)) {
+        *deviceState = OFFLINE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+eaipCommunicationErrorCodes eaipParseStatus(const char *message, size_t length,
+                                            eaipStatusView_t *status) {
+    bool hasId = false;
+    bool hasType = false;
+    bool hasState = false;
+    status->additionalFieldsCount = 0;
+
+    eaipStatusIterator_t iterator;
+    eaipStatusField_t field;
+    eaipStatusIteratorInit(&iterator, message, length);
+    while (eaipStatusIteratorNext(&iterator, &field)) {
+        if (!hasId && viewEquals(field.key, FIELD_NAME_ID, sizeof(FIELD_NAME_ID) - 1)) {
+            status->deviceId = field.value;
+            hasId = true;
+        } else if (!hasType &&
+                   viewEquals(field.key, FIELD_NAME_TYPE, sizeof(FIELD_NAME_TYPE) - 1)) {
+            if (!parseDeviceType(field.value, &status->deviceType)) {
+                return EAIP_COM_INVALID_MESSAGE;
+            }
+            hasType = true;
+        } else if (!hasState &&
+                   viewEquals(field.key, FIELD_NAME_STATE, sizeof(FIELD_NAME_STATE) - 1)) {
+            if (!parseDeviceState(field.value, &status->deviceState)) {
+                return EAIP_COM_INVALID_MESSAGE;
+            }
+            hasState = true;
+        } else {
+            if (status->additionalFieldsCount < status->additionalFieldsCapacity) {
+                status->additionalFields[status->additionalFieldsCount] = field;
+            }
+            status->additionalFieldsCount++;
+        }
+    }
+
+    if (!hasId || !hasType || !hasState) {
+        return EAIP_COM_INVALID_MESSAGE;
+    }
+    return EAIP_COM_NO_ERROR;
 }
 
 /* endregion STATUS */
+
+/* region DATA */
+
+char *serializeFloatVector(char *buffer, size_t bufferSize, const float *values, size_t count) {
+    eaipWriter_t writer;
+    eaipWriterInit(&writer, buffer, bufferSize);
+    eaipWriteFloatVector(&writer, values, count);
+
+    if (eaipWriterTruncated(&writer)) {
+#ifdef EAIP_STACK_BOUNDED
+        return NULL;
+#else
+        size_t requiredSize = writer.length + 1;
+        buffer = calloc(requiredSize, sizeof(char));
+        if (buffer == NULL) {
+            return NULL;
+        }
+        eaipWriterInit(&writer, buffer, requiredSize);
+        eaipWriteFloatVector(&writer, values, count);
+#endif
+    }
+
+    eaipWriterFinish(&writer);
+    return buffer;
+}
+
+eaipCommunicationErrorCodes eaipParseDataFloat(const char *data, size_t length, float *value) {
+    size_t consumed = eaipScanFloat(data, length, value);
+    if (consumed == 0 || consumed != length) {
+        return EAIP_COM_INVALID_MESSAGE;
+    }
+    return EAIP_COM_NO_ERROR;
+}
+
+eaipCommunicationErrorCodes eaipParseDataInt(const char *data, size_t length, int32_t *value) {
+    size_t consumed = eaipScanInt(data, length, value);
+    if (consumed == 0 || consumed != length) {
+        return EAIP_COM_INVALID_MESSAGE;
+    }
+    return EAIP_COM_NO_ERROR;
+}
+
+eaipCommunicationErrorCodes eaipParseDataVector(const char *data, size_t length, float *values,
+                                                size_t capacity, size_t *count) {
+    *count = 0;
+    if (length == 0) {
+        return EAIP_COM_NO_ERROR;
+    }
+
+    size_t index = 0;
+    while (true) {
+        if (*count == capacity) {
+            return EAIP_COM_MESSAGE_TO_LONG;
+        }
+
+        size_t consumed = eaipScanFloat(data + index, length - index, &values[*count]);
+        if (consumed == 0) {
+            return EAIP_COM_INVALID_MESSAGE;
+        }
+        (*count)++;
+        index += consumed;
+
+        if (index == length) {
+            return EAIP_COM_NO_ERROR;
+        }
+        if (data[index] != ',' || index + 1 == length) {
+            return EAIP_COM_INVALID_MESSAGE;
+        }
+        index++;
+    }
+}
+
+/* endregion DATA */
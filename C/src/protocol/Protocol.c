@@ -1,60 +1,118 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "eaip/protocol/Buffer.h"
+#include "eaip/protocol/Number.h"
 #include "eaip/protocol/Parser.h"
 #include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Transport.h"
 
 /* region PUBLISH */
 
+/*! @brief publish `<baseUrl>/<deviceId>` of the requester, the message of START and STOP */
+static eaipCommunicationErrorCodes publishRequester(const eaiProtocol_t *config, char *topic) {
+    size_t length = strlen(config->baseUrl) + 1 + strlen(config->deviceId);
+    REQUESTER_BUFFER(requester, length + 1);
+    snprintf(requester, length + 1, "%s/%s", config->baseUrl, config->deviceId);
+
+    return transportPublish(config, topic, requester, false);
+}
+
 eaipCommunicationErrorCodes eaipPublishStatus(eaiProtocol_t config, eaipDeviceState_t status) {
-    char topic[getTopicLength(STATUS, config.baseUrl, config.deviceId, NULL)];
+    TOPIC_BUFFER(topic, getTopicLength(STATUS, config.baseUrl, config.deviceId, NULL));
     parseTopic(topic, STATUS, config.baseUrl, config.deviceId, NULL);
 
-    char data[getStatusLength(config.deviceId, status)];
-    parseStatus(data, config.deviceId, status);
-
-    return config.publish(topic, data, true);
+    char buffer[EAIP_STATUS_BUFFER_SIZE];
+    char *data = serializeStatus(buffer, sizeof(buffer), config.deviceId, status);
+    if (data == NULL) {
+        return SERIALIZATION_FAILED;
+    }
+
+    eaipCommunicationErrorCodes result = transportPublish(&config, topic, data, true);
+    if (data != buffer) {
+        free(data);
+    }
+    return result;
 }
 
 eaipCommunicationErrorCodes eaipPublishData(eaiProtocol_t config, eaipPubRequest_t request) {
-    char topic[getTopicLength(DATA, config.baseUrl, config.deviceId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(DATA, config.baseUrl, config.deviceId, request.dataId));
+    parseTopic(topic, DATA, config.baseUrl, config.deviceId, request.dataId);
+
+    return transportPublish(&config, topic, request.data, false);
+}
+
+eaipCommunicationErrorCodes eaipPublishDataBinary(eaiProtocol_t config, eaipPubRequest_t request) {
+    if (!transportHasPublishBinary(&config)) {
+        return EAIP_COM_NOT_SUPPORTED;
+    }
+
+    TOPIC_BUFFER(topic, getTopicLength(DATA, config.baseUrl, config.deviceId, request.dataId));
     parseTopic(topic, DATA, config.baseUrl, config.deviceId, request.dataId);
 
-    return config.publish(topic, request.data, false);
+    return transportPublishBinary(&config, topic, (const uint8_t *)request.data, request.length,
+                                  false);
+}
+
+eaipCommunicationErrorCodes eaipPublishDataFloat(eaiProtocol_t config, char *dataId, float value) {
+    char data[EAIP_NUMBER_BUFFER_SIZE];
+    eaipFormatFloat(data, value);
+
+    eaipPubRequest_t request = {.dataId = dataId, .data = data};
+    return eaipPublishData(config, request);
+}
+
+eaipCommunicationErrorCodes eaipPublishDataInt(eaiProtocol_t config, char *dataId, int32_t value) {
+    char data[EAIP_NUMBER_BUFFER_SIZE];
+    eaipFormatInt(data, value);
+
+    eaipPubRequest_t request = {.dataId = dataId, .data = data};
+    return eaipPublishData(config, request);
+}
+
+eaipCommunicationErrorCodes eaipPublishDataVector(eaiProtocol_t config, char *dataId,
+                                                  const float *values, size_t count) {
+    char buffer[EAIP_DATA_BUFFER_SIZE];
+    char *data = serializeFloatVector(buffer, sizeof(buffer), values, count);
+    if (data == NULL) {
+        return SERIALIZATION_FAILED;
+    }
+
+    eaipPubRequest_t request = {.dataId = dataId, .data = data};
+    eaipCommunicationErrorCodes result = eaipPublishData(config, request);
+    if (data != buffer) {
+        free(data);
+    }
+    return result;
 }
 
 eaipCommunicationErrorCodes eaipPublishStart(eaiProtocol_t config, eaipPubRequest_t request) {
-    char topic[getTopicLength(START, config.baseUrl, request.deviceId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(START, config.baseUrl, request.deviceId, request.dataId));
     parseTopic(topic, START, config.baseUrl, request.deviceId, request.dataId);
 
-    char data[strlen(config.baseUrl) + strlen(config.deviceId) + 2];
-    sprintf(data, "%s/%s", config.baseUrl, config.deviceId);
-
-    return config.publish(topic, data, false);
+    return publishRequester(&config, topic);
 }
 
 eaipCommunicationErrorCodes eaipPublishStop(eaiProtocol_t config, eaipPubRequest_t request) {
-    char topic[getTopicLength(STOP, config.baseUrl, request.deviceId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(STOP, config.baseUrl, request.deviceId, request.dataId));
     parseTopic(topic, STOP, config.baseUrl, request.deviceId, request.dataId);
 
-    char data[strlen(config.baseUrl) + strlen(config.deviceId) + 2];
-    sprintf(data, "%s/%s", config.baseUrl, config.deviceId);
-
-    return config.publish(topic, data, false);
+    return publishRequester(&config, topic);
 }
 
 eaipCommunicationErrorCodes eaipPublishDo(eaiProtocol_t config, eaipPubRequest_t request) {
-    char topic[getTopicLength(DO, config.baseUrl, request.deviceId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(DO, config.baseUrl, request.deviceId, request.dataId));
     parseTopic(topic, DO, config.baseUrl, request.deviceId, request.dataId);
 
-    return config.publish(topic, request.data, false);
+    return transportPublish(&config, topic, request.data, false);
 }
 
 eaipCommunicationErrorCodes eaipPublishDone(eaiProtocol_t config, eaipPubRequest_t request) {
-    char topic[getTopicLength(DONE, config.baseUrl, config.deviceId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(DONE, config.baseUrl, config.deviceId, request.dataId));
     parseTopic(topic, DONE, config.baseUrl, config.deviceId, request.dataId);
 
-    return config.publish(topic, request.data, false);
+    return transportPublish(&config, topic, request.data, false);
 }
 
 /* endregion PUBLISH */
@@ -62,45 +120,120 @@ eaipCommunicationErrorCodes eaipPublishDone(eaiProtocol_t config, eaipPubRequest
 /* region SUBSCRIBE */
 
 eaipCommunicationErrorCodes eaipSubscribeStatus(eaiProtocol_t config, eaipSubRequest_t request) {
-    char topic[getTopicLength(STATUS, config.baseUrl, request.targetId, NULL)];
+    TOPIC_BUFFER(topic, getTopicLength(STATUS, config.baseUrl, request.targetId, NULL));
     parseTopic(topic, STATUS, config.baseUrl, request.targetId, NULL);
 
-    return config.subscribe(topic, request.handler);
+    return transportSubscribe(&config, topic, request.handler);
 }
 
 eaipCommunicationErrorCodes eaipSubscribeData(eaiProtocol_t config, eaipSubRequest_t request) {
-    char topic[getTopicLength(DATA, config.baseUrl, request.targetId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(DATA, config.baseUrl, request.targetId, request.dataId));
+    parseTopic(topic, DATA, config.baseUrl, request.targetId, request.dataId);
+
+    return transportSubscribe(&config, topic, request.handler);
+}
+
+eaipCommunicationErrorCodes eaipSubscribeDataBinary(eaiProtocol_t config,
+                                                    eaipSubRequest_t request) {
+    if (!transportHasSubscribeBinary(&config)) {
+        return EAIP_COM_NOT_SUPPORTED;
+    }
+
+    TOPIC_BUFFER(topic, getTopicLength(DATA, config.baseUrl, request.targetId, request.dataId));
     parseTopic(topic, DATA, config.baseUrl, request.targetId, request.dataId);
 
-    return config.subscribe(topic, request.handler);
+    return transportSubscribeBinary(&config, topic, request.binaryHandler);
 }
 
 eaipCommunicationErrorCodes eaipSubscribeStart(eaiProtocol_t config, eaipSubRequest_t request) {
-    char topic[getTopicLength(START, config.baseUrl, config.deviceId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(START, config.baseUrl, config.deviceId, request.dataId));
     parseTopic(topic, START, config.baseUrl, config.deviceId, request.dataId);
 
-    return config.subscribe(topic, request.handler);
+    return transportSubscribe(&config, topic, request.handler);
 }
 
 eaipCommunicationErrorCodes eaipSubscribeStop(eaiProtocol_t config, eaipSubRequest_t request) {
-    char topic[getTopicLength(STOP, config.baseUrl, config.deviceId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(STOP, config.baseUrl, config.deviceId, request.dataId));
     parseTopic(topic, STOP, config.baseUrl, config.deviceId, request.dataId);
 
-    return config.subscribe(topic, request.handler);
+    return transportSubscribe(&config, topic, request.handler);
 }
 
 eaipCommunicationErrorCodes eaipSubscribeDo(eaiProtocol_t config, eaipSubRequest_t request) {
-    char topic[getTopicLength(DO, config.baseUrl, config.deviceId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(DO, config.baseUrl, config.deviceId, request.dataId));
     parseTopic(topic, DO, config.baseUrl, config.deviceId, request.dataId);
 
-    return config.subscribe(topic, request.handler);
+    return transportSubscribe(&config, topic, request.handler);
 }
 
 eaipCommunicationErrorCodes eaipSubscribeDone(eaiProtocol_t config, eaipSubRequest_t request) {
-    char topic[getTopicLength(DONE, config.baseUrl, request.targetId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(DONE, config.baseUrl, request.targetId, request.dataId));
     parseTopic(topic, DONE, config.baseUrl, request.targetId, request.dataId);
 
-    return config.subscribe(topic, request.handler);
+    return transportSubscribe(&config, topic, request.handler);
+}
+
+/*! @brief device of the topic, the own device for requests and commands sent to it */
+static char *getViewDevice(const eaiProtocol_t *config, topic_t type,
+                           const eaipSubRequest_t *request) {
+    return (type == START || type == STOP || type == DO) ? config->deviceId : request->targetId;
+}
+
+static void dispatchView(void *userData, const char *topic, size_t topicLength,
+                         const uint8_t *payload, size_t length) {
+    const eaipViewSubscription_t *subscription = userData;
+    const char *deviceId = topic + subscription->deviceIdStart;
+    size_t remaining = topicLength - subscription->deviceIdStart;
+
+    size_t deviceIdLength = subscription->deviceIdLength;
+    if (subscription->anyDevice && !subscription->anyDataId) {
+        deviceIdLength = remaining - subscription->suffixLength;
+    } else if (subscription->anyDevice) {
+        const char *end = memchr(deviceId, '/', remaining);
+        deviceIdLength = end != NULL ? (size_t)(end - deviceId) : remaining;
+    }
+
+    eaipMessageView_t message = {
+        .topic = {topic, topicLength},
+        .type = subscription->type,
+        .deviceId = {deviceId, deviceIdLength},
+        .dataId = {topic + topicLength, 0},
+        .payload = payload,
+        .length = length,
+    };
+    size_t dataIdStart = deviceIdLength + getTopicNameLength(subscription->type) + 2;
+    /* `<deviceId>/<TYPE>/#` also matches its parent topic, which has no data-ID */
+    if (subscription->type != STATUS && dataIdStart <= remaining) {
+        message.dataId.data = deviceId + dataIdStart;
+        message.dataId.length = remaining - dataIdStart;
+    }
+    subscription->handler(&message, subscription->userData);
+}
+
+eaipCommunicationErrorCodes eaipSubscribeView(eaiProtocol_t config, topic_t type,
+                                              eaipSubRequest_t request,
+                                              eaipViewSubscription_t *subscription) {
+    if (!transportHasSubscribeView(&config)) {
+        return EAIP_COM_NOT_SUPPORTED;
+    }
+
+    char *deviceId = getViewDevice(&config, type, &request);
+    char *dataId = type == STATUS ? NULL : request.dataId;
+    TOPIC_BUFFER(topic, getTopicLength(type, config.baseUrl, deviceId, dataId));
+    parseTopic(topic, type, config.baseUrl, deviceId, dataId);
+
+    size_t nameLength = getTopicNameLength(type);
+    *subscription = (eaipViewSubscription_t){
+        .handler = request.viewHandler,
+        .userData = request.userData,
+        .type = type,
+        .deviceIdStart = strlen(config.baseUrl) + 1,
+        .deviceIdLength = strlen(deviceId),
+        .suffixLength = dataId == NULL ? nameLength + 1 : nameLength + strlen(dataId) + 2,
+        .anyDevice = 0 == strcmp(deviceId, "+"),
+        .anyDataId = dataId != NULL && (0 == strcmp(dataId, "+") || 0 == strcmp(dataId, "#")),
+    };
+    return transportSubscribeView(&config, topic, &dispatchView, subscription);
 }
 
 /* endregion SUBSCRIBE */
@@ -108,45 +241,55 @@ eaipCommunicationErrorCodes eaipSubscribeDone(eaiProtocol_t config, eaipSubReque
 /* region UNSUBSCRIBE */
 
 eaipCommunicationErrorCodes eaipUnsubscribeStatus(eaiProtocol_t config, eaipSubRequest_t request) {
-    char topic[getTopicLength(STATUS, config.baseUrl, request.targetId, NULL)];
+    TOPIC_BUFFER(topic, getTopicLength(STATUS, config.baseUrl, request.targetId, NULL));
     parseTopic(topic, STATUS, config.baseUrl, request.targetId, NULL);
 
-    return config.unsubscribe(topic);
+    return transportUnsubscribe(&config, topic);
 }
 
 eaipCommunicationErrorCodes eaipUnsubscribeData(eaiProtocol_t config, eaipSubRequest_t request) {
-    char topic[getTopicLength(DATA, config.baseUrl, request.targetId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(DATA, config.baseUrl, request.targetId, request.dataId));
     parseTopic(topic, DATA, config.baseUrl, request.targetId, request.dataId);
 
-    return config.unsubscribe(topic);
+    return transportUnsubscribe(&config, topic);
 }
 
 eaipCommunicationErrorCodes eaipUnsubscribeStart(eaiProtocol_t config, eaipSubRequest_t request) {
-    char topic[getTopicLength(START, config.baseUrl, config.deviceId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(START, config.baseUrl, config.deviceId, request.dataId));
     parseTopic(topic, START, config.baseUrl, config.deviceId, request.dataId);
 
-    return config.unsubscribe(topic);
+    return transportUnsubscribe(&config, topic);
 }
 
 eaipCommunicationErrorCodes eaipUnsubscribeStop(eaiProtocol_t config, eaipSubRequest_t request) {
-    char topic[getTopicLength(STOP, config.baseUrl, config.deviceId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(STOP, config.baseUrl, config.deviceId, request.dataId));
     parseTopic(topic, STOP, config.baseUrl, config.deviceId, request.dataId);
 
-    return config.unsubscribe(topic);
+    return transportUnsubscribe(&config, topic);
 }
 
 eaipCommunicationErrorCodes eaipUnsubscribeDo(eaiProtocol_t config, eaipSubRequest_t request) {
-    char topic[getTopicLength(DO, config.baseUrl, config.deviceId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(DO, config.baseUrl, config.deviceId, request.dataId));
     parseTopic(topic, DO, config.baseUrl, config.deviceId, request.dataId);
 
-    return config.unsubscribe(topic);
+    return transportUnsubscribe(&config, topic);
 }
 
 eaipCommunicationErrorCodes eaipUnsubscribeDone(eaiProtocol_t config, eaipSubRequest_t request) {
-    char topic[getTopicLength(DONE, config.baseUrl, request.targetId, request.dataId)];
+    TOPIC_BUFFER(topic, getTopicLength(DONE, config.baseUrl, request.targetId, request.dataId));
     parseTopic(topic, DONE, config.baseUrl, request.targetId, request.dataId);
 
-    return config.unsubscribe(topic);
+    return transportUnsubscribe(&config, topic);
+}
+
+eaipCommunicationErrorCodes eaipUnsubscribeView(eaiProtocol_t config, topic_t type,
+                                                eaipSubRequest_t request) {
+    char *deviceId = getViewDevice(&config, type, &request);
+    char *dataId = type == STATUS ? NULL : request.dataId;
+    TOPIC_BUFFER(topic, getTopicLength(type, config.baseUrl, deviceId, dataId));
+    parseTopic(topic, type, config.baseUrl, deviceId, dataId);
+
+    return transportUnsubscribe(&config, topic);
 }
 
 /* endregion UNSUBSCRIBE */
@@ -0,0 +1,209 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/protocol/Hash.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Provider.h"
+#include "eaip/protocol/Router.h"
+#include "eaip/protocol/Session.h"
+#include "eaip/protocol/Transport.h"
+
+/* region CONSUMERS */
+
+/* every stream lists its consumers, unused entries are chained through `next` */
+
+static eaipConsumer_t *findConsumer(const eaipStream_t *stream, uint32_t hash,
+                                    const char *requester) {
+    for (eaipConsumer_t *consumer = stream->firstConsumer; consumer != NULL;
+         consumer = consumer->next) {
+        if (consumer->hash == hash && 0 == strcmp(consumer->requester, requester)) {
+            return consumer;
+        }
+    }
+    return NULL;
+}
+
+static eaipConsumer_t *takeUnusedConsumer(eaipProvider_t *provider) {
+    eaipConsumer_t *consumer = provider->unusedConsumers;
+    if (consumer != NULL) {
+        provider->unusedConsumers = consumer->next;
+    }
+    return consumer;
+}
+
+static void addConsumer(eaipStream_t *stream, eaipConsumer_t *consumer) {
+    consumer->previous = NULL;
+    consumer->next = stream->firstConsumer;
+    if (stream->firstConsumer != NULL) {
+        stream->firstConsumer->previous = consumer;
+    }
+    stream->firstConsumer = consumer;
+    stream->consumers++;
+}
+
+static void removeConsumer(eaipConsumer_t *consumer) {
+    eaipStream_t *stream = consumer->stream;
+    eaipProvider_t *provider = stream->provider;
+    if (consumer->previous != NULL) {
+        consumer->previous->next = consumer->next;
+    } else {
+        stream->firstConsumer = consumer->next;
+    }
+    if (consumer->next != NULL) {
+        consumer->next->previous = consumer->previous;
+    }
+    stream->consumers--;
+    free(consumer->requester);
+
+    *consumer = (eaipConsumer_t){.next = provider->unusedConsumers};
+    provider->unusedConsumers = consumer;
+}
+
+static void handleStart(__attribute__((unused)) const eaipTopicView_t *topic, char *message,
+                        void *userData) {
+    eaipStream_t *stream = userData;
+    eaipProvider_t *provider = stream->provider;
+    uint32_t hash = hashUpdate32(FNV32_OFFSET_BASIS, message, strlen(message));
+
+    eaipConsumer_t *consumer = findConsumer(stream, hash, message);
+    if (consumer != NULL) {
+        consumer->references++;
+        return;
+    }
+
+    /* without room to track the requester its STOP could not be matched, so it is ignored */
+    if (provider->unusedConsumers == NULL) {
+        return;
+    }
+    char *requester = calloc(strlen(message) + 1, sizeof(char));
+    if (requester == NULL) {
+        return;
+    }
+    strcpy(requester, message);
+
+    consumer = takeUnusedConsumer(provider);
+    *consumer = (eaipConsumer_t){
+        .stream = stream,
+        .hash = hash,
+        .requester = requester,
+        .references = 1,
+    };
+    addConsumer(stream, consumer);
+}
+
+static void handleStop(__attribute__((unused)) const eaipTopicView_t *topic, char *message,
+                       void *userData) {
+    eaipStream_t *stream = userData;
+    uint32_t hash = hashUpdate32(FNV32_OFFSET_BASIS, message, strlen(message));
+
+    eaipConsumer_t *consumer = findConsumer(stream, hash, message);
+    if (consumer != NULL && --consumer->references == 0) {
+        removeConsumer(consumer);
+    }
+}
+
+/* endregion CONSUMERS */
+
+eaipCommunicationErrorCodes eaipProviderInit(eaipProvider_t *provider, eaipRouter_t *router,
+                                             size_t streamCapacity, size_t consumerCapacity) {
+    eaipStream_t *streams = calloc(streamCapacity, sizeof(eaipStream_t));
+    eaipConsumer_t *consumers = calloc(consumerCapacity, sizeof(eaipConsumer_t));
+    if ((streamCapacity > 0 && streams == NULL) || (consumerCapacity > 0 && consumers == NULL)) {
+        free(streams);
+        free(consumers);
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    provider->router = router;
+    provider->streams = streams;
+    provider->streamCapacity = streamCapacity;
+    provider->consumers = consumers;
+    provider->consumerCapacity = consumerCapacity;
+    provider->unusedConsumers = NULL;
+    for (size_t index = consumerCapacity; index > 0; index--) {
+        consumers[index - 1].next = provider->unusedConsumers;
+        provider->unusedConsumers = &consumers[index - 1];
+    }
+    return EAIP_COM_NO_ERROR;
+}
+
+void eaipProviderFree(eaipProvider_t *provider) {
+    for (size_t index = 0; index < provider->streamCapacity; index++) {
+        if (provider->streams[index].dataId != NULL) {
+            eaipProviderUnregister(provider, &provider->streams[index]);
+        }
+    }
+    free(provider->streams);
+    free(provider->consumers);
+    memset(provider, 0, sizeof(eaipProvider_t));
+}
+
+eaipCommunicationErrorCodes eaipProviderRegister(eaipProvider_t *provider, const char *dataId,
+                                                 eaipStream_t **stream) {
+    eaipStream_t *entry = NULL;
+    for (size_t index = 0; index < provider->streamCapacity && entry == NULL; index++) {
+        if (provider->streams[index].dataId == NULL) {
+            entry = &provider->streams[index];
+        }
+    }
+    if (entry == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    const eaipSession_t *session = provider->router->session;
+    size_t dataIdLength = strlen(dataId);
+    size_t prefixLength = session->prefixLengths[DATA];
+
+    /* layout: `<dataId>\0` followed by `<baseUrl>/<deviceId>/DATA/<dataId>\0` */
+    char *buffer = calloc(2 * dataIdLength + prefixLength + 2, sizeof(char));
+    if (buffer == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+    memcpy(buffer, dataId, dataIdLength);
+    char *topic = buffer + dataIdLength + 1;
+    memcpy(topic, session->prefixes[DATA], prefixLength);
+    memcpy(topic + prefixLength, dataId, dataIdLength);
+
+    eaipCommunicationErrorCodes result =
+        eaipRouterRegister(provider->router, START, dataId, &handleStart, entry);
+    if (result != EAIP_COM_NO_ERROR) {
+        free(buffer);
+        return result;
+    }
+    result = eaipRouterRegister(provider->router, STOP, dataId, &handleStop, entry);
+    if (result != EAIP_COM_NO_ERROR) {
+        eaipRouterUnregister(provider->router, START, dataId);
+        free(buffer);
+        return result;
+    }
+
+    *entry = (eaipStream_t){
+        .provider = provider,
+        .dataId = buffer,
+        .topic = topic,
+        .consumers = 0,
+        .firstConsumer = NULL,
+    };
+    *stream = entry;
+    return EAIP_COM_NO_ERROR;
+}
+
+void eaipProviderUnregister(eaipProvider_t *provider, eaipStream_t *stream) {
+    eaipRouterUnregister(provider->router, START, stream->dataId);
+    eaipRouterUnregister(provider->router, STOP, stream->dataId);
+
+    while (stream->firstConsumer != NULL) {
+        removeConsumer(stream->firstConsumer);
+    }
+
+    free(stream->dataId);
+    memset(stream, 0, sizeof(eaipStream_t));
+}
+
+eaipCommunicationErrorCodes eaipProviderPublishData(const eaipProvider_t *provider,
+                                                    const eaipStream_t *stream, char *data) {
+    if (stream->consumers == 0) {
+        return EAIP_COM_NO_ERROR;
+    }
+    return transportPublish(&provider->router->session->config, stream->topic, data, false);
+}
@@ -0,0 +1,174 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/protocol/Buffer.h"
+#include "eaip/protocol/Hash.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Router.h"
+#include "eaip/protocol/Session.h"
+#include "eaip/protocol/Transport.h"
+
+/* region ROUTING TABLE */
+
+static uint32_t hashRoute(topic_t type, const char *dataId, size_t dataIdLength) {
+    uint32_t hash = hashUpdate32(FNV32_OFFSET_BASIS, dataId, dataIdLength);
+    return (hash ^ (uint32_t)type) * FNV32_PRIME;
+}
+
+static eaipRoute_t *findRoute(const eaipRouter_t *router, uint32_t hash, topic_t type,
+                              const char *dataId, size_t dataIdLength) {
+    size_t mask = router->tableSize - 1;
+    for (size_t index = hash & mask;; index = (index + 1) & mask) {
+        eaipRoute_t *route = &router->routes[index];
+        if (route->handler == NULL) {
+            return NULL;
+        }
+        if (route->hash == hash && route->type == type && route->dataIdLength == dataIdLength &&
+            0 == memcmp(route->dataId, dataId, dataIdLength)) {
+            return route;
+        }
+    }
+}
+
+static void removeRoute(eaipRouter_t *router, eaipRoute_t *route) {
+    size_t mask = router->tableSize - 1;
+    size_t hole = (size_t)(route - router->routes);
+
+    free(route->dataId);
+    memset(route, 0, sizeof(eaipRoute_t));
+
+    /* backward shift deletion: move following entries of the probe sequence into the hole */
+    for (size_t index = (hole + 1) & mask; router->routes[index].handler != NULL;
+         index = (index + 1) & mask) {
+        size_t home = router->routes[index].hash & mask;
+        if (((index - home) & mask) >= ((index - hole) & mask)) {
+            router->routes[hole] = router->routes[index];
+            memset(&router->routes[index], 0, sizeof(eaipRoute_t));
+            hole = index;
+        }
+    }
+}
+
+/* endregion ROUTING TABLE */
+
+eaipCommunicationErrorCodes eaipRouterInit(eaipRouter_t *router, const eaipSession_t *session,
+                                           size_t capacity) {
+    /* keep the load factor of the table below 75% */
+    size_t tableSize = 1;
+    while (tableSize < capacity + capacity / 3 + 1) {
+        tableSize <<= 1;
+    }
+
+    eaipRoute_t *routes = calloc(tableSize, sizeof(eaipRoute_t));
+    if (routes == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    router->session = session;
+    router->routes = routes;
+    router->tableSize = tableSize;
+    router->capacity = capacity;
+    router->count = 0;
+    return EAIP_COM_NO_ERROR;
+}
+
+void eaipRouterFree(eaipRouter_t *router) {
+    for (size_t index = 0; index < router->tableSize; index++) {
+        free(router->routes[index].dataId);
+    }
+    free(router->routes);
+    memset(router, 0, sizeof(eaipRouter_t));
+}
+
+eaipCommunicationErrorCodes eaipRouterRegister(eaipRouter_t *router, topic_t type,
+                                               const char *dataId, eaipRouteHandler handler,
+                                               void *userData) {
+    if (dataId == NULL) {
+        dataId = "";
+    }
+    size_t dataIdLength = strlen(dataId);
+    uint32_t hash = hashRoute(type, dataId, dataIdLength);
+
+    if (findRoute(router, hash, type, dataId, dataIdLength) != NULL) {
+        return EAIP_COM_TOPIC_ALREADY_SUBSCRIBED;
+    }
+    if (router->count >= router->capacity) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    char *dataIdCopy = calloc(dataIdLength + 1, sizeof(char));
+    if (dataIdCopy == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+    if (dataIdLength > 0) {
+        memcpy(dataIdCopy, dataId, dataIdLength);
+    }
+
+    size_t mask = router->tableSize - 1;
+    size_t index = hash & mask;
+    while (router->routes[index].handler != NULL) {
+        index = (index + 1) & mask;
+    }
+    router->routes[index] = (eaipRoute_t){
+        .hash = hash,
+        .type = type,
+        .dataId = dataIdCopy,
+        .dataIdLength = dataIdLength,
+        .handler = handler,
+        .userData = userData,
+    };
+    router->count++;
+
+    return EAIP_COM_NO_ERROR;
+}
+
+eaipCommunicationErrorCodes eaipRouterUnregister(eaipRouter_t *router, topic_t type,
+                                                 const char *dataId) {
+    if (dataId == NULL) {
+        dataId = "";
+    }
+    size_t dataIdLength = strlen(dataId);
+    eaipRoute_t *route =
+        findRoute(router, hashRoute(type, dataId, dataIdLength), type, dataId, dataIdLength);
+
+    if (route != NULL) {
+        removeRoute(router, route);
+        router->count--;
+    }
+    return EAIP_COM_NO_ERROR;
+}
+
+eaipCommunicationErrorCodes eaipRouterSubscribe(const eaipRouter_t *router,
+                                                messageHandler handler) {
+    const eaipSession_t *session = router->session;
+    TOPIC_BUFFER(topic, session->requesterLength + 3);
+    memcpy(topic, session->requester, session->requesterLength);
+    memcpy(topic + session->requesterLength, "/#", 3);
+
+    return transportSubscribe(&session->config, topic, handler);
+}
+
+eaipCommunicationErrorCodes eaipRouterUnsubscribe(const eaipRouter_t *router) {
+    const eaipSession_t *session = router->session;
+    TOPIC_BUFFER(topic, session->requesterLength + 3);
+    memcpy(topic, session->requester, session->requesterLength);
+    memcpy(topic + session->requesterLength, "/#", 3);
+
+    return transportUnsubscribe(&session->config, topic);
+}
+
+bool eaipRouterDispatch(const eaipRouter_t *router, char *topic, char *message) {
+    eaipTopicView_t view;
+    if (EAIP_COM_NO_ERROR != eaipDecodeTopic(router->session, topic, strlen(topic), &view)) {
+        return false;
+    }
+
+    uint32_t hash = hashRoute(view.type, view.dataId.data, view.dataId.length);
+    eaipRoute_t *route = findRoute(router, hash, view.type, view.dataId.data, view.dataId.length);
+    if (route == NULL) {
+        return false;
+    }
+
+    route->handler(&view, message, route->userData);
+    return true;
+}
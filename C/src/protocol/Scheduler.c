@@ -0,0 +1,121 @@
+#include <string.h>
+
+#include "eaip/protocol/Outbox.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Scheduler.h"
+#include "eaip/protocol/Session.h"
+
+eaipCommunicationErrorCodes eaipSchedulerInit(eaipScheduler_t *scheduler, eaiProtocol_t config,
+                                              size_t controlCapacity, size_t recordSize) {
+    memset(scheduler, 0, sizeof(eaipScheduler_t));
+    scheduler->recordSize = recordSize;
+    return eaipOutboxInitMultiProducer(&scheduler->control, config, controlCapacity, recordSize,
+                                       EAIP_OVERFLOW_BLOCK);
+}
+
+void eaipSchedulerFree(eaipScheduler_t *scheduler) {
+    eaipOutboxFree(&scheduler->control);
+    for (size_t index = 0; index < scheduler->bulkLanes; index++) {
+        eaipOutboxFree(&scheduler->bulk[index].outbox);
+    }
+    memset(scheduler, 0, sizeof(eaipScheduler_t));
+}
+
+eaipCommunicationErrorCodes eaipSchedulerAddBulkLane(eaipScheduler_t *scheduler, size_t capacity,
+                                                     uint32_t weight, eaipOverflowPolicy_t policy,
+                                                     size_t *lane) {
+    if (scheduler->bulkLanes >= EAIP_SCHEDULER_BULK_LANES) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    eaipLane_t *entry = &scheduler->bulk[scheduler->bulkLanes];
+    eaipCommunicationErrorCodes result;
+    if (policy == EAIP_OVERFLOW_DROP_OLDEST) {
+        result = eaipOutboxInit(&entry->outbox, scheduler->control.config, capacity,
+                                scheduler->recordSize, policy);
+    } else {
+        result = eaipOutboxInitMultiProducer(&entry->outbox, scheduler->control.config, capacity,
+                                             scheduler->recordSize, policy);
+    }
+    if (result != EAIP_COM_NO_ERROR) {
+        return result;
+    }
+
+    entry->weight = weight > 0 ? weight : 1;
+    entry->deficit = 0;
+    *lane = scheduler->bulkLanes++;
+    return EAIP_COM_NO_ERROR;
+}
+
+eaipCommunicationErrorCodes eaipSchedulerPublishControl(eaipScheduler_t *scheduler,
+                                                        const char *topic, const char *message,
+                                                        bool retain) {
+    return eaipOutboxPublish(&scheduler->control, topic, message, retain);
+}
+
+eaipCommunicationErrorCodes eaipSchedulerPublishBulk(eaipScheduler_t *scheduler, size_t lane,
+                                                     const char *topic, const char *message) {
+    if (lane >= scheduler->bulkLanes) {
+        return EAIP_COM_GENERIC_ERROR;
+    }
+    return eaipOutboxPublish(&scheduler->bulk[lane].outbox, topic, message, false);
+}
+
+eaipCommunicationErrorCodes eaipSchedulerPublishData(eaipScheduler_t *scheduler, size_t lane,
+                                                     const eaipSession_t *session,
+                                                     eaipPubRequest_t request) {
+    if (lane >= scheduler->bulkLanes) {
+        return EAIP_COM_GENERIC_ERROR;
+    }
+    return eaipOutboxPublishData(&scheduler->bulk[lane].outbox, session, request);
+}
+
+static void endTurn(eaipScheduler_t *scheduler) {
+    scheduler->current = (scheduler->current + 1) % scheduler->bulkLanes;
+    scheduler->granted = false;
+}
+
+size_t eaipSchedulerDrain(eaipScheduler_t *scheduler, size_t limit) {
+    size_t published = 0;
+    size_t emptyLanes = 0;
+
+    while (published < limit) {
+        /* control messages preempt bulk messages */
+        size_t sent = eaipOutboxDrain(&scheduler->control, limit - published);
+        published += sent;
+        if (published >= limit || scheduler->bulkLanes == 0 ||
+            (sent == 0 && eaipOutboxPeekLength(&scheduler->control) > 0)) {
+            break;
+        }
+
+        eaipLane_t *lane = &scheduler->bulk[scheduler->current];
+        if (!scheduler->granted) {
+            lane->deficit += (size_t)lane->weight * EAIP_SCHEDULER_QUANTUM;
+            scheduler->granted = true;
+        }
+
+        size_t length = eaipOutboxPeekLength(&lane->outbox);
+        if (length == 0) {
+            /* an idle lane must not save up its share */
+            lane->deficit = 0;
+            endTurn(scheduler);
+            if (++emptyLanes >= scheduler->bulkLanes) {
+                break;
+            }
+            continue;
+        }
+        emptyLanes = 0;
+
+        if (length > lane->deficit) {
+            endTurn(scheduler);
+            continue;
+        }
+        if (0 == eaipOutboxDrain(&lane->outbox, 1)) {
+            break;
+        }
+        lane->deficit -= length;
+        published++;
+    }
+
+    return published;
+}
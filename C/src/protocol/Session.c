@@ -0,0 +1,369 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/protocol/Buffer.h"
+#include "eaip/protocol/Hash.h"
+#include "eaip/protocol/Number.h"
+#include "eaip/protocol/Parser.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Session.h"
+#include "eaip/protocol/Transport.h"
+
+/* region SESSION */
+
+eaipCommunicationErrorCodes eaipSessionInit(eaipSession_t *session, eaiProtocol_t config) {
+    size_t baseUrlLength = strlen(config.baseUrl);
+    size_t deviceIdLength = strlen(config.deviceId);
+    size_t requesterLength = baseUrlLength + deviceIdLength + 1;
+
+    /* layout: `<baseUrl>/<deviceId>\0` followed by `<baseUrl>/<deviceId>/<TYPE>/\0` per type */
+    size_t bufferLength = requesterLength + 1;
+    for (topic_t topic = STATUS; topic <= DONE; topic++) {
+        bufferLength += requesterLength + getTopicNameLength(topic) + 3;
+    }
+
+    char *buffer = calloc(bufferLength, sizeof(char));
+    if (buffer == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    session->config = config;
+    session->requester = buffer;
+    session->requesterLength = requesterLength;
+    session->baseUrlLength = baseUrlLength + 1;
+    session->statusDigest = 0;
+    session->statusPublished = false;
+
+    memcpy(buffer, config.baseUrl, baseUrlLength);
+    buffer[baseUrlLength] = '/';
+    memcpy(buffer + baseUrlLength + 1, config.deviceId, deviceIdLength);
+
+    char *cursor = buffer + requesterLength + 1;
+    for (topic_t topic = STATUS; topic <= DONE; topic++) {
+        char *prefix = cursor;
+
+        memcpy(cursor, session->requester, requesterLength);
+        cursor += requesterLength;
+        *cursor++ = '/';
+        memcpy(cursor, getTopicName(topic), getTopicNameLength(topic));
+        cursor += getTopicNameLength(topic);
+        if (topic != STATUS) {
+            *cursor++ = '/';
+        }
+
+        session->prefixes[topic] = prefix;
+        session->prefixLengths[topic] = (size_t)(cursor - prefix);
+        cursor++; /* keep the terminating `\0` */
+    }
+
+    return EAIP_COM_NO_ERROR;
+}
+
+void eaipSessionFree(eaipSession_t *session) {
+    free(session->requester);
+    memset(session, 0, sizeof(eaipSession_t));
+}
+
+/* endregion SESSION */
+
+/* region PUBLISH */
+
+eaipCommunicationErrorCodes eaipSessionPublishStatus(eaipSession_t *session,
+                                                     eaipDeviceState_t status) {
+    char buffer[EAIP_STATUS_BUFFER_SIZE];
+    char *data = serializeStatus(buffer, sizeof(buffer), session->config.deviceId, status);
+    if (data == NULL) {
+        return SERIALIZATION_FAILED;
+    }
+
+    uint64_t digest = hashUpdate64(FNV64_OFFSET_BASIS, data, strlen(data));
+    eaipCommunicationErrorCodes result = EAIP_COM_NO_ERROR;
+    if (!session->statusPublished || session->statusDigest != digest) {
+        result = transportPublish(&session->config, session->prefixes[STATUS], data, true);
+        if (result == EAIP_COM_NO_ERROR) {
+            session->statusDigest = digest;
+            session->statusPublished = true;
+        }
+    }
+
+    if (data != buffer) {
+        free(data);
+    }
+    return result;
+}
+
+eaipCommunicationErrorCodes eaipSessionUpdateStatusField(eaipSession_t *session,
+                                                         eaipDeviceState_t status, const char *id,
+                                                         char *data) {
+    eaipStateDataField_t *field = status.additionalFields;
+    while (field != NULL && strcmp(field->id, id) != 0) {
+        field = field->next;
+    }
+    if (field == NULL) {
+        return EAIP_COM_INVALID_MESSAGE;
+    }
+
+    field->data = data;
+    return eaipSessionPublishStatus(session, status);
+}
+
+void eaipSessionInvalidateStatus(eaipSession_t *session) {
+    session->statusPublished = false;
+}
+
+eaipCommunicationErrorCodes eaipSessionPublishData(const eaipSession_t *session,
+                                                   eaipPubRequest_t request) {
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getOwnTopicLength(session, DATA, dataIdLength));
+    parseOwnTopic(topic, session, DATA, request.dataId, dataIdLength);
+
+    return transportPublish(&session->config, topic, request.data, false);
+}
+
+eaipCommunicationErrorCodes eaipSessionPublishDataFloat(const eaipSession_t *session,
+                                                        char *dataId, float value) {
+    char data[EAIP_NUMBER_BUFFER_SIZE];
+    eaipFormatFloat(data, value);
+
+    eaipPubRequest_t request = {.dataId = dataId, .data = data};
+    return eaipSessionPublishData(session, request);
+}
+
+eaipCommunicationErrorCodes eaipSessionPublishDataInt(const eaipSession_t *session, char *dataId,
+                                                      int32_t value) {
+    char data[EAIP_NUMBER_BUFFER_SIZE];
+    eaipFormatInt(data, value);
+
+    eaipPubRequest_t request = {.dataId = dataId, .data = data};
+    return eaipSessionPublishData(session, request);
+}
+
+eaipCommunicationErrorCodes eaipSessionPublishDataVector(const eaipSession_t *session,
+                                                         char *dataId, const float *values,
+                                                         size_t count) {
+    char buffer[EAIP_DATA_BUFFER_SIZE];
+    char *data = serializeFloatVector(buffer, sizeof(buffer), values, count);
+    if (data == NULL) {
+        return SERIALIZATION_FAILED;
+    }
+
+    eaipPubRequest_t request = {.dataId = dataId, .data = data};
+    eaipCommunicationErrorCodes result = eaipSessionPublishData(session, request);
+    if (data != buffer) {
+        free(data);
+    }
+    return result;
+}
+
+eaipCommunicationErrorCodes eaipSessionPublishDataBinary(const eaipSession_t *session,
+                                                         eaipPubRequest_t request) {
+    if (!transportHasPublishBinary(&session->config)) {
+        return EAIP_COM_NOT_SUPPORTED;
+    }
+
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getOwnTopicLength(session, DATA, dataIdLength));
+    parseOwnTopic(topic, session, DATA, request.dataId, dataIdLength);
+
+    return transportPublishBinary(&session->config, topic, (const uint8_t *)request.data,
+                                  request.length, false);
+}
+
+eaipCommunicationErrorCodes eaipSessionPublishDataFloatArray(const eaipSession_t *session,
+                                                             char *dataId, const float *values,
+                                                             size_t count) {
+    eaipPubRequest_t request = {
+        .dataId = dataId, .data = (char *)values, .length = count * sizeof(float)};
+    return eaipSessionPublishDataBinary(session, request);
+}
+
+eaipCommunicationErrorCodes eaipSessionPublishDataInt16Array(const eaipSession_t *session,
+                                                             char *dataId, const int16_t *values,
+                                                             size_t count) {
+    eaipPubRequest_t request = {
+        .dataId = dataId, .data = (char *)values, .length = count * sizeof(int16_t)};
+    return eaipSessionPublishDataBinary(session, request);
+}
+
+eaipCommunicationErrorCodes eaipSessionPublishStart(const eaipSession_t *session,
+                                                    eaipPubRequest_t request) {
+    size_t deviceIdLength = strlen(request.deviceId);
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getForeignTopicLength(session, START, deviceIdLength, dataIdLength));
+    parseForeignTopic(topic, session, START, request.deviceId, deviceIdLength, request.dataId,
+                      dataIdLength);
+
+    return transportPublish(&session->config, topic, session->requester, false);
+}
+
+eaipCommunicationErrorCodes eaipSessionPublishStop(const eaipSession_t *session,
+                                                   eaipPubRequest_t request) {
+    size_t deviceIdLength = strlen(request.deviceId);
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getForeignTopicLength(session, STOP, deviceIdLength, dataIdLength));
+    parseForeignTopic(topic, session, STOP, request.deviceId, deviceIdLength, request.dataId,
+                      dataIdLength);
+
+    return transportPublish(&session->config, topic, session->requester, false);
+}
+
+eaipCommunicationErrorCodes eaipSessionPublishDo(const eaipSession_t *session,
+                                                 eaipPubRequest_t request) {
+    size_t deviceIdLength = strlen(request.deviceId);
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getForeignTopicLength(session, DO, deviceIdLength, dataIdLength));
+    parseForeignTopic(topic, session, DO, request.deviceId, deviceIdLength, request.dataId,
+                      dataIdLength);
+
+    return transportPublish(&session->config, topic, request.data, false);
+}
+
+eaipCommunicationErrorCodes eaipSessionPublishDone(const eaipSession_t *session,
+                                                   eaipPubRequest_t request) {
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getOwnTopicLength(session, DONE, dataIdLength));
+    parseOwnTopic(topic, session, DONE, request.dataId, dataIdLength);
+
+    return transportPublish(&session->config, topic, request.data, false);
+}
+
+/* endregion PUBLISH */
+
+/* region SUBSCRIBE */
+
+eaipCommunicationErrorCodes eaipSessionSubscribeStatus(const eaipSession_t *session,
+                                                       eaipSubRequest_t request) {
+    size_t targetIdLength = strlen(request.targetId);
+    TOPIC_BUFFER(topic, getForeignTopicLength(session, STATUS, targetIdLength, 0));
+    parseForeignTopic(topic, session, STATUS, request.targetId, targetIdLength, NULL, 0);
+
+    return transportSubscribe(&session->config, topic, request.handler);
+}
+
+eaipCommunicationErrorCodes eaipSessionSubscribeData(const eaipSession_t *session,
+                                                     eaipSubRequest_t request) {
+    size_t targetIdLength = strlen(request.targetId);
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getForeignTopicLength(session, DATA, targetIdLength, dataIdLength));
+    parseForeignTopic(topic, session, DATA, request.targetId, targetIdLength, request.dataId,
+                      dataIdLength);
+
+    return transportSubscribe(&session->config, topic, request.handler);
+}
+
+eaipCommunicationErrorCodes eaipSessionSubscribeDataBinary(const eaipSession_t *session,
+                                                           eaipSubRequest_t request) {
+    if (!transportHasSubscribeBinary(&session->config)) {
+        return EAIP_COM_NOT_SUPPORTED;
+    }
+
+    size_t targetIdLength = strlen(request.targetId);
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getForeignTopicLength(session, DATA, targetIdLength, dataIdLength));
+    parseForeignTopic(topic, session, DATA, request.targetId, targetIdLength, request.dataId,
+                      dataIdLength);
+
+    return transportSubscribeBinary(&session->config, topic, request.binaryHandler);
+}
+
+eaipCommunicationErrorCodes eaipSessionSubscribeStart(const eaipSession_t *session,
+                                                      eaipSubRequest_t request) {
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getOwnTopicLength(session, START, dataIdLength));
+    parseOwnTopic(topic, session, START, request.dataId, dataIdLength);
+
+    return transportSubscribe(&session->config, topic, request.handler);
+}
+
+eaipCommunicationErrorCodes eaipSessionSubscribeStop(const eaipSession_t *session,
+                                                     eaipSubRequest_t request) {
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getOwnTopicLength(session, STOP, dataIdLength));
+    parseOwnTopic(topic, session, STOP, request.dataId, dataIdLength);
+
+    return transportSubscribe(&session->config, topic, request.handler);
+}
+
+eaipCommunicationErrorCodes eaipSessionSubscribeDo(const eaipSession_t *session,
+                                                   eaipSubRequest_t request) {
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getOwnTopicLength(session, DO, dataIdLength));
+    parseOwnTopic(topic, session, DO, request.dataId, dataIdLength);
+
+    return transportSubscribe(&session->config, topic, request.handler);
+}
+
+eaipCommunicationErrorCodes eaipSessionSubscribeDone(const eaipSession_t *session,
+                                                     eaipSubRequest_t request) {
+    size_t targetIdLength = strlen(request.targetId);
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getForeignTopicLength(session, DONE, targetIdLength, dataIdLength));
+    parseForeignTopic(topic, session, DONE, request.targetId, targetIdLength, request.dataId,
+                      dataIdLength);
+
+    return transportSubscribe(&session->config, topic, request.handler);
+}
+
+/* endregion SUBSCRIBE */
+
+/* region UNSUBSCRIBE */
+
+eaipCommunicationErrorCodes eaipSessionUnsubscribeStatus(const eaipSession_t *session,
+                                                         eaipSubRequest_t request) {
+    size_t targetIdLength = strlen(request.targetId);
+    TOPIC_BUFFER(topic, getForeignTopicLength(session, STATUS, targetIdLength, 0));
+    parseForeignTopic(topic, session, STATUS, request.targetId, targetIdLength, NULL, 0);
+
+    return transportUnsubscribe(&session->config, topic);
+}
+
+eaipCommunicationErrorCodes eaipSessionUnsubscribeData(const eaipSession_t *session,
+                                                       eaipSubRequest_t request) {
+    size_t targetIdLength = strlen(request.targetId);
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getForeignTopicLength(session, DATA, targetIdLength, dataIdLength));
+    parseForeignTopic(topic, session, DATA, request.targetId, targetIdLength, request.dataId,
+                      dataIdLength);
+
+    return transportUnsubscribe(&session->config, topic);
+}
+
+eaipCommunicationErrorCodes eaipSessionUnsubscribeStart(const eaipSession_t *session,
+                                                        eaipSubRequest_t request) {
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getOwnTopicLength(session, START, dataIdLength));
+    parseOwnTopic(topic, session, START, request.dataId, dataIdLength);
+
+    return transportUnsubscribe(&session->config, topic);
+}
+
+eaipCommunicationErrorCodes eaipSessionUnsubscribeStop(const eaipSession_t *session,
+                                                       eaipSubRequest_t request) {
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getOwnTopicLength(session, STOP, dataIdLength));
+    parseOwnTopic(topic, session, STOP, request.dataId, dataIdLength);
+
+    return transportUnsubscribe(&session->config, topic);
+}
+
+eaipCommunicationErrorCodes eaipSessionUnsubscribeDo(const eaipSession_t *session,
+                                                     eaipSubRequest_t request) {
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getOwnTopicLength(session, DO, dataIdLength));
+    parseOwnTopic(topic, session, DO, request.dataId, dataIdLength);
+
+    return transportUnsubscribe(&session->config, topic);
+}
+
+eaipCommunicationErrorCodes eaipSessionUnsubscribeDone(const eaipSession_t *session,
+                                                       eaipSubRequest_t request) {
+    size_t targetIdLength = strlen(request.targetId);
+    size_t dataIdLength = strlen(request.dataId);
+    TOPIC_BUFFER(topic, getForeignTopicLength(session, DONE, targetIdLength, dataIdLength));
+    parseForeignTopic(topic, session, DONE, request.targetId, targetIdLength, request.dataId,
+                      dataIdLength);
+
+    return transportUnsubscribe(&session->config, topic);
+}
+
+/* endregion UNSUBSCRIBE */
@@ -0,0 +1,101 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "eaip/endpoint/CommunicationEndpoint.h"
+#include "eaip/protocol/Hash.h"
+#include "eaip/protocol/ShardedEndpoint.h"
+
+eaipCommunicationErrorCodes eaipShardedEndpointInit(eaipShardedEndpoint_t *sharded,
+                                                    const eaipEndpoint_t *shards,
+                                                    size_t shardCount, eaipShardKey_t key,
+                                                    const char *baseUrl) {
+    if (shards == NULL || shardCount == 0 || (key == EAIP_SHARD_BY_DEVICE && baseUrl == NULL)) {
+        return EAIP_COM_GENERIC_ERROR;
+    }
+    sharded->shards = shards;
+    sharded->shardCount = shardCount;
+    sharded->key = key;
+    sharded->baseUrl = baseUrl;
+    sharded->baseUrlLength = baseUrl != NULL ? strlen(baseUrl) + 1 : 0;
+    return EAIP_COM_NO_ERROR;
+}
+
+size_t eaipShardedEndpointSelect(const eaipShardedEndpoint_t *sharded, const char *topic) {
+    size_t length = strlen(topic);
+    size_t prefixLength = sharded->baseUrlLength;
+    /* topics outside the base URL are hashed completely */
+    if (sharded->key == EAIP_SHARD_BY_DEVICE && length > prefixLength &&
+        0 == memcmp(topic, sharded->baseUrl, prefixLength - 1) &&
+        topic[prefixLength - 1] == '/') {
+        topic += prefixLength;
+        const char *end = strchr(topic, '/');
+        length = end != NULL ? (size_t)(end - topic) : strlen(topic);
+    }
+    return hashUpdate32(FNV32_OFFSET_BASIS, topic, length) % sharded->shardCount;
+}
+
+static const eaipEndpoint_t *selectShard(void *context, const char *topic) {
+    const eaipShardedEndpoint_t *sharded = context;
+    return &sharded->shards[eaipShardedEndpointSelect(sharded, topic)];
+}
+
+/* region INTERFACE */
+
+static eaipCommunicationErrorCodes shardedPublish(void *context, char *topic, char *data,
+                                                  bool retain) {
+    const eaipEndpoint_t *shard = selectShard(context, topic);
+    return shard->interface->publish(shard->context, topic, data, retain);
+}
+
+static eaipCommunicationErrorCodes shardedSubscribe(void *context, char *topic,
+                                                    void (*handle)(char *topic, char *message)) {
+    const eaipEndpoint_t *shard = selectShard(context, topic);
+    return shard->interface->subscribe(shard->context, topic, handle);
+}
+
+static eaipCommunicationErrorCodes shardedUnsubscribe(void *context, char *topic) {
+    const eaipEndpoint_t *shard = selectShard(context, topic);
+    return shard->interface->unsubscribe(shard->context, topic);
+}
+
+static eaipCommunicationErrorCodes shardedPublishBinary(void *context, char *topic,
+                                                        const uint8_t *payload, size_t length,
+                                                        bool retain) {
+    const eaipEndpoint_t *shard = selectShard(context, topic);
+    if (shard->interface->publishBinary == NULL) {
+        return EAIP_COM_NOT_SUPPORTED;
+    }
+    return shard->interface->publishBinary(shard->context, topic, payload, length, retain);
+}
+
+static eaipCommunicationErrorCodes
+shardedSubscribeBinary(void *context, char *topic,
+                       void (*handle)(char *topic, const uint8_t *payload, size_t length)) {
+    const eaipEndpoint_t *shard = selectShard(context, topic);
+    if (shard->interface->subscribeBinary == NULL) {
+        return EAIP_COM_NOT_SUPPORTED;
+    }
+    return shard->interface->subscribeBinary(shard->context, topic, handle);
+}
+
+static eaipCommunicationErrorCodes shardedSubscribeView(void *context, char *topic,
+                                                        eaipViewHandler handle, void *userData) {
+    const eaipEndpoint_t *shard = selectShard(context, topic);
+    if (shard->interface->subscribeView == NULL) {
+        return EAIP_COM_NOT_SUPPORTED;
+    }
+    return shard->interface->subscribeView(shard->context, topic, handle, userData);
+}
+
+const eaipEndpointInterface_t eaipShardedEndpointInterface = {
+    .publish = &shardedPublish,
+    .subscribe = &shardedSubscribe,
+    .unsubscribe = &shardedUnsubscribe,
+    .publishBinary = &shardedPublishBinary,
+    .subscribeBinary = &shardedSubscribeBinary,
+    .subscribeView = &shardedSubscribeView,
+};
+
+/* endregion INTERFACE */
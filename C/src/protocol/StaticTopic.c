@@ -0,0 +1,41 @@
+#include <stdlib.h>
+
+#include "eaip/protocol/Buffer.h"
+#include "eaip/protocol/Parser.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/StaticTopic.h"
+#include "eaip/protocol/Transport.h"
+
+/*
+ * The endpoint interface takes mutable topics for historical reasons; endpoints must not
+ * modify them, so passing the read-only literals is safe.
+ */
+
+eaipCommunicationErrorCodes eaipPublishStatic(eaiProtocol_t config, eaipStaticTopic_t topic,
+                                              char *message, bool retain) {
+    return transportPublish(&config, (char *)topic.topic, message, retain);
+}
+
+eaipCommunicationErrorCodes eaipPublishStatusStatic(eaiProtocol_t config, eaipStaticTopic_t topic,
+                                                    eaipDeviceState_t status) {
+    char buffer[EAIP_STATUS_BUFFER_SIZE];
+    char *data = serializeStatus(buffer, sizeof(buffer), config.deviceId, status);
+    if (data == NULL) {
+        return SERIALIZATION_FAILED;
+    }
+
+    eaipCommunicationErrorCodes result = transportPublish(&config, (char *)topic.topic, data, true);
+    if (data != buffer) {
+        free(data);
+    }
+    return result;
+}
+
+eaipCommunicationErrorCodes eaipSubscribeStatic(eaiProtocol_t config, eaipStaticTopic_t topic,
+                                                messageHandler handler) {
+    return transportSubscribe(&config, (char *)topic.topic, handler);
+}
+
+eaipCommunicationErrorCodes eaipUnsubscribeStatic(eaiProtocol_t config, eaipStaticTopic_t topic) {
+    return transportUnsubscribe(&config, (char *)topic.topic);
+}
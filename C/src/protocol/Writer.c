@@ -0,0 +1,42 @@
+#include <string.h>
+
+#include "eaip/protocol/Writer.h"
+
+void eaipWriterInit(eaipWriter_t *writer, char *buffer, size_t capacity) {
+    writer->buffer = buffer;
+    writer->capacity = capacity;
+    writer->length = 0;
+}
+
+void eaipWriterAppend(eaipWriter_t *writer, const char *data, size_t length) {
+    if (writer->length < writer->capacity) {
+        size_t available = writer->capacity - writer->length - 1;
+        memcpy(writer->buffer + writer->length, data, length < available ? length : available);
+    }
+    writer->length += length;
+}
+
+void eaipWriterAppendString(eaipWriter_t *writer, const char *string) {
+    eaipWriterAppend(writer, string, strlen(string));
+}
+
+void eaipWriterAppendChar(eaipWriter_t *writer, char character) {
+    if (writer->length + 1 < writer->capacity) {
+        writer->buffer[writer->length] = character;
+    }
+    writer->length++;
+}
+
+size_t eaipWriterFinish(eaipWriter_t *writer) {
+    if (writer->capacity == 0) {
+        return 0;
+    }
+
+    size_t written = eaipWriterTruncated(writer) ? writer->capacity - 1 : writer->length;
+    writer->buffer[written] = '\0';
+    return written;
+}
+
+bool eaipWriterTruncated(const eaipWriter_t *writer) {
+    return writer->length >= writer->capacity;
+}
@@ -0,0 +1,51 @@
+#ifndef EAI_PROTOCOL_BUFFER_HEADER
+#define EAI_PROTOCOL_BUFFER_HEADER
+
+#include "eaip/protocol/Protocol.h"
+
+/*!
+ * @brief declare a `char` buffer named `name` holding `size` bytes for a topic
+ *
+ * By default this is a variable length array. With `EAIP_STACK_BOUNDED` the buffer has the fixed
+ * size `EAIP_MAX_TOPIC_LENGTH + 1` and the enclosing function returns `EAIP_COM_TOPIC_TO_LONG`
+ * if `size` exceeds it, so the stack usage no longer depends on the input.
+ */
+#ifdef EAIP_STACK_BOUNDED
+#define TOPIC_BUFFER(name, size)                                                                   \
+    char name[EAIP_MAX_TOPIC_LENGTH + 1];                                                          \
+    if ((size) > sizeof(name))                                                                     \
+    return EAIP_COM_TOPIC_TO_LONG
+#else
+#define TOPIC_BUFFER(name, size) char name[size]
+#endif
+
+/*!
+ * @brief declare a `char` buffer named `name` holding `size` bytes for a `<baseUrl>/<deviceId>`
+ *        message, as sent with START and STOP
+ *
+ * The requester is the prefix of the own topics of a device. With `EAIP_STACK_BOUNDED` the buffer
+ * therefore has the size of a topic buffer and the enclosing function returns
+ * `EAIP_COM_MESSAGE_TO_LONG` if `size` exceeds it.
+ */
+#ifdef EAIP_STACK_BOUNDED
+#define REQUESTER_BUFFER(name, size)                                                               \
+    char name[EAIP_MAX_TOPIC_LENGTH + 1];                                                          \
+    if ((size) > sizeof(name))                                                                     \
+    return EAIP_COM_MESSAGE_TO_LONG
+#else
+#define REQUESTER_BUFFER(name, size) char name[size]
+#endif
+
+/*!
+ * @brief error returned if a message does not fit its scratch buffer
+ *
+ * Without `EAIP_STACK_BOUNDED` such messages are serialized on the heap instead, which can only
+ * fail if no memory is left.
+ */
+#ifdef EAIP_STACK_BOUNDED
+#define SERIALIZATION_FAILED EAIP_COM_MESSAGE_TO_LONG
+#else
+#define SERIALIZATION_FAILED EAIP_COM_OUT_OF_MEMORY
+#endif
+
+#endif /* EAI_PROTOCOL_BUFFER_HEADER */
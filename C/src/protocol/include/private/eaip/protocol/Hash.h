@@ -0,0 +1,40 @@
+#ifndef EAI_PROTOCOL_HASH_HEADER
+#define EAI_PROTOCOL_HASH_HEADER
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * FNV-1a hashes shared by the protocol library and the broker mock, header only so the broker mock
+ * does not have to link the protocol library
+ */
+
+#define FNV32_OFFSET_BASIS 0x811c9dc5u
+#define FNV32_PRIME 0x01000193u
+
+#define FNV64_OFFSET_BASIS 0xcbf29ce484222325u
+#define FNV64_PRIME 0x00000100000001b3u
+
+/*!
+ * @brief continue a 32 bit FNV-1a hash over `length` bytes
+ */
+static inline uint32_t hashUpdate32(uint32_t hash, const void *data, size_t length) {
+    const unsigned char *bytes = data;
+    for (size_t index = 0; index < length; index++) {
+        hash = (hash ^ bytes[index]) * FNV32_PRIME;
+    }
+    return hash;
+}
+
+/*!
+ * @brief continue a 64 bit FNV-1a hash over `length` bytes
+ */
+static inline uint64_t hashUpdate64(uint64_t hash, const void *data, size_t length) {
+    const unsigned char *bytes = data;
+    for (size_t index = 0; index < length; index++) {
+        hash = (hash ^ bytes[index]) * FNV64_PRIME;
+    }
+    return hash;
+}
+
+#endif /* EAI_PROTOCOL_HASH_HEADER */
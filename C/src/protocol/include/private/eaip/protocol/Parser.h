@@ -1,14 +1,43 @@
 #ifndef EAI_PROTOCOL_TOPICPARSER_HEADER
 #define EAI_PROTOCOL_TOPICPARSER_HEADER
 
+#include <stddef.h>
+
 #include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Session.h"
 
-typedef enum topic { STATUS, START, STOP, DATA, DO, DONE } topic_t;
+const char *getTopicName(topic_t topic);
+size_t getTopicNameLength(topic_t topic);
 
 size_t getTopicLength(topic_t topic, char *baseUrl, char *deviceId, char *dataId);
 void parseTopic(char *topicBuffer, topic_t topic, char *baseUrl, char *deviceId, char *dataId);
 
-size_t getStatusLength(char *deviceId, eaipDeviceState_t status);
-void parseStatus(char *statusBuffer, char *deviceId, eaipDeviceState_t status);
+size_t getOwnTopicLength(const eaipSession_t *session, topic_t topic, size_t dataIdLength);
+void parseOwnTopic(char *topicBuffer, const eaipSession_t *session, topic_t topic,
+                   const char *dataId, size_t dataIdLength);
+
+size_t getForeignTopicLength(const eaipSession_t *session, topic_t topic, size_t deviceIdLength,
+                             size_t dataIdLength);
+void parseForeignTopic(char *topicBuffer, const eaipSession_t *session, topic_t topic,
+                       const char *deviceId, size_t deviceIdLength, const char *dataId,
+                       size_t dataIdLength);
+
+/*!
+ * @brief serialize a status, falling back to the heap if it exceeds the scratch buffer
+ *
+ * @return `buffer` or a heap allocated buffer that has to be freed by the caller,
+ *         NULL if the allocation failed or, with `EAIP_STACK_BOUNDED`, the message does not fit
+ */
+char *serializeStatus(char *buffer, size_t bufferSize, const char *deviceId,
+                      eaipDeviceState_t status);
+
+/*!
+ * @brief serialize floats as comma separated values, falling back to the heap if they exceed
+ *        the scratch buffer
+ *
+ * @return `buffer` or a heap allocated buffer that has to be freed by the caller,
+ *         NULL if the allocation failed or, with `EAIP_STACK_BOUNDED`, the message does not fit
+ */
+char *serializeFloatVector(char *buffer, size_t bufferSize, const float *values, size_t count);
 
 #endif // EAI_PROTOCOL_TOPICPARSER_HEADER
@@ -0,0 +1,95 @@
+#ifndef EAI_PROTOCOL_TRANSPORT_HEADER
+#define EAI_PROTOCOL_TRANSPORT_HEADER
+
+/*!
+ * Calls the endpoint of a configuration, which is either its `endpoint` or, if no interface is set
+ * there, its plain function pointers.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eaip/endpoint/CommunicationEndpoint.h"
+#include "eaip/protocol/Protocol.h"
+
+static inline eaipCommunicationErrorCodes transportPublish(const eaiProtocol_t *config,
+                                                           char *topic, char *message,
+                                                           bool retain) {
+    const eaipEndpoint_t *endpoint = &config->endpoint;
+    if (endpoint->interface != NULL) {
+        return endpoint->interface->publish(endpoint->context, topic, message, retain);
+    }
+    return config->publish(topic, message, retain);
+}
+
+static inline eaipCommunicationErrorCodes transportSubscribe(const eaiProtocol_t *config,
+                                                             char *topic,
+                                                             void (*handle)(char *topic,
+                                                                            char *message)) {
+    const eaipEndpoint_t *endpoint = &config->endpoint;
+    if (endpoint->interface != NULL) {
+        return endpoint->interface->subscribe(endpoint->context, topic, handle);
+    }
+    return config->subscribe(topic, handle);
+}
+
+static inline eaipCommunicationErrorCodes transportUnsubscribe(const eaiProtocol_t *config,
+                                                               char *topic) {
+    const eaipEndpoint_t *endpoint = &config->endpoint;
+    if (endpoint->interface != NULL) {
+        return endpoint->interface->unsubscribe(endpoint->context, topic);
+    }
+    return config->unsubscribe(topic);
+}
+
+static inline bool transportHasPublishBinary(const eaiProtocol_t *config) {
+    return config->endpoint.interface != NULL ? config->endpoint.interface->publishBinary != NULL
+                                              : config->publishBinary != NULL;
+}
+
+static inline eaipCommunicationErrorCodes transportPublishBinary(const eaiProtocol_t *config,
+                                                                 char *topic,
+                                                                 const uint8_t *payload,
+                                                                 size_t length, bool retain) {
+    const eaipEndpoint_t *endpoint = &config->endpoint;
+    if (endpoint->interface != NULL) {
+        return endpoint->interface->publishBinary(endpoint->context, topic, payload, length,
+                                                  retain);
+    }
+    return config->publishBinary(topic, payload, length, retain);
+}
+
+static inline bool transportHasSubscribeBinary(const eaiProtocol_t *config) {
+    return config->endpoint.interface != NULL
+               ? config->endpoint.interface->subscribeBinary != NULL
+               : config->subscribeBinary != NULL;
+}
+
+static inline eaipCommunicationErrorCodes
+transportSubscribeBinary(const eaiProtocol_t *config, char *topic,
+                         void (*handle)(char *topic, const uint8_t *payload, size_t length)) {
+    const eaipEndpoint_t *endpoint = &config->endpoint;
+    if (endpoint->interface != NULL) {
+        return endpoint->interface->subscribeBinary(endpoint->context, topic, handle);
+    }
+    return config->subscribeBinary(topic, handle);
+}
+
+static inline bool transportHasSubscribeView(const eaiProtocol_t *config) {
+    return config->endpoint.interface != NULL ? config->endpoint.interface->subscribeView != NULL
+                                              : config->subscribeView != NULL;
+}
+
+static inline eaipCommunicationErrorCodes transportSubscribeView(const eaiProtocol_t *config,
+                                                                 char *topic,
+                                                                 eaipViewHandler handle,
+                                                                 void *userData) {
+    const eaipEndpoint_t *endpoint = &config->endpoint;
+    if (endpoint->interface != NULL) {
+        return endpoint->interface->subscribeView(endpoint->context, topic, handle, userData);
+    }
+    return config->subscribeView(topic, handle, userData);
+}
+
+#endif /* EAI_PROTOCOL_TRANSPORT_HEADER */
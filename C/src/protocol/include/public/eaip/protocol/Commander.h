@@ -0,0 +1,221 @@
+#ifndef EAI_PROTOCOL_COMMANDER_HEADER
+#define EAI_PROTOCOL_COMMANDER_HEADER
+
+/*!
+ * Asynchronous DO/DONE requests for the elastic-AI protocol library
+ *
+ * The commander publishes DO requests without waiting for their DONE reply, so many requests can
+ * be in flight per target device. Every request gets a token identifying it and a completion
+ * handler, which is called once with the DONE message, or after the request timed out.
+ *
+ * DONE messages carry no correlation information on the wire. Replies are therefore matched to
+ * the oldest pending request with the same target and command, which relies on a device
+ * executing the commands it receives in order. Pending requests are indexed by a hash of target
+ * and command, each entry a FIFO of the requests for the same command, and tokens encode the
+ * entry of their request, so matching a reply and cancelling take constant time regardless of
+ * the number of requests in flight.
+ *
+ * Time is provided by the user through `eaipCommanderTick`; expired requests are found with a
+ * hashed timer wheel. As for the router, the user has to provide a forwarding function:
+ *
+ * ```c
+ * eaipCommander_t commander;
+ * void completeCommand(char *topic, char *message) {
+ *     eaipCommanderDispatch(&commander, topic, message);
+ * }
+ * ...
+ * eaipCommanderSubscribe(&commander, &completeCommand);
+ * eaipCommanderRequest(&commander, request, 500, &handleResult, NULL, &token);
+ * ...
+ * eaipCommanderTick(&commander, millisecondsSinceBoot());
+ * ```
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Session.h"
+
+/*!
+ * @brief number of slots of the timer wheel, has to be a power of two
+ */
+#ifndef EAIP_TIMER_WHEEL_SLOTS
+#define EAIP_TIMER_WHEEL_SLOTS 64
+#endif
+
+typedef enum eaipCommandResult {
+    EAIP_COMMAND_DONE,
+    EAIP_COMMAND_TIMEOUT,
+    EAIP_COMMAND_CANCELLED,
+} eaipCommandResult_t;
+
+/*!
+ * @brief function pointer for handler to process the completion of a DO request
+ *
+ * @param result[eaipCommandResult_t] how the request completed
+ * @param message[char *] received DONE message, NULL unless `result` is `EAIP_COMMAND_DONE`
+ * @param userData[void *] pointer given with the request
+ */
+typedef void (*eaipCompletionHandler)(eaipCommandResult_t result, char *message, void *userData);
+
+/*!
+ * @brief a pending DO request
+ *
+ * IMPORTANT: Managed by the commander, considered private.
+ */
+typedef struct eaipCommand eaipCommand_t;
+struct eaipCommand {
+    uint32_t token;
+    uint32_t hash;
+    uint32_t deadline;
+    char *target;
+    size_t targetLength;
+    char *command;
+    size_t commandLength;
+    eaipCompletionHandler handler;
+    void *userData;
+    eaipCommand_t *previous;
+    eaipCommand_t *next;
+    eaipCommand_t *timerPrevious;
+    eaipCommand_t *timerNext;
+    eaipCommand_t *keyNext;      /*! next request of another target and command in the bucket */
+    eaipCommand_t *samePrevious; /*! older pending request for the same target and command */
+    eaipCommand_t *sameNext;     /*! newer pending request for the same target and command */
+    eaipCommand_t *sameNewest;   /*! newest request for the same target and command, oldest only */
+};
+
+/*!
+ * @brief struct holding the pending requests
+ *
+ * @param session[eaipSession_t *] session the commander publishes with
+ * @param commands[eaipCommand_t *] storage for `capacity` requests
+ * @param capacity[size_t] maximum number of pending requests
+ * @param count[size_t] number of pending requests
+ * @param unused[eaipCommand_t *] list of unused entries in `commands`
+ * @param oldest[eaipCommand_t *] first pending request in issue order
+ * @param newest[eaipCommand_t *] last pending request in issue order
+ * @param wheel[eaipCommand_t *] timer wheel, pending requests by deadline
+ * @param resolution[uint32_t] milliseconds covered by one slot of the wheel
+ * @param now[uint32_t] time given to the last `eaipCommanderTick` call in milliseconds
+ * @param generation[uint32_t] counter making tokens unique
+ * @param indexBits[uint32_t] low bits of a token holding the index of its entry in `commands`
+ * @param buckets[eaipCommand_t **] hash index, the oldest pending request per target and command
+ * @param bucketMask[size_t] number of buckets - 1, the number of buckets is a power of two
+ *
+ * IMPORTANT: All fields are managed by the `eaipCommander*` functions and must not be modified by
+ *            the user.
+ */
+typedef struct eaipCommander {
+    const eaipSession_t *session;
+    eaipCommand_t *commands;
+    size_t capacity;
+    size_t count;
+    eaipCommand_t *unused;
+    eaipCommand_t *oldest;
+    eaipCommand_t *newest;
+    eaipCommand_t *wheel[EAIP_TIMER_WHEEL_SLOTS];
+    uint32_t resolution;
+    uint32_t now;
+    uint32_t generation;
+    uint32_t indexBits;
+    eaipCommand_t **buckets;
+    size_t bucketMask;
+} eaipCommander_t;
+
+/*!
+ * @brief initialize a commander
+ *
+ * @param commander[eaipCommander_t *] commander to initialize
+ * @param session[eaipSession_t *] initialized session, has to outlive the commander
+ * @param capacity[size_t] maximum number of pending requests
+ * @param resolution[uint32_t] granularity of timeouts in milliseconds, at least 1
+ * @param now[uint32_t] current time in milliseconds
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipCommanderInit(eaipCommander_t *commander,
+                                              const eaipSession_t *session, size_t capacity,
+                                              uint32_t resolution, uint32_t now);
+
+/*!
+ * @brief cancel all pending requests and release the memory held by a commander
+ *
+ * @param commander[eaipCommander_t *] commander to release
+ */
+void eaipCommanderFree(eaipCommander_t *commander);
+
+/*!
+ * @brief subscribe to the DONE messages of all devices, `<baseUrl>/+/DONE/#`
+ *
+ * @param commander[eaipCommander_t *] initialized commander
+ * @param handler[messageHandler] function forwarding received messages to `eaipCommanderDispatch`
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipCommanderSubscribe(const eaipCommander_t *commander,
+                                                   messageHandler handler);
+
+/*!
+ * @brief unsubscribe from `<baseUrl>/+/DONE/#`
+ *
+ * @param commander[eaipCommander_t *] initialized commander
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipCommanderUnsubscribe(const eaipCommander_t *commander);
+
+/*!
+ * @brief publish a DO request without waiting for its completion
+ *
+ * @param commander[eaipCommander_t *] initialized commander
+ * @param request[eaipPubRequest_t] request
+ *                                  deviceId -> device-ID to send the command to
+ *                                  dataId -> command
+ *                                  data -> parameters of the command
+ * @param timeout[uint32_t] milliseconds after the last tick until the request expires
+ * @param handler[eaipCompletionHandler] function called once on completion
+ * @param userData[void *] pointer passed to the handler
+ * @param token[uint32_t *] receives the token of the request, may be NULL
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_OUT_OF_MEMORY if the capacity of the commander is exhausted
+ */
+eaipCommunicationErrorCodes eaipCommanderRequest(eaipCommander_t *commander,
+                                                 eaipPubRequest_t request, uint32_t timeout,
+                                                 eaipCompletionHandler handler, void *userData,
+                                                 uint32_t *token);
+
+/*!
+ * @brief complete a pending request with `EAIP_COMMAND_CANCELLED`
+ *
+ * A DONE message received later is matched to the next pending request for the same command.
+ *
+ * @param commander[eaipCommander_t *] initialized commander
+ * @param token[uint32_t] token of the request
+ *
+ * @return true if the request was pending
+ */
+bool eaipCommanderCancel(eaipCommander_t *commander, uint32_t token);
+
+/*!
+ * @brief advance the time and expire requests whose timeout elapsed
+ *
+ * @param commander[eaipCommander_t *] initialized commander
+ * @param now[uint32_t] current time in milliseconds, may wrap around
+ */
+void eaipCommanderTick(eaipCommander_t *commander, uint32_t now);
+
+/*!
+ * @brief complete the oldest pending request matching a received DONE message
+ *
+ * @param commander[eaipCommander_t *] initialized commander
+ * @param topic[char *] topic of the received message
+ * @param message[char *] received message
+ *
+ * @return true if a request was completed
+ */
+bool eaipCommanderDispatch(eaipCommander_t *commander, char *topic, char *message);
+
+#endif /* EAI_PROTOCOL_COMMANDER_HEADER */
@@ -0,0 +1,76 @@
+#ifndef EAI_PROTOCOL_NUMBER_HEADER
+#define EAI_PROTOCOL_NUMBER_HEADER
+
+/*!
+ * Locale independent number codec for DATA payloads
+ *
+ * Floats are written with the shortest digit sequence that reads back to the same value, integers
+ * without any padding. Vectors are written as comma separated values, e.g. `1.5,-2,3e-7`.
+ * The scanners accept everything written by the formatters as well as the usual `%f`/`%g` output
+ * of `printf`.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eaip/protocol/Writer.h"
+
+/*!
+ * @brief buffer size sufficient for any single number written by the formatters, including `\0`
+ */
+#define EAIP_NUMBER_BUFFER_SIZE 24
+
+/*!
+ * @brief write the shortest representation of a float that reads back to the same value
+ *
+ * @param buffer[char *] buffer with at least `EAIP_NUMBER_BUFFER_SIZE` bytes
+ * @param value[float] value to write, `nan` and `inf` are written as such
+ *
+ * @return number of characters written, without the terminating `\0`
+ */
+size_t eaipFormatFloat(char *buffer, float value);
+
+/*!
+ * @brief write a 32 bit integer
+ *
+ * @param buffer[char *] buffer with at least `EAIP_NUMBER_BUFFER_SIZE` bytes
+ * @param value[int32_t] value to write
+ *
+ * @return number of characters written, without the terminating `\0`
+ */
+size_t eaipFormatInt(char *buffer, int32_t value);
+
+/*!
+ * @brief append floats as comma separated values to a writer
+ *
+ * @param writer[eaipWriter_t *] initialized writer
+ * @param values[float *] values to append
+ * @param count[size_t] number of values
+ */
+void eaipWriteFloatVector(eaipWriter_t *writer, const float *values, size_t count);
+
+/*!
+ * @brief read a float from the start of a string
+ *
+ * @param text[char *] string to read from, does not need to be `\0` terminated
+ * @param length[size_t] number of characters available in `text`
+ * @param value[float *] location to store the value
+ *
+ * @return number of characters consumed, 0 if `text` does not start with a number
+ */
+size_t eaipScanFloat(const char *text, size_t length, float *value);
+
+/*!
+ * @brief read a 32 bit integer from the start of a string
+ *
+ * @param text[char *] string to read from, does not need to be `\0` terminated
+ * @param length[size_t] number of characters available in `text`
+ * @param value[int32_t *] location to store the value
+ *
+ * @return number of characters consumed, 0 if `text` does not start with an integer or the value
+ *         does not fit into 32 bit
+ */
+size_t eaipScanInt(const char *text, size_t length, int32_t *value);
+
+#endif /* EAI_PROTOCOL_NUMBER_HEADER */
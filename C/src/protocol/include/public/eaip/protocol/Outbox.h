@@ -0,0 +1,211 @@
+#ifndef EAI_PROTOCOL_OUTBOX_HEADER
+#define EAI_PROTOCOL_OUTBOX_HEADER
+
+/*!
+ * Outbound message queue for the elastic-AI protocol library
+ *
+ * The outbox decouples a producer, e.g. an interrupt handler or an inference thread, from the
+ * transport. Messages are formatted into a fixed number of preallocated records of a lock-free
+ * single-producer/single-consumer ring, which takes constant time and never allocates. The
+ * consumer forwards queued messages to the `publish` function of the configuration by calling
+ * `eaipOutboxDrain`, e.g. from a separate thread or the main loop.
+ *
+ * An outbox initialized with `eaipOutboxInitMultiProducer` accepts messages from any number of
+ * threads at the same time, e.g. one inference worker per core, while a single thread owns the
+ * transport and drains the outbox. Records are claimed with a compare-and-swap on the tail and
+ * published per record through a sequence number, so producers never wait for each other except
+ * for the duration of a single atomic operation.
+ *
+ * IMPORTANT: Only one thread may drain at the same time. Without `eaipOutboxInitMultiProducer`
+ *            only one thread may enqueue at the same time.
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Session.h"
+
+/*!
+ * @brief default size of a record, has to hold the retain flag, topic and message
+ */
+#ifndef EAIP_OUTBOX_RECORD_SIZE
+#define EAIP_OUTBOX_RECORD_SIZE 256
+#endif
+
+/*!
+ * @brief called while `EAIP_OVERFLOW_BLOCK` waits for a free record, e.g. `taskYIELD()`
+ *
+ * Defaults to `sched_yield()` on POSIX systems and to busy waiting otherwise.
+ */
+#ifndef EAIP_OUTBOX_YIELD
+#if defined(__unix__)
+#include <sched.h>
+#define EAIP_OUTBOX_YIELD() sched_yield()
+#else
+#define EAIP_OUTBOX_YIELD() ((void)0)
+#endif
+#endif
+
+/*!
+ * @brief behaviour if a message is enqueued while all records are in use
+ *
+ * DROP_NEWEST -> the new message is discarded
+ * DROP_OLDEST -> the oldest queued message is discarded in favor of the new message, the new
+ *                message is discarded instead if the only record it could take is still being
+ *                copied by the consumer
+ * BLOCK -> wait until the consumer drained a record
+ */
+typedef enum eaipOverflowPolicy {
+    EAIP_OVERFLOW_DROP_NEWEST,
+    EAIP_OVERFLOW_DROP_OLDEST,
+    EAIP_OVERFLOW_BLOCK,
+} eaipOverflowPolicy_t;
+
+/*!
+ * @brief struct holding the ring of queued messages
+ *
+ * @param config[eaiProtocol_t] configuration providing the `publish` function
+ * @param records[char *] `capacity` records of `recordSize` bytes,
+ *                        each `<retain><topic>\0<message>\0`
+ * @param capacity[size_t] number of records, always a power of two
+ * @param recordSize[size_t] size of a record in bytes
+ * @param policy[eaipOverflowPolicy_t] behaviour if the ring is full
+ * @param head[atomic_size_t] counter of the next record to drain
+ * @param tail[atomic_size_t] counter of the next record to fill
+ * @param dropped[atomic_size_t] number of messages discarded due to overflow
+ * @param reading[atomic_size_t] counter of the record the consumer copies to `scratch`,
+ *                               `SIZE_MAX` while it copies none
+ * @param scratch[char *] copy of the record in transit for `EAIP_OVERFLOW_DROP_OLDEST`
+ * @param pending[bool] whether `scratch` holds a record that could not be published yet
+ * @param sequences[atomic_size_t *] per record sequence numbers if multiple producers are
+ *                                   allowed, NULL otherwise
+ *
+ * IMPORTANT: All fields are managed by the `eaipOutbox*` functions and must not be modified by the
+ *            user.
+ */
+typedef struct eaipOutbox {
+    eaiProtocol_t config;
+    char *records;
+    size_t capacity;
+    size_t recordSize;
+    eaipOverflowPolicy_t policy;
+    atomic_size_t head;
+    atomic_size_t tail;
+    atomic_size_t dropped;
+    atomic_size_t reading;
+    char *scratch;
+    bool pending;
+    atomic_size_t *sequences;
+} eaipOutbox_t;
+
+/*!
+ * @brief initialize an outbox and allocate all records
+ *
+ * @param outbox[eaipOutbox_t *] outbox to initialize
+ * @param config[eaiProtocol_t] configuration providing the `publish` function
+ * @param capacity[size_t] minimum number of records, rounded up to a power of two
+ * @param recordSize[size_t] size of a record, e.g. `EAIP_OUTBOX_RECORD_SIZE`
+ * @param policy[eaipOverflowPolicy_t] behaviour if all records are in use
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipOutboxInit(eaipOutbox_t *outbox, eaiProtocol_t config,
+                                           size_t capacity, size_t recordSize,
+                                           eaipOverflowPolicy_t policy);
+
+/*!
+ * @brief initialize an outbox accepting messages from multiple threads at the same time
+ *
+ * @param outbox[eaipOutbox_t *] outbox to initialize
+ * @param config[eaiProtocol_t] configuration providing the `publish` function
+ * @param capacity[size_t] minimum number of records, rounded up to a power of two
+ * @param recordSize[size_t] size of a record, e.g. `EAIP_OUTBOX_RECORD_SIZE`
+ * @param policy[eaipOverflowPolicy_t] behaviour if all records are in use
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_NOT_SUPPORTED for `EAIP_OVERFLOW_DROP_OLDEST`
+ */
+eaipCommunicationErrorCodes eaipOutboxInitMultiProducer(eaipOutbox_t *outbox,
+                                                        eaiProtocol_t config, size_t capacity,
+                                                        size_t recordSize,
+                                                        eaipOverflowPolicy_t policy);
+
+/*!
+ * @brief release the records of an outbox, queued messages are discarded
+ *
+ * @param outbox[eaipOutbox_t *] outbox to release
+ */
+void eaipOutboxFree(eaipOutbox_t *outbox);
+
+/*!
+ * @brief queue a message for a topic
+ *
+ * @param outbox[eaipOutbox_t *] initialized outbox
+ * @param topic[char *] topic to publish to
+ * @param message[char *] message to publish
+ * @param retain[bool] whether the broker should retain the message
+ *
+ * @return 0 if the message was queued,
+ *         EAIP_COM_MESSAGE_TO_LONG if topic and message do not fit into a record,
+ *         EAIP_COM_OUT_OF_MEMORY if the message was dropped by `EAIP_OVERFLOW_DROP_NEWEST`
+ */
+eaipCommunicationErrorCodes eaipOutboxPublish(eaipOutbox_t *outbox, const char *topic,
+                                              const char *message, bool retain);
+
+/*!
+ * @brief queue a DATA message, formatting the topic directly into the record
+ *
+ * @param outbox[eaipOutbox_t *] initialized outbox
+ * @param session[eaipSession_t *] session providing the topic prefix
+ * @param request[eaipPubRequest_t] request
+ *                                  deviceId -> unused
+ *                                  dataId -> data-ID to publish
+ *                                  data -> data to publish
+ *
+ * @return see `eaipOutboxPublish`
+ */
+eaipCommunicationErrorCodes eaipOutboxPublishData(eaipOutbox_t *outbox,
+                                                  const eaipSession_t *session,
+                                                  eaipPubRequest_t request);
+
+/*!
+ * @brief forward queued messages to the `publish` function of the configuration
+ *
+ * If publishing fails, the message is kept and draining stops until the next call.
+ *
+ * @param outbox[eaipOutbox_t *] initialized outbox
+ * @param limit[size_t] maximum number of messages to forward
+ *
+ * @return number of messages published
+ */
+size_t eaipOutboxDrain(eaipOutbox_t *outbox, size_t limit);
+
+/*!
+ * @brief size of the next message to drain
+ *
+ * Must only be called by the thread draining the outbox.
+ *
+ * @param outbox[eaipOutbox_t *] initialized outbox
+ *
+ * @return length of topic and message of the next record, 0 if the outbox is empty
+ */
+size_t eaipOutboxPeekLength(const eaipOutbox_t *outbox);
+
+/*!
+ * @brief number of queued messages
+ *
+ * @param outbox[eaipOutbox_t *] initialized outbox
+ */
+size_t eaipOutboxCount(const eaipOutbox_t *outbox);
+
+/*!
+ * @brief number of messages discarded since initialization due to overflow
+ *
+ * @param outbox[eaipOutbox_t *] initialized outbox
+ */
+size_t eaipOutboxDropped(const eaipOutbox_t *outbox);
+
+#endif /* EAI_PROTOCOL_OUTBOX_HEADER */
@@ -11,8 +11,11 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #include "eaip/endpoint/CommunicationEndpoint.h"
+#include "eaip/protocol/Writer.h"
 
 /* region CONFIGURATION */
 
@@ -24,6 +27,11 @@
  * @param publish function to handle publish requests
  * @param subscribe function to handle subscribe requests
  * @param unsubscribe function to handle unsubscribe requests
+ * @param publishBinary [OPTIONAL] function to handle publish requests with binary payload
+ * @param subscribeBinary [OPTIONAL] function to handle subscribe requests for binary payload
+ * @param subscribeView [OPTIONAL] function to handle subscribe requests of `eaipSubscribeView`
+ * @param endpoint[eaipEndpoint_t] [OPTIONAL] endpoint carrying a context, used instead of the
+ *                                 functions above if its `interface` is set
  *
  * IMPORTANT: The memory for the `deviceId` and `basUrl` field should be allocated on the heap with
  * `calloc`.
@@ -35,10 +43,70 @@ typedef struct eaiProtocol {
     eaipCommunicationErrorCodes (*subscribe)(char *topic,
                                              void (*handle)(char *topic, char *message));
     eaipCommunicationErrorCodes (*unsubscribe)(char *topic);
+    eaipCommunicationErrorCodes (*publishBinary)(char *topic, const uint8_t *payload,
+                                                 size_t length, bool retain);
+    eaipCommunicationErrorCodes (*subscribeBinary)(char *topic,
+                                                   void (*handle)(char *topic,
+                                                                  const uint8_t *payload,
+                                                                  size_t length));
+    eaipCommunicationErrorCodes (*subscribeView)(char *topic, eaipViewHandler handle,
+                                                 void *userData);
+    eaipEndpoint_t endpoint;
 } eaiProtocol_t;
 
+/*!
+ * @brief maximum length of a topic in the stack bounded build
+ *
+ * If the library is built with `EAIP_STACK_BOUNDED` (CMake option of the same name), topics are
+ * formatted into fixed buffers of this size instead of variable length arrays and messages that
+ * exceed their scratch buffer are rejected instead of moved to the heap. Functions then return
+ * `EAIP_COM_TOPIC_TO_LONG` or `EAIP_COM_MESSAGE_TO_LONG` respectively.
+ */
+#ifndef EAIP_MAX_TOPIC_LENGTH
+#define EAIP_MAX_TOPIC_LENGTH 128
+#endif
+
 /* endregion CONFIGURATION */
 
+/* region STRING VIEW */
+
+/*!
+ * @brief non-owning reference to a character sequence that is not `\0` terminated
+ *
+ * @param data[char *] first character of the sequence
+ * @param length[size_t] number of characters in the sequence
+ */
+typedef struct eaipStringView {
+    const char *data;
+    size_t length;
+} eaipStringView_t;
+
+/* endregion STRING VIEW */
+
+/* region TOPIC */
+
+/*!
+ * @brief message types defined by the elastic-AI protocol
+ */
+typedef enum topic { STATUS, START, STOP, DATA, DO, DONE } topic_t;
+
+/*!
+ * @brief number of message types defined in `topic_t`
+ */
+#define EAIP_TOPIC_TYPES (DONE + 1)
+
+/*!
+ * @brief names of the message types as used in topics, named `EAIP_TOPIC_NAME_<topic_t>`
+ */
+#define EAIP_TOPIC_NAME_STATUS "STATUS"
+#define EAIP_TOPIC_NAME_START "START"
+#define EAIP_TOPIC_NAME_STOP "STOP"
+#define EAIP_TOPIC_NAME_DATA "DATA"
+#define EAIP_TOPIC_NAME_DO "DO"
+#define EAIP_TOPIC_NAME_DONE "DONE"
+
+/* endregion TOPIC */
+
 /* region STATUS */
 
 typedef enum deviceState { OFFLINE, ONLINE } deviceState_t;
@@ -69,14 +137,186 @@ typedef struct eaipDeviceState {
     eaipStateDataField_t *additionalFields;
 } eaipDeviceState_t;
 
+/*!
+ * @brief size of the stack buffer used to serialize a status before falling back to the heap
+ */
+#ifndef EAIP_STATUS_BUFFER_SIZE
+#define EAIP_STATUS_BUFFER_SIZE 256
+#endif
+
+/*!
+ * @brief append a status message to a writer
+ *
+ * Runs in a single pass over the status, independent of the number of additional fields.
+ *
+ * @param writer[eaipWriter_t *] writer to append to
+ * @param deviceId[char *] id of the device the status belongs to
+ * @param status[eaipDeviceState_t] status to serialize
+ */
+void eaipWriteStatus(eaipWriter_t *writer, const char *deviceId, eaipDeviceState_t status);
+
+/*!
+ * @brief serialize a status message into a caller provided buffer
+ *
+ * @param buffer[char *] buffer to write to, always `\0` terminated if `bufferSize` > 0
+ * @param bufferSize[size_t] size of the buffer
+ * @param deviceId[char *] id of the device the status belongs to
+ * @param status[eaipDeviceState_t] status to serialize
+ * @param truncated[bool *] set to true if the status did not fit into the buffer, may be NULL
+ *
+ * @return number of characters written, excluding the terminating `\0`
+ */
+size_t eaipSerializeStatus(char *buffer, size_t bufferSize, const char *deviceId,
+                           eaipDeviceState_t status, bool *truncated);
+
+/*!
+ * @brief a `<key>:<value>;` field of a received status message
+ *
+ * @param key[eaipStringView_t] characters before the first `:`
+ * @param value[eaipStringView_t] characters after the first `:`, empty if there is none
+ */
+typedef struct eaipStatusField {
+    eaipStringView_t key;
+    eaipStringView_t value;
+} eaipStatusField_t;
+
+/*!
+ * @brief iterator over the fields of a received status message
+ *
+ * IMPORTANT: The fields are managed by `eaipStatusIteratorInit` and `eaipStatusIteratorNext`.
+ */
+typedef struct eaipStatusIterator {
+    const char *cursor;
+    const char *end;
+} eaipStatusIterator_t;
+
+/*!
+ * @brief start iterating over the fields of a status message
+ *
+ * @param iterator[eaipStatusIterator_t *] iterator to initialize
+ * @param message[char *] received status message, does not need to be `\0` terminated
+ * @param length[size_t] length of the message
+ */
+void eaipStatusIteratorInit(eaipStatusIterator_t *iterator, const char *message, size_t length);
+
+/*!
+ * @brief get the next field of a status message
+ *
+ * Empty fields (`;;`) are skipped. The returned views point into the message, which is neither
+ * copied nor modified.
+ *
+ * @param iterator[eaipStatusIterator_t *] initialized iterator
+ * @param field[eaipStatusField_t *] receives the next field
+ *
+ * @return false if all fields were consumed
+ */
+bool eaipStatusIteratorNext(eaipStatusIterator_t *iterator, eaipStatusField_t *field);
+
+/*!
+ * @brief struct receiving a parsed status message
+ *
+ * @param deviceId[eaipStringView_t] value of the `ID` field
+ * @param deviceType[deviceType_t] decoded value of the `TYPE` field
+ * @param deviceState[deviceState_t] decoded value of the `STATE` field
+ * @param additionalFields[eaipStatusField_t *] caller provided storage for additional fields,
+ *                                              may be NULL
+ * @param additionalFieldsCapacity[size_t] number of entries in `additionalFields`
+ * @param additionalFieldsCount[size_t] number of additional fields found in the message,
+ *                                      only the first `additionalFieldsCapacity` are stored
+ */
+typedef struct eaipStatusView {
+    eaipStringView_t deviceId;
+    deviceType_t deviceType;
+    deviceState_t deviceState;
+    eaipStatusField_t *additionalFields;
+    size_t additionalFieldsCapacity;
+    size_t additionalFieldsCount;
+} eaipStatusView_t;
+
+/*!
+ * @brief parse a received status message without allocating or modifying it
+ *
+ * `APPLICATION`/`APP` and `enV5`/`NODE` are accepted as device type.
+ *
+ * @param message[char *] received status message, does not need to be `\0` terminated
+ * @param length[size_t] length of the message
+ * @param status[eaipStatusView_t *] receives the parsed fields, `additionalFields` and
+ *                                   `additionalFieldsCapacity` have to be set by the caller
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_INVALID_MESSAGE if a mandatory field is missing or has an unknown value
+ */
+eaipCommunicationErrorCodes eaipParseStatus(const char *message, size_t length,
+                                            eaipStatusView_t *status);
+
 /* endregion STATUS */
 
+/* region DATA */
+
+/*!
+ * @brief size of the stack buffer used to serialize vectors, larger vectors fall back to the heap
+ */
+#ifndef EAIP_DATA_BUFFER_SIZE
+#define EAIP_DATA_BUFFER_SIZE 256
+#endif
+
+/*!
+ * @brief parse a received DATA message holding a single float
+ *
+ * @param data[char *] received message, does not need to be `\0` terminated
+ * @param length[size_t] length of the message
+ * @param value[float *] location to store the value
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_INVALID_MESSAGE if the message is not exactly one number
+ */
+eaipCommunicationErrorCodes eaipParseDataFloat(const char *data, size_t length, float *value);
+
+/*!
+ * @brief parse a received DATA message holding a single integer
+ *
+ * @param data[char *] received message, does not need to be `\0` terminated
+ * @param length[size_t] length of the message
+ * @param value[int32_t *] location to store the value
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_INVALID_MESSAGE if the message is not exactly one 32 bit integer
+ */
+eaipCommunicationErrorCodes eaipParseDataInt(const char *data, size_t length, int32_t *value);
+
+/*!
+ * @brief parse a received DATA message holding comma separated floats
+ *
+ * @param data[char *] received message, does not need to be `\0` terminated
+ * @param length[size_t] length of the message
+ * @param values[float *] location to store the values
+ * @param capacity[size_t] number of entries available in `values`
+ * @param count[size_t *] receives the number of parsed values
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_INVALID_MESSAGE if the message is malformed,
+ *         EAIP_COM_MESSAGE_TO_LONG if the message holds more than `capacity` values
+ */
+eaipCommunicationErrorCodes eaipParseDataVector(const char *data, size_t length, float *values,
+                                                size_t capacity, size_t *count);
+
+/* endregion DATA */
+
 /* region Requests */
 
+/*!
+ * @brief struct describing a publish request
+ *
+ * @param deviceId[char *] target device, usage depends on the message type
+ * @param dataId[char *] data-ID or command
+ * @param data[char *] payload, `\0` terminated unless published with a `*Binary` function
+ * @param length[size_t] length of `data`, only used by the `*Binary` functions
+ */
 typedef struct eaipPubRequest {
     char *deviceId;
     char *dataId;
     char *data;
+    size_t length;
 } eaipPubRequest_t;
 
 /*!
@@ -87,12 +327,85 @@ typedef struct eaipPubRequest {
  */
 typedef void (*messageHandler)(char *topic, char *message);
 
+/*!
+ * @brief function pointer for handler to process received binary posting
+ *
+ * @param topic[char*] topic of received message
+ * @param payload[uint8_t *] received payload, not `\0` terminated
+ * @param length[size_t] length of the payload
+ */
+typedef void (*binaryMessageHandler)(char *topic, const uint8_t *payload, size_t length);
+
+/*!
+ * @brief a received message as handed to an `eaipMessageViewHandler`
+ *
+ * All views point into the buffer of the endpoint and are only valid during the call.
+ *
+ * @param topic[eaipStringView_t] complete topic of the message
+ * @param type[topic_t] message type of the subscription
+ * @param deviceId[eaipStringView_t] device the topic belongs to
+ * @param dataId[eaipStringView_t] data-ID or command, empty for `STATUS`
+ * @param payload[uint8_t *] received payload, not necessarily `\0` terminated
+ * @param length[size_t] length of the payload
+ */
+typedef struct eaipMessageView {
+    eaipStringView_t topic;
+    topic_t type;
+    eaipStringView_t deviceId;
+    eaipStringView_t dataId;
+    const uint8_t *payload;
+    size_t length;
+} eaipMessageView_t;
+
+/*!
+ * @brief function pointer for handler to process a received message without copying it
+ *
+ * @param message[eaipMessageView_t *] received message
+ * @param userData[void *] pointer given with the subscribe request
+ */
+typedef void (*eaipMessageViewHandler)(const eaipMessageView_t *message, void *userData);
+
+/*!
+ * @brief struct describing a subscribe request
+ *
+ * @param targetId[char *] target device, usage depends on the message type
+ * @param dataId[char *] data-ID or command
+ * @param handler[messageHandler] function to handle received messages
+ * @param binaryHandler[binaryMessageHandler] function to handle received messages,
+ *                                            only used by the `*Binary` functions
+ * @param viewHandler[eaipMessageViewHandler] function to handle received messages,
+ *                                            only used by `eaipSubscribeView`
+ * @param userData[void *] passed to `viewHandler`
+ */
 typedef struct eaipSubRequest {
     char *targetId;
     char *dataId;
     messageHandler handler;
+    binaryMessageHandler binaryHandler;
+    eaipMessageViewHandler viewHandler;
+    void *userData;
 } eaipSubRequest_t;
 
+/*!
+ * @brief storage of a subscription made with `eaipSubscribeView`
+ *
+ * Holds what is known about the topic at subscription time, so the views of a received message
+ * are computed from the topic length instead of parsing the topic again. Only a topic subscribed
+ * with `+` as device and data-ID is searched, for the end of the device-ID.
+ *
+ * IMPORTANT: All fields are managed by `eaipSubscribeView` and must not be modified by the user.
+ */
+typedef struct eaipViewSubscription {
+    eaipMessageViewHandler handler;
+    void *userData;
+    topic_t type;
+    size_t deviceIdStart;
+    size_t deviceIdLength;
+    size_t suffixLength;
+    bool anyDevice;
+    bool anyDataId;
+} eaipViewSubscription_t;
+
 /* endregion Requests */
 
 /* region PUBLISH */
@@ -120,6 +433,55 @@ eaipCommunicationErrorCodes eaipPublishStatus(eaiProtocol_t config, eaipDeviceSt
  */
 eaipCommunicationErrorCodes eaipPublishData(eaiProtocol_t config, eaipPubRequest_t request);
 
+/*!
+ * @brief publish binary data
+ *
+ * @param config[eaiProtocol_t] configuration, `publishBinary` has to be set
+ * @param request[eaipPubReuest_t] request
+ *                                 deviceId -> unused
+ *                                 dataId -> data-ID to publish for
+ *                                 data -> data to publish
+ *                                 length -> length of the data
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipPublishDataBinary(eaiProtocol_t config, eaipPubRequest_t request);
+
+/*!
+ * @brief publish a float with the shortest representation that reads back to the same value
+ *
+ * @param config[eaiProtocol_t] configuration
+ * @param dataId[char *] data-ID to publish for
+ * @param value[float] value to publish
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipPublishDataFloat(eaiProtocol_t config, char *dataId, float value);
+
+/*!
+ * @brief publish an integer
+ *
+ * @param config[eaiProtocol_t] configuration
+ * @param dataId[char *] data-ID to publish for
+ * @param value[int32_t] value to publish
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipPublishDataInt(eaiProtocol_t config, char *dataId, int32_t value);
+
+/*!
+ * @brief publish floats as comma separated values
+ *
+ * @param config[eaiProtocol_t] configuration
+ * @param dataId[char *] data-ID to publish for
+ * @param values[float *] values to publish
+ * @param count[size_t] number of values
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipPublishDataVector(eaiProtocol_t config, char *dataId,
+                                                  const float *values, size_t count);
+
 /*!
  * @brief publish data start request
  *
@@ -202,6 +564,20 @@ eaipCommunicationErrorCodes eaipSubscribeStatus(eaiProtocol_t config, eaipSubReq
  */
 eaipCommunicationErrorCodes eaipSubscribeData(eaiProtocol_t config, eaipSubRequest_t request);
 
+/*!
+ * @brief subscribe to binary data
+ *
+ * @param config[eaiProtocol_t] configuration, `subscribeBinary` has to be set
+ * @param request[eaipSubRequest] request
+ *                                targetId -> target device to subscribe data
+ *                                dataId -> id of data field to subscribe
+ *                                binaryHandler -> function to handle received data
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSubscribeDataBinary(eaiProtocol_t config,
+                                                    eaipSubRequest_t request);
+
 /*!
  * @brief subscribe to start requests
  *
@@ -254,6 +630,42 @@ eaipCommunicationErrorCodes eaipSubscribeDo(eaiProtocol_t config, eaipSubRequest
  */
 eaipCommunicationErrorCodes eaipSubscribeDone(eaiProtocol_t config, eaipSubRequest_t request);
 
+/*!
+ * @brief subscribe to messages of any type with a handler receiving views on the message
+ *
+ * The device of the topic is `targetId` for `STATUS`, `DATA` and `DONE` and the own device for
+ * `START`, `STOP` and `DO`, like for the other subscribe functions. Both `targetId` and `dataId`
+ * may be `+`. The handler gets topic and payload with their lengths, the message type, device-ID
+ * and data-ID, without any copy or allocation:
+ *
+ * ```c
+ * void handleData(const eaipMessageView_t *message, void *userData) {
+ *     sensor_t *sensor = userData;
+ *     eaipParseDataFloat((const char *)message->payload, message->length, &sensor->value);
+ * }
+ * ...
+ * eaipSubRequest_t request = {.targetId = "+", .dataId = "temperature",
+ *                             .viewHandler = &handleData, .userData = &sensor};
+ * eaipSubscribeView(config, DATA, request, &subscription);
+ * ```
+ *
+ * @param config[eaiProtocol_t] configuration, `subscribeView` or `endpoint` has to provide it
+ * @param type[topic_t] message type to subscribe
+ * @param request[eaipSubRequest] request
+ *                                targetId -> target device, unused for START, STOP and DO
+ *                                dataId -> data-ID or command, unused for STATUS
+ *                                viewHandler -> function to handle received messages
+ *                                userData -> passed to `viewHandler`
+ * @param subscription[eaipViewSubscription_t *] storage of the subscription, has to stay valid
+ *                                               until the topic is unsubscribed
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_NOT_SUPPORTED if the endpoint does not provide `subscribeView`
+ */
+eaipCommunicationErrorCodes eaipSubscribeView(eaiProtocol_t config, topic_t type,
+                                              eaipSubRequest_t request,
+                                              eaipViewSubscription_t *subscription);
+
 /* endregion SUBSCRIBE */
 
 /* region UNSUBSCRIBE */
@@ -336,6 +748,18 @@ eaipCommunicationErrorCodes eaipUnsubscribeDo(eaiProtocol_t config, eaipSubReque
  */
 eaipCommunicationErrorCodes eaipUnsubscribeDone(eaiProtocol_t config, eaipSubRequest_t request);
 
+/*!
+ * @brief unsubscribe a subscription made with `eaipSubscribeView`
+ *
+ * @param config[eaiProtocol_t] configuration
+ * @param type[topic_t] message type given on subscription
+ * @param request[eaipSubRequest] request given on subscription, handler fields are unused
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipUnsubscribeView(eaiProtocol_t config, topic_t type,
+                                                eaipSubRequest_t request);
+
 /* endregion UNSUBSCRIBE */
 
 #endif /* EAI_PROTOCOL_PROTOCOL_HEADER */
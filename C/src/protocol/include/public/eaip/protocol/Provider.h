@@ -0,0 +1,163 @@
+#ifndef EAI_PROTOCOL_PROVIDER_HEADER
+#define EAI_PROTOCOL_PROVIDER_HEADER
+
+/*!
+ * Consumer aware DATA publishing for the elastic-AI protocol library
+ *
+ * A provider registers a START and a STOP route on a router for every offered data-ID and keeps
+ * track of the requesters that started a stream. Publishing to a stream without any consumer
+ * returns immediately without contacting the broker:
+ *
+ * ```c
+ * eaipStream_t *temperature;
+ * eaipProviderRegister(&provider, "temperature", &temperature);
+ * ...
+ * if (eaipStreamHasConsumers(temperature)) {
+ *     eaipProviderPublishData(&provider, temperature, measureTemperature());
+ * }
+ * ```
+ *
+ * The router has to be subscribed, see "eaip/protocol/Router.h".
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Router.h"
+
+typedef struct eaipProvider eaipProvider_t;
+typedef struct eaipConsumer eaipConsumer_t;
+
+/*!
+ * @brief a data-ID offered by a provider
+ *
+ * @param provider[eaipProvider_t *] provider the stream belongs to
+ * @param dataId[char *] data-ID of the stream, NULL if the entry is unused
+ * @param topic[char *] `<baseUrl>/<deviceId>/DATA/<dataId>`
+ * @param consumers[size_t] number of distinct requesters that started the stream
+ * @param firstConsumer[eaipConsumer_t *] list of the requesters that started the stream
+ *
+ * IMPORTANT: Managed by the provider, considered private.
+ */
+typedef struct eaipStream {
+    eaipProvider_t *provider;
+    char *dataId;
+    char *topic;
+    size_t consumers;
+    eaipConsumer_t *firstConsumer;
+} eaipStream_t;
+
+/*!
+ * @brief a requester that started a stream
+ *
+ * @param stream[eaipStream_t *] started stream, NULL if the entry is unused
+ * @param hash[uint32_t] hash of `requester`
+ * @param requester[char *] `<baseUrl>/<deviceId>` of the requester
+ * @param references[size_t] number of START requests not yet matched by a STOP request
+ * @param previous[eaipConsumer_t *] previous consumer of the same stream
+ * @param next[eaipConsumer_t *] next consumer of the same stream, next unused entry if unused
+ *
+ * IMPORTANT: Managed by the provider, considered private.
+ */
+struct eaipConsumer {
+    eaipStream_t *stream;
+    uint32_t hash;
+    char *requester;
+    size_t references;
+    eaipConsumer_t *previous;
+    eaipConsumer_t *next;
+};
+
+/*!
+ * @brief struct holding the streams of a provider and their consumers
+ *
+ * @param router[eaipRouter_t *] router receiving the START and STOP requests
+ * @param streams[eaipStream_t *] registered streams
+ * @param streamCapacity[size_t] number of entries in `streams`
+ * @param consumers[eaipConsumer_t *] consumers of all streams
+ * @param consumerCapacity[size_t] number of entries in `consumers`
+ * @param unusedConsumers[eaipConsumer_t *] list of the unused entries in `consumers`
+ *
+ * IMPORTANT: All fields are managed by the `eaipProvider*` functions and must not be modified by
+ *            the user.
+ */
+struct eaipProvider {
+    eaipRouter_t *router;
+    eaipStream_t *streams;
+    size_t streamCapacity;
+    eaipConsumer_t *consumers;
+    size_t consumerCapacity;
+    eaipConsumer_t *unusedConsumers;
+};
+
+/*!
+ * @brief initialize a provider
+ *
+ * @param provider[eaipProvider_t *] provider to initialize
+ * @param router[eaipRouter_t *] initialized router with room for two routes per stream, has to
+ *                               outlive the provider
+ * @param streamCapacity[size_t] maximum number of streams
+ * @param consumerCapacity[size_t] maximum number of (stream, requester) pairs tracked at once
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipProviderInit(eaipProvider_t *provider, eaipRouter_t *router,
+                                             size_t streamCapacity, size_t consumerCapacity);
+
+/*!
+ * @brief unregister all streams and release the memory held by a provider
+ *
+ * @param provider[eaipProvider_t *] provider to release
+ */
+void eaipProviderFree(eaipProvider_t *provider);
+
+/*!
+ * @brief offer a data-ID and start tracking its consumers
+ *
+ * @param provider[eaipProvider_t *] initialized provider
+ * @param dataId[char *] data-ID to offer; the provider keeps a copy
+ * @param stream[eaipStream_t **] receives the stream, valid until it is unregistered
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_TOPIC_ALREADY_SUBSCRIBED if the data-ID is already registered on the router,
+ *         EAIP_COM_OUT_OF_MEMORY if the capacity of the provider or router is exhausted
+ */
+eaipCommunicationErrorCodes eaipProviderRegister(eaipProvider_t *provider, const char *dataId,
+                                                 eaipStream_t **stream);
+
+/*!
+ * @brief stop offering a stream and forget its consumers
+ *
+ * @param provider[eaipProvider_t *] initialized provider
+ * @param stream[eaipStream_t *] registered stream
+ */
+void eaipProviderUnregister(eaipProvider_t *provider, eaipStream_t *stream);
+
+/*!
+ * @brief check if at least one requester started the stream
+ *
+ * Allows to skip acquiring and formatting data nobody consumes.
+ *
+ * @param stream[eaipStream_t *] registered stream
+ *
+ * @return true if the stream has consumers
+ */
+static inline bool eaipStreamHasConsumers(const eaipStream_t *stream) {
+    return stream->consumers > 0;
+}
+
+/*!
+ * @brief publish data to a stream if it has consumers
+ *
+ * @param provider[eaipProvider_t *] initialized provider
+ * @param stream[eaipStream_t *] registered stream
+ * @param data[char *] data to publish
+ *
+ * @return 0 if no error occurred or the stream has no consumers
+ */
+eaipCommunicationErrorCodes eaipProviderPublishData(const eaipProvider_t *provider,
+                                                    const eaipStream_t *stream, char *data);
+
+#endif /* EAI_PROTOCOL_PROVIDER_HEADER */
@@ -0,0 +1,153 @@
+#ifndef EAI_PROTOCOL_ROUTER_HEADER
+#define EAI_PROTOCOL_ROUTER_HEADER
+
+/*!
+ * Message router for the elastic-AI protocol library
+ *
+ * Instead of one broker subscription per message type and data-ID, the router subscribes once to
+ * `<baseUrl>/<deviceId>/#` and dispatches received messages to handlers registered for a
+ * (message type, data-ID) pair. Handlers are looked up in an open addressing hash table.
+ *
+ * Because `messageHandler` does not carry a context, the user has to provide a small forwarding
+ * function calling `eaipRouterDispatch` for the router:
+ *
+ * ```c
+ * eaipRouter_t router;
+ * void routeMessage(char *topic, char *message) {
+ *     eaipRouterDispatch(&router, topic, message);
+ * }
+ * ...
+ * eaipRouterSubscribe(&router, &routeMessage);
+ * ```
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Session.h"
+
+/*!
+ * @brief function pointer for handler to process a routed message
+ *
+ * @param topic[eaipTopicView_t *] decoded topic of the received message
+ * @param message[char *] received message
+ * @param userData[void *] pointer given on registration
+ */
+typedef void (*eaipRouteHandler)(const eaipTopicView_t *topic, char *message, void *userData);
+
+/*!
+ * @brief entry of the routing table
+ *
+ * IMPORTANT: Managed by the router, considered private.
+ */
+typedef struct eaipRoute {
+    uint32_t hash;
+    topic_t type;
+    char *dataId;
+    size_t dataIdLength;
+    eaipRouteHandler handler;
+    void *userData;
+} eaipRoute_t;
+
+/*!
+ * @brief struct holding the routing table
+ *
+ * @param session[eaipSession_t *] session the router belongs to
+ * @param routes[eaipRoute_t *] open addressing hash table, unused entries have no handler
+ * @param tableSize[size_t] number of entries in `routes`, always a power of two
+ * @param capacity[size_t] maximum number of registered routes
+ * @param count[size_t] number of registered routes
+ *
+ * IMPORTANT: All fields are managed by the `eaipRouter*` functions and must not be modified by the
+ *            user.
+ */
+typedef struct eaipRouter {
+    const eaipSession_t *session;
+    eaipRoute_t *routes;
+    size_t tableSize;
+    size_t capacity;
+    size_t count;
+} eaipRouter_t;
+
+/*!
+ * @brief initialize a router
+ *
+ * @param router[eaipRouter_t *] router to initialize
+ * @param session[eaipSession_t *] initialized session, has to outlive the router
+ * @param capacity[size_t] maximum number of routes
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipRouterInit(eaipRouter_t *router, const eaipSession_t *session,
+                                           size_t capacity);
+
+/*!
+ * @brief release the memory held by a router
+ *
+ * @param router[eaipRouter_t *] router to release
+ */
+void eaipRouterFree(eaipRouter_t *router);
+
+/*!
+ * @brief register a handler for a message type and data-ID
+ *
+ * @param router[eaipRouter_t *] initialized router
+ * @param type[topic_t] message type to route
+ * @param dataId[char *] data-ID or command to route, NULL for `STATUS`; the router keeps a copy
+ * @param handler[eaipRouteHandler] function to handle routed messages
+ * @param userData[void *] pointer passed to the handler
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_TOPIC_ALREADY_SUBSCRIBED if a handler is already registered,
+ *         EAIP_COM_OUT_OF_MEMORY if the capacity of the router is exhausted
+ */
+eaipCommunicationErrorCodes eaipRouterRegister(eaipRouter_t *router, topic_t type,
+                                               const char *dataId, eaipRouteHandler handler,
+                                               void *userData);
+
+/*!
+ * @brief remove the handler for a message type and data-ID
+ *
+ * @param router[eaipRouter_t *] initialized router
+ * @param type[topic_t] message type of the route
+ * @param dataId[char *] data-ID or command of the route, NULL for `STATUS`
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipRouterUnregister(eaipRouter_t *router, topic_t type,
+                                                 const char *dataId);
+
+/*!
+ * @brief subscribe to `<baseUrl>/<deviceId>/#`
+ *
+ * @param router[eaipRouter_t *] initialized router
+ * @param handler[messageHandler] function forwarding received messages to `eaipRouterDispatch`
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipRouterSubscribe(const eaipRouter_t *router,
+                                                messageHandler handler);
+
+/*!
+ * @brief unsubscribe from `<baseUrl>/<deviceId>/#`
+ *
+ * @param router[eaipRouter_t *] initialized router
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipRouterUnsubscribe(const eaipRouter_t *router);
+
+/*!
+ * @brief decode a received message and call the registered handler
+ *
+ * @param router[eaipRouter_t *] initialized router
+ * @param topic[char *] topic of the received message
+ * @param message[char *] received message
+ *
+ * @return true if a handler was called
+ */
+bool eaipRouterDispatch(const eaipRouter_t *router, char *topic, char *message);
+
+#endif /* EAI_PROTOCOL_ROUTER_HEADER */
@@ -0,0 +1,185 @@
+#ifndef EAI_PROTOCOL_SCHEDULER_HEADER
+#define EAI_PROTOCOL_SCHEDULER_HEADER
+
+/*!
+ * Prioritized outbound scheduling for the elastic-AI protocol library
+ *
+ * The scheduler queues messages in lanes, each backed by an outbox (see
+ * "eaip/protocol/Outbox.h"). Control traffic (STATUS, START, STOP, DO, DONE) goes to the control
+ * lane, which has strict priority: it is drained completely before every single bulk message, so
+ * a control message waits for at most one bulk message that is being published.
+ *
+ * DATA streams go to one or more bulk lanes. Bulk lanes share the remaining capacity of the
+ * transport by deficit round robin: per round a lane may publish `weight * EAIP_SCHEDULER_QUANTUM`
+ * bytes of topic and message, so a lane with twice the weight gets twice the bandwidth while all
+ * lanes have data queued.
+ *
+ * ```c
+ * eaipScheduler_t scheduler;
+ * size_t sensors, logs;
+ * eaipSchedulerInit(&scheduler, config, 16, EAIP_OUTBOX_RECORD_SIZE);
+ * eaipSchedulerAddBulkLane(&scheduler, 256, 3, EAIP_OVERFLOW_DROP_OLDEST, &sensors);
+ * eaipSchedulerAddBulkLane(&scheduler, 256, 1, EAIP_OVERFLOW_DROP_NEWEST, &logs);
+ * ...
+ * eaipSchedulerPublishData(&scheduler, sensors, &session, request);
+ * ...
+ * eaipSchedulerDrain(&scheduler, 32); // in the thread owning the transport
+ * ```
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eaip/protocol/Outbox.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Session.h"
+
+/*!
+ * @brief maximum number of bulk lanes
+ */
+#ifndef EAIP_SCHEDULER_BULK_LANES
+#define EAIP_SCHEDULER_BULK_LANES 4
+#endif
+
+/*!
+ * @brief bytes a bulk lane of weight 1 may publish per round
+ */
+#ifndef EAIP_SCHEDULER_QUANTUM
+#define EAIP_SCHEDULER_QUANTUM 256
+#endif
+
+/*!
+ * @brief a bulk lane
+ *
+ * @param outbox[eaipOutbox_t] queued messages
+ * @param weight[uint32_t] share of the bulk capacity relative to the other lanes
+ * @param deficit[size_t] bytes the lane may still publish in the current round
+ *
+ * IMPORTANT: Managed by the scheduler, considered private.
+ */
+typedef struct eaipLane {
+    eaipOutbox_t outbox;
+    uint32_t weight;
+    size_t deficit;
+} eaipLane_t;
+
+/*!
+ * @brief struct holding the lanes of a scheduler
+ *
+ * @param control[eaipOutbox_t] lane for control messages
+ * @param bulk[eaipLane_t] lanes for DATA messages
+ * @param bulkLanes[size_t] number of used entries in `bulk`
+ * @param current[size_t] bulk lane whose turn it is
+ * @param granted[bool] whether `current` already received its quantum for this turn
+ * @param recordSize[size_t] size of a record of every lane
+ *
+ * IMPORTANT: All fields are managed by the `eaipScheduler*` functions and must not be modified by
+ *            the user.
+ */
+typedef struct eaipScheduler {
+    eaipOutbox_t control;
+    eaipLane_t bulk[EAIP_SCHEDULER_BULK_LANES];
+    size_t bulkLanes;
+    size_t current;
+    bool granted;
+    size_t recordSize;
+} eaipScheduler_t;
+
+/*!
+ * @brief initialize a scheduler and its control lane
+ *
+ * The control lane accepts messages from multiple threads and blocks if it is full; control
+ * messages are never dropped.
+ *
+ * @param scheduler[eaipScheduler_t *] scheduler to initialize
+ * @param config[eaiProtocol_t] configuration providing the `publish` function
+ * @param controlCapacity[size_t] minimum number of records of the control lane
+ * @param recordSize[size_t] size of a record of every lane, e.g. `EAIP_OUTBOX_RECORD_SIZE`
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSchedulerInit(eaipScheduler_t *scheduler, eaiProtocol_t config,
+                                              size_t controlCapacity, size_t recordSize);
+
+/*!
+ * @brief release all lanes of a scheduler, queued messages are discarded
+ *
+ * @param scheduler[eaipScheduler_t *] scheduler to release
+ */
+void eaipSchedulerFree(eaipScheduler_t *scheduler);
+
+/*!
+ * @brief add a lane for DATA messages
+ *
+ * The lane accepts messages from multiple threads, except for `EAIP_OVERFLOW_DROP_OLDEST`.
+ *
+ * @param scheduler[eaipScheduler_t *] initialized scheduler
+ * @param capacity[size_t] minimum number of records of the lane
+ * @param weight[uint32_t] share of the bulk capacity, at least 1
+ * @param policy[eaipOverflowPolicy_t] behaviour if the lane is full
+ * @param lane[size_t *] receives the index of the lane
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_OUT_OF_MEMORY if `EAIP_SCHEDULER_BULK_LANES` lanes are in use
+ */
+eaipCommunicationErrorCodes eaipSchedulerAddBulkLane(eaipScheduler_t *scheduler, size_t capacity,
+                                                     uint32_t weight, eaipOverflowPolicy_t policy,
+                                                     size_t *lane);
+
+/*!
+ * @brief queue a control message
+ *
+ * @param scheduler[eaipScheduler_t *] initialized scheduler
+ * @param topic[char *] topic to publish to
+ * @param message[char *] message to publish
+ * @param retain[bool] whether the broker should retain the message
+ *
+ * @return see `eaipOutboxPublish`
+ */
+eaipCommunicationErrorCodes eaipSchedulerPublishControl(eaipScheduler_t *scheduler,
+                                                        const char *topic, const char *message,
+                                                        bool retain);
+
+/*!
+ * @brief queue a message in a bulk lane
+ *
+ * @param scheduler[eaipScheduler_t *] initialized scheduler
+ * @param lane[size_t] index of the bulk lane
+ * @param topic[char *] topic to publish to
+ * @param message[char *] message to publish
+ *
+ * @return see `eaipOutboxPublish`,
+ *         EAIP_COM_GENERIC_ERROR if the lane was not added
+ */
+eaipCommunicationErrorCodes eaipSchedulerPublishBulk(eaipScheduler_t *scheduler, size_t lane,
+                                                     const char *topic, const char *message);
+
+/*!
+ * @brief queue a DATA message in a bulk lane
+ *
+ * @param scheduler[eaipScheduler_t *] initialized scheduler
+ * @param lane[size_t] index of the bulk lane
+ * @param session[eaipSession_t *] session providing the topic prefix
+ * @param request[eaipPubRequest_t] see `eaipOutboxPublishData`
+ *
+ * @return see `eaipOutboxPublish`,
+ *         EAIP_COM_GENERIC_ERROR if the lane was not added
+ */
+eaipCommunicationErrorCodes eaipSchedulerPublishData(eaipScheduler_t *scheduler, size_t lane,
+                                                     const eaipSession_t *session,
+                                                     eaipPubRequest_t request);
+
+/*!
+ * @brief forward queued messages by priority to the `publish` function of the configuration
+ *
+ * Must only be called by a single thread at the same time.
+ *
+ * @param scheduler[eaipScheduler_t *] initialized scheduler
+ * @param limit[size_t] maximum number of messages to forward
+ *
+ * @return number of messages published
+ */
+size_t eaipSchedulerDrain(eaipScheduler_t *scheduler, size_t limit);
+
+#endif /* EAI_PROTOCOL_SCHEDULER_HEADER */
@@ -0,0 +1,489 @@
+#ifndef EAI_PROTOCOL_SESSION_HEADER
+#define EAI_PROTOCOL_SESSION_HEADER
+
+/*!
+ * Session based API for the elastic-AI protocol library
+ *
+ * A session formats the topic prefixes of its participant once on initialization.
+ * Publishing or subscribing afterwards only appends the message specific suffix, instead of
+ * formatting the complete topic on every call like the functions from
+ * "eaip/protocol/Protocol.h".
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eaip/protocol/Protocol.h"
+
+/* region SESSION */
+
+/*!
+ * @brief struct holding the precomputed topics of a participant
+ *
+ * @param config[eaiProtocol_t] configuration the session was created from
+ * @param requester[char *] `<baseUrl>/<deviceId>`, send as message for START/STOP requests
+ * @param requesterLength[size_t] length of `requester`
+ * @param baseUrlLength[size_t] length of the `<baseUrl>/` prefix at the start of `requester`
+ * @param prefixes[char *] `<baseUrl>/<deviceId>/<TYPE>/` for every message type
+ *                         (`<baseUrl>/<deviceId>/STATUS` for `STATUS`)
+ * @param prefixLengths[size_t] length of the entries in `prefixes`
+ * @param statusDigest[uint64_t] FNV-1a hash of the last successfully published status
+ * @param statusPublished[bool] whether `statusDigest` is valid
+ *
+ * IMPORTANT: All fields are managed by `eaipSessionInit` and `eaipSessionFree` and must not be
+ *            modified by the user.
+ */
+typedef struct eaipSession {
+    eaiProtocol_t config;
+    char *requester;
+    size_t requesterLength;
+    size_t baseUrlLength;
+    char *prefixes[EAIP_TOPIC_TYPES];
+    size_t prefixLengths[EAIP_TOPIC_TYPES];
+    uint64_t statusDigest;
+    bool statusPublished;
+} eaipSession_t;
+
+/*!
+ * @brief initialize a session and precompute all topic prefixes
+ *
+ * @param session[eaipSession_t *] session to initialize
+ * @param config[eaiProtocol_t] configuration
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionInit(eaipSession_t *session, eaiProtocol_t config);
+
+/*!
+ * @brief release the memory held by a session
+ *
+ * @param session[eaipSession_t *] session to release
+ */
+void eaipSessionFree(eaipSession_t *session);
+
+/* endregion SESSION */
+
+/* region TOPIC */
+
+/*!
+ * @brief views on the parts of a received topic
+ *
+ * @param deviceId[eaipStringView_t] device the topic belongs to
+ * @param type[topic_t] message type of the topic
+ * @param dataId[eaipStringView_t] data-ID or command, empty for `STATUS`
+ */
+typedef struct eaipTopicView {
+    eaipStringView_t deviceId;
+    topic_t type;
+    eaipStringView_t dataId;
+} eaipTopicView_t;
+
+/*!
+ * @brief split a `<baseUrl>/<deviceId>/<TYPE>[/<dataId>]` topic in a single pass
+ *
+ * The views point into `topic`, which is neither copied nor modified.
+ *
+ * @param session[eaipSession_t *] session providing the base url
+ * @param topic[char *] received topic, does not need to be `\0` terminated
+ * @param length[size_t] length of the topic
+ * @param view[eaipTopicView_t *] receives the parts of the topic
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_INVALID_TOPIC if the topic does not follow the protocol
+ */
+eaipCommunicationErrorCodes eaipDecodeTopic(const eaipSession_t *session, const char *topic,
+                                            size_t length, eaipTopicView_t *view);
+
+/* endregion TOPIC */
+
+/* region PUBLISH */
+
+/*!
+ * @brief publish state
+ *
+ * The session remembers a digest of the last published status. If the serialized status is
+ * identical to it, the retained message is not published again.
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param status[status_t] status to publish
+ *
+ * @return 0 if no error occurred or the status did not change
+ */
+eaipCommunicationErrorCodes eaipSessionPublishStatus(eaipSession_t *session,
+                                                     eaipDeviceState_t status);
+
+/*!
+ * @brief set the value of a single additional status field and republish the status if it changed
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param status[eaipDeviceState_t] complete status, containing the field in `additionalFields`
+ * @param id[char *] id of the field to update
+ * @param data[char *] new value of the field, has to stay valid as long as the field is used
+ *
+ * @return 0 if no error occurred or the status did not change,
+ *         EAIP_COM_INVALID_MESSAGE if `status` has no field with the given id
+ */
+eaipCommunicationErrorCodes eaipSessionUpdateStatusField(eaipSession_t *session,
+                                                         eaipDeviceState_t status, const char *id,
+                                                         char *data);
+
+/*!
+ * @brief forget the last published status, so the next status is published in any case
+ *
+ * Required if the broker lost its retained messages, e.g. after reconnecting to a new broker.
+ *
+ * @param session[eaipSession_t *] initialized session
+ */
+void eaipSessionInvalidateStatus(eaipSession_t *session);
+
+/*!
+ * @brief publish data
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipPubReuest_t] request
+ *                                 deviceId -> unused
+ *                                 dataId -> data-ID to publish for
+ *                                 data -> data to publish
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionPublishData(const eaipSession_t *session,
+                                                   eaipPubRequest_t request);
+
+/*!
+ * @brief publish binary data
+ *
+ * @param session[eaipSession_t *] initialized session, `publishBinary` has to be set
+ * @param request[eaipPubReuest_t] request
+ *                                 deviceId -> unused
+ *                                 dataId -> data-ID to publish for
+ *                                 data -> data to publish
+ *                                 length -> length of the data
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionPublishDataBinary(const eaipSession_t *session,
+                                                         eaipPubRequest_t request);
+
+/*!
+ * @brief publish an array of floats as binary data without conversion
+ *
+ * The values are sent in the native byte order of the device (little endian on all supported
+ * targets), 4 bytes per value.
+ *
+ * @param session[eaipSession_t *] initialized session, `publishBinary` has to be set
+ * @param dataId[char *] data-ID to publish for
+ * @param values[float *] values to publish
+ * @param count[size_t] number of values
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionPublishDataFloatArray(const eaipSession_t *session,
+                                                             char *dataId, const float *values,
+                                                             size_t count);
+
+/*!
+ * @brief publish an array of 16 bit integers as binary data without conversion
+ *
+ * The values are sent in the native byte order of the device (little endian on all supported
+ * targets), 2 bytes per value.
+ *
+ * @param session[eaipSession_t *] initialized session, `publishBinary` has to be set
+ * @param dataId[char *] data-ID to publish for
+ * @param values[int16_t *] values to publish
+ * @param count[size_t] number of values
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionPublishDataInt16Array(const eaipSession_t *session,
+                                                             char *dataId, const int16_t *values,
+                                                             size_t count);
+
+/*!
+ * @brief publish a float with the shortest representation that reads back to the same value
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param dataId[char *] data-ID to publish for
+ * @param value[float] value to publish
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionPublishDataFloat(const eaipSession_t *session,
+                                                        char *dataId, float value);
+
+/*!
+ * @brief publish an integer
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param dataId[char *] data-ID to publish for
+ * @param value[int32_t] value to publish
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionPublishDataInt(const eaipSession_t *session, char *dataId,
+                                                      int32_t value);
+
+/*!
+ * @brief publish floats as comma separated values
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param dataId[char *] data-ID to publish for
+ * @param values[float *] values to publish
+ * @param count[size_t] number of values
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionPublishDataVector(const eaipSession_t *session,
+                                                         char *dataId, const float *values,
+                                                         size_t count);
+
+/*!
+ * @brief publish data start request
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipPubReuest_t] request
+ *                                 deviceId -> device-ID to start requesting data from
+ *                                 dataId -> name of the data field to start requesting data
+ *                                 data -> unused
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionPublishStart(const eaipSession_t *session,
+                                                    eaipPubRequest_t request);
+
+/*!
+ * @brief publish data stop request
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipPubReuest_t] request
+ *                                 deviceId -> device-ID to stop requesting data from
+ *                                 dataId -> name of the data field to stop requesting data
+ *                                 data -> unused
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionPublishStop(const eaipSession_t *session,
+                                                   eaipPubRequest_t request);
+
+/*!
+ * @brief publish command
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipPubReuest_t] request
+ *                                 deviceId -> device-ID to publish command for
+ *                                 dataId -> command to publish
+ *                                 data -> settings to give with command
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionPublishDo(const eaipSession_t *session,
+                                                 eaipPubRequest_t request);
+
+/*!
+ * @brief publish command execution result
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipPubReuest_t] request
+ *                                 deviceId -> unused
+ *                                 dataId -> command to publish execution result for
+ *                                 data -> status of command execution
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionPublishDone(const eaipSession_t *session,
+                                                   eaipPubRequest_t request);
+
+/* endregion PUBLISH */
+
+/* region SUBSCRIBE */
+
+/*!
+ * @brief subscribe to state updates
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipSubRequest] request
+ *                                targetId -> target device to subscribe states
+ *                                dataId -> unused
+ *                                handler -> function to handle received states
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionSubscribeStatus(const eaipSession_t *session,
+                                                       eaipSubRequest_t request);
+
+/*!
+ * @brief subscribe to data
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipSubRequest] request
+ *                                targetId -> target device to subscribe data
+ *                                dataId -> id of data field to subscribe
+ *                                handler -> function to handle received data
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionSubscribeData(const eaipSession_t *session,
+                                                     eaipSubRequest_t request);
+
+/*!
+ * @brief subscribe to binary data
+ *
+ * @param session[eaipSession_t *] initialized session, `subscribeBinary` has to be set
+ * @param request[eaipSubRequest] request
+ *                                targetId -> target device to subscribe data
+ *                                dataId -> id of data field to subscribe
+ *                                binaryHandler -> function to handle received data
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionSubscribeDataBinary(const eaipSession_t *session,
+                                                           eaipSubRequest_t request);
+
+/*!
+ * @brief subscribe to start requests
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipSubRequest] request
+ *                                targetId -> unused
+ *                                dataId -> id of data field to subscribe
+ *                                handler -> function to handle received requests
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionSubscribeStart(const eaipSession_t *session,
+                                                      eaipSubRequest_t request);
+
+/*!
+ * @brief subscribe to stop requests
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipSubRequest] request
+ *                                targetId -> unused
+ *                                dataId -> id of data field to subscribe
+ *                                handler -> function to handle received requests
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionSubscribeStop(const eaipSession_t *session,
+                                                     eaipSubRequest_t request);
+
+/*!
+ * @brief subscribe to command
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipSubRequest] request
+ *                                targetId -> unused
+ *                                dataId -> command to subscribe for
+ *                                handler -> function to handle received requests
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionSubscribeDo(const eaipSession_t *session,
+                                                   eaipSubRequest_t request);
+
+/*!
+ * @brief subscribe to command execution results
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipSubRequest] request
+ *                                targetId -> target device to subscribe data
+ *                                dataId -> command to subscribe
+ *                                handler -> function to handle received data
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionSubscribeDone(const eaipSession_t *session,
+                                                     eaipSubRequest_t request);
+
+/* endregion SUBSCRIBE */
+
+/* region UNSUBSCRIBE */
+
+/*!
+ * @brief unsubscribe from state updates
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipSubRequest] request
+ *                                targetId -> target device to unsubscribe states
+ *                                dataId -> unused
+ *                                handler -> unused
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionUnsubscribeStatus(const eaipSession_t *session,
+                                                         eaipSubRequest_t request);
+
+/*!
+ * @brief unsubscribe from data
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipSubRequest] request
+ *                                targetId -> target device to unsubscribe data
+ *                                dataId -> data-id to unsubscribe
+ *                                handler -> unused
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionUnsubscribeData(const eaipSession_t *session,
+                                                       eaipSubRequest_t request);
+
+/*!
+ * @brief unsubscribe from data start requests
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipSubRequest] request
+ *                                targetId -> unused
+ *                                dataId -> data-id to unsubscribe
+ *                                handler -> unused
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionUnsubscribeStart(const eaipSession_t *session,
+                                                        eaipSubRequest_t request);
+
+/*!
+ * @brief unsubscribe from data stop requests
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipSubRequest] request
+ *                                targetId -> unused
+ *                                dataId -> data-id to unsubscribe
+ *                                handler -> unused
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionUnsubscribeStop(const eaipSession_t *session,
+                                                       eaipSubRequest_t request);
+
+/*!
+ * @brief unsubscribe from command requests
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipSubRequest] request
+ *                                targetId -> unused
+ *                                dataId -> command to unsubscribe
+ *                                handler -> unused
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionUnsubscribeDo(const eaipSession_t *session,
+                                                     eaipSubRequest_t request);
+
+/*!
+ * @brief unsubscribe from command execution states
+ *
+ * @param session[eaipSession_t *] initialized session
+ * @param request[eaipSubRequest] request
+ *                                targetId -> target device to unsubscribe
+ *                                dataId -> command to unsubscribe
+ *                                handler -> unused
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSessionUnsubscribeDone(const eaipSession_t *session,
+                                                       eaipSubRequest_t request);
+
+/* endregion UNSUBSCRIBE */
+
+#endif /* EAI_PROTOCOL_SESSION_HEADER */
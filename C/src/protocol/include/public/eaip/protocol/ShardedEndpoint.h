@@ -0,0 +1,100 @@
+#ifndef EAI_PROTOCOL_SHARDED_ENDPOINT_HEADER
+#define EAI_PROTOCOL_SHARDED_ENDPOINT_HEADER
+
+/*!
+ * Endpoint spreading messages over several connections
+ *
+ * A sharded endpoint forwards every call to one of N underlying endpoints, chosen by the hash of
+ * the topic or of the device-ID in the topic. Messages with the same key therefore always take the
+ * same connection and keep their order, while different streams are spread over all of them, e.g.
+ * to get past the throughput of a single socket on a gateway:
+ *
+ * ```c
+ * eaipEndpoint_t shards[4] = {{&mqttEndpointInterface, &connections[0]}, ...};
+ * eaipShardedEndpoint_t sharded;
+ * eaipShardedEndpointInit(&sharded, shards, 4, EAIP_SHARD_BY_DEVICE, "eaip://uni-due.de/es");
+ *
+ * eaiProtocol_t config = {.baseUrl = ..., .deviceId = ...,
+ *                         .endpoint = {&eaipShardedEndpointInterface, &sharded}};
+ * eaipPublishData(config, request);
+ * ```
+ *
+ * Subscriptions are spread by the hash of their filter the same way, so unsubscribing reaches the
+ * connection that subscribed. Overlapping filters on different connections may deliver a message
+ * once per connection.
+ */
+
+#include <stddef.h>
+
+#include "eaip/endpoint/CommunicationEndpoint.h"
+#include "eaip/protocol/Protocol.h"
+
+/*!
+ * @brief part of the topic that selects the connection
+ *
+ * EAIP_SHARD_BY_TOPIC -> the complete topic, messages keep their order per topic,
+ *                        e.g. per data-ID of a device
+ * EAIP_SHARD_BY_DEVICE -> the device-ID following the base URL, all messages of a device keep
+ *                         their order
+ */
+typedef enum eaipShardKey {
+    EAIP_SHARD_BY_TOPIC,
+    EAIP_SHARD_BY_DEVICE,
+} eaipShardKey_t;
+
+/*!
+ * @brief struct holding the connections of a sharded endpoint
+ *
+ * @param shards[eaipEndpoint_t *] underlying endpoints, owned by the user
+ * @param shardCount[size_t] number of entries in `shards`
+ * @param key[eaipShardKey_t] part of the topic that selects the connection
+ * @param baseUrl[char *] base URL of all topics, only used by `EAIP_SHARD_BY_DEVICE`
+ * @param baseUrlLength[size_t] length of the `<baseUrl>/` prefix skipped by
+ *                              `EAIP_SHARD_BY_DEVICE`
+ *
+ * IMPORTANT: All fields are managed by `eaipShardedEndpointInit` and must not be modified by the
+ *            user.
+ */
+typedef struct eaipShardedEndpoint {
+    const eaipEndpoint_t *shards;
+    size_t shardCount;
+    eaipShardKey_t key;
+    const char *baseUrl;
+    size_t baseUrlLength;
+} eaipShardedEndpoint_t;
+
+/*!
+ * @brief functions of a sharded endpoint, the context is an `eaipShardedEndpoint_t *`
+ *
+ * The binary and view variants return EAIP_COM_NOT_SUPPORTED if the selected connection does not
+ * provide them.
+ */
+extern const eaipEndpointInterface_t eaipShardedEndpointInterface;
+
+/*!
+ * @brief initialize a sharded endpoint
+ *
+ * @param sharded[eaipShardedEndpoint_t *] endpoint to initialize
+ * @param shards[eaipEndpoint_t *] underlying endpoints, must outlive the sharded endpoint
+ * @param shardCount[size_t] number of underlying endpoints
+ * @param key[eaipShardKey_t] part of the topic that selects the connection
+ * @param baseUrl[char *] base URL of all topics, only required for `EAIP_SHARD_BY_DEVICE`, must
+ *                        outlive the sharded endpoint
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_GENERIC_ERROR if there are no shards or the base URL is missing
+ */
+eaipCommunicationErrorCodes eaipShardedEndpointInit(eaipShardedEndpoint_t *sharded,
+                                                    const eaipEndpoint_t *shards,
+                                                    size_t shardCount, eaipShardKey_t key,
+                                                    const char *baseUrl);
+
+/*!
+ * @brief index of the underlying endpoint a topic or topic filter is forwarded to
+ *
+ * With `EAIP_SHARD_BY_DEVICE`, a topic that does not start with `<baseUrl>/` is hashed completely
+ * like with `EAIP_SHARD_BY_TOPIC`.
+ */
+size_t eaipShardedEndpointSelect(const eaipShardedEndpoint_t *sharded, const char *topic);
+
+#endif /* EAI_PROTOCOL_SHARDED_ENDPOINT_HEADER */
@@ -0,0 +1,128 @@
+#ifndef EAI_PROTOCOL_STATIC_TOPIC_HEADER
+#define EAI_PROTOCOL_STATIC_TOPIC_HEADER
+
+/*!
+ * Compile-time topics for the elastic-AI protocol library
+ *
+ * If `baseUrl` and `deviceId` are known at compile time, topics can be emitted as constant string
+ * literals. They are placed in read-only memory and need neither runtime formatting nor stack
+ * space:
+ *
+ * ```c
+ * #define BASE_URL "eaip://uni-due.de/es"
+ * #define DEVICE_ID "enV5"
+ *
+ * static const eaipStaticTopic_t temperature =
+ *     EAIP_STATIC_TOPIC(BASE_URL, DEVICE_ID, DATA, "temperature");
+ * ...
+ * eaipPublishStatic(config, temperature, "21.5", false);
+ * ```
+ *
+ * All macros only accept string literals.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "eaip/protocol/Protocol.h"
+
+/*!
+ * @brief topic string literal for a message type and data-ID
+ *
+ * @param baseUrl[literal] base URL of the topic
+ * @param deviceId[literal] device to publish for, or to send the request to
+ * @param type[topic_t] message type without quotes, e.g. `DATA`
+ * @param dataId[literal] data-ID or command
+ */
+#define EAIP_TOPIC_LITERAL(baseUrl, deviceId, type, dataId)                                       \
+    baseUrl "/" deviceId "/" EAIP_TOPIC_NAME_##type "/" dataId
+
+/*!
+ * @brief topic string literal for the status of a device
+ */
+#define EAIP_STATUS_TOPIC_LITERAL(baseUrl, deviceId) baseUrl "/" deviceId "/" EAIP_TOPIC_NAME_STATUS
+
+/*!
+ * @brief string literal identifying a device as requester in START and STOP messages
+ */
+#define EAIP_REQUESTER_LITERAL(baseUrl, deviceId) baseUrl "/" deviceId
+
+/*!
+ * @brief constant topic with its length
+ *
+ * @param topic[char *] topic in read-only memory
+ * @param length[size_t] length of the topic without the terminating `\0`
+ */
+typedef struct eaipStaticTopic {
+    const char *topic;
+    size_t length;
+} eaipStaticTopic_t;
+
+/*!
+ * @brief initializer for a `eaipStaticTopic_t` from a string literal
+ */
+#define EAIP_STATIC_TOPIC_FROM_LITERAL(literal) {.topic = literal, .length = sizeof(literal) - 1}
+
+/*!
+ * @brief initializer for a `eaipStaticTopic_t` for a message type and data-ID
+ */
+#define EAIP_STATIC_TOPIC(baseUrl, deviceId, type, dataId)                                        \
+    EAIP_STATIC_TOPIC_FROM_LITERAL(EAIP_TOPIC_LITERAL(baseUrl, deviceId, type, dataId))
+
+/*!
+ * @brief initializer for a `eaipStaticTopic_t` for the status of a device
+ */
+#define EAIP_STATIC_STATUS_TOPIC(baseUrl, deviceId)                                               \
+    EAIP_STATIC_TOPIC_FROM_LITERAL(EAIP_STATUS_TOPIC_LITERAL(baseUrl, deviceId))
+
+/*!
+ * @brief publish a message to a precomputed topic
+ *
+ * For START and STOP requests the message has to be the requester, see
+ * `EAIP_REQUESTER_LITERAL`.
+ *
+ * @param config[eaiProtocol_t] configuration
+ * @param topic[eaipStaticTopic_t] precomputed topic
+ * @param message[char *] message to publish
+ * @param retain[bool] whether the broker should retain the message
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipPublishStatic(eaiProtocol_t config, eaipStaticTopic_t topic,
+                                              char *message, bool retain);
+
+/*!
+ * @brief publish the own status to a precomputed status topic
+ *
+ * @param config[eaiProtocol_t] configuration
+ * @param topic[eaipStaticTopic_t] precomputed topic, see `EAIP_STATIC_STATUS_TOPIC`
+ * @param status[eaipDeviceState_t] status to publish
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipPublishStatusStatic(eaiProtocol_t config, eaipStaticTopic_t topic,
+                                                    eaipDeviceState_t status);
+
+/*!
+ * @brief subscribe to a precomputed topic
+ *
+ * @param config[eaiProtocol_t] configuration
+ * @param topic[eaipStaticTopic_t] precomputed topic
+ * @param handler[messageHandler] function to handle received messages
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipSubscribeStatic(eaiProtocol_t config, eaipStaticTopic_t topic,
+                                                messageHandler handler);
+
+/*!
+ * @brief unsubscribe from a precomputed topic
+ *
+ * @param config[eaiProtocol_t] configuration
+ * @param topic[eaipStaticTopic_t] precomputed topic
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes eaipUnsubscribeStatic(eaiProtocol_t config, eaipStaticTopic_t topic);
+
+#endif /* EAI_PROTOCOL_STATIC_TOPIC_HEADER */
@@ -0,0 +1,81 @@
+#ifndef EAI_PROTOCOL_WRITER_HEADER
+#define EAI_PROTOCOL_WRITER_HEADER
+
+/*!
+ * Bounded cursor based string writer
+ *
+ * The writer appends to a caller provided buffer without rescanning already written content.
+ * Like `snprintf` it keeps counting after the buffer is exhausted, so the required buffer size
+ * is known after a single pass.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*!
+ * @brief struct holding the state of a writer
+ *
+ * @param buffer[char *] buffer to write to
+ * @param capacity[size_t] size of the buffer including the terminating `\0`
+ * @param length[size_t] number of characters appended so far, including truncated ones
+ */
+typedef struct eaipWriter {
+    char *buffer;
+    size_t capacity;
+    size_t length;
+} eaipWriter_t;
+
+/*!
+ * @brief initialize a writer for the given buffer
+ *
+ * @param writer[eaipWriter_t *] writer to initialize
+ * @param buffer[char *] buffer to write to, may be NULL if capacity is 0
+ * @param capacity[size_t] size of the buffer including the terminating `\0`
+ */
+void eaipWriterInit(eaipWriter_t *writer, char *buffer, size_t capacity);
+
+/*!
+ * @brief append `length` characters to the writer
+ *
+ * @param writer[eaipWriter_t *] writer to append to
+ * @param data[char *] characters to append
+ * @param length[size_t] number of characters to append
+ */
+void eaipWriterAppend(eaipWriter_t *writer, const char *data, size_t length);
+
+/*!
+ * @brief append a `\0` terminated string to the writer
+ *
+ * @param writer[eaipWriter_t *] writer to append to
+ * @param string[char *] string to append
+ */
+void eaipWriterAppendString(eaipWriter_t *writer, const char *string);
+
+/*!
+ * @brief append a single character to the writer
+ *
+ * @param writer[eaipWriter_t *] writer to append to
+ * @param character[char] character to append
+ */
+void eaipWriterAppendChar(eaipWriter_t *writer, char character);
+
+/*!
+ * @brief terminate the written string
+ *
+ * @param writer[eaipWriter_t *] writer to terminate
+ *
+ * @return number of characters stored in the buffer, excluding the terminating `\0`
+ */
+size_t eaipWriterFinish(eaipWriter_t *writer);
+
+/*!
+ * @brief check if appended characters did not fit into the buffer
+ *
+ * @param writer[eaipWriter_t *] writer to check
+ *
+ * @return true if the content was truncated,
+ *         `length + 1` is then the required buffer size
+ */
+bool eaipWriterTruncated(const eaipWriter_t *writer);
+
+#endif /* EAI_PROTOCOL_WRITER_HEADER */
@@ -1,218 +1,1087 @@
-#include <regex.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "eaip/brokerMock/Broker.h"
+#include "eaip/brokerMock/SubscriptionStore.h"
+#include "eaip/brokerMock/TopicTree.h"
+#include "eaip/brokerMock/TopicValidation.h"
 #include "eaip/endpoint/CommunicationEndpoint.h"
+#include "eaip/protocol/Hash.h"
 
 /* region TOPIC VALIDATION */
 #define MQTT_MAX_TOPIC_LENGTH 128 /*! As defined by the ESP32 AT commands */
-#define REGEX_MQTT_SUBSCRIBE                                                                       \
-    "^(\\/?[a-zA-Z0-9_\\!$&'()*+,.:;=?@%~-]*(\\/[a-zA-Z0-9_\\!$&'()*+,.:;=?@%~-]*)*(\\/"           \
-    "\\#)?|\\+)$"
-#define REGEX_MQTT_PUBLISH                                                                         \
-    "^(\\/?[a-zA-Z0-9_\\!$&'()*,.:;=?@%~-]+(\\/[a-zA-Z0-9_\\!$&'()*,.:;=?@%~-]*)*\\/?$)"
-
-typedef struct validationResult {
-    int errorCode;
-    bool isValidTopic;
-} validationResult_t;
-validationResult_t validateTopicForSubscribe(char *topic) {
-    regex_t regex;
-    validationResult_t validation = {.errorCode = 0};
-
-    validation.errorCode = regcomp(&regex, REGEX_MQTT_SUBSCRIBE, REG_EXTENDED);
-    if (validation.errorCode == 0) {
-        int result = regexec(&regex, topic, 0, NULL, 0);
-        if (result == 0) {
-            validation.isValidTopic = true;
-        } else if (result == REG_NOMATCH) {
-            validation.isValidTopic = false;
-        } else {
-            validation.errorCode = result;
+bool topicIsTooLong(const char *topic) {
+    return (topic != NULL && strlen(topic) > MQTT_MAX_TOPIC_LENGTH);
+}
+/* endregion TOPIC VALIDATION */
+
+/* region SUBSCRIPTION MANAGEMENT */
+#define INITIAL_REGISTRY_BUCKETS 64
+
+/*!
+ * Every subscription is linked into
+ *   - the list of all subscriptions of the broker, in subscription order,
+ *   - the registry, a hash table keyed by client and interned topic filter,
+ *   - the chain of subscriptions of the same filter, whose first entry is stored in the tree,
+ *   - the list of subscriptions of its client.
+ */
+
+/*! @brief hash of a client and an interned filter, both are identified by their address */
+static uint32_t hashSubscription(const brokerClient_t *client, const char *interned) {
+    uint32_t hash = hashUpdate32(FNV32_OFFSET_BASIS, &client, sizeof(client));
+    return hashUpdate32(hash, &interned, sizeof(interned));
+}
+static subscriptions_t *findRegistered(const broker_t *broker, const brokerClient_t *client,
+                                       const char *interned, uint32_t hash) {
+    if (broker->registryBuckets == 0 || interned == NULL) {
+        return NULL;
+    }
+    subscriptions_t *current = broker->registry[hash & (broker->registryBuckets - 1)];
+    while (current != NULL) {
+        if (current->subscription->topic == interned && current->subscription->client == client) {
+            return current;
         }
+        current = current->bucketNext;
+    }
+    return NULL;
+}
+static bool growRegistry(broker_t *broker) {
+    size_t buckets =
+        broker->registryBuckets == 0 ? INITIAL_REGISTRY_BUCKETS : broker->registryBuckets * 2;
+    subscriptions_t **grown = calloc(buckets, sizeof(subscriptions_t *));
+    if (grown == NULL) {
+        return false;
+    }
+    for (subscriptions_t *current = *broker->first; current != NULL; current = current->next) {
+        current->bucketNext = grown[current->hash & (buckets - 1)];
+        grown[current->hash & (buckets - 1)] = current;
     }
-    regfree(&regex);
-    return validation;
+    free(broker->registry);
+    broker->registry = grown;
+    broker->registryBuckets = buckets;
+    return true;
 }
-validationResult_t validateTopicForPublish(char *topic) {
-    regex_t regex;
-    validationResult_t validation = {.errorCode = 0};
+/*! @brief find a subscription of a client by the text of its filter */
+static subscriptions_t *findSubscriptionOf(const broker_t *broker, const brokerClient_t *client,
+                                           const char *topic) {
+    char *interned = subscriptionStoreLookup(broker->store, topic, strlen(topic));
+    return findRegistered(broker, client, interned, hashSubscription(client, interned));
+}
+static eaipCommunicationErrorCodes linkSubscription(broker_t *broker, subscriptions_t *item) {
+    if (broker->registryCount >= broker->registryBuckets && !growRegistry(broker)) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
 
-    validation.errorCode = regcomp(&regex, REGEX_MQTT_PUBLISH, REG_EXTENDED);
-    if (validation.errorCode == 0) {
-        int result = regexec(&regex, topic, 0, NULL, 0);
-        if (result == 0) {
-            validation.isValidTopic = true;
-        } else if (result == REG_NOMATCH) {
-            validation.isValidTopic = false;
-        } else {
-            validation.errorCode = result;
+    const char *topic = item->subscription->topic;
+    subscriptions_t *sameFilter = topicTreeFind(broker->subscriptionTree, topic, strlen(topic));
+    if (sameFilter != NULL) {
+        item->filterPrevious = sameFilter;
+        item->filterNext = sameFilter->filterNext;
+        if (sameFilter->filterNext != NULL) {
+            sameFilter->filterNext->filterPrevious = item;
         }
+        sameFilter->filterNext = item;
+    } else if (!topicTreeInsert(broker->subscriptionTree, topic, strlen(topic), item)) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    item->previous = broker->last;
+    if (*broker->first == NULL) {
+        *broker->first = item;
+    } else {
+        broker->last->next = item;
+    }
+    broker->last = item;
+
+    item->bucketNext = broker->registry[item->hash & (broker->registryBuckets - 1)];
+    broker->registry[item->hash & (broker->registryBuckets - 1)] = item;
+    broker->registryCount++;
+
+    brokerClient_t *client = item->subscription->client;
+    item->clientNext = client->subscriptions;
+    if (client->subscriptions != NULL) {
+        client->subscriptions->clientPrevious = item;
     }
-    regfree(&regex);
-    return validation;
+    client->subscriptions = item;
+    return EAIP_COM_NO_ERROR;
 }
+static void removeSubscription(broker_t *broker, subscriptions_t *item) {
+    subscriptions_t **link = &broker->registry[item->hash & (broker->registryBuckets - 1)];
+    while (*link != item) {
+        link = &(*link)->bucketNext;
+    }
+    *link = item->bucketNext;
+    broker->registryCount--;
 
-bool topicIsTooLong(char *topic) {
-    return (topic != NULL && strlen(topic) > MQTT_MAX_TOPIC_LENGTH);
+    const char *topic = item->subscription->topic;
+    if (item->filterPrevious != NULL) {
+        item->filterPrevious->filterNext = item->filterNext;
+    } else if (item->filterNext != NULL) {
+        /* the node exists, replacing its value does not allocate */
+        topicTreeInsert(broker->subscriptionTree, topic, strlen(topic), item->filterNext);
+    } else {
+        topicTreeRemove(broker->subscriptionTree, topic, strlen(topic));
+    }
+    if (item->filterNext != NULL) {
+        item->filterNext->filterPrevious = item->filterPrevious;
+    }
+
+    if (item->previous == NULL) {
+        *broker->first = item->next;
+    } else {
+        item->previous->next = item->next;
+    }
+    if (item->next == NULL) {
+        broker->last = item->previous;
+    } else {
+        item->next->previous = item->previous;
+    }
+
+    brokerClient_t *client = item->subscription->client;
+    if (item->clientPrevious == NULL) {
+        client->subscriptions = item->clientNext;
+    } else {
+        item->clientPrevious->clientNext = item->clientNext;
+    }
+    if (item->clientNext != NULL) {
+        item->clientNext->clientPrevious = item->clientPrevious;
+    }
+
+    subscriptionStoreRelease(broker->store, item->subscription->topic);
+    subscriptionStoreRecycle(broker->store, item);
 }
-bool topicIsAlreadySubscribed(char *topic) {
-    if (subscriptions != NULL) {
-        subscriptions_t *current = subscriptions;
-        while (current != NULL) {
-            if (0 == strcmp(current->subscription->topic, topic)) {
-                return true;
-            }
-            current = current->next;
+
+/*!
+ * @brief forget all subscriptions of all clients at once, the broker must be write locked
+ */
+static void releaseSubscriptions(broker_t *broker) {
+    topicTreeClear(broker->subscriptionTree);
+    if (broker->registry != NULL) {
+        memset(broker->registry, 0, broker->registryBuckets * sizeof(subscriptions_t *));
+    }
+    broker->registryCount = 0;
+    *broker->first = NULL;
+    broker->last = NULL;
+    for (brokerClient_t *client = broker->clients; client != NULL; client = client->next) {
+        client->subscriptions = NULL;
+    }
+    subscriptionStoreClear(broker->store);
+}
+/* endregion SUBSCRIPTION MANAGEMENT */
+
+/* region RETAINED MESSAGES */
+/*!
+ * @brief a retained message, `<topic>\0<payload>\0` are stored in `data`
+ *
+ * Messages are kept in the order they were retained, the oldest is evicted first.
+ */
+typedef struct retained retained_t;
+struct retained {
+    retained_t *older;
+    retained_t *newer;
+    size_t topicLength;
+    size_t length;
+    char data[];
+};
+
+static void dropRetained(broker_t *broker, retained_t *retained) {
+    topicTreeRemove(broker->retainedTree, retained->data, retained->topicLength);
+    if (retained->older == NULL) {
+        broker->oldestRetained = retained->newer;
+    } else {
+        retained->older->newer = retained->newer;
+    }
+    if (retained->newer == NULL) {
+        broker->newestRetained = retained->older;
+    } else {
+        retained->newer->older = retained->older;
+    }
+    broker->retainedBytes -= retained->topicLength + retained->length;
+    free(retained);
+}
+static void evictRetained(broker_t *broker) {
+    while (broker->retainedBytes > broker->retainedLimit) {
+        dropRetained(broker, broker->oldestRetained);
+    }
+}
+/*!
+ * @brief replace the retained message of a topic, an empty payload only removes it
+ *
+ * A message larger than the limit of the store is not retained.
+ */
+static eaipCommunicationErrorCodes retainMessage(broker_t *broker, const char *topic,
+                                                 const uint8_t *payload, size_t length) {
+    size_t topicLength = strlen(topic);
+    retained_t *previous = topicTreeFind(broker->retainedTree, topic, topicLength);
+    if (previous != NULL) {
+        dropRetained(broker, previous);
+    }
+    if (length == 0 || topicLength + length > broker->retainedLimit) {
+        return EAIP_COM_NO_ERROR;
+    }
+
+    retained_t *retained = malloc(sizeof(retained_t) + topicLength + length + 2);
+    if (retained == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+    retained->topicLength = topicLength;
+    retained->length = length;
+    memcpy(retained->data, topic, topicLength + 1);
+    memcpy(retained->data + topicLength + 1, payload, length);
+    retained->data[topicLength + 1 + length] = '\0';
+    if (!topicTreeInsert(broker->retainedTree, topic, topicLength, retained)) {
+        free(retained);
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    retained->older = broker->newestRetained;
+    retained->newer = NULL;
+    if (broker->newestRetained == NULL) {
+        broker->oldestRetained = retained;
+    } else {
+        broker->newestRetained->newer = retained;
+    }
+    broker->newestRetained = retained;
+    broker->retainedBytes += topicLength + length;
+    evictRetained(broker);
+    return EAIP_COM_NO_ERROR;
+}
+
+typedef struct retainedMatches {
+    retained_t **entries;
+    size_t count;
+    size_t capacity;
+    size_t bytes;
+    bool exhausted;
+} retainedMatches_t;
+
+/*! @brief size of a copy of a retained message, keeping the next copy aligned */
+static size_t copySize(const retained_t *retained) {
+    size_t size = sizeof(retained_t) + retained->topicLength + retained->length + 2;
+    return (size + _Alignof(retained_t) - 1) & ~(_Alignof(retained_t) - 1);
+}
+
+static void collectRetained(void *retained, void *context) {
+    retainedMatches_t *matches = context;
+    if (matches->count == matches->capacity) {
+        size_t capacity = matches->capacity == 0 ? 16 : 2 * matches->capacity;
+        retained_t **entries = realloc(matches->entries, capacity * sizeof(retained_t *));
+        if (entries == NULL) {
+            matches->exhausted = true;
+            return;
         }
+        matches->entries = entries;
+        matches->capacity = capacity;
     }
-    return false;
+    matches->entries[matches->count++] = retained;
+    matches->bytes += copySize(retained);
 }
-bool subscribedTopicIsSame(char *subscription, char *topic) {
-    while (*subscription && *topic) {
-        if (*subscription == '#') {
-            // match all remaining levels
-            return 1;
-        } else if (*subscription == '+') {
-            // skip one level in the topic
-            while (*topic && *topic != '/') {
-                topic++;
+
+static void releaseRetained(broker_t *broker) {
+    while (broker->oldestRetained != NULL) {
+        dropRetained(broker, broker->oldestRetained);
+    }
+}
+/* endregion RETAINED MESSAGES */
+
+/* region DELIVERY */
+#define MATCHES_INLINE 16
+
+/*!
+ * @brief copies of the subscriptions matching a published topic
+ *
+ * Handlers are called after the subscriptions were unlocked. Every copy holds a reference on the
+ * `active` counter of its client, so the client is not released before the copy was handled.
+ */
+typedef struct matches {
+    subscription_t *entries;
+    size_t count;
+    size_t capacity;
+    bool exhausted;
+} matches_t;
+
+static void collectMatch(void *sameFilter, void *context) {
+    matches_t *matches = context;
+    for (subscriptions_t *item = sameFilter; item != NULL && !matches->exhausted;
+         item = item->filterNext) {
+        if (matches->count == matches->capacity) {
+            subscription_t *entries = malloc(2 * matches->capacity * sizeof(subscription_t));
+            if (entries == NULL) {
+                matches->exhausted = true;
+                return;
             }
-            subscription++;
-        } else if (*subscription == *topic) {
-            // level is equal
-            subscription++;
-            topic++;
-        } else {
-            // mismatch
-            return 0;
+            memcpy(entries, matches->entries, matches->count * sizeof(subscription_t));
+            if (matches->capacity > MATCHES_INLINE) {
+                free(matches->entries);
+            }
+            matches->entries = entries;
+            matches->capacity *= 2;
         }
+        atomic_fetch_add_explicit(&item->subscription->client->active, 1, memory_order_relaxed);
+        matches->entries[matches->count++] = *item->subscription;
+    }
+}
+
+static void releaseClientReference(brokerClient_t *client) {
+    /* the client may be released as soon as the count dropped, only the broker is accessed then */
+    broker_t *broker = client->broker;
+    if (1 == atomic_fetch_sub(&client->active, 1) && atomic_load(&broker->disconnecting) > 0) {
+        pthread_mutex_lock(&broker->runLock);
+        pthread_cond_broadcast(&broker->releaseSignal);
+        pthread_mutex_unlock(&broker->runLock);
+    }
+}
+
+/*!
+ * @brief call the handler of a subscription
+ *
+ * @param text[char **] terminated message, created from `payload` on first use if NULL
+ * @param retained[bool] message is a retained one delivered because of the subscription
+ */
+static eaipCommunicationErrorCodes callHandler(const subscription_t *subscription, char *topic,
+                                               size_t topicLength, char **text, char **textCopy,
+                                               const uint8_t *payload, size_t length,
+                                               bool retained) {
+    if (subscription->handleView != NULL) {
+        subscription->handleView(subscription->userData, topic, topicLength, payload, length);
+        return EAIP_COM_NO_ERROR;
+    }
+    if (subscription->handleBinary != NULL) {
+        subscription->handleBinary(topic, payload, length);
+        return EAIP_COM_NO_ERROR;
+    }
+    if (subscription->handle == NULL && subscription->handleMessage == NULL &&
+        subscription->handleRetainAware == NULL) {
+        return EAIP_COM_NO_ERROR;
+    }
 
-        if (*topic == '/' && *subscription != '/' && *subscription != '#') {
-            // mismatch due to structural difference
-            return 0;
+    if (*text == NULL && payload != NULL) {
+        /* binary payload for a text handler: provide a terminated copy once */
+        *textCopy = calloc(length + 1, sizeof(char));
+        if (*textCopy == NULL) {
+            return EAIP_COM_OUT_OF_MEMORY;
         }
+        memcpy(*textCopy, payload, length);
+        *text = *textCopy;
     }
+    if (subscription->handleRetainAware != NULL) {
+        subscription->handleRetainAware(subscription->client, topic,
+                                        (const uint8_t *)(*text != NULL ? *text : ""), length,
+                                        retained);
+    } else if (subscription->handleMessage != NULL) {
+        subscription->handleMessage(subscription->client, topic,
+                                    (const uint8_t *)(*text != NULL ? *text : ""), length);
+    } else {
+        subscription->handle(topic, *text);
+    }
+    return EAIP_COM_NO_ERROR;
+}
+/* endregion DELIVERY */
+
+/* region WORKERS */
+/*!
+ * @brief a published message shared by all its queued deliveries, `<topic>\0<payload>\0`
+ */
+typedef struct message {
+    atomic_size_t references;
+    size_t topicLength;
+    size_t length;
+    bool retained;
+    char data[];
+} message_t;
 
-    if (*subscription == '#') {
-        // handle trailing `/` or `#`
-        return 1;
+/*!
+ * @brief a message queued for one subscription, holds a reference on the client
+ */
+typedef struct delivery delivery_t;
+struct delivery {
+    delivery_t *next;
+    subscription_t subscription;
+    message_t *message;
+};
+
+static void releaseMessage(message_t *message) {
+    if (1 == atomic_fetch_sub_explicit(&message->references, 1, memory_order_acq_rel)) {
+        free(message);
     }
+}
 
-    return *subscription == '\0' && *topic == '\0';
+static void scheduleClient(broker_t *broker, brokerClient_t *client) {
+    pthread_mutex_lock(&broker->runLock);
+    client->runNext = NULL;
+    if (broker->runFirst == NULL) {
+        broker->runFirst = client;
+    } else {
+        broker->runLast->runNext = client;
+    }
+    broker->runLast = client;
+    pthread_cond_signal(&broker->runSignal);
+    pthread_mutex_unlock(&broker->runLock);
 }
-/* endregion TOPIC VALIDATION */
 
-/* region SUBSCRIPTION MANAGEMENT */
-subscriptions_t *subscriptions = NULL;
-void appendSubscription(subscription_t *subscription) {
-    subscriptions_t *new = calloc(1, sizeof(subscriptions_t));
-    new->subscription = subscription;
-    new->next = NULL;
-
-    if (subscriptions == NULL) {
-        subscriptions = new;
-        return;
-    }
-
-    subscriptions_t *current = subscriptions;
-    while (current->next != NULL) {
-        current = current->next;
-    }
-    current->next = new;
-}
-void freeSubscription(subscriptions_t *subscriptionItem) {
-    free(subscriptionItem->subscription->topic);
-    free(subscriptionItem->subscription);
-    free(subscriptionItem);
-}
-void removeSubscription(char *topic) {
-    subscriptions_t *last = NULL;
-    subscriptions_t *current = subscriptions;
-
-    if (current == NULL) {
-        // Nothing to do here!
-    } else if (0 == strcmp(current->subscription->topic, topic)) {
-        subscriptions = current->next;
-        freeSubscription(current);
-    } else if (current->next != NULL) {
-        last = current;
-        current = current->next;
-        while (0 != strcmp(current->subscription->topic, topic)) {
-            last = current;
-            current = current->next;
-            if (current == NULL) {
-                return;
-            }
+/*!
+ * @brief append a delivery to the queue of its client, scheduling the client if it was idle
+ *
+ * A scheduled client holds an additional reference, which is released by the worker once the
+ * queue is empty.
+ */
+static void pushDelivery(broker_t *broker, delivery_t *delivery) {
+    brokerClient_t *client = delivery->subscription.client;
+    atomic_fetch_add_explicit(&client->active, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&broker->pending, 1, memory_order_relaxed);
+
+    pthread_mutex_lock(&client->queueLock);
+    delivery->next = NULL;
+    if (client->queueFirst == NULL) {
+        client->queueFirst = delivery;
+    } else {
+        client->queueLast->next = delivery;
+    }
+    client->queueLast = delivery;
+    bool idle = !client->scheduled;
+    if (idle) {
+        client->scheduled = true;
+        atomic_fetch_add_explicit(&client->active, 1, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&client->queueLock);
+
+    if (idle) {
+        scheduleClient(broker, client);
+    }
+}
+
+/*!
+ * @brief queue one message for the given subscriptions
+ *
+ * @return 0 if no error occurred, EAIP_COM_OUT_OF_MEMORY if not all deliveries could be queued
+ */
+static eaipCommunicationErrorCodes queueMessage(broker_t *broker, const subscription_t *entries,
+                                                size_t count, const char *topic,
+                                                size_t topicLength, const uint8_t *payload,
+                                                size_t length, bool retained) {
+    message_t *message = malloc(sizeof(message_t) + topicLength + length + 2);
+    if (message == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+    atomic_init(&message->references, count + 1);
+    message->topicLength = topicLength;
+    message->length = length;
+    message->retained = retained;
+    memcpy(message->data, topic, topicLength + 1);
+    if (length > 0) {
+        memcpy(message->data + topicLength + 1, payload, length);
+    }
+    message->data[topicLength + 1 + length] = '\0';
+
+    eaipCommunicationErrorCodes result = EAIP_COM_NO_ERROR;
+    for (size_t index = 0; index < count; index++) {
+        delivery_t *delivery = malloc(sizeof(delivery_t));
+        if (delivery == NULL) {
+            atomic_fetch_sub_explicit(&message->references, count - index, memory_order_relaxed);
+            result = EAIP_COM_OUT_OF_MEMORY;
+            break;
         }
-        last->next = current->next;
-        freeSubscription(current);
+        delivery->subscription = entries[index];
+        delivery->message = message;
+        pushDelivery(broker, delivery);
     }
+    releaseMessage(message);
+    return result;
 }
-/* endregion SUBSCRIPTION MANAGEMENT */
 
-eaipCommunicationErrorCodes subscribe(char *topic, void (*handle)(char *topic, char *message)) {
+static void completeDelivery(broker_t *broker, delivery_t *delivery) {
+    releaseClientReference(delivery->subscription.client);
+    releaseMessage(delivery->message);
+    free(delivery);
+    if (1 == atomic_fetch_sub_explicit(&broker->pending, 1, memory_order_acq_rel)) {
+        pthread_mutex_lock(&broker->runLock);
+        pthread_cond_broadcast(&broker->idleSignal);
+        pthread_mutex_unlock(&broker->runLock);
+    }
+}
+
+/*!
+ * @brief handle up to `EAIP_BROKER_DELIVERY_BATCH` messages of a scheduled client
+ *
+ * @return whether messages are left, the client stays scheduled then
+ */
+static bool serveClient(broker_t *broker, brokerClient_t *client) {
+    for (size_t handled = 0; handled < EAIP_BROKER_DELIVERY_BATCH; handled++) {
+        pthread_mutex_lock(&client->queueLock);
+        delivery_t *delivery = client->queueFirst;
+        if (delivery != NULL) {
+            client->queueFirst = delivery->next;
+        }
+        pthread_mutex_unlock(&client->queueLock);
+        if (delivery == NULL) {
+            break;
+        }
+
+        message_t *message = delivery->message;
+        char *text = message->data + message->topicLength + 1;
+        callHandler(&delivery->subscription, message->data, message->topicLength, &text, NULL,
+                    (const uint8_t *)text, message->length, message->retained);
+        completeDelivery(broker, delivery);
+    }
+
+    pthread_mutex_lock(&client->queueLock);
+    bool remaining = client->queueFirst != NULL;
+    client->scheduled = remaining;
+    pthread_mutex_unlock(&client->queueLock);
+    return remaining;
+}
+
+static void *runWorker(void *argument) {
+    broker_t *broker = argument;
+    for (;;) {
+        pthread_mutex_lock(&broker->runLock);
+        while (broker->runFirst == NULL && !broker->stopping) {
+            pthread_cond_wait(&broker->runSignal, &broker->runLock);
+        }
+        brokerClient_t *client = broker->runFirst;
+        if (client == NULL) {
+            pthread_mutex_unlock(&broker->runLock);
+            return NULL;
+        }
+        broker->runFirst = client->runNext;
+        pthread_mutex_unlock(&broker->runLock);
+
+        if (serveClient(broker, client)) {
+            /* other clients are served first, a busy client must not starve them */
+            scheduleClient(broker, client);
+        } else {
+            releaseClientReference(client);
+        }
+    }
+}
+
+static void stopWorkers(broker_t *broker) {
+    pthread_mutex_lock(&broker->runLock);
+    broker->stopping = true;
+    pthread_cond_broadcast(&broker->runSignal);
+    pthread_mutex_unlock(&broker->runLock);
+    for (size_t index = 0; index < broker->workerCount; index++) {
+        pthread_join(broker->workers[index], NULL);
+    }
+    free(broker->workers);
+    broker->workers = NULL;
+    broker->workerCount = 0;
+}
+/* endregion WORKERS */
+
+/*!
+ * @brief queue or copy all retained messages matching a new subscription
+ *
+ * Called while the subscriptions are locked for writing, right after the subscription was linked.
+ * Publishing retains a message and matches the subscriptions under the same lock, so every message
+ * reaches the subscription either retained or live, never both. With workers the retained
+ * messages are queued before any live message can be queued for the subscription. Without workers
+ * the handler may publish retained messages itself, the messages are therefore copied and handed to
+ * `deliverRetainedCopies` once the subscriptions are unlocked.
+ *
+ * @param copies[char **] receives the copies of the retained messages, NULL if nothing is left
+ * @param end[char **] receives the end of the copies
+ */
+static eaipCommunicationErrorCodes takeRetained(broker_t *broker,
+                                                const subscription_t *subscription,
+                                                char **copies, char **end) {
+    *copies = NULL;
+    *end = NULL;
+    retainedMatches_t matches = {0};
+    pthread_mutex_lock(&broker->retainedLock);
+    topicTreeMatchFilter(broker->retainedTree, subscription->topic, strlen(subscription->topic),
+                         &collectRetained, &matches);
+    eaipCommunicationErrorCodes result =
+        matches.exhausted ? EAIP_COM_OUT_OF_MEMORY : EAIP_COM_NO_ERROR;
+
+    if (result == EAIP_COM_NO_ERROR && matches.count > 0 && broker->workerCount > 0) {
+        for (size_t index = 0; index < matches.count && result == EAIP_COM_NO_ERROR; index++) {
+            retained_t *retained = matches.entries[index];
+            result = queueMessage(broker, subscription, 1, retained->data, retained->topicLength,
+                                  (const uint8_t *)retained->data + retained->topicLength + 1,
+                                  retained->length, true);
+        }
+    } else if (result == EAIP_COM_NO_ERROR && matches.count > 0) {
+        *copies = malloc(matches.bytes);
+        *end = *copies;
+        result = *copies == NULL ? EAIP_COM_OUT_OF_MEMORY : EAIP_COM_NO_ERROR;
+        for (size_t index = 0; index < matches.count && *copies != NULL; index++) {
+            size_t size = sizeof(retained_t) + matches.entries[index]->topicLength +
+                          matches.entries[index]->length + 2;
+            memcpy(*end, matches.entries[index], size);
+            *end += copySize(matches.entries[index]);
+        }
+    }
+    pthread_mutex_unlock(&broker->retainedLock);
+    free(matches.entries);
+    return result;
+}
+
+/*!
+ * @brief call the handler of a new subscription for the copies made by `takeRetained`
+ *
+ * Handlers are called by the publishing thread without workers, so a live message published by
+ * another thread at the same time may be handled before the retained ones.
+ */
+static void deliverRetainedCopies(const subscription_t *subscription, char *copies, char *end) {
+    for (char *current = copies; current < end;) {
+        retained_t *retained = (retained_t *)current;
+        char *payload = retained->data + retained->topicLength + 1;
+        callHandler(subscription, retained->data, retained->topicLength, &payload, NULL,
+                    (const uint8_t *)payload, retained->length, true);
+        current += copySize(retained);
+    }
+    free(copies);
+}
+
+static eaipCommunicationErrorCodes deliver(broker_t *broker, char *topic, char *text,
+                                           const uint8_t *payload, size_t length, bool retain) {
+    size_t topicLength = strlen(topic);
+    if (topicLength > MQTT_MAX_TOPIC_LENGTH) {
+        return EAIP_COM_TOPIC_TO_LONG;
+    }
+
+    if (!topicIsValidForPublish(topic, topicLength)) {
+        return EAIP_COM_INVALID_TOPIC;
+    }
+
+    /* a new subscription gets the message either retained or live, see `takeRetained` */
+    eaipCommunicationErrorCodes retained = EAIP_COM_NO_ERROR;
+    subscription_t inlineEntries[MATCHES_INLINE];
+    matches_t matches = {.entries = inlineEntries, .capacity = MATCHES_INLINE};
+    pthread_rwlock_rdlock(&broker->lock);
+    if (retain) {
+        pthread_mutex_lock(&broker->retainedLock);
+        retained = retainMessage(broker, topic, payload, length);
+        pthread_mutex_unlock(&broker->retainedLock);
+    }
+    topicTreeMatch(broker->subscriptionTree, topic, topicLength, &collectMatch, &matches);
+    pthread_rwlock_unlock(&broker->lock);
+
+    eaipCommunicationErrorCodes result =
+        matches.exhausted ? EAIP_COM_OUT_OF_MEMORY : EAIP_COM_NO_ERROR;
+    char *textCopy = NULL;
+    if (result == EAIP_COM_NO_ERROR && matches.count > 0 && broker->workerCount > 0) {
+        result = queueMessage(broker, matches.entries, matches.count, topic, topicLength, payload,
+                              length, false);
+    } else {
+        for (size_t index = 0; index < matches.count && result == EAIP_COM_NO_ERROR; index++) {
+            result = callHandler(&matches.entries[index], topic, topicLength, &text, &textCopy,
+                                 payload, length, false);
+        }
+    }
+
+    for (size_t index = 0; index < matches.count; index++) {
+        releaseClientReference(matches.entries[index].client);
+    }
+    free(textCopy);
+    if (matches.entries != inlineEntries) {
+        free(matches.entries);
+    }
+    /* subscribers get the message even if it could not be retained */
+    return result != EAIP_COM_NO_ERROR ? result : retained;
+}
+
+static eaipCommunicationErrorCodes addSubscription(brokerClient_t *client, const char *topic,
+                                                   subscription_t handlers) {
     if (topicIsTooLong(topic)) {
         return EAIP_COM_TOPIC_TO_LONG;
     }
 
-    validationResult_t validation = validateTopicForSubscribe(topic);
-    if (0 != validation.errorCode) {
-        return EAIP_COM_GENERIC_ERROR;
-    } else if (!validation.isValidTopic) {
+    if (!topicIsValidForSubscribe(topic, strlen(topic))) {
         return EAIP_COM_INVALID_TOPIC;
     }
 
-    if (topicIsAlreadySubscribed(topic)) {
+    broker_t *broker = client->broker;
+    pthread_rwlock_wrlock(&broker->lock);
+    char *filter = subscriptionStoreIntern(broker->store, topic, strlen(topic));
+    uint32_t hash = hashSubscription(client, filter);
+    if (filter != NULL && findRegistered(broker, client, filter, hash) != NULL) {
+        subscriptionStoreRelease(broker->store, filter);
+        pthread_rwlock_unlock(&broker->lock);
         return EAIP_COM_TOPIC_ALREADY_SUBSCRIBED;
     }
 
-    subscription_t *newSubscription = calloc(1, sizeof(subscription_t));
-    newSubscription->topic = calloc(1, strlen(topic) + 1);
-    strcpy(newSubscription->topic, topic);
-    newSubscription->handle = handle;
-    appendSubscription(newSubscription);
+    subscriptions_t *item = filter != NULL ? subscriptionStoreAllocate(broker->store) : NULL;
+    if (item == NULL) {
+        if (filter != NULL) {
+            subscriptionStoreRelease(broker->store, filter);
+        }
+        pthread_rwlock_unlock(&broker->lock);
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+    subscription_t *newSubscription = item->subscription;
+    *newSubscription = handlers;
+    newSubscription->topic = filter;
+    newSubscription->client = client;
+    item->hash = hash;
+
+    if (EAIP_COM_NO_ERROR != linkSubscription(broker, item)) {
+        subscriptionStoreRelease(broker->store, filter);
+        subscriptionStoreRecycle(broker->store, item);
+        pthread_rwlock_unlock(&broker->lock);
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+    /* the handler may unsubscribe the filter while retained messages are delivered */
+    char filterCopy[MQTT_MAX_TOPIC_LENGTH + 1];
+    strcpy(filterCopy, topic);
+    subscription_t delivery = *newSubscription;
+    delivery.topic = filterCopy;
+    char *copies;
+    char *end;
+    eaipCommunicationErrorCodes result = takeRetained(broker, &delivery, &copies, &end);
+    pthread_rwlock_unlock(&broker->lock);
+
+    deliverRetainedCopies(&delivery, copies, end);
+    return result;
+}
+
+/* region CLIENTS */
 
+eaipCommunicationErrorCodes brokerInit(broker_t *broker) {
+    memset(broker, 0, sizeof(broker_t));
+    broker->store = calloc(1, sizeof(subscriptionStore_t));
+    broker->subscriptionTree = calloc(1, sizeof(topicNode_t));
+    broker->retainedTree = calloc(1, sizeof(topicNode_t));
+    if (broker->store == NULL || broker->subscriptionTree == NULL ||
+        broker->retainedTree == NULL) {
+        free(broker->store);
+        free(broker->subscriptionTree);
+        free(broker->retainedTree);
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+    broker->first = &broker->ownFirst;
+    broker->retainedLimit = EAIP_BROKER_RETAINED_BYTES;
+    atomic_init(&broker->pending, 0);
+    atomic_init(&broker->disconnecting, 0);
+
+    pthread_rwlock_init(&broker->lock, NULL);
+    pthread_mutex_init(&broker->retainedLock, NULL);
+    pthread_mutex_init(&broker->runLock, NULL);
+    pthread_cond_init(&broker->runSignal, NULL);
+    pthread_cond_init(&broker->idleSignal, NULL);
+    pthread_cond_init(&broker->releaseSignal, NULL);
     return EAIP_COM_NO_ERROR;
 }
 
-eaipCommunicationErrorCodes unsubscribe(char *topic) {
-    removeSubscription(topic);
+eaipCommunicationErrorCodes brokerStartWorkers(broker_t *broker, size_t workers) {
+    if (broker->workerCount > 0 || workers == 0) {
+        return EAIP_COM_GENERIC_ERROR;
+    }
+    broker->workers = calloc(workers, sizeof(pthread_t));
+    if (broker->workers == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+
+    broker->stopping = false;
+    for (size_t index = 0; index < workers; index++) {
+        if (0 != pthread_create(&broker->workers[index], NULL, &runWorker, broker)) {
+            stopWorkers(broker);
+            return EAIP_COM_GENERIC_ERROR;
+        }
+        broker->workerCount++;
+    }
+    return EAIP_COM_NO_ERROR;
+}
+
+void brokerFlush(broker_t *broker) {
+    pthread_mutex_lock(&broker->runLock);
+    while (atomic_load_explicit(&broker->pending, memory_order_acquire) > 0) {
+        pthread_cond_wait(&broker->idleSignal, &broker->runLock);
+    }
+    pthread_mutex_unlock(&broker->runLock);
+}
+
+/*!
+ * @brief remove a client and its subscriptions from the broker, the broker must be write locked
+ */
+static void unlinkClient(brokerClient_t *client) {
+    broker_t *broker = client->broker;
+    while (client->subscriptions != NULL) {
+        removeSubscription(broker, client->subscriptions);
+    }
+    if (client->previous == NULL) {
+        broker->clients = client->next;
+    } else {
+        client->previous->next = client->next;
+    }
+    if (client->next != NULL) {
+        client->next->previous = client->previous;
+    }
+}
+
+static void freeClient(brokerClient_t *client) {
+    pthread_mutex_destroy(&client->queueLock);
+    free(client->willTopic);
+    free(client->id);
+    free(client);
+}
+
+void brokerFree(broker_t *broker) {
+    brokerFlush(broker);
+    stopWorkers(broker);
+
+    pthread_rwlock_wrlock(&broker->lock);
+    releaseSubscriptions(broker);
+    while (broker->clients != NULL) {
+        brokerClient_t *client = broker->clients;
+        unlinkClient(client);
+        freeClient(client);
+    }
+    free(broker->store);
+    free(broker->subscriptionTree);
+    free(broker->registry);
+    pthread_rwlock_unlock(&broker->lock);
+
+    pthread_mutex_lock(&broker->retainedLock);
+    releaseRetained(broker);
+    topicTreeClear(broker->retainedTree);
+    free(broker->retainedTree);
+    pthread_mutex_unlock(&broker->retainedLock);
+
+    pthread_rwlock_destroy(&broker->lock);
+    pthread_mutex_destroy(&broker->retainedLock);
+    pthread_mutex_destroy(&broker->runLock);
+    pthread_cond_destroy(&broker->runSignal);
+    pthread_cond_destroy(&broker->idleSignal);
+    pthread_cond_destroy(&broker->releaseSignal);
+}
+
+eaipCommunicationErrorCodes brokerConnect(broker_t *broker, const char *id, void *userData,
+                                          brokerClient_t **client) {
+    brokerClient_t *new = calloc(1, sizeof(brokerClient_t));
+    char *copy = calloc(strlen(id) + 1, sizeof(char));
+    if (new == NULL || copy == NULL) {
+        free(new);
+        free(copy);
+        return EAIP_COM_OUT_OF_MEMORY;
+    }
+    strcpy(copy, id);
+    new->broker = broker;
+    new->id = copy;
+    new->userData = userData;
+    atomic_init(&new->active, 0);
+    pthread_mutex_init(&new->queueLock, NULL);
+
+    pthread_rwlock_wrlock(&broker->lock);
+    new->next = broker->clients;
+    if (broker->clients != NULL) {
+        broker->clients->previous = new;
+    }
+    broker->clients = new;
+    pthread_rwlock_unlock(&broker->lock);
+
+    *client = new;
     return EAIP_COM_NO_ERROR;
 }
 
-eaipCommunicationErrorCodes publish(char *topic, char *data, __attribute__((unused)) bool retain) {
+eaipCommunicationErrorCodes brokerSetWill(brokerClient_t *client, const char *topic,
+                                          const char *message, bool retain) {
     if (topicIsTooLong(topic)) {
         return EAIP_COM_TOPIC_TO_LONG;
     }
-
-    validationResult_t validation = validateTopicForPublish(topic);
-    if (0 != validation.errorCode) {
-        return EAIP_COM_GENERIC_ERROR;
-    } else if (!validation.isValidTopic) {
+    if (!topicIsValidForPublish(topic, strlen(topic))) {
         return EAIP_COM_INVALID_TOPIC;
     }
 
-    subscriptions_t *current = subscriptions;
-    while (current != NULL) {
-        if (subscribedTopicIsSame(current->subscription->topic, topic)) {
-            current->subscription->handle(topic, data);
-        }
-        current = current->next;
+    /* layout: `<topic>\0<message>\0` */
+    size_t topicLength = strlen(topic);
+    size_t length = strlen(message);
+    char *will = calloc(topicLength + length + 2, sizeof(char));
+    if (will == NULL) {
+        return EAIP_COM_OUT_OF_MEMORY;
     }
+    memcpy(will, topic, topicLength);
+    memcpy(will + topicLength + 1, message, length);
+
+    pthread_rwlock_wrlock(&client->broker->lock);
+    free(client->willTopic);
+    client->willTopic = will;
+    client->willMessage = will + topicLength + 1;
+    client->willLength = length;
+    client->willRetain = retain;
+    pthread_rwlock_unlock(&client->broker->lock);
     return EAIP_COM_NO_ERROR;
 }
 
-void resetSubscriptions() {
-    subscriptions_t *current = subscriptions;
-    while (current != NULL) {
-        subscriptions_t *next = current->next;
+void brokerDisconnect(brokerClient_t *client, bool graceful) {
+    broker_t *broker = client->broker;
+    pthread_rwlock_wrlock(&broker->lock);
+    unlinkClient(client);
+    pthread_rwlock_unlock(&broker->lock);
+
+    /* messages matched before the client was unlinked are still being delivered */
+    atomic_fetch_add(&broker->disconnecting, 1);
+    pthread_mutex_lock(&broker->runLock);
+    while (atomic_load(&client->active) > 0) {
+        pthread_cond_wait(&broker->releaseSignal, &broker->runLock);
+    }
+    pthread_mutex_unlock(&broker->runLock);
+    atomic_fetch_sub(&broker->disconnecting, 1);
+
+    if (!graceful && client->willTopic != NULL) {
+        deliver(broker, client->willTopic, client->willMessage,
+                (const uint8_t *)client->willMessage, client->willLength, client->willRetain);
+    }
+    freeClient(client);
+}
 
-        freeSubscription(current);
-        current = next;
+eaipCommunicationErrorCodes brokerSubscribe(brokerClient_t *client, const char *topic,
+                                            brokerMessageHandler handler) {
+    return addSubscription(client, topic, (subscription_t){.handleMessage = handler});
+}
+
+eaipCommunicationErrorCodes brokerSubscribeRetainAware(brokerClient_t *client, const char *topic,
+                                                       brokerRetainAwareHandler handler) {
+    return addSubscription(client, topic, (subscription_t){.handleRetainAware = handler});
+}
+
+eaipCommunicationErrorCodes brokerUnsubscribe(brokerClient_t *client, const char *topic) {
+    broker_t *broker = client->broker;
+    pthread_rwlock_wrlock(&broker->lock);
+    subscriptions_t *item = findSubscriptionOf(broker, client, topic);
+    if (item != NULL) {
+        removeSubscription(broker, item);
     }
-    subscriptions = NULL;
+    pthread_rwlock_unlock(&broker->lock);
+    return EAIP_COM_NO_ERROR;
+}
+
+eaipCommunicationErrorCodes brokerPublish(brokerClient_t *client, const char *topic,
+                                          const uint8_t *payload, size_t length, bool retain) {
+    return deliver(client->broker, (char *)topic, NULL, payload, length, retain);
+}
+
+void brokerSetRetainedMemoryLimit(broker_t *broker, size_t bytes) {
+    pthread_mutex_lock(&broker->retainedLock);
+    broker->retainedLimit = bytes;
+    evictRetained(broker);
+    pthread_mutex_unlock(&broker->retainedLock);
+}
+
+/* endregion CLIENTS */
+
+/* region ENDPOINT INTERFACE */
+
+static eaipCommunicationErrorCodes clientPublish(void *context, char *topic, char *data,
+                                                 bool retain) {
+    brokerClient_t *client = context;
+    return deliver(client->broker, topic, data, (const uint8_t *)data,
+                   data == NULL ? 0 : strlen(data), retain);
+}
+
+static eaipCommunicationErrorCodes clientSubscribe(void *context, char *topic,
+                                                   void (*handle)(char *topic, char *message)) {
+    return addSubscription(context, topic, (subscription_t){.handle = handle});
+}
+
+static eaipCommunicationErrorCodes clientUnsubscribe(void *context, char *topic) {
+    return brokerUnsubscribe(context, topic);
+}
+
+static eaipCommunicationErrorCodes clientPublishBinary(void *context, char *topic,
+                                                       const uint8_t *payload, size_t length,
+                                                       bool retain) {
+    return brokerPublish(context, topic, payload, length, retain);
+}
+
+static eaipCommunicationErrorCodes
+clientSubscribeBinary(void *context, char *topic,
+                      void (*handle)(char *topic, const uint8_t *payload, size_t length)) {
+    return addSubscription(context, topic, (subscription_t){.handleBinary = handle});
+}
+
+static eaipCommunicationErrorCodes clientSubscribeView(void *context, char *topic,
+                                                       eaipViewHandler handle, void *userData) {
+    return addSubscription(context, topic,
+                           (subscription_t){.handleView = handle, .userData = userData});
 }
+
+const eaipEndpointInterface_t brokerEndpointInterface = {
+    .publish = &clientPublish,
+    .subscribe = &clientSubscribe,
+    .unsubscribe = &clientUnsubscribe,
+    .publishBinary = &clientPublishBinary,
+    .subscribeBinary = &clientSubscribeBinary,
+    .subscribeView = &clientSubscribeView,
+};
+
+/* endregion ENDPOINT INTERFACE */
+
+/* region DEFAULT BROKER */
+
+subscriptions_t *subscriptions = NULL;
+
+static broker_t defaultBroker;
+static brokerClient_t *defaultClient;
+static pthread_once_t defaultBrokerOnce = PTHREAD_ONCE_INIT;
+
+static void initializeDefaultBroker(void) {
+    brokerInit(&defaultBroker);
+    defaultBroker.first = &subscriptions;
+    brokerConnect(&defaultBroker, "default", NULL, &defaultClient);
+}
+static brokerClient_t *getDefaultClient(void) {
+    pthread_once(&defaultBrokerOnce, &initializeDefaultBroker);
+    return defaultClient;
+}
+
+eaipCommunicationErrorCodes subscribe(char *topic, void (*handle)(char *topic, char *message)) {
+    return addSubscription(getDefaultClient(), topic, (subscription_t){.handle = handle});
+}
+
+eaipCommunicationErrorCodes subscribeBinary(char *topic,
+                                            void (*handle)(char *topic, const uint8_t *payload,
+                                                           size_t length)) {
+    return addSubscription(getDefaultClient(), topic, (subscription_t){.handleBinary = handle});
+}
+
+eaipCommunicationErrorCodes subscribeView(char *topic, eaipViewHandler handle, void *userData) {
+    return addSubscription(getDefaultClient(), topic,
+                           (subscription_t){.handleView = handle, .userData = userData});
+}
+
+eaipCommunicationErrorCodes unsubscribe(char *topic) {
+    return brokerUnsubscribe(getDefaultClient(), topic);
+}
+
+eaipCommunicationErrorCodes publish(char *topic, char *data, bool retain) {
+    getDefaultClient();
+    return deliver(&defaultBroker, topic, data, (const uint8_t *)data,
+                   data == NULL ? 0 : strlen(data), retain);
+}
+
+eaipCommunicationErrorCodes publishBinary(char *topic, const uint8_t *payload, size_t length,
+                                          bool retain) {
+    return brokerPublish(getDefaultClient(), topic, payload, length, retain);
+}
+
+const subscription_t *findSubscription(char *topic) {
+    brokerClient_t *client = getDefaultClient();
+    pthread_rwlock_rdlock(&defaultBroker.lock);
+    subscriptions_t *item = findSubscriptionOf(&defaultBroker, client, topic);
+    pthread_rwlock_unlock(&defaultBroker.lock);
+    return item != NULL ? item->subscription : NULL;
+}
+
+void setRetainedMemoryLimit(size_t bytes) {
+    getDefaultClient();
+    brokerSetRetainedMemoryLimit(&defaultBroker, bytes);
+}
+
+void resetSubscriptions() {
+    getDefaultClient();
+    pthread_rwlock_wrlock(&defaultBroker.lock);
+    releaseSubscriptions(&defaultBroker);
+    pthread_rwlock_unlock(&defaultBroker.lock);
+
+    pthread_mutex_lock(&defaultBroker.retainedLock);
+    releaseRetained(&defaultBroker);
+    pthread_mutex_unlock(&defaultBroker.retainedLock);
+}
+
+/* endregion DEFAULT BROKER */
@@ -0,0 +1,183 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/brokerMock/Broker.h"
+#include "eaip/brokerMock/SubscriptionStore.h"
+#include "eaip/protocol/Hash.h"
+
+#define INITIAL_TOPIC_BUCKETS 64
+
+/* region RECORDS */
+
+subscriptions_t *subscriptionStoreAllocate(subscriptionStore_t *store) {
+    subscriptionRecord_t *record = store->freeRecords;
+    if (record != NULL) {
+        store->freeRecords = (subscriptionRecord_t *)record->item.next;
+    } else {
+        if (store->slabs == NULL || store->slabUsed == EAIP_BROKER_SLAB_RECORDS) {
+            subscriptionSlab_t *slab = malloc(sizeof(subscriptionSlab_t));
+            if (slab == NULL) {
+                return NULL;
+            }
+            slab->next = store->slabs;
+            store->slabs = slab;
+            store->slabUsed = 0;
+        }
+        record = &store->slabs->records[store->slabUsed++];
+    }
+
+    memset(record, 0, sizeof(subscriptionRecord_t));
+    record->item.subscription = &record->subscription;
+    return &record->item;
+}
+
+void subscriptionStoreRecycle(subscriptionStore_t *store, subscriptions_t *item) {
+    subscriptionRecord_t *record = (subscriptionRecord_t *)item;
+    record->item.next = (subscriptions_t *)store->freeRecords;
+    store->freeRecords = record;
+}
+
+/* endregion RECORDS */
+
+/* region INTERNED TOPICS */
+
+static uint32_t hashFilter(const char *filter, size_t length) {
+    return hashUpdate32(FNV32_OFFSET_BASIS, filter, length);
+}
+
+static internedTopic_t *findTopic(const subscriptionStore_t *store, const char *filter,
+                                  size_t length, uint32_t hash) {
+    if (store->topicBuckets == 0) {
+        return NULL;
+    }
+    internedTopic_t *current = store->topics[hash & (store->topicBuckets - 1)];
+    while (current != NULL) {
+        if (current->hash == hash && current->length == length &&
+            0 == memcmp(current->text, filter, length)) {
+            return current;
+        }
+        current = current->next;
+    }
+    return NULL;
+}
+
+static bool growTopics(subscriptionStore_t *store) {
+    size_t buckets = store->topicBuckets == 0 ? INITIAL_TOPIC_BUCKETS : store->topicBuckets * 2;
+    internedTopic_t **grown = calloc(buckets, sizeof(internedTopic_t *));
+    if (grown == NULL) {
+        return false;
+    }
+    for (size_t bucket = 0; bucket < store->topicBuckets; bucket++) {
+        internedTopic_t *current = store->topics[bucket];
+        while (current != NULL) {
+            internedTopic_t *next = current->next;
+            current->next = grown[current->hash & (buckets - 1)];
+            grown[current->hash & (buckets - 1)] = current;
+            current = next;
+        }
+    }
+    free(store->topics);
+    store->topics = grown;
+    store->topicBuckets = buckets;
+    return true;
+}
+
+/*! @brief cut a block from the newest arena, starting a new arena if it is full */
+static void *allocateFromArena(subscriptionStore_t *store, size_t size) {
+    if (size > EAIP_BROKER_ARENA_BYTES) {
+        return NULL;
+    }
+    if (store->arenas == NULL || EAIP_BROKER_ARENA_BYTES - store->arenas->used < size) {
+        topicArena_t *arena = malloc(sizeof(topicArena_t));
+        if (arena == NULL) {
+            return NULL;
+        }
+        arena->next = store->arenas;
+        arena->used = 0;
+        store->arenas = arena;
+    }
+    void *block = store->arenas->data + store->arenas->used;
+    store->arenas->used += size;
+    return block;
+}
+
+/*! @brief size class of a filter, all blocks of a class have the same aligned size */
+static size_t sizeClassOf(size_t length) {
+    return (sizeof(internedTopic_t) + length + 1 + INTERNED_TOPIC_STEP - 1) / INTERNED_TOPIC_STEP;
+}
+
+char *subscriptionStoreIntern(subscriptionStore_t *store, const char *filter, size_t length) {
+    uint32_t hash = hashFilter(filter, length);
+    internedTopic_t *topic = findTopic(store, filter, length, hash);
+    if (topic != NULL) {
+        topic->references++;
+        return topic->text;
+    }
+
+    if (store->topicCount >= store->topicBuckets && !growTopics(store)) {
+        return NULL;
+    }
+    size_t sizeClass = sizeClassOf(length);
+    if (sizeClass < INTERNED_TOPIC_CLASSES && store->freeTopics[sizeClass] != NULL) {
+        topic = store->freeTopics[sizeClass];
+        store->freeTopics[sizeClass] = topic->next;
+    } else {
+        topic = allocateFromArena(store, sizeClass * INTERNED_TOPIC_STEP);
+        if (topic == NULL) {
+            return NULL;
+        }
+    }
+    topic->references = 1;
+    topic->hash = hash;
+    topic->length = length;
+    memcpy(topic->text, filter, length);
+    topic->text[length] = '\0';
+    topic->next = store->topics[hash & (store->topicBuckets - 1)];
+    store->topics[hash & (store->topicBuckets - 1)] = topic;
+    store->topicCount++;
+    return topic->text;
+}
+
+void subscriptionStoreRelease(subscriptionStore_t *store, char *interned) {
+    internedTopic_t *topic = (internedTopic_t *)(interned - offsetof(internedTopic_t, text));
+    if (--topic->references > 0) {
+        return;
+    }
+
+    internedTopic_t **link = &store->topics[topic->hash & (store->topicBuckets - 1)];
+    while (*link != topic) {
+        link = &(*link)->next;
+    }
+    *link = topic->next;
+    store->topicCount--;
+
+    size_t sizeClass = sizeClassOf(topic->length);
+    if (sizeClass < INTERNED_TOPIC_CLASSES) {
+        topic->next = store->freeTopics[sizeClass];
+        store->freeTopics[sizeClass] = topic;
+    }
+}
+
+char *subscriptionStoreLookup(const subscriptionStore_t *store, const char *filter, size_t length) {
+    internedTopic_t *topic = findTopic(store, filter, length, hashFilter(filter, length));
+    return topic != NULL ? topic->text : NULL;
+}
+
+/* endregion INTERNED TOPICS */
+
+void subscriptionStoreClear(subscriptionStore_t *store) {
+    while (store->slabs != NULL) {
+        subscriptionSlab_t *next = store->slabs->next;
+        free(store->slabs);
+        store->slabs = next;
+    }
+    while (store->arenas != NULL) {
+        topicArena_t *next = store->arenas->next;
+        free(store->arenas);
+        store->arenas = next;
+    }
+    free(store->topics);
+    memset(store, 0, sizeof(subscriptionStore_t));
+}
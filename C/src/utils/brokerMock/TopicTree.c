@@ -0,0 +1,301 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/brokerMock/TopicTree.h"
+#include "eaip/protocol/Hash.h"
+
+#define INITIAL_BUCKETS 4
+
+/* region LEVELS */
+
+typedef struct level {
+    const char *data;
+    size_t length;
+    bool last;
+} level_t;
+
+/*! @brief split off the level starting at `start`, the caller ensures `start <= length` */
+static level_t levelAt(const char *topic, size_t length, size_t start) {
+    const char *separator = memchr(topic + start, '/', length - start);
+    size_t end = separator != NULL ? (size_t)(separator - topic) : length;
+    return (level_t){.data = topic + start, .length = end - start, .last = separator == NULL};
+}
+
+static uint32_t hashLevel(const char *data, size_t length) {
+    return hashUpdate32(FNV32_OFFSET_BASIS, data, length);
+}
+
+static bool isWildcard(level_t level, char wildcard) {
+    return level.length == 1 && level.data[0] == wildcard;
+}
+
+/* endregion LEVELS */
+
+/* region CHILDREN */
+
+static topicNode_t *findChild(const topicNode_t *node, level_t level, uint32_t hash) {
+    if (node->bucketCount == 0) {
+        return NULL;
+    }
+    topicNode_t *child = node->buckets[hash & (node->bucketCount - 1)];
+    while (child != NULL) {
+        if (child->hash == hash && child->levelLength == level.length &&
+            0 == memcmp(child->level, level.data, level.length)) {
+            return child;
+        }
+        child = child->sibling;
+    }
+    return NULL;
+}
+
+static bool growBuckets(topicNode_t *node) {
+    size_t bucketCount = node->bucketCount == 0 ? INITIAL_BUCKETS : node->bucketCount * 2;
+    topicNode_t **buckets = calloc(bucketCount, sizeof(topicNode_t *));
+    if (buckets == NULL) {
+        return false;
+    }
+
+    for (size_t index = 0; index < node->bucketCount; index++) {
+        topicNode_t *child = node->buckets[index];
+        while (child != NULL) {
+            topicNode_t *next = child->sibling;
+            child->sibling = buckets[child->hash & (bucketCount - 1)];
+            buckets[child->hash & (bucketCount - 1)] = child;
+            child = next;
+        }
+    }
+    free(node->buckets);
+    node->buckets = buckets;
+    node->bucketCount = bucketCount;
+    return true;
+}
+
+static topicNode_t *createNode(topicNode_t *parent, level_t level, uint32_t hash) {
+    topicNode_t *node = calloc(1, sizeof(topicNode_t) + level.length + 1);
+    if (node == NULL) {
+        return NULL;
+    }
+    node->parent = parent;
+    node->hash = hash;
+    node->levelLength = level.length;
+    memcpy(node->level, level.data, level.length);
+    return node;
+}
+
+/*! @brief child for a level of a filter, wildcards are stored outside of the hash table */
+static topicNode_t *addChild(topicNode_t *node, level_t level) {
+    topicNode_t **wildcard = isWildcard(level, '+')   ? &node->singleLevel
+                             : isWildcard(level, '#') ? &node->multiLevel
+                                                      : NULL;
+    if (wildcard != NULL) {
+        if (*wildcard == NULL) {
+            *wildcard = createNode(node, level, 0);
+        }
+        return *wildcard;
+    }
+
+    uint32_t hash = hashLevel(level.data, level.length);
+    topicNode_t *child = findChild(node, level, hash);
+    if (child != NULL) {
+        return child;
+    }
+    if (node->childCount >= node->bucketCount && !growBuckets(node)) {
+        return NULL;
+    }
+    child = createNode(node, level, hash);
+    if (child == NULL) {
+        return NULL;
+    }
+    child->sibling = node->buckets[hash & (node->bucketCount - 1)];
+    node->buckets[hash & (node->bucketCount - 1)] = child;
+    node->childCount++;
+    return child;
+}
+
+static topicNode_t *getChild(const topicNode_t *node, level_t level) {
+    if (isWildcard(level, '+')) {
+        return node->singleLevel;
+    }
+    if (isWildcard(level, '#')) {
+        return node->multiLevel;
+    }
+    return findChild(node, level, hashLevel(level.data, level.length));
+}
+
+static void unlinkChild(topicNode_t *parent, topicNode_t *child) {
+    if (parent->singleLevel == child) {
+        parent->singleLevel = NULL;
+        return;
+    }
+    if (parent->multiLevel == child) {
+        parent->multiLevel = NULL;
+        return;
+    }
+    topicNode_t **link = &parent->buckets[child->hash & (parent->bucketCount - 1)];
+    while (*link != child) {
+        link = &(*link)->sibling;
+    }
+    *link = child->sibling;
+    parent->childCount--;
+}
+
+static bool isUnused(const topicNode_t *node) {
+    return node->value == NULL && node->childCount == 0 && node->singleLevel == NULL &&
+           node->multiLevel == NULL;
+}
+
+/* endregion CHILDREN */
+
+static topicNode_t *findNode(topicNode_t *root, const char *filter, size_t length) {
+    topicNode_t *node = root;
+    for (size_t start = 0; node != NULL && start <= length;) {
+        level_t level = levelAt(filter, length, start);
+        node = getChild(node, level);
+        start += level.length + 1;
+    }
+    return node;
+}
+
+void *topicTreeFind(topicNode_t *root, const char *filter, size_t length) {
+    topicNode_t *node = findNode(root, filter, length);
+    return node != NULL ? node->value : NULL;
+}
+
+bool topicTreeInsert(topicNode_t *root, const char *filter, size_t length, void *value) {
+    topicNode_t *node = root;
+    for (size_t start = 0; start <= length;) {
+        level_t level = levelAt(filter, length, start);
+        topicNode_t *child = addChild(node, level);
+        if (child == NULL) {
+            /* drop the levels created so far */
+            while (node != root && isUnused(node)) {
+                topicNode_t *parent = node->parent;
+                unlinkChild(parent, node);
+                free(node->buckets);
+                free(node);
+                node = parent;
+            }
+            return false;
+        }
+        node = child;
+        start += level.length + 1;
+    }
+    node->value = value;
+    return true;
+}
+
+void *topicTreeRemove(topicNode_t *root, const char *filter, size_t length) {
+    topicNode_t *node = findNode(root, filter, length);
+    if (node == NULL || node->value == NULL) {
+        return NULL;
+    }
+
+    void *value = node->value;
+    node->value = NULL;
+    while (node != root && isUnused(node)) {
+        topicNode_t *parent = node->parent;
+        unlinkChild(parent, node);
+        free(node->buckets);
+        free(node);
+        node = parent;
+    }
+    return value;
+}
+
+static void matchLevels(const topicNode_t *node, const char *topic, size_t length, size_t start,
+                        topicVisitor visit, void *context) {
+    if (start > length) {
+        if (node->value != NULL) {
+            visit(node->value, context);
+        }
+        return;
+    }
+
+    if (node->multiLevel != NULL && node->multiLevel->value != NULL) {
+        visit(node->multiLevel->value, context);
+    }
+
+    level_t level = levelAt(topic, length, start);
+    topicNode_t *child = findChild(node, level, hashLevel(level.data, level.length));
+    if (child != NULL) {
+        matchLevels(child, topic, length, start + level.length + 1, visit, context);
+    }
+    if (node->singleLevel != NULL) {
+        matchLevels(node->singleLevel, topic, length, start + level.length + 1, visit, context);
+    }
+}
+
+void topicTreeMatch(topicNode_t *root, const char *topic, size_t length, topicVisitor visit,
+                    void *context) {
+    matchLevels(root, topic, length, 0, visit, context);
+}
+
+static void visitDescendants(const topicNode_t *node, topicVisitor visit, void *context) {
+    for (size_t index = 0; index < node->bucketCount; index++) {
+        for (topicNode_t *child = node->buckets[index]; child != NULL; child = child->sibling) {
+            if (child->value != NULL) {
+                visit(child->value, context);
+            }
+            visitDescendants(child, visit, context);
+        }
+    }
+}
+
+static void matchFilterLevels(const topicNode_t *node, const char *filter, size_t length,
+                              size_t start, topicVisitor visit, void *context) {
+    if (start > length) {
+        if (node->value != NULL) {
+            visit(node->value, context);
+        }
+        return;
+    }
+
+    level_t level = levelAt(filter, length, start);
+    if (isWildcard(level, '#')) {
+        visitDescendants(node, visit, context);
+    } else if (isWildcard(level, '+')) {
+        for (size_t index = 0; index < node->bucketCount; index++) {
+            for (topicNode_t *child = node->buckets[index]; child != NULL;
+                 child = child->sibling) {
+                matchFilterLevels(child, filter, length, start + 2, visit, context);
+            }
+        }
+    } else {
+        topicNode_t *child = findChild(node, level, hashLevel(level.data, level.length));
+        if (child != NULL) {
+            matchFilterLevels(child, filter, length, start + level.length + 1, visit, context);
+        }
+    }
+}
+
+void topicTreeMatchFilter(topicNode_t *root, const char *filter, size_t length,
+                          topicVisitor visit, void *context) {
+    matchFilterLevels(root, filter, length, 0, visit, context);
+}
+
+static void releaseChildren(topicNode_t *node) {
+    for (size_t index = 0; index < node->bucketCount; index++) {
+        topicNode_t *child = node->buckets[index];
+        while (child != NULL) {
+            topicNode_t *next = child->sibling;
+            releaseChildren(child);
+            free(child);
+            child = next;
+        }
+    }
+    free(node->buckets);
+    if (node->singleLevel != NULL) {
+        releaseChildren(node->singleLevel);
+        free(node->singleLevel);
+    }
+    if (node->multiLevel != NULL) {
+        releaseChildren(node->multiLevel);
+        free(node->multiLevel);
+    }
+}
+
+void topicTreeClear(topicNode_t *root) {
+    releaseChildren(root);
+    memset(root, 0, sizeof(topicNode_t));
+}
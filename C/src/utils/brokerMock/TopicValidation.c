@@ -0,0 +1,115 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eaip/brokerMock/TopicValidation.h"
+
+#if EAIP_TOPIC_VALIDATION_SIMD
+#include <emmintrin.h>
+#endif
+
+/* region CHARACTER CLASSES */
+
+#define LEVEL 0x01     /*! character of a topic level, `P` */
+#define WILDCARD 0x02  /*! single level wildcard `+`, only part of `S` */
+#define SEPARATOR 0x04 /*! level separator `/` */
+
+static const uint8_t characterClasses[256] = {
+    ['a' ... 'z'] = LEVEL,
+    ['A' ... 'Z'] = LEVEL,
+    ['0' ... '9'] = LEVEL,
+    ['_'] = LEVEL,
+    ['\\'] = LEVEL,
+    ['!'] = LEVEL,
+    ['$'] = LEVEL,
+    ['&'] = LEVEL,
+    ['\''] = LEVEL,
+    ['('] = LEVEL,
+    [')'] = LEVEL,
+    ['*'] = LEVEL,
+    [','] = LEVEL,
+    ['.'] = LEVEL,
+    [':'] = LEVEL,
+    [';'] = LEVEL,
+    ['='] = LEVEL,
+    ['?'] = LEVEL,
+    ['@'] = LEVEL,
+    ['%'] = LEVEL,
+    ['~'] = LEVEL,
+    ['-'] = LEVEL,
+    ['+'] = WILDCARD,
+    ['/'] = SEPARATOR,
+};
+
+static uint8_t classOf(char character) {
+    return characterClasses[(uint8_t)character];
+}
+
+/* endregion CHARACTER CLASSES */
+
+/* region SCAN */
+
+#if EAIP_TOPIC_VALIDATION_SIMD
+/*!
+ * @brief number of leading characters that are `LEVEL` or `SEPARATOR`, in blocks of 16
+ *
+ * The printable ASCII range without space is accepted first, then the few printable characters
+ * outside of both classes are excluded.
+ */
+static size_t scanBlocks(const char *topic, size_t length) {
+    static const char excluded[] = {'"', '#', '+', '<', '>', '[', ']', '^', '`', '{', '|', '}'};
+    const __m128i lowest = _mm_set1_epi8(0x21 - 0x80);
+    const __m128i highest = _mm_set1_epi8(0x7e - 0x80);
+    const __m128i bias = _mm_set1_epi8((char)0x80);
+
+    size_t offset = 0;
+    for (; offset + 16 <= length; offset += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(topic + offset));
+        /* signed comparison of the biased bytes is an unsigned comparison of the bytes */
+        __m128i biased = _mm_xor_si128(block, bias);
+        __m128i invalid =
+            _mm_or_si128(_mm_cmplt_epi8(biased, lowest), _mm_cmpgt_epi8(biased, highest));
+        for (size_t index = 0; index < sizeof(excluded); index++) {
+            invalid = _mm_or_si128(invalid, _mm_cmpeq_epi8(block, _mm_set1_epi8(excluded[index])));
+        }
+        if (_mm_movemask_epi8(invalid) != 0) {
+            break;
+        }
+    }
+    return offset;
+}
+#else
+static size_t scanBlocks(__attribute__((unused)) const char *topic,
+                         __attribute__((unused)) size_t length) {
+    return 0;
+}
+#endif
+
+/* endregion SCAN */
+
+bool topicIsValidForSubscribe(const char *topic, size_t length) {
+    for (size_t index = scanBlocks(topic, length); index < length; index++) {
+        if (classOf(topic[index]) != 0) {
+            continue;
+        }
+        /* the only other accepted sequence is a trailing multi level wildcard, `/#` */
+        return topic[index] == '#' && index + 1 == length && index > 0 && topic[index - 1] == '/';
+    }
+    return true;
+}
+
+bool topicIsValidForPublish(const char *topic, size_t length) {
+    /* the first level, after an optional leading separator, must not be empty */
+    size_t first = (length > 0 && topic[0] == '/') ? 1 : 0;
+    if (first >= length || classOf(topic[first]) != LEVEL) {
+        return false;
+    }
+
+    for (size_t index = first + scanBlocks(topic + first, length - first); index < length;
+         index++) {
+        if ((classOf(topic[index]) & (LEVEL | SEPARATOR)) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
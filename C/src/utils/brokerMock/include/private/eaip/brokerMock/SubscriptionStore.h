@@ -0,0 +1,104 @@
+#ifndef EAI_PROTOCOL_BROKERMOCK_SUBSCRIPTION_STORE_HEADER
+#define EAI_PROTOCOL_BROKERMOCK_SUBSCRIPTION_STORE_HEADER
+
+/*!
+ * Dense storage for the subscriptions of a broker
+ *
+ * A subscription record, the list entry together with its subscription, is cut from slabs of
+ * `EAIP_BROKER_SLAB_RECORDS` records; removed records are recycled through a free list. Topic
+ * filters are interned: every distinct filter is stored once in an arena of
+ * `EAIP_BROKER_ARENA_BYTES`, shared by all subscriptions of the filter and compared by address.
+ * Interned filters are reference counted. The block of a filter whose last subscription was
+ * removed is kept on a free list of its size class and reused by the next filter of that size, so
+ * churning subscriptions does not grow the arenas beyond the filters subscribed at the same time.
+ *
+ * Slabs and arenas are only released all at once by `subscriptionStoreClear`.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eaip/brokerMock/Broker.h"
+
+#define INTERNED_TOPIC_STEP 16 /*! granularity of the size classes of interned filters */
+#define INTERNED_TOPIC_CLASSES 16 /*! blocks up to 240 bytes are reused, more than any filter */
+
+typedef struct subscriptionRecord {
+    subscriptions_t item;
+    subscription_t subscription;
+} subscriptionRecord_t;
+
+typedef struct subscriptionSlab subscriptionSlab_t;
+struct subscriptionSlab {
+    subscriptionSlab_t *next;
+    subscriptionRecord_t records[EAIP_BROKER_SLAB_RECORDS];
+};
+
+typedef struct internedTopic internedTopic_t;
+struct internedTopic {
+    internedTopic_t *next; /*! next topic in the same bucket or free list */
+    size_t references;
+    uint32_t hash;
+    size_t length;
+    char text[];
+};
+
+typedef struct topicArena topicArena_t;
+struct topicArena {
+    topicArena_t *next;
+    size_t used;
+    _Alignas(internedTopic_t) char data[EAIP_BROKER_ARENA_BYTES];
+};
+
+typedef struct subscriptionStore {
+    subscriptionSlab_t *slabs;
+    size_t slabUsed; /*! records of the newest slab handed out so far */
+    subscriptionRecord_t *freeRecords;
+    topicArena_t *arenas;
+    internedTopic_t *freeTopics[INTERNED_TOPIC_CLASSES];
+    internedTopic_t **topics;
+    size_t topicBuckets;
+    size_t topicCount;
+} subscriptionStore_t;
+
+/*!
+ * @brief hand out a zeroed record
+ *
+ * The `subscription` field of the returned entry points to the subscription of the record.
+ *
+ * @return the list entry of the record, NULL if memory is exhausted
+ */
+subscriptions_t *subscriptionStoreAllocate(subscriptionStore_t *store);
+
+/*!
+ * @brief return a record to the free list
+ */
+void subscriptionStoreRecycle(subscriptionStore_t *store, subscriptions_t *item);
+
+/*!
+ * @brief find or add the interned copy of a topic filter and take a reference on it
+ *
+ * @return the interned filter, NULL if memory is exhausted or the filter does not fit an arena
+ */
+char *subscriptionStoreIntern(subscriptionStore_t *store, const char *filter, size_t length);
+
+/*!
+ * @brief drop a reference taken by `subscriptionStoreIntern`, the last one recycles the filter
+ *
+ * @param interned[char *] filter returned by `subscriptionStoreIntern`
+ */
+void subscriptionStoreRelease(subscriptionStore_t *store, char *interned);
+
+/*!
+ * @brief find the interned copy of a topic filter without adding it
+ *
+ * @return the interned filter, NULL if the filter was never interned
+ */
+char *subscriptionStoreLookup(const subscriptionStore_t *store, const char *filter, size_t length);
+
+/*!
+ * @brief release all records and interned filters at once
+ */
+void subscriptionStoreClear(subscriptionStore_t *store);
+
+#endif /* EAI_PROTOCOL_BROKERMOCK_SUBSCRIPTION_STORE_HEADER */
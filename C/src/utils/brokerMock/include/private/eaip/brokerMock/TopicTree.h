@@ -0,0 +1,77 @@
+#ifndef EAI_PROTOCOL_BROKERMOCK_TOPIC_TREE_HEADER
+#define EAI_PROTOCOL_BROKERMOCK_TOPIC_TREE_HEADER
+
+/*!
+ * Level-indexed tree of topics or topic filters
+ *
+ * Every node stands for one level and may hold a value, e.g. the subscription of a topic filter or
+ * the retained message of a topic. Children with a literal level are found through a hash table,
+ * the wildcards `+` and `#` are kept aside, so matching visits one path per wildcard that actually
+ * matches instead of every entry.
+ *
+ * `+` and `#` are wildcards only if they make up a whole level. `+` matches exactly one, possibly
+ * empty, level; a trailing `#` matches one or more levels.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct topicNode topicNode_t;
+struct topicNode {
+    topicNode_t *parent;
+    topicNode_t *sibling; /*! next child of `parent` in the same bucket */
+    topicNode_t **buckets;
+    size_t bucketCount;
+    size_t childCount;
+    topicNode_t *singleLevel; /*! child for `+` */
+    topicNode_t *multiLevel;  /*! child for `#` */
+    void *value;
+    uint32_t hash;
+    size_t levelLength;
+    char level[];
+};
+
+typedef void (*topicVisitor)(void *value, void *context);
+
+/*!
+ * @brief find the value of a topic or topic filter
+ *
+ * @return the value, NULL if there is none
+ */
+void *topicTreeFind(topicNode_t *root, const char *filter, size_t length);
+
+/*!
+ * @brief store the value of a topic or topic filter, creating missing levels
+ *
+ * @return false if memory is exhausted
+ */
+bool topicTreeInsert(topicNode_t *root, const char *filter, size_t length, void *value);
+
+/*!
+ * @brief forget the value of a topic or topic filter and release levels no longer needed
+ *
+ * @return the removed value, NULL if there was none
+ */
+void *topicTreeRemove(topicNode_t *root, const char *filter, size_t length);
+
+/*!
+ * @brief call `visit` for every value whose topic filter matches a topic
+ */
+void topicTreeMatch(topicNode_t *root, const char *topic, size_t length, topicVisitor visit,
+                    void *context);
+
+/*!
+ * @brief call `visit` for every value whose topic is matched by a topic filter
+ *
+ * Only literal levels are followed in the tree, wildcards are taken from the filter.
+ */
+void topicTreeMatchFilter(topicNode_t *root, const char *filter, size_t length,
+                          topicVisitor visit, void *context);
+
+/*!
+ * @brief release all levels below `root`, values are not released
+ */
+void topicTreeClear(topicNode_t *root);
+
+#endif /* EAI_PROTOCOL_BROKERMOCK_TOPIC_TREE_HEADER */
@@ -1,22 +1,392 @@
 #ifndef EAI_PROTOCOL_BROKERMOCK_HEADER
 #define EAI_PROTOCOL_BROKERMOCK_HEADER
 
+/*!
+ * In-memory MQTT broker for tests, simulations and benchmarks
+ *
+ * A broker instance holds any number of clients. Every client has its own subscriptions and an
+ * optional last will, which is published if the client disconnects without saying goodbye, e.g.
+ * the offline STATUS of a device. Messages published by one client are delivered synchronously to
+ * all matching subscriptions of all connected clients, so thousands of virtual devices can be
+ * simulated in one process:
+ *
+ * ```c
+ * broker_t broker;
+ * brokerClient_t *device, *monitor;
+ * brokerInit(&broker);
+ * brokerConnect(&broker, "enV5", NULL, &device);
+ * brokerSetWill(device, "eaip://local-net/enV5/STATUS", "OFFLINE", true);
+ * brokerConnect(&broker, "monitor", NULL, &monitor);
+ * brokerSubscribe(monitor, "eaip://local-net/+/STATUS", &handleStatus);
+ * ...
+ * brokerDisconnect(device, false); // delivers OFFLINE to the monitor
+ * brokerFree(&broker);
+ * ```
+ *
+ * The functions of "eaip/endpoint/CommunicationEndpoint.h" act as a single client of a default
+ * broker, whose subscriptions are listed in `subscriptions`.
+ *
+ * All functions may be called from multiple threads at the same time. Publishers only share a
+ * read lock on the subscriptions, handlers are called without holding any lock of the broker.
+ * Handlers may publish, subscribe and unsubscribe but must not disconnect clients.
+ *
+ * By default handlers run on the thread of the publisher. After `brokerStartWorkers` messages are
+ * queued per client instead and handled by a pool of worker threads, so a slow handler no longer
+ * stalls publishers. The messages of a client are handled by one worker at a time in the order
+ * they were queued, which preserves the order of every topic.
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 #include "eaip/endpoint/CommunicationEndpoint.h"
 
+/*!
+ * @brief default limit of the bytes of topics and payloads of all retained messages
+ *
+ * The oldest retained messages are evicted once the limit is exceeded.
+ */
+#ifndef EAIP_BROKER_RETAINED_BYTES
+#define EAIP_BROKER_RETAINED_BYTES (1024 * 1024)
+#endif
+
+/*!
+ * @brief maximum number of messages a worker handles for one client before it serves the next
+ */
+#ifndef EAIP_BROKER_DELIVERY_BATCH
+#define EAIP_BROKER_DELIVERY_BATCH 32
+#endif
+
+/*!
+ * @brief number of subscriptions allocated at once
+ */
+#ifndef EAIP_BROKER_SLAB_RECORDS
+#define EAIP_BROKER_SLAB_RECORDS 256
+#endif
+
+/*!
+ * @brief bytes allocated at once to store topic filters
+ */
+#ifndef EAIP_BROKER_ARENA_BYTES
+#define EAIP_BROKER_ARENA_BYTES 16384
+#endif
+
+typedef struct broker broker_t;
+typedef struct brokerClient brokerClient_t;
+
+/*!
+ * @brief function pointer for handler to process a message received by a client
+ *
+ * @param client[brokerClient_t *] client the subscription belongs to
+ * @param topic[char *] topic of the message
+ * @param payload[uint8_t *] message, always followed by a `\0`
+ * @param length[size_t] length of the message
+ */
+typedef void (*brokerMessageHandler)(brokerClient_t *client, char *topic, const uint8_t *payload,
+                                     size_t length);
+
+/*!
+ * @brief function pointer for handler that also needs to know how a message was delivered, e.g.
+ *        to forward it with the RETAIN flag of MQTT
+ *
+ * @param client[brokerClient_t *] client the subscription belongs to
+ * @param topic[char *] topic of the message
+ * @param payload[uint8_t *] message, always followed by a `\0`
+ * @param length[size_t] length of the message
+ * @param retained[bool] true if the message is a retained one delivered because of the subscription
+ */
+typedef void (*brokerRetainAwareHandler)(brokerClient_t *client, char *topic,
+                                         const uint8_t *payload, size_t length, bool retained);
+
 typedef struct subscription subscription_t;
 struct subscription {
     char *topic;
     void (*handle)(char *topic, char *message);
+    void (*handleBinary)(char *topic, const uint8_t *payload, size_t length);
+    brokerMessageHandler handleMessage;
+    brokerRetainAwareHandler handleRetainAware;
+    eaipViewHandler handleView;
+    void *userData;
+    brokerClient_t *client;
 };
 
+/*!
+ * @brief entry of the list of active subscriptions
+ *
+ * @param subscription[subscription_t *] the subscription
+ * @param next[subscriptions_t *] next subscription in subscription order
+ * @param previous[subscriptions_t *] previous subscription in subscription order
+ *
+ * IMPORTANT: All other fields are managed by the broker and considered private.
+ */
 typedef struct subscriptions subscriptions_t;
 struct subscriptions {
     subscription_t *subscription;
     subscriptions_t *next;
+    subscriptions_t *previous;
+    subscriptions_t *bucketNext;
+    subscriptions_t *filterNext;
+    subscriptions_t *filterPrevious;
+    subscriptions_t *clientNext;
+    subscriptions_t *clientPrevious;
+    uint32_t hash;
+};
+
+/*!
+ * @brief a connected client
+ *
+ * @param broker[broker_t *] broker the client is connected to
+ * @param id[char *] client identifier
+ * @param userData[void *] pointer given on connect
+ *
+ * IMPORTANT: All fields are managed by the `broker*` functions and must not be modified by the
+ *            user.
+ */
+struct brokerClient {
+    broker_t *broker;
+    char *id;
+    void *userData;
+    subscriptions_t *subscriptions;
+    char *willTopic;
+    char *willMessage;
+    size_t willLength;
+    bool willRetain;
+    brokerClient_t *previous;
+    brokerClient_t *next;
+    atomic_size_t active;
+    pthread_mutex_t queueLock;
+    struct delivery *queueFirst;
+    struct delivery *queueLast;
+    bool scheduled;
+    brokerClient_t *runNext;
 };
 
+/*!
+ * @brief struct holding the state of a broker
+ *
+ * IMPORTANT: All fields are managed by the `broker*` functions and must not be modified by the
+ *            user.
+ */
+struct broker {
+    pthread_rwlock_t lock;
+    subscriptions_t **first;
+    subscriptions_t *ownFirst;
+    subscriptions_t *last;
+    struct subscriptionStore *store;
+    struct topicNode *subscriptionTree;
+    subscriptions_t **registry;
+    size_t registryBuckets;
+    size_t registryCount;
+    pthread_mutex_t retainedLock;
+    struct topicNode *retainedTree;
+    struct retained *oldestRetained;
+    struct retained *newestRetained;
+    size_t retainedBytes;
+    size_t retainedLimit;
+    brokerClient_t *clients;
+    pthread_mutex_t runLock;
+    pthread_cond_t runSignal;
+    pthread_cond_t idleSignal;
+    pthread_cond_t releaseSignal;
+    brokerClient_t *runFirst;
+    brokerClient_t *runLast;
+    pthread_t *workers;
+    size_t workerCount;
+    bool stopping;
+    atomic_size_t pending;
+    atomic_size_t disconnecting;
+};
+
+/*!
+ * @brief initialize a broker without clients
+ *
+ * @param broker[broker_t *] broker to initialize
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes brokerInit(broker_t *broker);
+
+/*!
+ * @brief start a pool of threads handling the messages of all clients
+ *
+ * Must be called at most once, before clients publish or subscribe.
+ *
+ * @param broker[broker_t *] initialized broker
+ * @param workers[size_t] number of worker threads, at least 1
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_GENERIC_ERROR if the workers were already started or a thread failed to start
+ */
+eaipCommunicationErrorCodes brokerStartWorkers(broker_t *broker, size_t workers);
+
+/*!
+ * @brief wait until all queued messages were handled
+ *
+ * Returns immediately if no workers were started. Must not be called by a handler, a handler
+ * running on a worker would wait for itself and stall the pool.
+ *
+ * @param broker[broker_t *] initialized broker
+ */
+void brokerFlush(broker_t *broker);
+
+/*!
+ * @brief release a broker, its clients, subscriptions and retained messages
+ *
+ * Queued messages are handled before the workers are stopped. Last wills are not published.
+ *
+ * @param broker[broker_t *] broker to release
+ */
+void brokerFree(broker_t *broker);
+
+/*!
+ * @brief connect a new client
+ *
+ * @param broker[broker_t *] initialized broker
+ * @param id[char *] client identifier, informational only
+ * @param userData[void *] pointer available to handlers as `client->userData`
+ * @param client[brokerClient_t **] receives the client
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes brokerConnect(broker_t *broker, const char *id, void *userData,
+                                          brokerClient_t **client);
+
+/*!
+ * @brief register the message published if the client disconnects unexpectedly
+ *
+ * A later call replaces the last will.
+ *
+ * @param client[brokerClient_t *] connected client
+ * @param topic[char *] topic of the last will
+ * @param message[char *] message of the last will
+ * @param retain[bool] whether the last will is retained
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_TOPIC_TO_LONG or EAIP_COM_INVALID_TOPIC if the topic can not be published to
+ */
+eaipCommunicationErrorCodes brokerSetWill(brokerClient_t *client, const char *topic,
+                                          const char *message, bool retain);
+
+/*!
+ * @brief disconnect and release a client and its subscriptions
+ *
+ * Waits until messages that are being delivered or queued for the client were handled. Must not be
+ * called by a handler running on a worker, which could wait for its own delivery.
+ *
+ * @param client[brokerClient_t *] connected client
+ * @param graceful[bool] false simulates a lost connection and publishes the last will
+ */
+void brokerDisconnect(brokerClient_t *client, bool graceful);
+
+/*!
+ * @brief subscribe a client to a topic filter
+ *
+ * Retained messages matching the filter are delivered, or queued if workers were started, before
+ * the function returns.
+ *
+ * @param client[brokerClient_t *] connected client
+ * @param topic[char *] topic filter, may contain `+` and a trailing `/#`
+ * @param handler[brokerMessageHandler] function called for every matching message
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_TOPIC_ALREADY_SUBSCRIBED if the client already subscribed the filter
+ */
+eaipCommunicationErrorCodes brokerSubscribe(brokerClient_t *client, const char *topic,
+                                            brokerMessageHandler handler);
+
+/*!
+ * @brief subscribe a client to a topic filter like `brokerSubscribe`, with a handler that is told
+ *        whether a message is a retained one delivered because of this subscription
+ *
+ * @param client[brokerClient_t *] connected client
+ * @param topic[char *] topic filter, may contain `+` and a trailing `/#`
+ * @param handler[brokerRetainAwareHandler] function called for every matching message
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_TOPIC_ALREADY_SUBSCRIBED if the client already subscribed the filter
+ */
+eaipCommunicationErrorCodes brokerSubscribeRetainAware(brokerClient_t *client, const char *topic,
+                                                       brokerRetainAwareHandler handler);
+
+/*!
+ * @brief unsubscribe a client from a topic filter
+ *
+ * @param client[brokerClient_t *] connected client
+ * @param topic[char *] topic filter as given to `brokerSubscribe`
+ *
+ * @return 0 if no error occurred
+ */
+eaipCommunicationErrorCodes brokerUnsubscribe(brokerClient_t *client, const char *topic);
+
+/*!
+ * @brief publish a message to the subscriptions of all clients of the broker
+ *
+ * @param client[brokerClient_t *] connected client
+ * @param topic[char *] topic to publish to
+ * @param payload[uint8_t *] message, may contain `\0` bytes
+ * @param length[size_t] length of the message
+ * @param retain[bool] whether the broker should retain the message
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_OUT_OF_MEMORY if the message could not be retained or not be delivered to all
+ *         subscribers; subscribers get the message even if it could not be retained
+ */
+eaipCommunicationErrorCodes brokerPublish(brokerClient_t *client, const char *topic,
+                                          const uint8_t *payload, size_t length, bool retain);
+
+/*!
+ * @brief change the limit of the retained messages, evicting the oldest if necessary
+ *
+ * Messages published with `retain` are stored per topic and delivered to every new subscription
+ * they match; an empty message removes the retained message of its topic.
+ *
+ * @param broker[broker_t *] initialized broker
+ * @param bytes[size_t] limit of the bytes of topics and payloads of all retained messages
+ */
+void brokerSetRetainedMemoryLimit(broker_t *broker, size_t bytes);
+
+/*!
+ * @brief communication endpoint functions acting for a client, the context is a `brokerClient_t *`
+ *
+ * Allows a configuration to use any number of clients, e.g. as connections of a sharded endpoint:
+ * `config.endpoint = (eaipEndpoint_t){&brokerEndpointInterface, client};`
+ */
+extern const eaipEndpointInterface_t brokerEndpointInterface;
+
+/* region DEFAULT BROKER */
+
+/*!
+ * @brief list of the subscriptions of the default broker
+ *
+ * Direct access to the list is not synchronized. Subscriptions are also indexed by topic filter
+ * and by level, so the list must only be read, never modified directly.
+ */
 extern subscriptions_t *subscriptions;
 
+/*!
+ * @brief look up a subscription of the default client in constant time
+ *
+ * @param topic[char *] topic filter as given to `subscribe`
+ *
+ * @return the subscription, valid until the filter is unsubscribed, NULL if not subscribed
+ */
+const subscription_t *findSubscription(char *topic);
+
+/*!
+ * @brief see `brokerSetRetainedMemoryLimit`, for the default broker
+ */
+void setRetainedMemoryLimit(size_t bytes);
+
+/*!
+ * @brief release all subscriptions and retained messages of the default broker
+ *
+ * Subscriptions are stored in slabs and arenas, which are released at once.
+ */
 void resetSubscriptions(void);
 
+/* endregion DEFAULT BROKER */
+
 #endif /* EAI_PROTOCOL_BROKERMOCK_HEADER */
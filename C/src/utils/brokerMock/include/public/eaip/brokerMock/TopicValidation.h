@@ -0,0 +1,53 @@
+#ifndef EAI_PROTOCOL_BROKERMOCK_TOPIC_VALIDATION_HEADER
+#define EAI_PROTOCOL_BROKERMOCK_TOPIC_VALIDATION_HEADER
+
+/*!
+ * Topic validation of the broker mock
+ *
+ * Topics are checked against a precomputed table of character classes by a small state machine,
+ * without any allocation or regex compilation. The accepted topics are the same as for the
+ * regular expressions
+ *
+ *   subscribe: ^(\/?S*(\/S*)*(\/#)?|\+)$
+ *   publish:   ^(\/?P+(\/P*)*\/?$)
+ *
+ * with `S` being `[a-zA-Z0-9_\!$&'()*+,.:;=?@%~-]` and `P` being `S` without `+`.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*!
+ * @brief scan 16 characters at once with SSE2 before falling back to the table
+ *
+ * Enabled by default if the target supports SSE2, define as 0 to disable.
+ */
+#ifndef EAIP_TOPIC_VALIDATION_SIMD
+#if defined(__SSE2__)
+#define EAIP_TOPIC_VALIDATION_SIMD 1
+#else
+#define EAIP_TOPIC_VALIDATION_SIMD 0
+#endif
+#endif
+
+/*!
+ * @brief check whether a topic filter may be subscribed to
+ *
+ * @param topic[char *] topic filter, may contain `+` and a trailing `/#`
+ * @param length[size_t] length of the topic filter
+ *
+ * @return true if the topic filter is valid
+ */
+bool topicIsValidForSubscribe(const char *topic, size_t length);
+
+/*!
+ * @brief check whether a topic may be published to
+ *
+ * @param topic[char *] topic, must not contain wildcards
+ * @param length[size_t] length of the topic
+ *
+ * @return true if the topic is valid
+ */
+bool topicIsValidForPublish(const char *topic, size_t length);
+
+#endif /* EAI_PROTOCOL_BROKERMOCK_TOPIC_VALIDATION_HEADER */
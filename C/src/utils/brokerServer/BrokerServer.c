@@ -0,0 +1,719 @@
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "eaip/brokerMock/Broker.h"
+#include "eaip/brokerServer/BrokerServer.h"
+#include "eaip/endpoint/CommunicationEndpoint.h"
+
+#define MAX_TOPIC_LENGTH 128 /*! As accepted by the broker mock */
+#define INITIAL_BUFFER 4096
+#define MAX_HEADER 5 /*! packet type and up to four bytes of remaining length */
+
+#define CONNECT 0x10
+#define CONNACK 0x20
+#define PUBLISH 0x30
+#define PUBACK 0x40
+#define SUBSCRIBE 0x80
+#define SUBACK 0x90
+#define UNSUBSCRIBE 0xA0
+#define UNSUBACK 0xB0
+#define PINGREQ 0xC0
+#define PINGRESP 0xD0
+#define DISCONNECT 0xE0
+#define RETAIN 0x01 /*! flag of PUBLISH */
+
+/*!
+ * @brief a TCP connection and the broker client it acts for once CONNECT was received
+ */
+typedef struct connection connection_t;
+struct connection {
+    brokerServer_t *server;
+    int socket;
+    brokerClient_t *client;
+    uint8_t *input;
+    size_t inputLength;
+    size_t inputCapacity;
+    uint8_t *output;
+    size_t outputStart;
+    size_t outputLength;
+    size_t outputCapacity;
+    bool waitingForOutput; /*! the socket buffer is full, waiting for EPOLLOUT */
+    bool flushPending;
+    bool closing;
+    bool graceful;
+    connection_t *previous;
+    connection_t *next;
+    connection_t *flushNext;
+    connection_t *closeNext;
+};
+
+/* region CONNECTIONS */
+
+static void closeLater(connection_t *connection, bool graceful) {
+    if (connection->closing) {
+        return;
+    }
+    connection->closing = true;
+    connection->graceful = graceful;
+    connection->closeNext = connection->server->closeFirst;
+    connection->server->closeFirst = connection;
+}
+
+static void flushLater(connection_t *connection) {
+    if (connection->flushPending || connection->closing) {
+        return;
+    }
+    connection->flushPending = true;
+    connection->flushNext = connection->server->flushFirst;
+    connection->server->flushFirst = connection;
+}
+
+static void releaseConnection(connection_t *connection) {
+    brokerServer_t *server = connection->server;
+    if (connection->flushPending) {
+        connection_t **link = &server->flushFirst;
+        while (*link != connection) {
+            link = &(*link)->flushNext;
+        }
+        *link = connection->flushNext;
+    }
+    if (connection->previous == NULL) {
+        server->connections = connection->next;
+    } else {
+        connection->previous->next = connection->next;
+    }
+    if (connection->next != NULL) {
+        connection->next->previous = connection->previous;
+    }
+
+    epoll_ctl(server->epoll, EPOLL_CTL_DEL, connection->socket, NULL);
+    close(connection->socket);
+    free(connection->input);
+    free(connection->output);
+    free(connection);
+}
+
+static void acceptConnections(brokerServer_t *server) {
+    for (;;) {
+        int socket = accept(server->listener, NULL, NULL);
+        if (socket < 0) {
+            return; /* EAGAIN once all pending connections were accepted */
+        }
+        fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK);
+        if (server->noDelay) {
+            int enabled = 1;
+            setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+        }
+
+        connection_t *connection = calloc(1, sizeof(connection_t));
+        struct epoll_event event = {.events = EPOLLIN, .data.ptr = connection};
+        if (connection == NULL || 0 != epoll_ctl(server->epoll, EPOLL_CTL_ADD, socket, &event)) {
+            free(connection);
+            close(socket);
+            continue;
+        }
+        connection->server = server;
+        connection->socket = socket;
+        connection->next = server->connections;
+        if (server->connections != NULL) {
+            server->connections->previous = connection;
+        }
+        server->connections = connection;
+    }
+}
+
+/* endregion CONNECTIONS */
+
+/* region OUTPUT */
+
+static bool reserveOutput(connection_t *connection, size_t length) {
+    if (connection->outputStart > 0 && connection->outputStart >= connection->outputLength) {
+        connection->outputStart = 0;
+        connection->outputLength = 0;
+    }
+    size_t required = connection->outputLength + length;
+    if (required <= connection->outputCapacity) {
+        return true;
+    }
+    if (required - connection->outputStart > EAIP_BROKER_SERVER_MAX_BACKLOG) {
+        return false;
+    }
+    if (connection->outputStart > 0) {
+        memmove(connection->output, connection->output + connection->outputStart,
+                connection->outputLength - connection->outputStart);
+        connection->outputLength -= connection->outputStart;
+        connection->outputStart = 0;
+        required = connection->outputLength + length;
+        if (required <= connection->outputCapacity) {
+            return true;
+        }
+    }
+
+    size_t capacity = connection->outputCapacity == 0 ? INITIAL_BUFFER : connection->outputCapacity;
+    while (capacity < required) {
+        capacity *= 2;
+    }
+    uint8_t *grown = realloc(connection->output, capacity);
+    if (grown == NULL) {
+        return false;
+    }
+    connection->output = grown;
+    connection->outputCapacity = capacity;
+    return true;
+}
+
+static size_t encodeRemainingLength(uint8_t *target, size_t length) {
+    size_t used = 0;
+    do {
+        uint8_t digit = length % 128;
+        length /= 128;
+        target[used++] = length > 0 ? digit | 0x80 : digit;
+    } while (length > 0);
+    return used;
+}
+
+/*!
+ * @brief queue a packet, closing the connection if it does not read fast enough
+ *
+ * @param first[uint8_t *] first part of the variable header and payload
+ * @param second[uint8_t *] second part, appended to `first`, may be NULL
+ */
+static void queuePacket(connection_t *connection, uint8_t type, const uint8_t *first,
+                        size_t firstLength, const uint8_t *second, size_t secondLength) {
+    if (connection->closing) {
+        return;
+    }
+    uint8_t header[MAX_HEADER];
+    header[0] = type;
+    size_t headerLength = 1 + encodeRemainingLength(header + 1, firstLength + secondLength);
+    if (!reserveOutput(connection, headerLength + firstLength + secondLength)) {
+        closeLater(connection, false);
+        return;
+    }
+
+    uint8_t *target = connection->output + connection->outputLength;
+    memcpy(target, header, headerLength);
+    if (firstLength > 0) {
+        memcpy(target + headerLength, first, firstLength);
+    }
+    if (secondLength > 0) {
+        memcpy(target + headerLength + firstLength, second, secondLength);
+    }
+    connection->outputLength += headerLength + firstLength + secondLength;
+    flushLater(connection);
+}
+
+static void watchOutput(connection_t *connection, bool waiting) {
+    struct epoll_event event = {.events = waiting ? EPOLLIN | EPOLLOUT : EPOLLIN,
+                                .data.ptr = connection};
+    epoll_ctl(connection->server->epoll, EPOLL_CTL_MOD, connection->socket, &event);
+    connection->waitingForOutput = waiting;
+}
+
+static void flushConnection(connection_t *connection) {
+    while (connection->outputStart < connection->outputLength) {
+        ssize_t sent = send(connection->socket, connection->output + connection->outputStart,
+                            connection->outputLength - connection->outputStart, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!connection->waitingForOutput) {
+                watchOutput(connection, true);
+            }
+            return;
+        }
+        if (sent < 0) {
+            closeLater(connection, false);
+            return;
+        }
+        connection->outputStart += (size_t)sent;
+    }
+    connection->outputStart = 0;
+    connection->outputLength = 0;
+    if (connection->waitingForOutput) {
+        watchOutput(connection, false);
+    }
+}
+
+/*!
+ * @brief forward a message of a matching subscription to the connection of the client
+ *
+ * Only retained messages sent because of a new subscription carry the RETAIN flag
+ * [MQTT-3.3.1-8, MQTT-3.3.1-9].
+ */
+static void forwardMessage(brokerClient_t *client, char *topic, const uint8_t *payload,
+                           size_t length, bool retained) {
+    connection_t *connection = client->userData;
+    size_t topicLength = strlen(topic);
+    uint8_t variableHeader[2 + MAX_TOPIC_LENGTH];
+    variableHeader[0] = (uint8_t)(topicLength >> 8);
+    variableHeader[1] = (uint8_t)topicLength;
+    memcpy(variableHeader + 2, topic, topicLength);
+    uint8_t type = retained ? PUBLISH | RETAIN : PUBLISH;
+    queuePacket(connection, type, variableHeader, 2 + topicLength, payload, length);
+}
+
+/* endregion OUTPUT */
+
+/* region PACKETS */
+
+/*!
+ * @brief cursor over the variable header and payload of a received packet
+ */
+typedef struct reader {
+    const uint8_t *position;
+    const uint8_t *end;
+    bool failed;
+} reader_t;
+
+static uint16_t readUint16(reader_t *reader) {
+    if (reader->end - reader->position < 2) {
+        reader->failed = true;
+        return 0;
+    }
+    uint16_t value = (uint16_t)(reader->position[0] << 8 | reader->position[1]);
+    reader->position += 2;
+    return value;
+}
+
+/*! @brief read a length prefixed string or binary field, the result is not terminated */
+static const uint8_t *readField(reader_t *reader, size_t *length) {
+    *length = readUint16(reader);
+    if (reader->failed || (size_t)(reader->end - reader->position) < *length) {
+        reader->failed = true;
+        return NULL;
+    }
+    const uint8_t *field = reader->position;
+    reader->position += *length;
+    return field;
+}
+
+/*! @brief read a topic or topic filter into a terminated buffer of `MAX_TOPIC_LENGTH + 1` */
+static bool readTopic(reader_t *reader, char *topic) {
+    size_t length;
+    const uint8_t *field = readField(reader, &length);
+    if (field == NULL || length > MAX_TOPIC_LENGTH) {
+        reader->failed = true;
+        return false;
+    }
+    memcpy(topic, field, length);
+    topic[length] = '\0';
+    return true;
+}
+
+/*!
+ * @brief disconnect another connection that uses the client id, publishing its will
+ *
+ * A client id identifies one session (MQTT-3.1.4-2). The old session is ended before the new one
+ * is accepted, so the broker never holds two clients with the same id.
+ */
+static void takeOverSession(connection_t *connection, const char *id) {
+    for (connection_t *other = connection->server->connections; other != NULL;
+         other = other->next) {
+        if (other == connection || other->client == NULL || 0 != strcmp(other->client->id, id)) {
+            continue;
+        }
+        brokerDisconnect(other->client, other->closing && other->graceful);
+        other->client = NULL;
+        closeLater(other, false);
+        return;
+    }
+}
+
+static void handleConnect(connection_t *connection, reader_t *reader) {
+    size_t length;
+    const uint8_t *protocol = readField(reader, &length);
+    if (protocol == NULL || length != 4 || 0 != memcmp(protocol, "MQTT", 4) ||
+        reader->end - reader->position < 4) {
+        closeLater(connection, false);
+        return;
+    }
+    uint8_t level = reader->position[0];
+    uint8_t flags = reader->position[1];
+    reader->position += 4; /* keep alive is not enforced */
+    if (level != 4) {
+        const uint8_t refused[] = {0x00, 0x01}; /* unacceptable protocol version */
+        queuePacket(connection, CONNACK, refused, sizeof(refused), NULL, 0);
+        closeLater(connection, false);
+        return;
+    }
+
+    char id[MAX_TOPIC_LENGTH + 1];
+    const uint8_t *clientId = readField(reader, &length);
+    if (clientId == NULL || length > MAX_TOPIC_LENGTH) {
+        closeLater(connection, false);
+        return;
+    }
+    memcpy(id, clientId, length);
+    id[length] = '\0';
+    takeOverSession(connection, id);
+    if (EAIP_COM_NO_ERROR !=
+        brokerConnect(&connection->server->broker, id, connection, &connection->client)) {
+        closeLater(connection, false);
+        return;
+    }
+
+    if (flags & 0x04) {
+        char willTopic[MAX_TOPIC_LENGTH + 1];
+        const uint8_t *willMessage = NULL;
+        if (readTopic(reader, willTopic)) {
+            willMessage = readField(reader, &length);
+        }
+        char *message = willMessage != NULL ? malloc(length + 1) : NULL;
+        if (message == NULL) {
+            closeLater(connection, false);
+            return;
+        }
+        /* wills are stored as text, binary wills end at their first zero byte */
+        memcpy(message, willMessage, length);
+        message[length] = '\0';
+        eaipCommunicationErrorCodes result =
+            brokerSetWill(connection->client, willTopic, message, (flags & 0x20) != 0);
+        free(message);
+        if (result != EAIP_COM_NO_ERROR) {
+            closeLater(connection, false);
+            return;
+        }
+    }
+
+    const uint8_t accepted[] = {0x00, 0x00};
+    queuePacket(connection, CONNACK, accepted, sizeof(accepted), NULL, 0);
+}
+
+static void handlePublish(connection_t *connection, uint8_t flags, reader_t *reader) {
+    char topic[MAX_TOPIC_LENGTH + 1];
+    uint8_t qos = (flags >> 1) & 0x03;
+    if (!readTopic(reader, topic) || qos > 1) {
+        closeLater(connection, false);
+        return;
+    }
+    uint16_t packetId = qos > 0 ? readUint16(reader) : 0;
+    if (reader->failed) {
+        closeLater(connection, false);
+        return;
+    }
+
+    if (EAIP_COM_NO_ERROR != brokerPublish(connection->client, topic, reader->position,
+                                           (size_t)(reader->end - reader->position),
+                                           (flags & RETAIN) != 0)) {
+        closeLater(connection, false);
+        return;
+    }
+    if (qos > 0) {
+        const uint8_t acknowledge[] = {(uint8_t)(packetId >> 8), (uint8_t)packetId};
+        queuePacket(connection, PUBACK, acknowledge, sizeof(acknowledge), NULL, 0);
+    }
+}
+
+static void handleSubscribe(connection_t *connection, reader_t *reader, bool subscribe) {
+    /* every filter takes at least three bytes, one return code each */
+    uint8_t *acknowledge = malloc(2 + (size_t)(reader->end - reader->position) / 3);
+    if (acknowledge == NULL) {
+        closeLater(connection, false);
+        return;
+    }
+    uint16_t packetId = readUint16(reader);
+    acknowledge[0] = (uint8_t)(packetId >> 8);
+    acknowledge[1] = (uint8_t)packetId;
+    size_t filters = 0;
+
+    while (!reader->failed && reader->position < reader->end) {
+        char filter[MAX_TOPIC_LENGTH + 1];
+        if (!readTopic(reader, filter)) {
+            break;
+        }
+        if (!subscribe) {
+            brokerUnsubscribe(connection->client, filter);
+            filters++;
+            continue;
+        }
+        if (reader->position == reader->end) {
+            reader->failed = true;
+            break;
+        }
+        reader->position++; /* requested QoS, QoS 0 is granted */
+        eaipCommunicationErrorCodes result =
+            brokerSubscribeRetainAware(connection->client, filter, &forwardMessage);
+        bool granted = result == EAIP_COM_NO_ERROR || result == EAIP_COM_TOPIC_ALREADY_SUBSCRIBED;
+        acknowledge[2 + filters++] = granted ? 0x00 : 0x80;
+    }
+    if (reader->failed || filters == 0) {
+        closeLater(connection, false);
+    } else if (subscribe) {
+        queuePacket(connection, SUBACK, acknowledge, 2 + filters, NULL, 0);
+    } else {
+        queuePacket(connection, UNSUBACK, acknowledge, 2, NULL, 0);
+    }
+    free(acknowledge);
+}
+
+static void handlePacket(connection_t *connection, uint8_t type, const uint8_t *body,
+                         size_t length) {
+    reader_t reader = {.position = body, .end = body + length, .failed = false};
+    uint8_t packetType = type & 0xF0;
+
+    if (connection->client == NULL) {
+        if (packetType == CONNECT) {
+            handleConnect(connection, &reader);
+        } else {
+            closeLater(connection, false);
+        }
+        return;
+    }
+
+    switch (packetType) {
+    case PUBLISH:
+        handlePublish(connection, type & 0x0F, &reader);
+        break;
+    case SUBSCRIBE:
+    case UNSUBSCRIBE:
+        if ((type & 0x0F) != 0x02) { /* reserved flags (MQTT-3.8.1-1, MQTT-3.10.1-1) */
+            closeLater(connection, false);
+        } else {
+            handleSubscribe(connection, &reader, packetType == SUBSCRIBE);
+        }
+        break;
+    case PINGREQ:
+        queuePacket(connection, PINGRESP, NULL, 0, NULL, 0);
+        break;
+    case DISCONNECT:
+        closeLater(connection, true); /* the only case that discards the will */
+        break;
+    case PUBACK:
+        break; /* messages are forwarded with QoS 0, nothing to acknowledge */
+    default:
+        closeLater(connection, false);
+        break;
+    }
+}
+
+/* endregion PACKETS */
+
+/* region INPUT */
+
+/*!
+ * @brief split off the next complete packet from the input
+ *
+ * @return size of the packet including its header, 0 if incomplete, SIZE_MAX if malformed
+ */
+static size_t nextPacket(const connection_t *connection, size_t start, size_t *headerLength) {
+    size_t length = 0;
+    size_t available = connection->inputLength - start;
+    for (size_t index = 1; index < MAX_HEADER; index++) {
+        if (index >= available) {
+            return 0;
+        }
+        uint8_t digit = connection->input[start + index];
+        length |= (size_t)(digit & 0x7F) << (7 * (index - 1));
+        if ((digit & 0x80) == 0) {
+            if (length > EAIP_BROKER_SERVER_MAX_PACKET) {
+                return SIZE_MAX;
+            }
+            *headerLength = index + 1;
+            return *headerLength + length;
+        }
+    }
+    return SIZE_MAX;
+}
+
+static bool reserveInput(connection_t *connection, size_t required) {
+    if (required <= connection->inputCapacity) {
+        return true;
+    }
+    size_t capacity = connection->inputCapacity == 0 ? INITIAL_BUFFER : connection->inputCapacity;
+    while (capacity < required) {
+        capacity *= 2;
+    }
+    uint8_t *grown = realloc(connection->input, capacity);
+    if (grown == NULL) {
+        return false;
+    }
+    connection->input = grown;
+    connection->inputCapacity = capacity;
+    return true;
+}
+
+/*!
+ * @brief read what the socket has and handle all complete packets, packets may span many reads
+ */
+static void readConnection(connection_t *connection) {
+    if (!reserveInput(connection, connection->inputLength + INITIAL_BUFFER)) {
+        closeLater(connection, false);
+        return;
+    }
+    ssize_t received = recv(connection->socket, connection->input + connection->inputLength,
+                            connection->inputCapacity - connection->inputLength, 0);
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        return;
+    }
+    if (received <= 0) {
+        closeLater(connection, false); /* connection lost, publishes the last will */
+        return;
+    }
+    connection->inputLength += (size_t)received;
+
+    size_t start = 0;
+    while (!connection->closing) {
+        size_t headerLength = 0;
+        size_t packetLength = nextPacket(connection, start, &headerLength);
+        if (packetLength == SIZE_MAX) {
+            closeLater(connection, false);
+        }
+        if (packetLength == 0 || packetLength == SIZE_MAX) {
+            break;
+        }
+        if (packetLength > connection->inputLength - start) {
+            if (!reserveInput(connection, packetLength)) {
+                closeLater(connection, false);
+            }
+            break;
+        }
+        handlePacket(connection, connection->input[start], connection->input + start + headerLength,
+                     packetLength - headerLength);
+        start += packetLength;
+    }
+
+    memmove(connection->input, connection->input + start, connection->inputLength - start);
+    connection->inputLength -= start;
+}
+
+/* endregion INPUT */
+
+/*!
+ * @brief send queued output and close connections until nothing is left to do
+ *
+ * Closing a connection may publish its last will, which queues output for other connections.
+ */
+static void completeIteration(brokerServer_t *server) {
+    while (server->flushFirst != NULL || server->closeFirst != NULL) {
+        while (server->flushFirst != NULL) {
+            connection_t *connection = server->flushFirst;
+            server->flushFirst = connection->flushNext;
+            connection->flushPending = false;
+            if (!connection->closing) {
+                flushConnection(connection);
+            }
+        }
+        while (server->closeFirst != NULL) {
+            connection_t *connection = server->closeFirst;
+            server->closeFirst = connection->closeNext;
+            if (connection->client != NULL) {
+                brokerDisconnect(connection->client, connection->graceful);
+            }
+            releaseConnection(connection);
+        }
+    }
+}
+
+eaipCommunicationErrorCodes brokerServerInit(brokerServer_t *server, uint16_t port, bool noDelay) {
+    memset(server, 0, sizeof(brokerServer_t));
+    atomic_init(&server->stopping, false);
+    server->noDelay = noDelay;
+    server->listener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    server->epoll = epoll_create1(EPOLL_CLOEXEC);
+    server->wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    int enabled = 1;
+    struct sockaddr_in address = {.sin_family = AF_INET,
+                                  .sin_port = htons(port),
+                                  .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    socklen_t addressLength = sizeof(address);
+    struct epoll_event incoming = {.events = EPOLLIN, .data.ptr = &server->listener};
+    struct epoll_event wakeup = {.events = EPOLLIN, .data.ptr = &server->wakeup};
+    if (server->listener < 0 || server->epoll < 0 || server->wakeup < 0 ||
+        0 != setsockopt(server->listener, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled)) ||
+        0 != bind(server->listener, (struct sockaddr *)&address, sizeof(address)) ||
+        0 != listen(server->listener, SOMAXCONN) ||
+        0 != getsockname(server->listener, (struct sockaddr *)&address, &addressLength) ||
+        0 != epoll_ctl(server->epoll, EPOLL_CTL_ADD, server->listener, &incoming) ||
+        0 != epoll_ctl(server->epoll, EPOLL_CTL_ADD, server->wakeup, &wakeup)) {
+        close(server->listener);
+        close(server->epoll);
+        close(server->wakeup);
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    server->port = ntohs(address.sin_port);
+
+    eaipCommunicationErrorCodes result = brokerInit(&server->broker);
+    if (result != EAIP_COM_NO_ERROR) {
+        close(server->listener);
+        close(server->epoll);
+        close(server->wakeup);
+    }
+    return result;
+}
+
+uint16_t brokerServerGetPort(const brokerServer_t *server) {
+    return server->port;
+}
+
+eaipCommunicationErrorCodes brokerServerRun(brokerServer_t *server) {
+    struct epoll_event events[EAIP_BROKER_SERVER_EVENTS];
+    while (!atomic_load(&server->stopping)) {
+        int count = epoll_wait(server->epoll, events, EAIP_BROKER_SERVER_EVENTS, -1);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0) {
+            return EAIP_COM_GENERIC_ERROR;
+        }
+
+        for (int index = 0; index < count; index++) {
+            if (events[index].data.ptr == &server->listener) {
+                acceptConnections(server);
+                continue;
+            }
+            if (events[index].data.ptr == &server->wakeup) {
+                uint64_t value;
+                ssize_t drained = read(server->wakeup, &value, sizeof(value));
+                (void)drained;
+                continue;
+            }
+
+            connection_t *connection = events[index].data.ptr;
+            if (connection->closing) {
+                continue;
+            }
+            if (events[index].events & EPOLLOUT) {
+                flushLater(connection);
+            }
+            if (events[index].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                readConnection(connection);
+            }
+        }
+        completeIteration(server);
+    }
+    return EAIP_COM_NO_ERROR;
+}
+
+void brokerServerStop(brokerServer_t *server) {
+    atomic_store(&server->stopping, true);
+    uint64_t increment = 1;
+    ssize_t written = write(server->wakeup, &increment, sizeof(increment));
+    (void)written;
+}
+
+void brokerServerFree(brokerServer_t *server) {
+    while (server->connections != NULL) {
+        connection_t *connection = server->connections;
+        connection->flushPending = false;
+        releaseConnection(connection);
+    }
+    brokerFree(&server->broker);
+    close(server->listener);
+    close(server->epoll);
+    close(server->wakeup);
+}
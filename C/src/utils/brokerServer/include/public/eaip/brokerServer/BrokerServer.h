@@ -0,0 +1,111 @@
+#ifndef EAI_PROTOCOL_BROKERSERVER_HEADER
+#define EAI_PROTOCOL_BROKERSERVER_HEADER
+
+/*!
+ * Loopback MQTT broker for socket level tests and benchmarks (Linux only)
+ *
+ * The server accepts TCP connections on 127.0.0.1 and speaks the subset of MQTT 3.1.1 used by the
+ * elastic-AI protocol: CONNECT with clean sessions and last will, PUBLISH with QoS 0 and 1,
+ * SUBSCRIBE, UNSUBSCRIBE, PINGREQ and DISCONNECT. Every connection is a client of a broker mock
+ * (see "eaip/brokerMock/Broker.h"), which matches topics, keeps retained messages and publishes
+ * last wills. Messages are forwarded with QoS 0.
+ *
+ * A single thread serves all connections with epoll and non-blocking sockets. Messages for a
+ * connection are collected while the ready sockets are read and written with one `send` per
+ * connection afterward.
+ *
+ * ```c
+ * brokerServer_t server;
+ * brokerServerInit(&server, 1883, true);
+ * brokerServerRun(&server); // until brokerServerStop is called, e.g. by a signal handler
+ * brokerServerFree(&server);
+ * ```
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eaip/brokerMock/Broker.h"
+#include "eaip/endpoint/CommunicationEndpoint.h"
+
+/*!
+ * @brief largest packet accepted from a client, larger packets close the connection
+ */
+#ifndef EAIP_BROKER_SERVER_MAX_PACKET
+#define EAIP_BROKER_SERVER_MAX_PACKET (256 * 1024)
+#endif
+
+/*!
+ * @brief bytes queued for a client that does not read, exceeding it closes the connection
+ */
+#ifndef EAIP_BROKER_SERVER_MAX_BACKLOG
+#define EAIP_BROKER_SERVER_MAX_BACKLOG (16 * 1024 * 1024)
+#endif
+
+/*!
+ * @brief maximum number of socket events handled per call to `epoll_wait`
+ */
+#ifndef EAIP_BROKER_SERVER_EVENTS
+#define EAIP_BROKER_SERVER_EVENTS 64
+#endif
+
+/*!
+ * @brief struct holding the state of a server
+ *
+ * IMPORTANT: All fields are managed by the `brokerServer*` functions and must not be modified by
+ *            the user.
+ */
+typedef struct brokerServer {
+    broker_t broker;
+    int listener;
+    int epoll;
+    int wakeup;
+    uint16_t port;
+    bool noDelay;
+    atomic_bool stopping;
+    struct connection *connections;
+    struct connection *flushFirst;
+    struct connection *closeFirst;
+} brokerServer_t;
+
+/*!
+ * @brief initialize a server listening on 127.0.0.1
+ *
+ * @param server[brokerServer_t *] server to initialize
+ * @param port[uint16_t] TCP port, 0 picks a free port, see `brokerServerGetPort`
+ * @param noDelay[bool] whether Nagle's algorithm is disabled for all connections
+ *
+ * @return 0 if no error occurred,
+ *         EAIP_COM_BROKER_NOT_REACHABLE if the socket could not be opened
+ */
+eaipCommunicationErrorCodes brokerServerInit(brokerServer_t *server, uint16_t port, bool noDelay);
+
+/*!
+ * @brief the TCP port the server is listening on
+ */
+uint16_t brokerServerGetPort(const brokerServer_t *server);
+
+/*!
+ * @brief serve all connections until `brokerServerStop` is called
+ *
+ * @param server[brokerServer_t *] initialized server
+ *
+ * @return 0 if the server was stopped, EAIP_COM_GENERIC_ERROR if waiting for events failed
+ */
+eaipCommunicationErrorCodes brokerServerRun(brokerServer_t *server);
+
+/*!
+ * @brief make `brokerServerRun` return, may be called from other threads and signal handlers
+ */
+void brokerServerStop(brokerServer_t *server);
+
+/*!
+ * @brief close all connections without publishing last wills and release the server
+ *
+ * Must not be called while `brokerServerRun` is running.
+ */
+void brokerServerFree(brokerServer_t *server);
+
+#endif /* EAI_PROTOCOL_BROKERSERVER_HEADER */
@@ -0,0 +1,58 @@
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/brokerServer/BrokerServer.h"
+
+/*
+ * Loopback MQTT broker for load tests on a single machine
+ *
+ * usage: eaip_brokerServer [--port <port>] [--nagle]
+ */
+
+static brokerServer_t server;
+
+static void stopServer(__attribute__((unused)) int signal) {
+    brokerServerStop(&server);
+}
+
+static void printUsage(const char *name) {
+    fprintf(stderr, "usage: %s [--port <port>] [--nagle]\n", name);
+    fprintf(stderr, "  --port <port>  TCP port on 127.0.0.1, 0 picks a free port (default 1883)\n");
+    fprintf(stderr, "  --nagle        keep Nagle's algorithm enabled on client sockets\n");
+}
+
+int main(int argc, char **argv) {
+    long port = 1883;
+    bool noDelay = true;
+    for (int index = 1; index < argc; index++) {
+        if (0 == strcmp(argv[index], "--port") && index + 1 < argc) {
+            char *end;
+            port = strtol(argv[++index], &end, 10);
+            if (*end != '\0' || port < 0 || port > 65535) {
+                printUsage(argv[0]);
+                return 2;
+            }
+        } else if (0 == strcmp(argv[index], "--nagle")) {
+            noDelay = false;
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (EAIP_COM_NO_ERROR != brokerServerInit(&server, (uint16_t)port, noDelay)) {
+        fprintf(stderr, "cannot listen on 127.0.0.1:%ld\n", port);
+        return 1;
+    }
+    signal(SIGINT, &stopServer);
+    signal(SIGTERM, &stopServer);
+    printf("listening on 127.0.0.1:%u\n", brokerServerGetPort(&server));
+    fflush(stdout);
+
+    eaipCommunicationErrorCodes result = brokerServerRun(&server);
+    brokerServerFree(&server);
+    return result == EAIP_COM_NO_ERROR ? 0 : 1;
+}
@@ -1,21 +1,14 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 #include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "eaip/brokerMock/Broker.h"
 #include "unity.h"
 
-void cleanSubscriptions() {
-    subscriptions_t *current = subscriptions;
-    while (current != NULL) {
-        subscriptions = current->next;
-        free(current->subscription->topic);
-        free(current->subscription);
-        free(current);
-        current = subscriptions;
-    }
-}
-
 char expectedTopicPublish[] = "eaip://test-dev/topic";
 char expectedTopicSubscribe[] = "eaip://+/topic";
 void validateTopic(char *topic, __attribute__((unused)) char *data) {
@@ -38,26 +31,93 @@ void test_publishSuccessful() {
     TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, publish(expectedTopicPublish, NULL, false));
 }
 void test_publishTopicCorrect() {
-    subscription_t *newSub = calloc(1, sizeof(subscription_t));
-    newSub->topic = calloc(1, strlen(expectedTopicSubscribe) + 1);
-    strcpy(newSub->topic, expectedTopicSubscribe);
-    newSub->handle = &validateTopic;
-    subscriptions = calloc(1, sizeof(subscription_t));
-    subscriptions->subscription = newSub;
+    subscribe(expectedTopicSubscribe, &validateTopic);
 
     publish(expectedTopicPublish, NULL, false);
 }
 void test_publishDataCorrect() {
-    subscription_t *newSub = calloc(1, sizeof(subscription_t));
-    newSub->topic = calloc(1, strlen(expectedTopicSubscribe) + 1);
-    strcpy(newSub->topic, expectedTopicSubscribe);
-    newSub->handle = &validateData;
-    subscriptions = calloc(1, sizeof(subscription_t));
-    subscriptions->subscription = newSub;
+    subscribe(expectedTopicSubscribe, &validateData);
 
     publish(expectedTopicPublish, expectedData, false);
 }
 
+uint8_t expectedPayload[] = {0x01, 0x00, 0x02, 0x00};
+size_t receivedLength = 0;
+void validatePayload(__attribute__((unused)) char *topic, const uint8_t *payload, size_t length) {
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expectedPayload, payload, length);
+    receivedLength = length;
+}
+void test_publishBinaryKeepsEmbeddedZeros() {
+    receivedLength = 0;
+    subscribeBinary(expectedTopicSubscribe, &validatePayload);
+
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, publishBinary(expectedTopicPublish, expectedPayload,
+                                                            sizeof(expectedPayload), false));
+    TEST_ASSERT_EQUAL_size_t(sizeof(expectedPayload), receivedLength);
+}
+void test_publishBinaryToTextSubscriptionTerminatesPayload() {
+    subscribe(expectedTopicSubscribe, &validateData);
+
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR,
+                           publishBinary(expectedTopicPublish, (uint8_t *)expectedData,
+                                         strlen(expectedData), false));
+}
+void test_publishTextToBinarySubscriptionPassesLength() {
+    receivedLength = 0;
+    subscribeBinary(expectedTopicSubscribe, &validatePayload);
+    expectedPayload[0] = 'a';
+    expectedPayload[1] = 'b';
+
+    publish(expectedTopicPublish, "ab", false);
+    TEST_ASSERT_EQUAL_size_t(2, receivedLength);
+
+    expectedPayload[0] = 0x01;
+    expectedPayload[1] = 0x00;
+}
+
+int deliveries = 0;
+void countMatch(__attribute__((unused)) char *topic, __attribute__((unused)) char *data) {
+    deliveries++;
+}
+void test_publishMatchesWildcardsPerLevel() {
+    deliveries = 0;
+    subscribe("eaip://+/DATA/#", &countMatch);
+    subscribe("eaip://dev/+/value", &countMatch);
+    subscribe("eaip://dev/DATA/value", &countMatch);
+    subscribe("eaip://dev/DATA/val+", &countMatch);
+
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, publish("eaip://dev/DATA/value", "1", false));
+    TEST_ASSERT_EQUAL_INT(3, deliveries);
+
+    deliveries = 0;
+    publish("eaip://dev/DATA", "1", false);
+    publish("eaip://dev/DATA/value/raw", "1", false);
+    publish("eaip://other/STATUS/value", "1", false);
+    TEST_ASSERT_EQUAL_INT(1, deliveries);
+}
+void test_publishMatchesSingleLevelWildcardForEmptyLevel() {
+    deliveries = 0;
+    subscribe("eaip://dev/+", &countMatch);
+
+    publish("eaip://dev/", "1", false);
+    TEST_ASSERT_EQUAL_INT(1, deliveries);
+}
+void unsubscribeWhileDelivering(__attribute__((unused)) char *topic,
+                                __attribute__((unused)) char *data) {
+    deliveries++;
+    unsubscribe("eaip://dev/#");
+    unsubscribe("eaip://+/DATA");
+}
+void test_unsubscribeWhileDeliveringIsSafe() {
+    deliveries = 0;
+    subscribe("eaip://dev/#", &unsubscribeWhileDelivering);
+    subscribe("eaip://+/DATA", &unsubscribeWhileDelivering);
+
+    publish("eaip://dev/DATA", "1", false);
+    TEST_ASSERT_EQUAL_INT(2, deliveries);
+    TEST_ASSERT_NULL(subscriptions);
+}
+
 void test_subscribeWithTopicToLongFails() {
     char topic[] = "/test/test/test/test/test/test/test/test/test/test/test/test/test/test/test/"
                    "test/test/test/test/test/test/test/test/test/test/test";
@@ -110,10 +170,481 @@ void test_unsubscribeFromSubscribedMiddleTopicSuccessful() {
     TEST_ASSERT_NOT_NULL(subscriptions);
 }
 
+void test_findSubscriptionReturnsStableHandle() {
+    subscribe(expectedTopicSubscribe, &validateTopic);
+    const subscription_t *handle = findSubscription(expectedTopicSubscribe);
+    TEST_ASSERT_NOT_NULL(handle);
+
+    char topic[32];
+    for (int index = 0; index < 500; index++) {
+        sprintf(topic, "eaip://dev-%d/STATUS", index);
+        subscribe(topic, NULL);
+    }
+    TEST_ASSERT_EQUAL_PTR(handle, findSubscription(expectedTopicSubscribe));
+    TEST_ASSERT_EQUAL_PTR(&validateTopic, handle->handle);
+
+    unsubscribe(expectedTopicSubscribe);
+    TEST_ASSERT_NULL(findSubscription(expectedTopicSubscribe));
+}
+void test_unsubscribeManyTopicsInAnyOrderKeepsListConsistent() {
+    char topic[32];
+    for (int index = 0; index < 1000; index++) {
+        sprintf(topic, "eaip://dev-%d/STATUS", index);
+        TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, subscribe(topic, NULL));
+    }
+    for (int index = 0; index < 1000; index++) {
+        sprintf(topic, "eaip://dev-%d/STATUS", index);
+        TEST_ASSERT_EQUAL_UINT(EAIP_COM_TOPIC_ALREADY_SUBSCRIBED, subscribe(topic, NULL));
+    }
+    for (int index = 0; index < 1000; index += 2) {
+        sprintf(topic, "eaip://dev-%d/STATUS", (index * 7) % 1000);
+        unsubscribe(topic);
+    }
+
+    size_t count = 0;
+    subscriptions_t *previous = NULL;
+    for (subscriptions_t *current = subscriptions; current != NULL; current = current->next) {
+        TEST_ASSERT_EQUAL_PTR(previous, current->previous);
+        previous = current;
+        count++;
+    }
+    TEST_ASSERT_EQUAL_size_t(500, count);
+
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, subscribe("eaip://dev-0/STATUS", NULL));
+    TEST_ASSERT_EQUAL_STRING("eaip://dev-0/STATUS", previous->next->subscription->topic);
+}
+
+void test_resetSubscriptionsReleasesAllSubscriptionsAtOnce() {
+    char topic[32];
+    for (int index = 0; index < 1000; index++) {
+        sprintf(topic, "eaip://dev-%d/DO", index);
+        TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, subscribe(topic, &countMatch));
+    }
+
+    resetSubscriptions();
+    TEST_ASSERT_NULL(subscriptions);
+    TEST_ASSERT_NULL(findSubscription("eaip://dev-1/DO"));
+
+    deliveries = 0;
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, subscribe("eaip://dev-1/DO", &countMatch));
+    publish("eaip://dev-1/DO", "MEASURE", false);
+    publish("eaip://dev-2/DO", "MEASURE", false);
+    TEST_ASSERT_EQUAL_INT(1, deliveries);
+}
+
+void validateRetainedOffline(__attribute__((unused)) char *topic, char *data) {
+    TEST_ASSERT_EQUAL_STRING("OFFLINE", data);
+    deliveries++;
+}
+char retainedTopics[4][64];
+void recordRetained(char *topic, __attribute__((unused)) char *data) {
+    if (deliveries < 4) {
+        strcpy(retainedTopics[deliveries], topic);
+    }
+    deliveries++;
+}
+void test_subscribeReceivesMatchingRetainedMessages() {
+    publish("eaip://dev-1/STATUS", "ONLINE", true);
+    publish("eaip://dev-2/STATUS", "ONLINE", true);
+    publish("eaip://dev-2/DATA/value", "1", true);
+    publish("eaip://dev-3/STATUS", "OFFLINE", false);
+
+    deliveries = 0;
+    subscribe("eaip://+/STATUS", &recordRetained);
+    TEST_ASSERT_EQUAL_INT(2, deliveries);
+
+    deliveries = 0;
+    subscribe("eaip://dev-2/#", &recordRetained);
+    TEST_ASSERT_EQUAL_INT(2, deliveries);
+
+    deliveries = 0;
+    subscribe("eaip://dev-2/DATA/value", &recordRetained);
+    TEST_ASSERT_EQUAL_INT(1, deliveries);
+    TEST_ASSERT_EQUAL_STRING("eaip://dev-2/DATA/value", retainedTopics[0]);
+}
+void test_emptyRetainedMessageRemovesRetainedMessage() {
+    publish("eaip://dev-1/STATUS", "ONLINE", true);
+    publish("eaip://dev-1/STATUS", "OFFLINE", true);
+
+    deliveries = 0;
+    subscribe("eaip://dev-1/STATUS", &validateRetainedOffline);
+    TEST_ASSERT_EQUAL_INT(1, deliveries);
+
+    unsubscribe("eaip://dev-1/STATUS");
+    publish("eaip://dev-1/STATUS", "", true);
+    deliveries = 0;
+    subscribe("eaip://dev-1/STATUS", &validateRetainedOffline);
+    TEST_ASSERT_EQUAL_INT(0, deliveries);
+}
+void test_retainedMessagesAreBoundedByMemoryLimit() {
+    char topic[32];
+    setRetainedMemoryLimit(10 * (strlen("eaip://dev-00/STATUS") + strlen("ONLINE")));
+    for (int index = 0; index < 20; index++) {
+        sprintf(topic, "eaip://dev-%02d/STATUS", index);
+        publish(topic, "ONLINE", true);
+    }
+
+    deliveries = 0;
+    subscribe("eaip://+/STATUS", &recordRetained);
+    TEST_ASSERT_EQUAL_INT(10, deliveries);
+    TEST_ASSERT_EQUAL_STRING_LEN("eaip://dev-1", retainedTopics[0], 12);
+    setRetainedMemoryLimit(EAIP_BROKER_RETAINED_BYTES);
+}
+void clearRetained(__attribute__((unused)) char *topic, __attribute__((unused)) char *data) {
+    if (++deliveries == 1) {
+        publish("eaip://dev-1/STATUS", "", true);
+        publish("eaip://dev-2/STATUS", "", true);
+    }
+}
+void test_retainedMessagesMayBeChangedWhileDelivering() {
+    publish("eaip://dev-1/STATUS", "ONLINE", true);
+    publish("eaip://dev-2/STATUS", "ONLINE", true);
+
+    deliveries = 0;
+    subscribe("eaip://+/STATUS", &clearRetained);
+    TEST_ASSERT_EQUAL_INT(4, deliveries);
+}
+
+typedef struct received {
+    int count;
+    char topic[64];
+    char message[16];
+} received_t;
+void recordMessage(brokerClient_t *client, char *topic, const uint8_t *payload, size_t length) {
+    received_t *received = client->userData;
+    received->count++;
+    snprintf(received->topic, sizeof(received->topic), "%s", topic);
+    snprintf(received->message, sizeof(received->message), "%.*s", (int)length, (char *)payload);
+}
+void test_brokerDeliversMessagesBetweenClients() {
+    broker_t broker;
+    brokerClient_t *device, *monitor;
+    received_t toDevice = {0}, toMonitor = {0};
+    brokerInit(&broker);
+    brokerConnect(&broker, "device", &toDevice, &device);
+    brokerConnect(&broker, "monitor", &toMonitor, &monitor);
+    brokerSubscribe(device, "eaip://dev-1/DO", &recordMessage);
+    brokerSubscribe(monitor, "eaip://+/DONE", &recordMessage);
+
+    brokerPublish(monitor, "eaip://dev-1/DO", (const uint8_t *)"MEASURE", 7, false);
+    brokerPublish(device, "eaip://dev-1/DONE", (const uint8_t *)"MEASURE", 7, false);
+
+    TEST_ASSERT_EQUAL_INT(1, toDevice.count);
+    TEST_ASSERT_EQUAL_STRING("eaip://dev-1/DO", toDevice.topic);
+    TEST_ASSERT_EQUAL_INT(1, toMonitor.count);
+    TEST_ASSERT_EQUAL_STRING("eaip://dev-1/DONE", toMonitor.topic);
+    TEST_ASSERT_EQUAL_STRING("MEASURE", toMonitor.message);
+    brokerFree(&broker);
+}
+void test_brokerAllowsSameFilterForDifferentClients() {
+    broker_t broker;
+    brokerClient_t *first, *second;
+    received_t toFirst = {0}, toSecond = {0};
+    brokerInit(&broker);
+    brokerConnect(&broker, "first", &toFirst, &first);
+    brokerConnect(&broker, "second", &toSecond, &second);
+
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR,
+                           brokerSubscribe(first, "eaip://+/STATUS", &recordMessage));
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR,
+                           brokerSubscribe(second, "eaip://+/STATUS", &recordMessage));
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_TOPIC_ALREADY_SUBSCRIBED,
+                           brokerSubscribe(second, "eaip://+/STATUS", &recordMessage));
+    brokerPublish(first, "eaip://dev-1/STATUS", (const uint8_t *)"ONLINE", 6, false);
+    TEST_ASSERT_EQUAL_INT(1, toFirst.count);
+    TEST_ASSERT_EQUAL_INT(1, toSecond.count);
+
+    brokerUnsubscribe(first, "eaip://+/STATUS");
+    brokerPublish(first, "eaip://dev-1/STATUS", (const uint8_t *)"ONLINE", 6, false);
+    TEST_ASSERT_EQUAL_INT(1, toFirst.count);
+    TEST_ASSERT_EQUAL_INT(2, toSecond.count);
+    brokerFree(&broker);
+}
+void test_brokerPublishesWillOnlyOnUngracefulDisconnect() {
+    broker_t broker;
+    brokerClient_t *first, *second, *monitor;
+    received_t toMonitor = {0}, toLate = {0};
+    brokerInit(&broker);
+    brokerConnect(&broker, "dev-1", NULL, &first);
+    brokerConnect(&broker, "dev-2", NULL, &second);
+    brokerConnect(&broker, "monitor", &toMonitor, &monitor);
+    brokerSetWill(first, "eaip://dev-1/STATUS", "OFFLINE", true);
+    brokerSetWill(second, "eaip://dev-2/STATUS", "OFFLINE", true);
+    brokerSubscribe(monitor, "eaip://+/STATUS", &recordMessage);
+
+    brokerDisconnect(first, true);
+    TEST_ASSERT_EQUAL_INT(0, toMonitor.count);
+
+    brokerDisconnect(second, false);
+    TEST_ASSERT_EQUAL_INT(1, toMonitor.count);
+    TEST_ASSERT_EQUAL_STRING("eaip://dev-2/STATUS", toMonitor.topic);
+    TEST_ASSERT_EQUAL_STRING("OFFLINE", toMonitor.message);
+
+    brokerClient_t *late;
+    brokerConnect(&broker, "late", &toLate, &late);
+    brokerSubscribe(late, "eaip://+/STATUS", &recordMessage);
+    TEST_ASSERT_EQUAL_INT(1, toLate.count);
+    TEST_ASSERT_EQUAL_STRING("eaip://dev-2/STATUS", toLate.topic);
+    brokerFree(&broker);
+}
+void test_brokerDisconnectRemovesSubscriptionsOfClient() {
+    broker_t broker;
+    brokerClient_t *device, *monitor;
+    received_t toDevice = {0}, toMonitor = {0};
+    brokerInit(&broker);
+    brokerConnect(&broker, "device", &toDevice, &device);
+    brokerConnect(&broker, "monitor", &toMonitor, &monitor);
+    brokerSubscribe(device, "eaip://dev-1/DO", &recordMessage);
+    brokerSubscribe(device, "eaip://dev-1/#", &recordMessage);
+    brokerSubscribe(monitor, "eaip://dev-1/#", &recordMessage);
+
+    brokerDisconnect(device, false);
+    brokerPublish(monitor, "eaip://dev-1/DO", (const uint8_t *)"MEASURE", 7, false);
+
+    TEST_ASSERT_EQUAL_INT(0, toDevice.count);
+    TEST_ASSERT_EQUAL_INT(1, toMonitor.count);
+    TEST_ASSERT_EQUAL_size_t(1, broker.registryCount);
+    brokerFree(&broker);
+}
+void test_brokerSharesFilterBetweenClients() {
+    broker_t broker;
+    brokerClient_t *first, *second;
+    brokerInit(&broker);
+    brokerConnect(&broker, "first", NULL, &first);
+    brokerConnect(&broker, "second", NULL, &second);
+    brokerSubscribe(first, "eaip://+/STATUS", &recordMessage);
+    brokerSubscribe(second, "eaip://+/STATUS", &recordMessage);
+
+    TEST_ASSERT_EQUAL_PTR(first->subscriptions->subscription->topic,
+                          second->subscriptions->subscription->topic);
+    TEST_ASSERT_EQUAL_STRING("eaip://+/STATUS", second->subscriptions->subscription->topic);
+    brokerFree(&broker);
+}
+void test_brokerReusesFiltersOfRemovedSubscriptions() {
+    broker_t broker;
+    brokerClient_t *client;
+    brokerInit(&broker);
+    brokerConnect(&broker, "client", NULL, &client);
+    brokerSubscribe(client, "eaip://dev-1000/DO", &recordMessage);
+    char *first = client->subscriptions->subscription->topic;
+    brokerUnsubscribe(client, "eaip://dev-1000/DO");
+
+    char topic[32];
+    for (int index = 1001; index < 10000; index++) {
+        sprintf(topic, "eaip://dev-%d/DO", index);
+        brokerSubscribe(client, topic, &recordMessage);
+        TEST_ASSERT_EQUAL_PTR(first, client->subscriptions->subscription->topic);
+        TEST_ASSERT_EQUAL_STRING(topic, client->subscriptions->subscription->topic);
+        brokerUnsubscribe(client, topic);
+    }
+    brokerFree(&broker);
+}
+
+#define ORDERED_SUBSCRIBERS 8
+#define ORDERED_MESSAGES 500
+typedef struct sequence {
+    int next[2];
+    int count;
+    int violations;
+} sequence_t;
+void checkSequence(brokerClient_t *client, char *topic, const uint8_t *payload,
+                   __attribute__((unused)) size_t length) {
+    sequence_t *sequence = client->userData;
+    int stream = topic[strlen(topic) - 1] == 'b';
+    if (atoi((const char *)payload) != sequence->next[stream]) {
+        sequence->violations++;
+    }
+    sequence->next[stream]++;
+    sequence->count++;
+}
+void test_brokerWorkersPreserveOrderPerTopic() {
+    broker_t broker;
+    brokerClient_t *publisher, *subscribers[ORDERED_SUBSCRIBERS];
+    sequence_t sequences[ORDERED_SUBSCRIBERS] = {0};
+    char payload[16];
+    brokerInit(&broker);
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, brokerStartWorkers(&broker, 4));
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_GENERIC_ERROR, brokerStartWorkers(&broker, 4));
+    brokerConnect(&broker, "publisher", NULL, &publisher);
+    for (int index = 0; index < ORDERED_SUBSCRIBERS; index++) {
+        brokerConnect(&broker, "subscriber", &sequences[index], &subscribers[index]);
+        brokerSubscribe(subscribers[index], "eaip://dev-1/DATA/+", &checkSequence);
+    }
+
+    for (int index = 0; index < ORDERED_MESSAGES; index++) {
+        snprintf(payload, sizeof(payload), "%d", index);
+        brokerPublish(publisher, "eaip://dev-1/DATA/a", (const uint8_t *)payload, strlen(payload),
+                      false);
+        brokerPublish(publisher, "eaip://dev-1/DATA/b", (const uint8_t *)payload, strlen(payload),
+                      false);
+    }
+    for (int index = 0; index < ORDERED_SUBSCRIBERS; index++) {
+        brokerDisconnect(subscribers[index], true);
+        TEST_ASSERT_EQUAL_INT(2 * ORDERED_MESSAGES, sequences[index].count);
+        TEST_ASSERT_EQUAL_INT(0, sequences[index].violations);
+    }
+    brokerFree(&broker);
+}
+#define LATE_SUBSCRIBERS 64
+#define RETAINED_UPDATES 20000
+typedef struct latest {
+    int last;
+    int violations;
+} latest_t;
+void checkIncreasing(brokerClient_t *client, __attribute__((unused)) char *topic,
+                     const uint8_t *payload, __attribute__((unused)) size_t length,
+                     __attribute__((unused)) bool retained) {
+    latest_t *latest = client->userData;
+    int value = atoi((const char *)payload);
+    if (value <= latest->last) {
+        latest->violations++;
+    }
+    latest->last = value;
+}
+static void *publishUpdates(void *argument) {
+    brokerClient_t *publisher = argument;
+    char payload[16];
+    for (int index = 1; index <= RETAINED_UPDATES; index++) {
+        snprintf(payload, sizeof(payload), "%d", index);
+        brokerPublish(publisher, "eaip://dev-1/STATUS", (const uint8_t *)payload,
+                      strlen(payload), true);
+    }
+    return NULL;
+}
+void test_brokerWorkersDeliverRetainedBeforeLiveMessages() {
+    broker_t broker;
+    brokerClient_t *publisher, *subscribers[LATE_SUBSCRIBERS];
+    latest_t latest[LATE_SUBSCRIBERS] = {0};
+    pthread_t publishing;
+    brokerInit(&broker);
+    brokerStartWorkers(&broker, 4);
+    brokerConnect(&broker, "publisher", NULL, &publisher);
+
+    pthread_create(&publishing, NULL, &publishUpdates, publisher);
+    for (int index = 0; index < LATE_SUBSCRIBERS; index++) {
+        brokerConnect(&broker, "subscriber", &latest[index], &subscribers[index]);
+        brokerSubscribeRetainAware(subscribers[index], "eaip://+/STATUS", &checkIncreasing);
+        sched_yield();
+    }
+    pthread_join(publishing, NULL);
+
+    for (int index = 0; index < LATE_SUBSCRIBERS; index++) {
+        brokerDisconnect(subscribers[index], true);
+        TEST_ASSERT_EQUAL_INT(RETAINED_UPDATES, latest[index].last);
+        TEST_ASSERT_EQUAL_INT(0, latest[index].violations);
+    }
+    brokerFree(&broker);
+}
+void recordView(void *userData, const char *topic, size_t topicLength, const uint8_t *payload,
+                size_t length) {
+    received_t *received = userData;
+    TEST_ASSERT_EQUAL_UINT(strlen(topic), topicLength);
+    received->count++;
+    snprintf(received->topic, sizeof(received->topic), "%.*s", (int)topicLength, topic);
+    snprintf(received->message, sizeof(received->message), "%.*s", (int)length, (char *)payload);
+}
+void test_brokerViewHandlerGetsLengthsAndUserData() {
+    broker_t broker;
+    brokerClient_t *device, *monitor;
+    received_t direct = {0}, queued = {0};
+    brokerInit(&broker);
+    brokerConnect(&broker, "device", NULL, &device);
+    brokerConnect(&broker, "monitor", NULL, &monitor);
+    brokerPublish(device, "eaip://dev-1/STATUS", (const uint8_t *)"ONLINE", 6, true);
+
+    /* retained message, delivered on subscription */
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, brokerEndpointInterface.subscribeView(
+                                                 monitor, "eaip://+/STATUS", &recordView, &direct));
+    TEST_ASSERT_EQUAL_INT(1, direct.count);
+    TEST_ASSERT_EQUAL_STRING("eaip://dev-1/STATUS", direct.topic);
+    TEST_ASSERT_EQUAL_STRING("ONLINE", direct.message);
+
+    /* published message, delivered on the thread of the publisher */
+    brokerPublish(device, "eaip://dev-2/STATUS", (const uint8_t *)"OFFLINE", 7, false);
+    TEST_ASSERT_EQUAL_INT(2, direct.count);
+    TEST_ASSERT_EQUAL_STRING("eaip://dev-2/STATUS", direct.topic);
+    TEST_ASSERT_EQUAL_STRING("OFFLINE", direct.message);
+
+    /* queued message, delivered by a worker */
+    brokerStartWorkers(&broker, 2);
+    brokerEndpointInterface.subscribeView(monitor, "eaip://dev-1/DATA/+", &recordView, &queued);
+    brokerPublish(device, "eaip://dev-1/DATA/value", (const uint8_t *)"42", 2, false);
+    brokerFlush(&broker);
+    TEST_ASSERT_EQUAL_INT(1, queued.count);
+    TEST_ASSERT_EQUAL_STRING("eaip://dev-1/DATA/value", queued.topic);
+    TEST_ASSERT_EQUAL_STRING("42", queued.message);
+    brokerFree(&broker);
+}
+atomic_bool publisherDone = false;
+atomic_int slowDeliveries = 0;
+bool handlerSawPublisherDone = false;
+void waitForPublisher(__attribute__((unused)) brokerClient_t *client,
+                      __attribute__((unused)) char *topic,
+                      __attribute__((unused)) const uint8_t *payload,
+                      __attribute__((unused)) size_t length) {
+    if (atomic_fetch_add(&slowDeliveries, 1) == 0) {
+        for (int attempt = 0; attempt < 1000000 && !atomic_load(&publisherDone); attempt++) {
+            sched_yield();
+        }
+        handlerSawPublisherDone = atomic_load(&publisherDone);
+    }
+}
+void test_brokerWorkersDoNotBlockPublisher() {
+    broker_t broker;
+    brokerClient_t *publisher, *subscriber;
+    brokerInit(&broker);
+    brokerStartWorkers(&broker, 1);
+    brokerConnect(&broker, "publisher", NULL, &publisher);
+    brokerConnect(&broker, "subscriber", NULL, &subscriber);
+    brokerSubscribe(subscriber, "eaip://dev-1/DO", &waitForPublisher);
+
+    for (int index = 0; index < 10; index++) {
+        brokerPublish(publisher, "eaip://dev-1/DO", (const uint8_t *)"MEASURE", 7, false);
+    }
+    atomic_store(&publisherDone, true);
+    brokerFlush(&broker);
+
+    TEST_ASSERT_TRUE(handlerSawPublisherDone);
+    TEST_ASSERT_EQUAL_INT(10, atomic_load(&slowDeliveries));
+    brokerFree(&broker);
+}
+
+#define CONCURRENT_CLIENTS 4
+#define CONCURRENT_MESSAGES 2000
+atomic_int concurrentDeliveries = 0;
+void countDelivery(__attribute__((unused)) char *topic, __attribute__((unused)) char *data) {
+    atomic_fetch_add(&concurrentDeliveries, 1);
+}
+static void *runClient(void *argument) {
+    char topic[32];
+    sprintf(topic, "eaip://client-%d/topic", *(int *)argument);
+
+    subscribe(topic, &countDelivery);
+    for (int index = 0; index < CONCURRENT_MESSAGES; index++) {
+        publish(topic, "data", false);
+    }
+    unsubscribe(topic);
+    return NULL;
+}
+void test_concurrentClientsKeepSubscriptionsConsistent() {
+    pthread_t clients[CONCURRENT_CLIENTS];
+    int ids[CONCURRENT_CLIENTS];
+    for (int index = 0; index < CONCURRENT_CLIENTS; index++) {
+        ids[index] = index;
+        pthread_create(&clients[index], NULL, &runClient, &ids[index]);
+    }
+    for (int index = 0; index < CONCURRENT_CLIENTS; index++) {
+        pthread_join(clients[index], NULL);
+    }
+
+    TEST_ASSERT_EQUAL(CONCURRENT_CLIENTS * CONCURRENT_MESSAGES, atomic_load(&concurrentDeliveries));
+    TEST_ASSERT_NULL(subscriptions);
+}
+
 void setUp(void) {}
 
 void tearDown(void) {
-    cleanSubscriptions();
+    resetSubscriptions();
 }
 
 int main(void) {
@@ -124,6 +655,12 @@ int main(void) {
     RUN_TEST(test_publishSuccessful);
     RUN_TEST(test_publishTopicCorrect);
     RUN_TEST(test_publishDataCorrect);
+    RUN_TEST(test_publishBinaryKeepsEmbeddedZeros);
+    RUN_TEST(test_publishBinaryToTextSubscriptionTerminatesPayload);
+    RUN_TEST(test_publishTextToBinarySubscriptionPassesLength);
+    RUN_TEST(test_publishMatchesWildcardsPerLevel);
+    RUN_TEST(test_publishMatchesSingleLevelWildcardForEmptyLevel);
+    RUN_TEST(test_unsubscribeWhileDeliveringIsSafe);
 
     RUN_TEST(test_subscribeWithTopicToLongFails);
     RUN_TEST(test_subscribeFirstTopicSuccessful);
@@ -136,6 +673,26 @@ int main(void) {
     RUN_TEST(test_unsubscribeFromNonSubscribedTopic);
     RUN_TEST(test_unsubscribeFromSubscribedTopicSuccessful);
     RUN_TEST(test_unsubscribeFromSubscribedMiddleTopicSuccessful);
+    RUN_TEST(test_findSubscriptionReturnsStableHandle);
+    RUN_TEST(test_unsubscribeManyTopicsInAnyOrderKeepsListConsistent);
+    RUN_TEST(test_resetSubscriptionsReleasesAllSubscriptionsAtOnce);
+    RUN_TEST(test_subscribeReceivesMatchingRetainedMessages);
+    RUN_TEST(test_emptyRetainedMessageRemovesRetainedMessage);
+    RUN_TEST(test_retainedMessagesAreBoundedByMemoryLimit);
+    RUN_TEST(test_retainedMessagesMayBeChangedWhileDelivering);
+
+    RUN_TEST(test_brokerDeliversMessagesBetweenClients);
+    RUN_TEST(test_brokerAllowsSameFilterForDifferentClients);
+    RUN_TEST(test_brokerPublishesWillOnlyOnUngracefulDisconnect);
+    RUN_TEST(test_brokerDisconnectRemovesSubscriptionsOfClient);
+    RUN_TEST(test_brokerSharesFilterBetweenClients);
+    RUN_TEST(test_brokerReusesFiltersOfRemovedSubscriptions);
+    RUN_TEST(test_brokerWorkersPreserveOrderPerTopic);
+    RUN_TEST(test_brokerWorkersDoNotBlockPublisher);
+    RUN_TEST(test_brokerWorkersDeliverRetainedBeforeLiveMessages);
+    RUN_TEST(test_brokerViewHandlerGetsLengthsAndUserData);
+
+    RUN_TEST(test_concurrentClientsKeepSubscriptionsConsistent);
 
     return UNITY_END();
 }
@@ -0,0 +1,351 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "eaip/brokerServer/BrokerServer.h"
+#include "unity.h"
+
+brokerServer_t server;
+pthread_t serverThread;
+
+static void *runServer(__attribute__((unused)) void *argument) {
+    brokerServerRun(&server);
+    return NULL;
+}
+
+/* region RAW MQTT CLIENT */
+
+typedef struct packet {
+    uint8_t type;
+    uint8_t body[512];
+    size_t length;
+} packet_t;
+
+static void sendBytes(int socket, const uint8_t *data, size_t length) {
+    TEST_ASSERT_EQUAL_INT((int)length, (int)send(socket, data, length, MSG_NOSIGNAL));
+}
+
+static bool receiveBytes(int socket, uint8_t *data, size_t length) {
+    size_t received = 0;
+    while (received < length) {
+        ssize_t result = recv(socket, data + received, length - received, 0);
+        if (result <= 0) {
+            return false;
+        }
+        received += (size_t)result;
+    }
+    return true;
+}
+
+/*! @return false if the connection was closed or no packet arrived within a second */
+static bool receivePacket(int socket, packet_t *packet) {
+    uint8_t digit;
+    if (!receiveBytes(socket, &packet->type, 1)) {
+        return false;
+    }
+    packet->length = 0;
+    for (size_t shift = 0;; shift += 7) {
+        if (!receiveBytes(socket, &digit, 1)) {
+            return false;
+        }
+        packet->length |= (size_t)(digit & 0x7F) << shift;
+        if ((digit & 0x80) == 0) {
+            break;
+        }
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(packet->body), packet->length);
+    return receiveBytes(socket, packet->body, packet->length);
+}
+
+static size_t putString(uint8_t *target, const char *text) {
+    size_t length = strlen(text);
+    target[0] = (uint8_t)(length >> 8);
+    target[1] = (uint8_t)length;
+    memcpy(target + 2, text, length);
+    return 2 + length;
+}
+
+/*! @brief frame a packet whose remaining length is below 128 */
+static size_t frame(uint8_t *packet, uint8_t type, size_t bodyLength) {
+    packet[0] = type;
+    packet[1] = (uint8_t)bodyLength;
+    return 2 + bodyLength;
+}
+
+static int connectClient(const char *id, const char *willTopic, const char *willMessage) {
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address = {.sin_family = AF_INET,
+                                  .sin_port = htons(brokerServerGetPort(&server)),
+                                  .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    struct timeval timeout = {.tv_sec = 1};
+    int enabled = 1;
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+    TEST_ASSERT_EQUAL_INT(0, connect(client, (struct sockaddr *)&address, sizeof(address)));
+
+    uint8_t packet[128];
+    uint8_t *body = packet + 2;
+    size_t length = putString(body, "MQTT");
+    body[length++] = 4;                               /* protocol level */
+    body[length++] = willTopic != NULL ? 0x26 : 0x02; /* clean session, retained will */
+    body[length++] = 0;
+    body[length++] = 60; /* keep alive */
+    length += putString(body + length, id);
+    if (willTopic != NULL) {
+        length += putString(body + length, willTopic);
+        length += putString(body + length, willMessage);
+    }
+    sendBytes(client, packet, frame(packet, 0x10, length));
+
+    packet_t connack;
+    TEST_ASSERT_TRUE(receivePacket(client, &connack));
+    TEST_ASSERT_EQUAL_HEX8(0x20, connack.type);
+    TEST_ASSERT_EQUAL_size_t(2, connack.length);
+    TEST_ASSERT_EQUAL_HEX8(0x00, connack.body[1]);
+    return client;
+}
+
+static void subscribeClient(int client, const char *filter) {
+    uint8_t packet[160];
+    uint8_t *body = packet + 2;
+    body[0] = 0;
+    body[1] = 1; /* packet identifier */
+    size_t length = 2 + putString(body + 2, filter);
+    body[length++] = 0;
+    sendBytes(client, packet, frame(packet, 0x82, length));
+}
+
+static void expectSuback(int client) {
+    packet_t suback;
+    TEST_ASSERT_TRUE(receivePacket(client, &suback));
+    TEST_ASSERT_EQUAL_HEX8(0x90, suback.type);
+    TEST_ASSERT_EQUAL_size_t(3, suback.length);
+    TEST_ASSERT_EQUAL_HEX8(0x00, suback.body[2]);
+}
+
+static size_t buildPublish(uint8_t *packet, uint8_t flags, const char *topic,
+                           const char *message) {
+    uint8_t *body = packet + 2;
+    size_t length = putString(body, topic);
+    if (flags & 0x06) {
+        body[length++] = 0x12;
+        body[length++] = 0x34;
+    }
+    memcpy(body + length, message, strlen(message));
+    return frame(packet, 0x30 | flags, length + strlen(message));
+}
+
+static void publishMessage(int client, const char *topic, const char *message, bool retain) {
+    uint8_t packet[160];
+    sendBytes(client, packet, buildPublish(packet, retain ? 0x01 : 0x00, topic, message));
+}
+
+static void expectMessage(int client, const char *topic, const char *message, bool retained) {
+    packet_t publish;
+    TEST_ASSERT_TRUE(receivePacket(client, &publish));
+    TEST_ASSERT_EQUAL_HEX8(retained ? 0x31 : 0x30, publish.type);
+    size_t topicLength = (size_t)(publish.body[0] << 8 | publish.body[1]);
+    TEST_ASSERT_EQUAL_size_t(strlen(topic), topicLength);
+    TEST_ASSERT_EQUAL_MEMORY(topic, publish.body + 2, topicLength);
+    TEST_ASSERT_EQUAL_size_t(strlen(message), publish.length - 2 - topicLength);
+    TEST_ASSERT_EQUAL_MEMORY(message, publish.body + 2 + topicLength, strlen(message));
+}
+
+/*! @brief round trip a PINGREQ, all packets sent before by other clients were handled then */
+static void expectNothingPending(int client) {
+    const uint8_t ping[] = {0xC0, 0x00};
+    packet_t response;
+    sendBytes(client, ping, sizeof(ping));
+    TEST_ASSERT_TRUE(receivePacket(client, &response));
+    TEST_ASSERT_EQUAL_HEX8(0xD0, response.type);
+}
+
+/* endregion RAW MQTT CLIENT */
+
+void test_connectIsAcknowledged() {
+    int client = connectClient("device", NULL, NULL);
+    expectNothingPending(client);
+    close(client);
+}
+
+void test_publishIsForwardedToMatchingSubscribers() {
+    int device = connectClient("device", NULL, NULL);
+    int monitor = connectClient("monitor", NULL, NULL);
+    subscribeClient(monitor, "eaip://+/STATUS");
+    expectSuback(monitor);
+
+    publishMessage(device, "eaip://dev-1/DATA/value", "1", false);
+    publishMessage(device, "eaip://dev-1/STATUS", "ONLINE", false);
+
+    expectMessage(monitor, "eaip://dev-1/STATUS", "ONLINE", false);
+    expectNothingPending(monitor);
+    close(device);
+    close(monitor);
+}
+
+void test_packetsSplitAcrossReadsAreAssembled() {
+    int device = connectClient("device", NULL, NULL);
+    int monitor = connectClient("monitor", NULL, NULL);
+    subscribeClient(monitor, "eaip://dev-1/#");
+    expectSuback(monitor);
+
+    uint8_t packets[320];
+    size_t length = buildPublish(packets, 0x00, "eaip://dev-1/STATUS", "ONLINE");
+    for (size_t index = 0; index < length; index++) {
+        sendBytes(device, packets + index, 1);
+        usleep(1000);
+    }
+    expectMessage(monitor, "eaip://dev-1/STATUS", "ONLINE", false);
+
+    length = buildPublish(packets, 0x00, "eaip://dev-1/DO", "MEASURE");
+    length += buildPublish(packets + length, 0x00, "eaip://dev-1/DONE", "MEASURE");
+    sendBytes(device, packets, length);
+    expectMessage(monitor, "eaip://dev-1/DO", "MEASURE", false);
+    expectMessage(monitor, "eaip://dev-1/DONE", "MEASURE", false);
+    close(device);
+    close(monitor);
+}
+
+void test_qos1PublishIsAcknowledged() {
+    int device = connectClient("device", NULL, NULL);
+    uint8_t packet[160];
+    packet_t puback;
+
+    sendBytes(device, packet, buildPublish(packet, 0x02, "eaip://dev-1/STATUS", "ONLINE"));
+
+    TEST_ASSERT_TRUE(receivePacket(device, &puback));
+    TEST_ASSERT_EQUAL_HEX8(0x40, puback.type);
+    TEST_ASSERT_EQUAL_size_t(2, puback.length);
+    TEST_ASSERT_EQUAL_HEX8(0x12, puback.body[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x34, puback.body[1]);
+    close(device);
+}
+
+void test_willIsPublishedOnlyWhenConnectionIsLost() {
+    int monitor = connectClient("monitor", NULL, NULL);
+    subscribeClient(monitor, "eaip://+/STATUS");
+    expectSuback(monitor);
+    int graceful = connectClient("dev-1", "eaip://dev-1/STATUS", "OFFLINE");
+    int lost = connectClient("dev-2", "eaip://dev-2/STATUS", "OFFLINE");
+
+    const uint8_t disconnect[] = {0xE0, 0x00};
+    sendBytes(graceful, disconnect, sizeof(disconnect));
+    close(graceful);
+    close(lost);
+
+    expectMessage(monitor, "eaip://dev-2/STATUS", "OFFLINE", false);
+    expectNothingPending(monitor);
+    close(monitor);
+}
+
+void test_willIsPublishedOnProtocolViolation() {
+    int monitor = connectClient("monitor", NULL, NULL);
+    subscribeClient(monitor, "eaip://+/STATUS");
+    expectSuback(monitor);
+    int device = connectClient("dev-1", "eaip://dev-1/STATUS", "OFFLINE");
+    uint8_t received;
+
+    publishMessage(device, "eaip://+/STATUS", "ONLINE", false);
+
+    TEST_ASSERT_EQUAL_INT(0, (int)recv(device, &received, 1, 0));
+    expectMessage(monitor, "eaip://dev-1/STATUS", "OFFLINE", false);
+    close(device);
+    close(monitor);
+}
+
+void test_retainedMessageIsDeliveredOnSubscribe() {
+    int device = connectClient("device", NULL, NULL);
+    publishMessage(device, "eaip://dev-1/STATUS", "ONLINE", true);
+    expectNothingPending(device);
+
+    int monitor = connectClient("monitor", NULL, NULL);
+    subscribeClient(monitor, "eaip://+/STATUS");
+    expectMessage(monitor, "eaip://dev-1/STATUS", "ONLINE", true);
+    expectSuback(monitor);
+
+    publishMessage(device, "eaip://dev-1/STATUS", "OFFLINE", true);
+    expectMessage(monitor, "eaip://dev-1/STATUS", "OFFLINE", false);
+    close(device);
+    close(monitor);
+}
+
+void test_malformedPacketClosesConnection() {
+    int client = connectClient("device", NULL, NULL);
+    const uint8_t malformed[] = {0x30, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F};
+    uint8_t received;
+
+    sendBytes(client, malformed, sizeof(malformed));
+
+    TEST_ASSERT_EQUAL_INT(0, (int)recv(client, &received, 1, 0));
+    close(client);
+}
+
+void test_reusedClientIdClosesPreviousConnection() {
+    int monitor = connectClient("monitor", NULL, NULL);
+    subscribeClient(monitor, "eaip://+/STATUS");
+    expectSuback(monitor);
+    int previous = connectClient("dev-1", "eaip://dev-1/STATUS", "OFFLINE");
+    uint8_t received;
+
+    int current = connectClient("dev-1", NULL, NULL);
+
+    TEST_ASSERT_EQUAL_INT(0, (int)recv(previous, &received, 1, 0));
+    expectMessage(monitor, "eaip://dev-1/STATUS", "OFFLINE", false);
+    publishMessage(current, "eaip://dev-1/STATUS", "ONLINE", false);
+    expectMessage(monitor, "eaip://dev-1/STATUS", "ONLINE", false);
+    expectNothingPending(current);
+    close(previous);
+    close(current);
+    close(monitor);
+}
+
+void test_subscribeWithReservedFlagsClosesConnection() {
+    int client = connectClient("device", NULL, NULL);
+    uint8_t packet[160];
+    uint8_t *body = packet + 2;
+    uint8_t received;
+    body[0] = 0;
+    body[1] = 1;
+    size_t length = 2 + putString(body + 2, "eaip://+/STATUS");
+    body[length++] = 0;
+
+    sendBytes(client, packet, frame(packet, 0x80, length));
+
+    TEST_ASSERT_EQUAL_INT(0, (int)recv(client, &received, 1, 0));
+    close(client);
+}
+
+void setUp(void) {
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, brokerServerInit(&server, 0, true));
+    pthread_create(&serverThread, NULL, &runServer, NULL);
+}
+
+void tearDown(void) {
+    brokerServerStop(&server);
+    pthread_join(serverThread, NULL);
+    brokerServerFree(&server);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_connectIsAcknowledged);
+    RUN_TEST(test_publishIsForwardedToMatchingSubscribers);
+    RUN_TEST(test_packetsSplitAcrossReadsAreAssembled);
+    RUN_TEST(test_qos1PublishIsAcknowledged);
+    RUN_TEST(test_willIsPublishedOnlyWhenConnectionIsLost);
+    RUN_TEST(test_willIsPublishedOnProtocolViolation);
+    RUN_TEST(test_retainedMessageIsDeliveredOnSubscribe);
+    RUN_TEST(test_malformedPacketClosesConnection);
+    RUN_TEST(test_reusedClientIdClosesPreviousConnection);
+    RUN_TEST(test_subscribeWithReservedFlagsClosesConnection);
+
+    return UNITY_END();
+}
@@ -0,0 +1,241 @@
+#include <string.h>
+
+#include "eaip/brokerMock/Broker.h"
+#include "eaip/protocol/Commander.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Session.h"
+#include "unity.h"
+
+#define BASE_URL "eaip://local-net"
+#define DEVICE_ID "test-dev"
+#define WORKER_ID "worker"
+#define RESOLUTION 10
+#define REVOLUTION (EAIP_TIMER_WHEEL_SLOTS * RESOLUTION)
+
+/* region TEST RUNTIME */
+eaiProtocol_t config = {
+    .subscribe = &subscribe,
+    .unsubscribe = &unsubscribe,
+    .publish = &publish,
+    .baseUrl = BASE_URL,
+    .deviceId = DEVICE_ID,
+};
+eaiProtocol_t worker = {
+    .subscribe = &subscribe,
+    .unsubscribe = &unsubscribe,
+    .publish = &publish,
+    .baseUrl = BASE_URL,
+    .deviceId = WORKER_ID,
+};
+eaipSession_t session;
+eaipCommander_t commander;
+
+void completeCommand(char *topic, char *message) {
+    eaipCommanderDispatch(&commander, topic, message);
+}
+
+int received = 0;
+void receiveCommand(__attribute__((unused)) char *topic, __attribute__((unused)) char *data) {
+    received++;
+}
+void executeCommand(__attribute__((unused)) char *topic, char *data) {
+    eaipPubRequest_t reply = {.dataId = "echo", .data = data};
+    eaipPublishDone(worker, reply);
+}
+
+static void reply(char *command, char *data) {
+    eaipPubRequest_t request = {.dataId = command, .data = data};
+    eaipPublishDone(worker, request);
+}
+
+typedef struct completion {
+    int calls;
+    eaipCommandResult_t result;
+    char message[32];
+} completion_t;
+void recordCompletion(eaipCommandResult_t result, char *message, void *userData) {
+    completion_t *completion = userData;
+    completion->calls++;
+    completion->result = result;
+    strcpy(completion->message, message == NULL ? "" : message);
+}
+completion_t completions[5];
+
+static eaipCommunicationErrorCodes request(char *command, char *data, uint32_t timeout,
+                                           completion_t *completion, uint32_t *token) {
+    eaipPubRequest_t request = {.deviceId = WORKER_ID, .dataId = command, .data = data};
+    return eaipCommanderRequest(&commander, request, timeout, &recordCompletion, completion,
+                                token);
+}
+/* endregion TEST RUNTIME */
+
+void test_requestsArePipelined() {
+    request("measure", "a", 100, &completions[0], NULL);
+    request("measure", "b", 100, &completions[1], NULL);
+    request("measure", "c", 100, &completions[2], NULL);
+    TEST_ASSERT_EQUAL(3, received);
+    TEST_ASSERT_EQUAL(3, commander.count);
+
+    reply("measure", "1");
+    reply("measure", "2");
+    TEST_ASSERT_EQUAL(1, completions[0].calls);
+    TEST_ASSERT_EQUAL(EAIP_COMMAND_DONE, completions[0].result);
+    TEST_ASSERT_EQUAL_STRING("1", completions[0].message);
+    TEST_ASSERT_EQUAL_STRING("2", completions[1].message);
+    TEST_ASSERT_EQUAL(0, completions[2].calls);
+    TEST_ASSERT_EQUAL(1, commander.count);
+}
+
+void test_repliesAreMatchedByCommand() {
+    request("measure", "", 100, &completions[0], NULL);
+    request("reset", "", 100, &completions[1], NULL);
+
+    reply("reset", "ok");
+    TEST_ASSERT_EQUAL(0, completions[0].calls);
+    TEST_ASSERT_EQUAL_STRING("ok", completions[1].message);
+}
+
+void test_replyWithoutRequestIgnored() {
+    request("measure", "", 100, &completions[0], NULL);
+
+    TEST_ASSERT_FALSE(eaipCommanderDispatch(&commander, BASE_URL "/other/DONE/measure", "x"));
+    TEST_ASSERT_FALSE(eaipCommanderDispatch(&commander, BASE_URL "/" WORKER_ID "/DATA/measure",
+                                            "x"));
+    TEST_ASSERT_EQUAL(0, completions[0].calls);
+}
+
+void test_synchronousReplyCompletes() {
+    subscribe(BASE_URL "/" WORKER_ID "/DO/echo", &executeCommand);
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, request("echo", "hello", 100, &completions[0], NULL));
+    TEST_ASSERT_EQUAL(1, completions[0].calls);
+    TEST_ASSERT_EQUAL_STRING("hello", completions[0].message);
+    TEST_ASSERT_EQUAL(0, commander.count);
+}
+
+void test_requestsExpire() {
+    request("measure", "", 50, &completions[0], NULL);
+    request("measure", "", 500, &completions[1], NULL);
+
+    eaipCommanderTick(&commander, 1049);
+    TEST_ASSERT_EQUAL(0, completions[0].calls);
+    eaipCommanderTick(&commander, 1050);
+    TEST_ASSERT_EQUAL(1, completions[0].calls);
+    TEST_ASSERT_EQUAL(EAIP_COMMAND_TIMEOUT, completions[0].result);
+    TEST_ASSERT_EQUAL(0, completions[1].calls);
+
+    reply("measure", "1");
+    TEST_ASSERT_EQUAL(EAIP_COMMAND_DONE, completions[1].result);
+    TEST_ASSERT_EQUAL(1, completions[0].calls);
+}
+
+void test_requestsBeyondWheelRevolutionExpire() {
+    request("measure", "", 3 * REVOLUTION + 5, &completions[0], NULL);
+
+    for (uint32_t now = 1000; now < 1000 + 3 * REVOLUTION + 5; now += 3) {
+        eaipCommanderTick(&commander, now);
+    }
+    TEST_ASSERT_EQUAL(0, completions[0].calls);
+
+    eaipCommanderTick(&commander, 1000 + 3 * REVOLUTION + 5);
+    TEST_ASSERT_EQUAL(1, completions[0].calls);
+}
+
+void test_requestsExpireAcrossTimeWrapAround() {
+    eaipCommanderFree(&commander);
+    eaipCommanderInit(&commander, &session, 4, 1, UINT32_MAX - 10);
+
+    request("measure", "", 20, &completions[0], NULL);
+    eaipCommanderTick(&commander, 5);
+    TEST_ASSERT_EQUAL(0, completions[0].calls);
+    eaipCommanderTick(&commander, 9);
+    TEST_ASSERT_EQUAL(1, completions[0].calls);
+}
+
+void test_cancelCompletesRequest() {
+    uint32_t token;
+    request("measure", "", 100, &completions[0], &token);
+    request("measure", "", 100, &completions[1], NULL);
+
+    TEST_ASSERT_TRUE(eaipCommanderCancel(&commander, token));
+    TEST_ASSERT_FALSE(eaipCommanderCancel(&commander, token));
+    TEST_ASSERT_EQUAL(EAIP_COMMAND_CANCELLED, completions[0].result);
+
+    reply("measure", "1");
+    TEST_ASSERT_EQUAL(1, completions[0].calls);
+    TEST_ASSERT_EQUAL_STRING("1", completions[1].message);
+}
+
+void test_cancelKeepsOrderOfRemainingRequests() {
+    uint32_t middle, newest;
+    request("measure", "", 100, &completions[0], NULL);
+    request("reset", "", 100, &completions[1], NULL);
+    request("measure", "", 100, &completions[2], &middle);
+    request("measure", "", 100, &completions[3], &newest);
+
+    TEST_ASSERT_TRUE(eaipCommanderCancel(&commander, newest));
+    TEST_ASSERT_TRUE(eaipCommanderCancel(&commander, middle));
+    request("measure", "", 100, &completions[4], NULL);
+
+    reply("measure", "1");
+    reply("measure", "2");
+    TEST_ASSERT_EQUAL_STRING("1", completions[0].message);
+    TEST_ASSERT_EQUAL_STRING("2", completions[4].message);
+    TEST_ASSERT_EQUAL(0, completions[1].calls);
+    TEST_ASSERT_FALSE(eaipCommanderCancel(&commander, middle));
+    TEST_ASSERT_FALSE(eaipCommanderCancel(&commander, 0));
+}
+
+void test_requestsBeyondCapacityFail() {
+    for (int index = 0; index < 4; index++) {
+        TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                          request("measure", "", 100, &completions[index], NULL));
+    }
+    TEST_ASSERT_EQUAL(EAIP_COM_OUT_OF_MEMORY, request("measure", "", 100, &completions[4], NULL));
+    TEST_ASSERT_EQUAL(4, received);
+
+    reply("measure", "1");
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, request("measure", "", 100, &completions[4], NULL));
+}
+
+void test_freeCancelsPendingRequests() {
+    request("measure", "", 100, &completions[0], NULL);
+
+    eaipCommanderFree(&commander);
+    TEST_ASSERT_EQUAL(EAIP_COMMAND_CANCELLED, completions[0].result);
+    eaipCommanderInit(&commander, &session, 4, 1, 0);
+}
+
+void setUp() {
+    received = 0;
+    memset(completions, 0, sizeof(completions));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionInit(&session, config));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                      eaipCommanderInit(&commander, &session, 4, RESOLUTION, 1000));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipCommanderSubscribe(&commander, &completeCommand));
+    subscribe(BASE_URL "/" WORKER_ID "/DO/measure", &receiveCommand);
+}
+
+void tearDown() {
+    eaipCommanderFree(&commander);
+    eaipSessionFree(&session);
+    resetSubscriptions();
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_requestsArePipelined);
+    RUN_TEST(test_repliesAreMatchedByCommand);
+    RUN_TEST(test_replyWithoutRequestIgnored);
+    RUN_TEST(test_synchronousReplyCompletes);
+    RUN_TEST(test_requestsExpire);
+    RUN_TEST(test_requestsBeyondWheelRevolutionExpire);
+    RUN_TEST(test_requestsExpireAcrossTimeWrapAround);
+    RUN_TEST(test_cancelCompletesRequest);
+    RUN_TEST(test_cancelKeepsOrderOfRemainingRequests);
+    RUN_TEST(test_requestsBeyondCapacityFail);
+    RUN_TEST(test_freeCancelsPendingRequests);
+
+    return UNITY_END();
+}
@@ -0,0 +1,400 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "eaip/brokerServer/BrokerServer.h"
+#include "eaip/endpoint/MqttEndpoint.h"
+#include "eaip/protocol/Protocol.h"
+#include "unity.h"
+
+#define MAX_RECEIVED 256
+
+brokerServer_t server;
+pthread_t serverThread;
+mqttEndpoint_t device;
+mqttEndpoint_t monitor;
+
+static void *runServer(__attribute__((unused)) void *argument) {
+    brokerServerRun(&server);
+    return NULL;
+}
+
+/* region HANDLERS */
+
+typedef struct received {
+    char topic[EAIP_MQTT_MAX_TOPIC_LENGTH + 1];
+    uint8_t *payload;
+    size_t length;
+} received_t;
+
+received_t received[MAX_RECEIVED];
+size_t receivedCount;
+bool synchronized;
+
+static void recordMessage(const char *topic, const uint8_t *payload, size_t length) {
+    TEST_ASSERT_LESS_THAN(MAX_RECEIVED, receivedCount);
+    received_t *message = &received[receivedCount++];
+    strcpy(message->topic, topic);
+    message->payload = malloc(length + 1);
+    memcpy(message->payload, payload, length);
+    message->length = length;
+}
+
+static void handleText(char *topic, char *message) {
+    recordMessage(topic, (const uint8_t *)message, strlen(message));
+}
+
+static void handleBinary(char *topic, const uint8_t *payload, size_t length) {
+    recordMessage(topic, payload, length);
+}
+
+static void handleView(void *userData, const char *topic, size_t topicLength,
+                       const uint8_t *payload, size_t length) {
+    TEST_ASSERT_EQUAL_PTR(&monitor, userData);
+    TEST_ASSERT_EQUAL_size_t(strlen(topic), topicLength);
+    recordMessage(topic, payload, length);
+}
+
+char viewedDataIds[MAX_RECEIVED][EAIP_MQTT_MAX_TOPIC_LENGTH + 1];
+
+static void handleMessageView(const eaipMessageView_t *message,
+                              __attribute__((unused)) void *userData) {
+    TEST_ASSERT_TRUE(message->dataId.data >= message->topic.data &&
+                     message->dataId.data + message->dataId.length <=
+                         message->topic.data + message->topic.length);
+    snprintf(viewedDataIds[receivedCount], sizeof(viewedDataIds[receivedCount]), "%.*s",
+             (int)message->dataId.length, message->dataId.data);
+    recordMessage(message->topic.data, message->payload, message->length);
+}
+
+static void handleSync(__attribute__((unused)) char *topic,
+                       __attribute__((unused)) char *message) {
+    synchronized = true;
+}
+
+/* endregion HANDLERS */
+
+static void connectEndpoint(mqttEndpoint_t *endpoint, const char *id) {
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR,
+                           mqttEndpointConnect(endpoint, "127.0.0.1",
+                                               brokerServerGetPort(&server), id));
+}
+
+/*! @brief poll both endpoints until `count` messages were received or a second passed */
+static void pollUntilReceived(size_t count) {
+    for (size_t round = 0; round < 100 && receivedCount < count; round++) {
+        TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, mqttEndpointPoll(&device, 0));
+        TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, mqttEndpointPoll(&monitor, 10));
+    }
+    TEST_ASSERT_EQUAL_size_t(count, receivedCount);
+}
+
+/*!
+ * @brief wait until the broker handled all packets the endpoint sent before
+ *
+ * Packets of a connection are handled in order, so receiving an own message proves it.
+ */
+static void synchronize(mqttEndpoint_t *endpoint) {
+    synchronized = false;
+    mqttEndpointSubscribe(endpoint, "eaip://test/sync", &handleSync);
+    mqttEndpointPublish(endpoint, "eaip://test/sync", (const uint8_t *)"", 0, false);
+    for (size_t round = 0; round < 100 && !synchronized; round++) {
+        TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, mqttEndpointPoll(endpoint, 10));
+    }
+    TEST_ASSERT_TRUE(synchronized);
+    mqttEndpointUnsubscribe(endpoint, "eaip://test/sync");
+}
+
+static void expectMessage(size_t index, const char *topic, const uint8_t *payload,
+                          size_t length) {
+    TEST_ASSERT_EQUAL_STRING(topic, received[index].topic);
+    TEST_ASSERT_EQUAL_size_t(length, received[index].length);
+    if (length > 0) {
+        TEST_ASSERT_EQUAL_MEMORY(payload, received[index].payload, length);
+    }
+}
+
+void test_connectToUnreachableBrokerFails() {
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_BROKER_NOT_REACHABLE,
+                           mqttEndpointConnect(&device, "127.0.0.1", 1, "device"));
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_BROKER_NOT_REACHABLE,
+                           mqttEndpointPublish(&device, "eaip://dev-1/STATUS",
+                                               (const uint8_t *)"ONLINE", 6, false));
+}
+
+void test_invalidTopicsAreRejected() {
+    char tooLong[EAIP_MQTT_MAX_TOPIC_LENGTH + 2];
+    memset(tooLong, 'a', sizeof(tooLong) - 1);
+    tooLong[sizeof(tooLong) - 1] = '\0';
+
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_INVALID_TOPIC,
+                           mqttEndpointPublish(&device, "eaip://+/STATUS", NULL, 0, false));
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_INVALID_TOPIC,
+                           mqttEndpointSubscribe(&device, "eaip://dev-1#", &handleText));
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_INVALID_TOPIC,
+                           mqttEndpointSubscribe(&device, "eaip://dev-1/#/DATA", &handleText));
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_TOPIC_TO_LONG,
+                           mqttEndpointSubscribe(&device, tooLong, &handleText));
+}
+
+void test_messageIsDeliveredToMatchingSubscription() {
+    connectEndpoint(&device, "device");
+    connectEndpoint(&monitor, "monitor");
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR,
+                           mqttEndpointSubscribe(&monitor, "eaip://+/STATUS", &handleText));
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_TOPIC_ALREADY_SUBSCRIBED,
+                           mqttEndpointSubscribe(&monitor, "eaip://+/STATUS", &handleText));
+    synchronize(&monitor);
+
+    mqttEndpointPublish(&device, "eaip://dev-1/DATA/value", (const uint8_t *)"1", 1, false);
+    mqttEndpointPublish(&device, "eaip://dev-1/STATUS", (const uint8_t *)"ONLINE", 6, false);
+
+    pollUntilReceived(1);
+    expectMessage(0, "eaip://dev-1/STATUS", (const uint8_t *)"ONLINE", 6);
+}
+
+void test_binaryPayloadKeepsZeroBytes() {
+    const uint8_t payload[] = {0x01, 0x00, 0x02, 0x00};
+    connectEndpoint(&device, "device");
+    connectEndpoint(&monitor, "monitor");
+    mqttEndpointSubscribeBinary(&monitor, "eaip://dev-1/DATA/#", &handleBinary);
+    synchronize(&monitor);
+
+    mqttEndpointPublish(&device, "eaip://dev-1/DATA/raw", payload, sizeof(payload), false);
+    mqttEndpointPublish(&device, "eaip://dev-1/DATA/empty", NULL, 0, false);
+
+    pollUntilReceived(2);
+    expectMessage(0, "eaip://dev-1/DATA/raw", payload, sizeof(payload));
+    expectMessage(1, "eaip://dev-1/DATA/empty", NULL, 0);
+}
+
+void test_viewHandlerGetsTopicLengthAndUserData() {
+    connectEndpoint(&device, "device");
+    connectEndpoint(&monitor, "monitor");
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, mqttEndpointSubscribeView(&monitor, "eaip://+/DO/+",
+                                                                        &handleView, &monitor));
+    synchronize(&monitor);
+
+    mqttEndpointPublish(&device, "eaip://dev-1/DO/MEASURE", (const uint8_t *)"fast", 4, false);
+
+    pollUntilReceived(1);
+    expectMessage(0, "eaip://dev-1/DO/MEASURE", (const uint8_t *)"fast", 4);
+}
+
+void test_messageViewOfMultiLevelWildcardIncludesParentTopic() {
+    eaiProtocol_t config = {
+        .baseUrl = "eaip://test",
+        .deviceId = "monitor",
+        .endpoint = {&mqttEndpointInterface, &monitor},
+    };
+    eaipViewSubscription_t subscription;
+    eaipSubRequest_t request = {
+        .targetId = "dev-1", .dataId = "#", .viewHandler = &handleMessageView};
+    connectEndpoint(&device, "device");
+    connectEndpoint(&monitor, "monitor");
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR,
+                           eaipSubscribeView(config, DATA, request, &subscription));
+    /* the broker mock does not match the parent of `/#`, a broker following MQTT 3.1.1 does */
+    mqttEndpointSubscribe(&monitor, "eaip://test/dev-1/+", &handleSync);
+    synchronize(&monitor);
+
+    mqttEndpointPublish(&device, "eaip://test/dev-1/DATA", (const uint8_t *)"1", 1, false);
+    mqttEndpointPublish(&device, "eaip://test/dev-1/DATA/a/b", (const uint8_t *)"2", 1, false);
+
+    pollUntilReceived(2);
+    expectMessage(0, "eaip://test/dev-1/DATA", (const uint8_t *)"1", 1);
+    TEST_ASSERT_EQUAL_STRING("", viewedDataIds[0]);
+    expectMessage(1, "eaip://test/dev-1/DATA/a/b", (const uint8_t *)"2", 1);
+    TEST_ASSERT_EQUAL_STRING("a/b", viewedDataIds[1]);
+}
+
+void test_queuedMessagesAreDeliveredInOrder() {
+    connectEndpoint(&device, "device");
+    connectEndpoint(&monitor, "monitor");
+    mqttEndpointSubscribe(&monitor, "eaip://dev-1/DATA/value", &handleText);
+    synchronize(&monitor);
+
+    char message[16];
+    for (size_t index = 0; index < MAX_RECEIVED; index++) {
+        snprintf(message, sizeof(message), "%zu", index);
+        TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR,
+                               mqttEndpointPublish(&device, "eaip://dev-1/DATA/value",
+                                                   (const uint8_t *)message, strlen(message),
+                                                   false));
+    }
+
+    pollUntilReceived(MAX_RECEIVED);
+    for (size_t index = 0; index < MAX_RECEIVED; index++) {
+        snprintf(message, sizeof(message), "%zu", index);
+        expectMessage(index, "eaip://dev-1/DATA/value", (const uint8_t *)message,
+                      strlen(message));
+    }
+}
+
+void test_messageLargerThanSendRingIsDelivered() {
+    size_t length = 3 * EAIP_MQTT_SEND_BYTES;
+    uint8_t *payload = malloc(length);
+    for (size_t index = 0; index < length; index++) {
+        payload[index] = (uint8_t)(index * 31);
+    }
+    connectEndpoint(&device, "device");
+    connectEndpoint(&monitor, "monitor");
+    mqttEndpointSubscribeBinary(&monitor, "eaip://dev-1/DATA/model", &handleBinary);
+    synchronize(&monitor);
+
+    mqttEndpointPublish(&device, "eaip://dev-1/DATA/model", (const uint8_t *)"a", 1, false);
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR,
+                           mqttEndpointPublish(&device, "eaip://dev-1/DATA/model", payload,
+                                               length, false));
+    memset(payload, 0, length); /* the payload must not be referenced after publishing */
+    mqttEndpointPublish(&device, "eaip://dev-1/DATA/model", (const uint8_t *)"b", 1, false);
+
+    pollUntilReceived(3);
+    expectMessage(0, "eaip://dev-1/DATA/model", (const uint8_t *)"a", 1);
+    TEST_ASSERT_EQUAL_size_t(length, received[1].length);
+    for (size_t index = 0; index < length; index++) {
+        TEST_ASSERT_EQUAL_HEX8((uint8_t)(index * 31), received[1].payload[index]);
+    }
+    expectMessage(2, "eaip://dev-1/DATA/model", (const uint8_t *)"b", 1);
+    free(payload);
+}
+
+void test_unsubscribedFilterIsNotCalled() {
+    connectEndpoint(&device, "device");
+    connectEndpoint(&monitor, "monitor");
+    mqttEndpointSubscribe(&monitor, "eaip://dev-1/STATUS", &handleText);
+    mqttEndpointSubscribe(&monitor, "eaip://dev-1/DATA/+", &handleText);
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR,
+                           mqttEndpointUnsubscribe(&monitor, "eaip://dev-1/STATUS"));
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_INVALID_TOPIC,
+                           mqttEndpointUnsubscribe(&monitor, "eaip://dev-1/STATUS"));
+    synchronize(&monitor);
+
+    mqttEndpointPublish(&device, "eaip://dev-1/STATUS", (const uint8_t *)"ONLINE", 6, false);
+    mqttEndpointPublish(&device, "eaip://dev-1/DATA/value", (const uint8_t *)"1", 1, false);
+
+    pollUntilReceived(1);
+    expectMessage(0, "eaip://dev-1/DATA/value", (const uint8_t *)"1", 1);
+}
+
+void test_subscriptionsAreSentOnConnect() {
+    mqttEndpointSubscribe(&monitor, "eaip://dev-1/STATUS", &handleText);
+    connectEndpoint(&monitor, "monitor");
+    connectEndpoint(&device, "device");
+    synchronize(&monitor);
+
+    mqttEndpointPublish(&device, "eaip://dev-1/STATUS", (const uint8_t *)"ONLINE", 6, false);
+
+    pollUntilReceived(1);
+    expectMessage(0, "eaip://dev-1/STATUS", (const uint8_t *)"ONLINE", 6);
+}
+
+void test_willIsPublishedOnlyWithoutDisconnect() {
+    connectEndpoint(&monitor, "monitor");
+    mqttEndpointSubscribe(&monitor, "eaip://+/STATUS", &handleText);
+    synchronize(&monitor);
+    mqttEndpoint_t graceful;
+    mqttEndpointInit(&graceful);
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR,
+                           mqttEndpointSetWill(&graceful, "eaip://dev-1/STATUS", "OFFLINE", false));
+    connectEndpoint(&graceful, "dev-1");
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR,
+                           mqttEndpointSetWill(&device, "eaip://dev-2/STATUS", "OFFLINE", false));
+    connectEndpoint(&device, "dev-2");
+
+    mqttEndpointDisconnect(&graceful);
+    mqttEndpointFree(&graceful);
+    mqttEndpointFree(&device);
+    mqttEndpointInit(&device);
+    connectEndpoint(&device, "device");
+
+    pollUntilReceived(1);
+    expectMessage(0, "eaip://dev-2/STATUS", (const uint8_t *)"OFFLINE", 7);
+}
+
+/*! @brief accepts one connection and answers its CONNECT, the socket is returned */
+static void *acceptRawConnection(void *argument) {
+    int listener = *(int *)argument;
+    int *connection = malloc(sizeof(int));
+    *connection = accept(listener, NULL, NULL);
+    uint8_t connect[64];
+    const uint8_t connack[] = {0x20, 0x02, 0x00, 0x00};
+    recv(*connection, connect, sizeof(connect), 0);
+    send(*connection, connack, sizeof(connack), 0);
+    return connection;
+}
+
+void test_packetLargerThanReceiveBufferClosesConnection() {
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address = {.sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    socklen_t addressLength = sizeof(address);
+    TEST_ASSERT_EQUAL_INT(0, bind(listener, (struct sockaddr *)&address, sizeof(address)));
+    TEST_ASSERT_EQUAL_INT(0, listen(listener, 1));
+    getsockname(listener, (struct sockaddr *)&address, &addressLength);
+
+    pthread_t thread;
+    int *connection;
+    pthread_create(&thread, NULL, &acceptRawConnection, &listener);
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR,
+                           mqttEndpointConnect(&device, "127.0.0.1", ntohs(address.sin_port),
+                                               "device"));
+    pthread_join(thread, (void **)&connection);
+
+    /* PUBLISH announcing 1 MiB, followed by the start of its topic */
+    const uint8_t publish[] = {0x30, 0x80, 0x80, 0x40, 0x00, 0x04, 'e', 'a', 'i', 'p'};
+    send(*connection, publish, sizeof(publish), 0);
+    eaipCommunicationErrorCodes result = EAIP_COM_NO_ERROR;
+    for (size_t round = 0; round < 100 && result == EAIP_COM_NO_ERROR; round++) {
+        result = mqttEndpointPoll(&device, 10);
+    }
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_BROKER_NOT_REACHABLE, result);
+
+    close(*connection);
+    free(connection);
+    close(listener);
+}
+
+void setUp(void) {
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, brokerServerInit(&server, 0, true));
+    pthread_create(&serverThread, NULL, &runServer, NULL);
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, mqttEndpointInit(&device));
+    TEST_ASSERT_EQUAL_UINT(EAIP_COM_NO_ERROR, mqttEndpointInit(&monitor));
+    receivedCount = 0;
+}
+
+void tearDown(void) {
+    mqttEndpointFree(&device);
+    mqttEndpointFree(&monitor);
+    brokerServerStop(&server);
+    pthread_join(serverThread, NULL);
+    brokerServerFree(&server);
+    for (size_t index = 0; index < receivedCount; index++) {
+        free(received[index].payload);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_connectToUnreachableBrokerFails);
+    RUN_TEST(test_invalidTopicsAreRejected);
+    RUN_TEST(test_messageIsDeliveredToMatchingSubscription);
+    RUN_TEST(test_binaryPayloadKeepsZeroBytes);
+    RUN_TEST(test_viewHandlerGetsTopicLengthAndUserData);
+    RUN_TEST(test_messageViewOfMultiLevelWildcardIncludesParentTopic);
+    RUN_TEST(test_queuedMessagesAreDeliveredInOrder);
+    RUN_TEST(test_messageLargerThanSendRingIsDelivered);
+    RUN_TEST(test_unsubscribedFilterIsNotCalled);
+    RUN_TEST(test_subscriptionsAreSentOnConnect);
+    RUN_TEST(test_willIsPublishedOnlyWithoutDisconnect);
+    RUN_TEST(test_packetLargerThanReceiveBufferClosesConnection);
+
+    return UNITY_END();
+}
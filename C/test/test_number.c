@@ -0,0 +1,264 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/protocol/Number.h"
+#include "eaip/protocol/Protocol.h"
+#include "unity.h"
+
+/* region HELPER */
+static float floatFromBits(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static uint32_t bitsFromFloat(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static size_t countSignificantDigits(const char *text) {
+    size_t digits = 0;
+    size_t zeros = 0;
+    for (; *text != '\0' && *text != 'e'; text++) {
+        if (*text == '0' && digits == 0) {
+            continue;
+        }
+        if (*text >= '0' && *text <= '9') {
+            digits++;
+            zeros = *text == '0' ? zeros + 1 : 0;
+        }
+    }
+    return digits - zeros;
+}
+/* endregion HELPER */
+
+void test_formatFloatWritesShortestRepresentation() {
+    char buffer[EAIP_NUMBER_BUFFER_SIZE];
+
+    TEST_ASSERT_EQUAL(5, eaipFormatFloat(buffer, 0.231f));
+    TEST_ASSERT_EQUAL_STRING("0.231", buffer);
+    eaipFormatFloat(buffer, 1.0f);
+    TEST_ASSERT_EQUAL_STRING("1", buffer);
+    eaipFormatFloat(buffer, -1.5f);
+    TEST_ASSERT_EQUAL_STRING("-1.5", buffer);
+    eaipFormatFloat(buffer, 100.0f);
+    TEST_ASSERT_EQUAL_STRING("100", buffer);
+    eaipFormatFloat(buffer, 0.1f);
+    TEST_ASSERT_EQUAL_STRING("0.1", buffer);
+    eaipFormatFloat(buffer, 0.0001f);
+    TEST_ASSERT_EQUAL_STRING("0.0001", buffer);
+    eaipFormatFloat(buffer, 0.00001f);
+    TEST_ASSERT_EQUAL_STRING("1e-5", buffer);
+    eaipFormatFloat(buffer, 16777216.0f);
+    TEST_ASSERT_EQUAL_STRING("16777216", buffer);
+    eaipFormatFloat(buffer, 1e10f);
+    TEST_ASSERT_EQUAL_STRING("1e10", buffer);
+    eaipFormatFloat(buffer, 3.4028235e38f);
+    TEST_ASSERT_EQUAL_STRING("3.4028235e38", buffer);
+    eaipFormatFloat(buffer, floatFromBits(1));
+    TEST_ASSERT_EQUAL_STRING("1e-45", buffer);
+}
+void test_formatFloatWritesSpecialValues() {
+    char buffer[EAIP_NUMBER_BUFFER_SIZE];
+
+    eaipFormatFloat(buffer, 0.0f);
+    TEST_ASSERT_EQUAL_STRING("0", buffer);
+    eaipFormatFloat(buffer, -0.0f);
+    TEST_ASSERT_EQUAL_STRING("-0", buffer);
+    eaipFormatFloat(buffer, floatFromBits(0x7F800000u));
+    TEST_ASSERT_EQUAL_STRING("inf", buffer);
+    eaipFormatFloat(buffer, floatFromBits(0xFF800000u));
+    TEST_ASSERT_EQUAL_STRING("-inf", buffer);
+    eaipFormatFloat(buffer, floatFromBits(0x7FC00000u));
+    TEST_ASSERT_EQUAL_STRING("nan", buffer);
+}
+void test_formatFloatRoundtripsThroughLibcAndScanner() {
+    char buffer[EAIP_NUMBER_BUFFER_SIZE];
+    for (uint64_t bits = 1; bits < 0x7F800000u; bits += 4093) {
+        float value = floatFromBits((uint32_t)bits);
+        size_t length = eaipFormatFloat(buffer, value);
+
+        float scanned = 0;
+        TEST_ASSERT_EQUAL(length, eaipScanFloat(buffer, length, &scanned));
+        TEST_ASSERT_EQUAL_HEX32(bits, bitsFromFloat(scanned));
+        TEST_ASSERT_EQUAL_HEX32(bits, bitsFromFloat(strtof(buffer, NULL)));
+    }
+}
+void test_formatFloatIsNotLongerThanShortestPrintf() {
+    char buffer[EAIP_NUMBER_BUFFER_SIZE];
+    char reference[32];
+    for (uint64_t bits = 1; bits < 0x7F800000u; bits += 104729) {
+        float value = floatFromBits((uint32_t)bits);
+        int precision = 1;
+        for (; precision < 9; precision++) {
+            snprintf(reference, sizeof(reference), "%.*g", precision, (double)value);
+            if (strtof(reference, NULL) == value) {
+                break;
+            }
+        }
+
+        eaipFormatFloat(buffer, value);
+        TEST_ASSERT_LESS_OR_EQUAL((size_t)precision, countSignificantDigits(buffer));
+    }
+}
+
+void test_formatFloatTakesShortestNeighbourOfRoundedDigits() {
+    char buffer[EAIP_NUMBER_BUFFER_SIZE];
+
+    /* the correctly rounded 6.888574e-16 does not round trip, the truncated digits do */
+    eaipFormatFloat(buffer, floatFromBits(0x26468cb3u));
+    TEST_ASSERT_EQUAL_STRING("6.888573e-16", buffer);
+    TEST_ASSERT_EQUAL_HEX32(0x26468cb3u, bitsFromFloat(strtof(buffer, NULL)));
+}
+
+void test_formatIntWritesLimits() {
+    char buffer[EAIP_NUMBER_BUFFER_SIZE];
+
+    TEST_ASSERT_EQUAL(1, eaipFormatInt(buffer, 0));
+    TEST_ASSERT_EQUAL_STRING("0", buffer);
+    eaipFormatInt(buffer, -42);
+    TEST_ASSERT_EQUAL_STRING("-42", buffer);
+    eaipFormatInt(buffer, INT32_MAX);
+    TEST_ASSERT_EQUAL_STRING("2147483647", buffer);
+    eaipFormatInt(buffer, INT32_MIN);
+    TEST_ASSERT_EQUAL_STRING("-2147483648", buffer);
+}
+
+void test_scanFloatAcceptsPrintfOutput() {
+    float value = 0;
+
+    TEST_ASSERT_EQUAL(8, eaipScanFloat("0.231000", 8, &value));
+    TEST_ASSERT_EQUAL_FLOAT(0.231f, value);
+    TEST_ASSERT_EQUAL(13, eaipScanFloat("-1.500000e+02", 13, &value));
+    TEST_ASSERT_EQUAL_FLOAT(-150.0f, value);
+    TEST_ASSERT_EQUAL(2, eaipScanFloat(".5", 2, &value));
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, value);
+    TEST_ASSERT_EQUAL(2, eaipScanFloat("5.", 2, &value));
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, value);
+    TEST_ASSERT_EQUAL(26, eaipScanFloat("1234567890.123456789012345", 26, &value));
+    TEST_ASSERT_EQUAL_FLOAT(1234567890.0f, value);
+}
+void test_scanFloatStopsAtEndOfNumber() {
+    float value = 0;
+
+    TEST_ASSERT_EQUAL(1, eaipScanFloat("1e", 2, &value));
+    TEST_ASSERT_EQUAL(3, eaipScanFloat("2.5,3", 3, &value));
+    TEST_ASSERT_EQUAL(3, eaipScanFloat("2.5,3", 5, &value));
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, value);
+}
+void test_scanFloatRejectsNonNumbers() {
+    float value = 0;
+
+    TEST_ASSERT_EQUAL(0, eaipScanFloat("", 0, &value));
+    TEST_ASSERT_EQUAL(0, eaipScanFloat(".", 1, &value));
+    TEST_ASSERT_EQUAL(0, eaipScanFloat("-", 1, &value));
+    TEST_ASSERT_EQUAL(0, eaipScanFloat("x1", 2, &value));
+}
+void test_scanIntRejectsOverflow() {
+    int32_t value = 0;
+
+    TEST_ASSERT_EQUAL(11, eaipScanInt("-2147483648", 11, &value));
+    TEST_ASSERT_EQUAL(INT32_MIN, value);
+    TEST_ASSERT_EQUAL(10, eaipScanInt("2147483647", 10, &value));
+    TEST_ASSERT_EQUAL(INT32_MAX, value);
+    TEST_ASSERT_EQUAL(0, eaipScanInt("2147483648", 10, &value));
+    TEST_ASSERT_EQUAL(0, eaipScanInt("-", 1, &value));
+}
+
+void test_parseDataFloatRejectsTrailingCharacters() {
+    float value = 0;
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipParseDataFloat("0.231", 5, &value));
+    TEST_ASSERT_EQUAL_FLOAT(0.231f, value);
+    TEST_ASSERT_EQUAL(EAIP_COM_INVALID_MESSAGE, eaipParseDataFloat("0.231F", 6, &value));
+}
+void test_parseDataIntCorrect() {
+    int32_t value = 0;
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipParseDataInt("-17", 3, &value));
+    TEST_ASSERT_EQUAL(-17, value);
+    TEST_ASSERT_EQUAL(EAIP_COM_INVALID_MESSAGE, eaipParseDataInt("1.5", 3, &value));
+}
+void test_parseDataVectorCorrect() {
+    char message[] = "1.5,-2,3e-7,12345678.25";
+    float values[4];
+    size_t count = 0;
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                      eaipParseDataVector(message, strlen(message), values, 4, &count));
+    TEST_ASSERT_EQUAL(4, count);
+    float expected[] = {1.5f, -2.0f, 3e-7f, 12345678.25f};
+    TEST_ASSERT_EQUAL_FLOAT_ARRAY(expected, values, 4);
+}
+void test_parseDataVectorRejectsMalformedMessages() {
+    float values[2];
+    size_t count = 0;
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipParseDataVector("", 0, values, 2, &count));
+    TEST_ASSERT_EQUAL(0, count);
+    TEST_ASSERT_EQUAL(EAIP_COM_INVALID_MESSAGE, eaipParseDataVector("1,", 2, values, 2, &count));
+    TEST_ASSERT_EQUAL(EAIP_COM_INVALID_MESSAGE, eaipParseDataVector("1,,2", 4, values, 2, &count));
+    TEST_ASSERT_EQUAL(EAIP_COM_INVALID_MESSAGE, eaipParseDataVector("1;2", 3, values, 2, &count));
+    TEST_ASSERT_EQUAL(EAIP_COM_MESSAGE_TO_LONG,
+                      eaipParseDataVector("1,2,3", 5, values, 2, &count));
+}
+void test_writeFloatVectorRoundtrips() {
+    float values[] = {0.1f, -2.5f, 1e-20f, 123456.79f};
+    char buffer[64];
+    eaipWriter_t writer;
+    eaipWriterInit(&writer, buffer, sizeof(buffer));
+
+    eaipWriteFloatVector(&writer, values, 4);
+    size_t length = eaipWriterFinish(&writer);
+    TEST_ASSERT_EQUAL_STRING("0.1,-2.5,1e-20,123456.79", buffer);
+
+    float parsed[4];
+    size_t count = 0;
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipParseDataVector(buffer, length, parsed, 4, &count));
+    TEST_ASSERT_EQUAL_MEMORY(values, parsed, sizeof(values));
+}
+void test_writeFloatVectorReportsRequiredLength() {
+    float values[] = {0.1f, -2.5f, 1e-20f};
+    char buffer[8];
+    eaipWriter_t writer;
+    eaipWriterInit(&writer, buffer, sizeof(buffer));
+
+    eaipWriteFloatVector(&writer, values, 3);
+
+    TEST_ASSERT_TRUE(eaipWriterTruncated(&writer));
+    TEST_ASSERT_EQUAL(strlen("0.1,-2.5,1e-20"), writer.length);
+    eaipWriterFinish(&writer);
+    TEST_ASSERT_EQUAL_STRING("0.1,-2.", buffer);
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_formatFloatWritesShortestRepresentation);
+    RUN_TEST(test_formatFloatWritesSpecialValues);
+    RUN_TEST(test_formatFloatRoundtripsThroughLibcAndScanner);
+    RUN_TEST(test_formatFloatIsNotLongerThanShortestPrintf);
+    RUN_TEST(test_formatFloatTakesShortestNeighbourOfRoundedDigits);
+    RUN_TEST(test_formatIntWritesLimits);
+
+    RUN_TEST(test_scanFloatAcceptsPrintfOutput);
+    RUN_TEST(test_scanFloatStopsAtEndOfNumber);
+    RUN_TEST(test_scanFloatRejectsNonNumbers);
+    RUN_TEST(test_scanIntRejectsOverflow);
+
+    RUN_TEST(test_parseDataFloatRejectsTrailingCharacters);
+    RUN_TEST(test_parseDataIntCorrect);
+    RUN_TEST(test_parseDataVectorCorrect);
+    RUN_TEST(test_parseDataVectorRejectsMalformedMessages);
+    RUN_TEST(test_writeFloatVectorRoundtrips);
+    RUN_TEST(test_writeFloatVectorReportsRequiredLength);
+
+    return UNITY_END();
+}
@@ -0,0 +1,373 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/protocol/Outbox.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Session.h"
+#include "unity.h"
+
+#define BASE_URL "eaip://local-net"
+#define DEVICE_ID "test-dev"
+#define STRESS_MESSAGES 200000
+#define STRESS_PRODUCERS 4
+
+/* region TEST RUNTIME */
+size_t published = 0;
+bool publishFails = false;
+char lastTopic[128];
+char lastMessage[128];
+bool lastRetain = false;
+size_t expectedSequence = 0;
+bool sequenceValid = true;
+
+eaipCommunicationErrorCodes recordPublish(char *topic, char *message, bool retain) {
+    if (publishFails) {
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    published++;
+    strcpy(lastTopic, topic);
+    strcpy(lastMessage, message);
+    lastRetain = retain;
+    return EAIP_COM_NO_ERROR;
+}
+
+/*! messages of the stress test carry a sequence number, which must strictly increase */
+eaipCommunicationErrorCodes checkSequence(__attribute__((unused)) char *topic, char *message,
+                                          __attribute__((unused)) bool retain) {
+    size_t sequence = strtoul(message, NULL, 10);
+    if (sequence < expectedSequence) {
+        sequenceValid = false;
+    }
+    expectedSequence = sequence + 1;
+    published++;
+    return EAIP_COM_NO_ERROR;
+}
+
+/*! the integrity test repeats the sequence number of the topic over the whole message */
+size_t tornRecords = 0;
+eaipCommunicationErrorCodes checkIntegrity(char *topic, char *message,
+                                           __attribute__((unused)) bool retain) {
+    char expected[48];
+    size_t sequence = strtoul(strrchr(topic, '/') + 1, NULL, 10);
+    snprintf(expected, sizeof(expected), "%08zu%08zu%08zu%08zu%08zu", sequence, sequence, sequence,
+             sequence, sequence);
+    if (0 != strcmp(expected, message)) {
+        tornRecords++;
+    }
+    return checkSequence(topic, message, retain);
+}
+
+/*! messages of the multi producer stress test carry `<producer>:<sequence>` */
+size_t expectedSequences[STRESS_PRODUCERS];
+eaipCommunicationErrorCodes checkProducerSequence(__attribute__((unused)) char *topic,
+                                                  char *message,
+                                                  __attribute__((unused)) bool retain) {
+    char *separator;
+    size_t producer = strtoul(message, &separator, 10);
+    size_t sequence = strtoul(separator + 1, NULL, 10);
+    if (producer >= STRESS_PRODUCERS || sequence < expectedSequences[producer]) {
+        sequenceValid = false;
+    } else {
+        expectedSequences[producer] = sequence + 1;
+    }
+    published++;
+    return EAIP_COM_NO_ERROR;
+}
+
+eaiProtocol_t config = {
+    .publish = &recordPublish,
+    .baseUrl = BASE_URL,
+    .deviceId = DEVICE_ID,
+};
+eaipOutbox_t outbox;
+
+static void enqueue(const char *message) {
+    eaipOutboxPublish(&outbox, "topic", message, false);
+}
+
+static void *produce(void *argument) {
+    eaipOutbox_t *target = argument;
+    char message[16];
+    for (size_t sequence = 0; sequence < STRESS_MESSAGES; sequence++) {
+        sprintf(message, "%zu", sequence);
+        eaipOutboxPublish(target, "stress/topic", message, false);
+    }
+    return NULL;
+}
+
+static void *produceRepeated(void *argument) {
+    eaipOutbox_t *target = argument;
+    char topic[32];
+    char message[48];
+    for (size_t sequence = 0; sequence < STRESS_MESSAGES; sequence++) {
+        snprintf(topic, sizeof(topic), "stress/%zu", sequence);
+        snprintf(message, sizeof(message), "%08zu%08zu%08zu%08zu%08zu", sequence, sequence,
+                 sequence, sequence, sequence);
+        eaipOutboxPublish(target, topic, message, false);
+    }
+    return NULL;
+}
+
+typedef struct producer {
+    eaipOutbox_t *outbox;
+    size_t id;
+} producer_t;
+static void *produceConcurrently(void *argument) {
+    producer_t *producer = argument;
+    char message[32];
+    for (size_t sequence = 0; sequence < STRESS_MESSAGES / STRESS_PRODUCERS; sequence++) {
+        sprintf(message, "%zu:%zu", producer->id, sequence);
+        eaipOutboxPublish(producer->outbox, "stress/topic", message, false);
+    }
+    return NULL;
+}
+
+static void runMultiProducerStressTest(eaipOverflowPolicy_t policy) {
+    eaiProtocol_t stressConfig = {.publish = &checkProducerSequence};
+    eaipOutbox_t stressOutbox;
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                      eaipOutboxInitMultiProducer(&stressOutbox, stressConfig, 64, 64, policy));
+
+    pthread_t threads[STRESS_PRODUCERS];
+    producer_t producers[STRESS_PRODUCERS];
+    for (size_t index = 0; index < STRESS_PRODUCERS; index++) {
+        producers[index] = (producer_t){.outbox = &stressOutbox, .id = index};
+        pthread_create(&threads[index], NULL, &produceConcurrently, &producers[index]);
+    }
+    while (published + eaipOutboxDropped(&stressOutbox) < STRESS_MESSAGES) {
+        if (0 == eaipOutboxDrain(&stressOutbox, 16)) {
+            sched_yield();
+        }
+    }
+    for (size_t index = 0; index < STRESS_PRODUCERS; index++) {
+        pthread_join(threads[index], NULL);
+    }
+
+    TEST_ASSERT_TRUE(sequenceValid);
+    TEST_ASSERT_EQUAL(0, eaipOutboxCount(&stressOutbox));
+    TEST_ASSERT_EQUAL(STRESS_MESSAGES, published + eaipOutboxDropped(&stressOutbox));
+    eaipOutboxFree(&stressOutbox);
+}
+
+static void runStressTest(eaipOverflowPolicy_t policy) {
+    eaiProtocol_t stressConfig = {.publish = &checkSequence};
+    eaipOutbox_t stressOutbox;
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                      eaipOutboxInit(&stressOutbox, stressConfig, 64, 64, policy));
+
+    pthread_t producer;
+    pthread_create(&producer, NULL, &produce, &stressOutbox);
+    while (published + eaipOutboxDropped(&stressOutbox) < STRESS_MESSAGES) {
+        if (0 == eaipOutboxDrain(&stressOutbox, 16)) {
+            sched_yield();
+        }
+    }
+    pthread_join(producer, NULL);
+
+    TEST_ASSERT_TRUE(sequenceValid);
+    TEST_ASSERT_EQUAL(0, eaipOutboxCount(&stressOutbox));
+    TEST_ASSERT_EQUAL(STRESS_MESSAGES, published + eaipOutboxDropped(&stressOutbox));
+    printf("policy %d: %zu published, %zu dropped\n", policy, published,
+           eaipOutboxDropped(&stressOutbox));
+    eaipOutboxFree(&stressOutbox);
+}
+/* endregion TEST RUNTIME */
+
+void test_drainPublishesInOrder() {
+    eaipOutboxPublish(&outbox, "first/topic", "1", true);
+    eaipOutboxPublish(&outbox, "second/topic", "2", false);
+    TEST_ASSERT_EQUAL(2, eaipOutboxCount(&outbox));
+    TEST_ASSERT_EQUAL(0, published);
+
+    TEST_ASSERT_EQUAL(1, eaipOutboxDrain(&outbox, 1));
+    TEST_ASSERT_EQUAL_STRING("first/topic", lastTopic);
+    TEST_ASSERT_EQUAL_STRING("1", lastMessage);
+    TEST_ASSERT_TRUE(lastRetain);
+
+    TEST_ASSERT_EQUAL(1, eaipOutboxDrain(&outbox, 8));
+    TEST_ASSERT_EQUAL_STRING("second/topic", lastTopic);
+    TEST_ASSERT_FALSE(lastRetain);
+    TEST_ASSERT_EQUAL(0, eaipOutboxCount(&outbox));
+}
+
+void test_publishDataFormatsTopic() {
+    eaipSession_t session;
+    eaipSessionInit(&session, config);
+
+    eaipPubRequest_t request = {.dataId = "light", .data = "0.5"};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipOutboxPublishData(&outbox, &session, request));
+    eaipOutboxDrain(&outbox, 1);
+
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID "/DATA/light", lastTopic);
+    TEST_ASSERT_EQUAL_STRING("0.5", lastMessage);
+    eaipSessionFree(&session);
+}
+
+void test_messageExceedingRecordFails() {
+    char message[EAIP_OUTBOX_RECORD_SIZE];
+    memset(message, 'x', sizeof(message) - 1);
+    message[sizeof(message) - 1] = '\0';
+
+    TEST_ASSERT_EQUAL(EAIP_COM_MESSAGE_TO_LONG,
+                      eaipOutboxPublish(&outbox, "topic", message, false));
+    TEST_ASSERT_EQUAL(0, eaipOutboxCount(&outbox));
+}
+
+void test_overflowDropsNewest() {
+    for (int index = 0; index < 4; index++) {
+        enqueue("kept");
+    }
+    TEST_ASSERT_EQUAL(EAIP_COM_OUT_OF_MEMORY,
+                      eaipOutboxPublish(&outbox, "topic", "dropped", false));
+    TEST_ASSERT_EQUAL(1, eaipOutboxDropped(&outbox));
+
+    TEST_ASSERT_EQUAL(4, eaipOutboxDrain(&outbox, 8));
+    TEST_ASSERT_EQUAL_STRING("kept", lastMessage);
+}
+
+void test_overflowDropsOldest() {
+    eaipOutboxFree(&outbox);
+    eaipOutboxInit(&outbox, config, 4, EAIP_OUTBOX_RECORD_SIZE, EAIP_OVERFLOW_DROP_OLDEST);
+
+    char *messages[] = {"0", "1", "2", "3", "4", "5"};
+    for (int index = 0; index < 6; index++) {
+        TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipOutboxPublish(&outbox, "t", messages[index], 0));
+    }
+    TEST_ASSERT_EQUAL(2, eaipOutboxDropped(&outbox));
+
+    TEST_ASSERT_EQUAL(1, eaipOutboxDrain(&outbox, 1));
+    TEST_ASSERT_EQUAL_STRING("2", lastMessage);
+    TEST_ASSERT_EQUAL(3, eaipOutboxDrain(&outbox, 8));
+    TEST_ASSERT_EQUAL_STRING("5", lastMessage);
+}
+
+void test_failedPublishIsRetried() {
+    enqueue("retried");
+
+    publishFails = true;
+    TEST_ASSERT_EQUAL(0, eaipOutboxDrain(&outbox, 8));
+    publishFails = false;
+
+    TEST_ASSERT_EQUAL(1, eaipOutboxDrain(&outbox, 8));
+    TEST_ASSERT_EQUAL_STRING("retried", lastMessage);
+}
+
+void test_failedPublishIsRetriedWhenDroppingOldest() {
+    eaipOutboxFree(&outbox);
+    eaipOutboxInit(&outbox, config, 4, EAIP_OUTBOX_RECORD_SIZE, EAIP_OVERFLOW_DROP_OLDEST);
+    enqueue("retried");
+
+    publishFails = true;
+    TEST_ASSERT_EQUAL(0, eaipOutboxDrain(&outbox, 8));
+    publishFails = false;
+
+    TEST_ASSERT_EQUAL(1, eaipOutboxDrain(&outbox, 8));
+    TEST_ASSERT_EQUAL_STRING("retried", lastMessage);
+}
+
+void test_concurrentProducerBlocking() {
+    runStressTest(EAIP_OVERFLOW_BLOCK);
+    TEST_ASSERT_EQUAL(STRESS_MESSAGES, published);
+}
+
+void test_concurrentProducerDroppingOldest() {
+    runStressTest(EAIP_OVERFLOW_DROP_OLDEST);
+}
+
+void test_concurrentProducerDroppingOldestKeepsRecordsIntact() {
+    eaiProtocol_t stressConfig = {.publish = &checkIntegrity};
+    eaipOutbox_t stressOutbox;
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipOutboxInit(&stressOutbox, stressConfig, 4, 64,
+                                                        EAIP_OVERFLOW_DROP_OLDEST));
+
+    pthread_t producer;
+    pthread_create(&producer, NULL, &produceRepeated, &stressOutbox);
+    while (published + eaipOutboxDropped(&stressOutbox) < STRESS_MESSAGES) {
+        eaipOutboxDrain(&stressOutbox, 1);
+    }
+    pthread_join(producer, NULL);
+
+    TEST_ASSERT_EQUAL(0, tornRecords);
+    TEST_ASSERT_TRUE(sequenceValid);
+    TEST_ASSERT_EQUAL(STRESS_MESSAGES, published + eaipOutboxDropped(&stressOutbox));
+    eaipOutboxFree(&stressOutbox);
+}
+
+void test_concurrentProducerDroppingNewest() {
+    runStressTest(EAIP_OVERFLOW_DROP_NEWEST);
+}
+
+void test_multiProducerDrainsInOrder() {
+    eaipOutboxFree(&outbox);
+    eaipOutboxInitMultiProducer(&outbox, config, 4, EAIP_OUTBOX_RECORD_SIZE,
+                                EAIP_OVERFLOW_DROP_NEWEST);
+
+    char *messages[] = {"0", "1", "2", "3", "4"};
+    for (int index = 0; index < 5; index++) {
+        eaipOutboxPublish(&outbox, "t", messages[index], false);
+    }
+    TEST_ASSERT_EQUAL(1, eaipOutboxDropped(&outbox));
+
+    TEST_ASSERT_EQUAL(2, eaipOutboxDrain(&outbox, 2));
+    TEST_ASSERT_EQUAL_STRING("1", lastMessage);
+    eaipOutboxPublish(&outbox, "t", "5", false);
+    TEST_ASSERT_EQUAL(3, eaipOutboxDrain(&outbox, 8));
+    TEST_ASSERT_EQUAL_STRING("5", lastMessage);
+}
+
+void test_multiProducerDroppingOldestNotSupported() {
+    eaipOutbox_t shared;
+    TEST_ASSERT_EQUAL(EAIP_COM_NOT_SUPPORTED,
+                      eaipOutboxInitMultiProducer(&shared, config, 4, EAIP_OUTBOX_RECORD_SIZE,
+                                                  EAIP_OVERFLOW_DROP_OLDEST));
+}
+
+void test_concurrentProducersBlocking() {
+    runMultiProducerStressTest(EAIP_OVERFLOW_BLOCK);
+    TEST_ASSERT_EQUAL(STRESS_MESSAGES, published);
+}
+
+void test_concurrentProducersDroppingNewest() {
+    runMultiProducerStressTest(EAIP_OVERFLOW_DROP_NEWEST);
+}
+
+void setUp() {
+    published = 0;
+    tornRecords = 0;
+    memset(expectedSequences, 0, sizeof(expectedSequences));
+    publishFails = false;
+    expectedSequence = 0;
+    sequenceValid = true;
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipOutboxInit(&outbox, config, 4,
+                                                        EAIP_OUTBOX_RECORD_SIZE,
+                                                        EAIP_OVERFLOW_DROP_NEWEST));
+}
+
+void tearDown() {
+    eaipOutboxFree(&outbox);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_drainPublishesInOrder);
+    RUN_TEST(test_publishDataFormatsTopic);
+    RUN_TEST(test_messageExceedingRecordFails);
+    RUN_TEST(test_overflowDropsNewest);
+    RUN_TEST(test_overflowDropsOldest);
+    RUN_TEST(test_failedPublishIsRetried);
+    RUN_TEST(test_failedPublishIsRetriedWhenDroppingOldest);
+    RUN_TEST(test_concurrentProducerBlocking);
+    RUN_TEST(test_concurrentProducerDroppingOldest);
+    RUN_TEST(test_concurrentProducerDroppingOldestKeepsRecordsIntact);
+    RUN_TEST(test_concurrentProducerDroppingNewest);
+    RUN_TEST(test_multiProducerDrainsInOrder);
+    RUN_TEST(test_multiProducerDroppingOldestNotSupported);
+    RUN_TEST(test_concurrentProducersBlocking);
+    RUN_TEST(test_concurrentProducersDroppingNewest);
+
+    return UNITY_END();
+}
@@ -1,3 +1,4 @@
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -13,6 +14,7 @@ eaiProtocol_t config = {
     .subscribe = &subscribe,
     .unsubscribe = &unsubscribe,
     .publish = &publish,
+    .subscribeView = &subscribeView,
     .baseUrl = BASE_URL,
     .deviceId = DEVICE_ID,
 };
@@ -64,6 +66,24 @@ void test_publishExtendedStatusCorrect() {
 
     TEST_ASSERT_EQUAL_CHAR_ARRAY(expectedMessage, receivedData, strlen(expectedMessage));
 }
+#ifndef EAIP_STACK_BOUNDED
+void test_publishStatusExceedingScratchBufferCorrect() {
+    char expectedTopic[] = BASE_URL "/" DEVICE_ID "/STATUS";
+    char longData[2 * EAIP_STATUS_BUFFER_SIZE + 1];
+    memset(longData, 'x', sizeof(longData) - 1);
+    longData[sizeof(longData) - 1] = '\0';
+    subscribe(expectedTopic, &validateTopic);
+
+    eaipStateDataField_t additionalField = {.id = "LONG", .data = longData, .next = NULL};
+    eaipDeviceState_t state = {
+        .deviceState = ONLINE, .deviceType = NODE, .additionalFields = &additionalField};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipPublishStatus(config, state));
+
+    size_t headerLength = strlen("ID:" DEVICE_ID ";TYPE:enV5;STATE:ONLINE;LONG:");
+    TEST_ASSERT_EQUAL(headerLength + strlen(longData) + 1, strlen(receivedData));
+    TEST_ASSERT_EQUAL_CHAR_ARRAY(longData, receivedData + headerLength, strlen(longData));
+}
+#endif
 
 void test_publishDataSuccessful() {
     eaipPubRequest_t data = {.dataId = "test-top", .data = "DATA"};
@@ -89,6 +109,29 @@ void test_publishDataDataCorrect() {
     TEST_ASSERT_EQUAL_CHAR_ARRAY(expectedMessage, receivedData, strlen(expectedMessage));
 }
 
+void test_publishDataFloatCorrect() {
+    char expectedTopic[] = BASE_URL "/" DEVICE_ID "/DATA/test-top";
+    subscribe(expectedTopic, &validateTopic);
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipPublishDataFloat(config, "test-top", 0.231f));
+    TEST_ASSERT_EQUAL_STRING("0.231", receivedData);
+}
+void test_publishDataIntCorrect() {
+    char expectedTopic[] = BASE_URL "/" DEVICE_ID "/DATA/test-top";
+    subscribe(expectedTopic, &validateTopic);
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipPublishDataInt(config, "test-top", -17));
+    TEST_ASSERT_EQUAL_STRING("-17", receivedData);
+}
+void test_publishDataVectorCorrect() {
+    char expectedTopic[] = BASE_URL "/" DEVICE_ID "/DATA/test-top";
+    subscribe(expectedTopic, &validateTopic);
+
+    float values[] = {1.5f, -2.0f, 3e-7f};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipPublishDataVector(config, "test-top", values, 3));
+    TEST_ASSERT_EQUAL_STRING("1.5,-2,3e-7", receivedData);
+}
+
 void test_publishStartRequestSuccessful() {
     eaipPubRequest_t data = {.deviceId = "test-receiver", .dataId = "test-top"};
     TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipPublishStart(config, data));
@@ -438,6 +481,153 @@ void test_unsubscribeDoneCorrectTopic() {
     TEST_ASSERT_NULL(subscriptions->next);
 }
 
+typedef struct viewed {
+    int count;
+    topic_t type;
+    size_t topicLength;
+    char topic[128];
+    char deviceId[32];
+    char dataId[32];
+    uint8_t payload[32];
+    size_t length;
+} viewed_t;
+void recordView(const eaipMessageView_t *message, void *userData) {
+    viewed_t *viewed = userData;
+    viewed->count++;
+    viewed->type = message->type;
+    viewed->topicLength = message->topic.length;
+    snprintf(viewed->topic, sizeof(viewed->topic), "%.*s", (int)message->topic.length,
+             message->topic.data);
+    snprintf(viewed->deviceId, sizeof(viewed->deviceId), "%.*s", (int)message->deviceId.length,
+             message->deviceId.data);
+    snprintf(viewed->dataId, sizeof(viewed->dataId), "%.*s", (int)message->dataId.length,
+             message->dataId.data);
+    viewed->length = message->length;
+    if (message->length > 0) {
+        size_t stored = message->length < sizeof(viewed->payload) ? message->length
+                                                                    : sizeof(viewed->payload);
+        memcpy(viewed->payload, message->payload, stored);
+    }
+}
+
+void test_subscribeViewDataDecodesMessage() {
+    viewed_t viewed = {0};
+    eaipViewSubscription_t subscription;
+    eaipSubRequest_t request = {.targetId = "test-device",
+                                .dataId = "value",
+                                .viewHandler = &recordView,
+                                .userData = &viewed};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSubscribeView(config, DATA, request, &subscription));
+
+    publish(BASE_URL "/test-device/DATA/value", "42.5", false);
+
+    TEST_ASSERT_EQUAL_INT(1, viewed.count);
+    TEST_ASSERT_EQUAL(DATA, viewed.type);
+    TEST_ASSERT_EQUAL(strlen(BASE_URL "/test-device/DATA/value"), viewed.topicLength);
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/test-device/DATA/value", viewed.topic);
+    TEST_ASSERT_EQUAL_STRING("test-device", viewed.deviceId);
+    TEST_ASSERT_EQUAL_STRING("value", viewed.dataId);
+    TEST_ASSERT_EQUAL(4, viewed.length);
+    TEST_ASSERT_EQUAL_MEMORY("42.5", viewed.payload, 4);
+}
+void test_subscribeViewStatusOfAnyDevice() {
+    viewed_t viewed = {0};
+    eaipViewSubscription_t subscription;
+    eaipSubRequest_t request = {.targetId = "+", .viewHandler = &recordView, .userData = &viewed};
+    eaipSubscribeView(config, STATUS, request, &subscription);
+
+    eaipDeviceState_t state = {.deviceState = ONLINE, .deviceType = NODE};
+    eaipPublishStatus(config, state);
+
+    TEST_ASSERT_EQUAL_INT(1, viewed.count);
+    TEST_ASSERT_EQUAL(STATUS, viewed.type);
+    TEST_ASSERT_EQUAL_STRING(DEVICE_ID, viewed.deviceId);
+    TEST_ASSERT_EQUAL_STRING("", viewed.dataId);
+    TEST_ASSERT_EQUAL_MEMORY("ID:" DEVICE_ID ";", viewed.payload, strlen("ID:" DEVICE_ID ";"));
+}
+void test_subscribeViewAnyDeviceAndDataId() {
+    viewed_t viewed = {0};
+    eaipViewSubscription_t subscription;
+    eaipSubRequest_t request = {
+        .targetId = "+", .dataId = "+", .viewHandler = &recordView, .userData = &viewed};
+    eaipSubscribeView(config, DATA, request, &subscription);
+
+    publish(BASE_URL "/dev-7/DATA/temperature", "21", false);
+    TEST_ASSERT_EQUAL_STRING("dev-7", viewed.deviceId);
+    TEST_ASSERT_EQUAL_STRING("temperature", viewed.dataId);
+
+    publish(BASE_URL "/another-device/DATA/t", "22", false);
+    TEST_ASSERT_EQUAL_INT(2, viewed.count);
+    TEST_ASSERT_EQUAL_STRING("another-device", viewed.deviceId);
+    TEST_ASSERT_EQUAL_STRING("t", viewed.dataId);
+}
+void test_subscribeViewAnyDeviceWithFixedDataId() {
+    viewed_t viewed = {0};
+    eaipViewSubscription_t subscription;
+    eaipSubRequest_t request = {
+        .targetId = "+", .dataId = "MEASURE", .viewHandler = &recordView, .userData = &viewed};
+    eaipSubscribeView(config, DONE, request, &subscription);
+
+    publish(BASE_URL "/dev-12/DONE/MEASURE", "OK", false);
+    TEST_ASSERT_EQUAL_INT(1, viewed.count);
+    TEST_ASSERT_EQUAL(DONE, viewed.type);
+    TEST_ASSERT_EQUAL_STRING("dev-12", viewed.deviceId);
+    TEST_ASSERT_EQUAL_STRING("MEASURE", viewed.dataId);
+}
+void test_subscribeViewDoUsesOwnDevice() {
+    viewed_t viewed = {0};
+    eaipViewSubscription_t subscription;
+    eaipSubRequest_t request = {
+        .targetId = "ignored", .dataId = "+", .viewHandler = &recordView, .userData = &viewed};
+    eaipSubscribeView(config, DO, request, &subscription);
+
+    eaipPubRequest_t command = {.deviceId = DEVICE_ID, .dataId = "MEASURE", .data = "fast"};
+    eaipPublishDo(config, command);
+
+    TEST_ASSERT_EQUAL_INT(1, viewed.count);
+    TEST_ASSERT_EQUAL(DO, viewed.type);
+    TEST_ASSERT_EQUAL_STRING(DEVICE_ID, viewed.deviceId);
+    TEST_ASSERT_EQUAL_STRING("MEASURE", viewed.dataId);
+    TEST_ASSERT_EQUAL_MEMORY("fast", viewed.payload, 4);
+}
+void test_subscribeViewPassesBinaryPayload() {
+    viewed_t viewed = {0};
+    eaipViewSubscription_t subscription;
+    eaipSubRequest_t request = {
+        .targetId = "dev", .dataId = "raw", .viewHandler = &recordView, .userData = &viewed};
+    eaipSubscribeView(config, DATA, request, &subscription);
+
+    const uint8_t raw[] = {0x01, 0x00, 0x02};
+    publishBinary(BASE_URL "/dev/DATA/raw", raw, sizeof(raw), false);
+
+    TEST_ASSERT_EQUAL_INT(1, viewed.count);
+    TEST_ASSERT_EQUAL(sizeof(raw), viewed.length);
+    TEST_ASSERT_EQUAL_MEMORY(raw, viewed.payload, sizeof(raw));
+}
+void test_subscribeViewNotSupportedWithoutEndpointFunction() {
+    eaiProtocol_t withoutView = config;
+    withoutView.subscribeView = NULL;
+    eaipViewSubscription_t subscription;
+    eaipSubRequest_t request = {.targetId = "dev", .dataId = "value", .viewHandler = &recordView};
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NOT_SUPPORTED,
+                      eaipSubscribeView(withoutView, DATA, request, &subscription));
+    TEST_ASSERT_NULL(subscriptions);
+}
+void test_unsubscribeViewRemovesSubscription() {
+    viewed_t viewed = {0};
+    eaipViewSubscription_t subscription;
+    eaipSubRequest_t request = {
+        .targetId = "dev", .dataId = "value", .viewHandler = &recordView, .userData = &viewed};
+    eaipSubscribeView(config, DATA, request, &subscription);
+    TEST_ASSERT_NOT_NULL(subscriptions);
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipUnsubscribeView(config, DATA, request));
+    TEST_ASSERT_NULL(subscriptions);
+    publish(BASE_URL "/dev/DATA/value", "1", false);
+    TEST_ASSERT_EQUAL_INT(0, viewed.count);
+}
+
 void setUp() {
     TEST_ASSERT_NULL(receivedTopic);
     TEST_ASSERT_NULL(receivedData);
@@ -465,10 +655,16 @@ int main(void) {
     RUN_TEST(test_publishStatusTopicCorrect);
     RUN_TEST(test_publishStandardStatusCorrect);
     RUN_TEST(test_publishExtendedStatusCorrect);
+#ifndef EAIP_STACK_BOUNDED
+    RUN_TEST(test_publishStatusExceedingScratchBufferCorrect);
+#endif
 
     RUN_TEST(test_publishDataSuccessful);
     RUN_TEST(test_publishDataTopicCorrect);
     RUN_TEST(test_publishDataDataCorrect);
+    RUN_TEST(test_publishDataFloatCorrect);
+    RUN_TEST(test_publishDataIntCorrect);
+    RUN_TEST(test_publishDataVectorCorrect);
 
     RUN_TEST(test_publishStartRequestSuccessful);
     RUN_TEST(test_publishStartRequestTopicCorrect);
@@ -528,5 +724,14 @@ int main(void) {
     RUN_TEST(test_unsubscribeDoneSuccessful);
     RUN_TEST(test_unsubscribeDoneCorrectTopic);
 
+    RUN_TEST(test_subscribeViewDataDecodesMessage);
+    RUN_TEST(test_subscribeViewStatusOfAnyDevice);
+    RUN_TEST(test_subscribeViewAnyDeviceAndDataId);
+    RUN_TEST(test_subscribeViewAnyDeviceWithFixedDataId);
+    RUN_TEST(test_subscribeViewDoUsesOwnDevice);
+    RUN_TEST(test_subscribeViewPassesBinaryPayload);
+    RUN_TEST(test_subscribeViewNotSupportedWithoutEndpointFunction);
+    RUN_TEST(test_unsubscribeViewRemovesSubscription);
+
     return UNITY_END();
 }
@@ -0,0 +1,180 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/brokerMock/Broker.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Provider.h"
+#include "eaip/protocol/Router.h"
+#include "eaip/protocol/Session.h"
+#include "unity.h"
+
+#define BASE_URL "eaip://local-net"
+#define DEVICE_ID "test-dev"
+
+/* region TEST RUNTIME */
+eaiProtocol_t config = {
+    .subscribe = &subscribe,
+    .unsubscribe = &unsubscribe,
+    .publish = &publish,
+    .baseUrl = BASE_URL,
+    .deviceId = DEVICE_ID,
+};
+eaiProtocol_t consumerA = {
+    .subscribe = &subscribe,
+    .unsubscribe = &unsubscribe,
+    .publish = &publish,
+    .baseUrl = BASE_URL,
+    .deviceId = "consumer-a",
+};
+eaiProtocol_t consumerB = {
+    .subscribe = &subscribe,
+    .unsubscribe = &unsubscribe,
+    .publish = &publish,
+    .baseUrl = BASE_URL,
+    .deviceId = "consumer-b",
+};
+eaipSession_t session;
+eaipRouter_t router;
+eaipProvider_t provider;
+eaipStream_t *light;
+
+void routeMessage(char *topic, char *message) {
+    eaipRouterDispatch(&router, topic, message);
+}
+
+int received = 0;
+void countData(__attribute__((unused)) char *topic, __attribute__((unused)) char *data) {
+    received++;
+}
+
+static void start(eaiProtocol_t consumer, char *dataId) {
+    eaipPubRequest_t request = {.deviceId = DEVICE_ID, .dataId = dataId};
+    eaipPublishStart(consumer, request);
+}
+static void stop(eaiProtocol_t consumer, char *dataId) {
+    eaipPubRequest_t request = {.deviceId = DEVICE_ID, .dataId = dataId};
+    eaipPublishStop(consumer, request);
+}
+/* endregion TEST RUNTIME */
+
+void test_publishWithoutConsumersSkipped() {
+    TEST_ASSERT_FALSE(eaipStreamHasConsumers(light));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipProviderPublishData(&provider, light, "0.5"));
+    TEST_ASSERT_EQUAL(0, received);
+}
+
+void test_startEnablesAndStopDisablesStream() {
+    start(consumerA, "light");
+    TEST_ASSERT_TRUE(eaipStreamHasConsumers(light));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipProviderPublishData(&provider, light, "0.5"));
+    TEST_ASSERT_EQUAL(1, received);
+
+    stop(consumerA, "light");
+    TEST_ASSERT_FALSE(eaipStreamHasConsumers(light));
+    eaipProviderPublishData(&provider, light, "0.5");
+    TEST_ASSERT_EQUAL(1, received);
+}
+
+void test_requestersAreCountedById() {
+    start(consumerA, "light");
+    start(consumerA, "light");
+    start(consumerB, "light");
+    TEST_ASSERT_EQUAL(2, light->consumers);
+
+    stop(consumerB, "light");
+    stop(consumerA, "light");
+    TEST_ASSERT_TRUE(eaipStreamHasConsumers(light));
+
+    stop(consumerA, "light");
+    TEST_ASSERT_FALSE(eaipStreamHasConsumers(light));
+}
+
+void test_unmatchedStopIgnored() {
+    start(consumerA, "light");
+    stop(consumerB, "light");
+    stop(consumerB, "light");
+
+    TEST_ASSERT_EQUAL(1, light->consumers);
+}
+
+void test_streamsAreTrackedSeparately() {
+    eaipStream_t *sound;
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipProviderRegister(&provider, "sound", &sound));
+
+    start(consumerA, "sound");
+    TEST_ASSERT_TRUE(eaipStreamHasConsumers(sound));
+    TEST_ASSERT_FALSE(eaipStreamHasConsumers(light));
+
+    eaipProviderUnregister(&provider, sound);
+    TEST_ASSERT_EQUAL(2, router.count);
+    TEST_ASSERT_FALSE(eaipRouterDispatch(&router, BASE_URL "/" DEVICE_ID "/START/sound", "x"));
+}
+
+void test_registerBeyondCapacityFails() {
+    eaipStream_t *stream;
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipProviderRegister(&provider, "sound", &stream));
+    TEST_ASSERT_EQUAL(EAIP_COM_OUT_OF_MEMORY, eaipProviderRegister(&provider, "heat", &stream));
+    TEST_ASSERT_EQUAL(4, router.count);
+}
+
+void test_duplicateRegisterFails() {
+    eaipStream_t *stream;
+    TEST_ASSERT_EQUAL(EAIP_COM_TOPIC_ALREADY_SUBSCRIBED,
+                      eaipProviderRegister(&provider, "light", &stream));
+    TEST_ASSERT_EQUAL(2, router.count);
+}
+
+void test_consumerEntriesAreReusedAfterUnregister() {
+    eaipStream_t *sound;
+    eaiProtocol_t consumerC = consumerA;
+    consumerC.deviceId = "consumer-c";
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipProviderRegister(&provider, "sound", &sound));
+    start(consumerA, "light");
+    start(consumerB, "light");
+    start(consumerA, "sound");
+    start(consumerB, "sound");
+
+    start(consumerC, "light");
+    TEST_ASSERT_EQUAL(2, light->consumers);
+
+    eaipProviderUnregister(&provider, sound);
+    start(consumerC, "light");
+    TEST_ASSERT_EQUAL(3, light->consumers);
+    stop(consumerA, "light");
+    stop(consumerC, "light");
+    TEST_ASSERT_EQUAL(1, light->consumers);
+    stop(consumerB, "light");
+    TEST_ASSERT_FALSE(eaipStreamHasConsumers(light));
+}
+
+void setUp() {
+    received = 0;
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionInit(&session, config));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipRouterInit(&router, &session, 4));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipProviderInit(&provider, &router, 2, 4));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipProviderRegister(&provider, "light", &light));
+    eaipRouterSubscribe(&router, &routeMessage);
+    subscribe(BASE_URL "/" DEVICE_ID "/DATA/light", &countData);
+}
+
+void tearDown() {
+    eaipProviderFree(&provider);
+    eaipRouterFree(&router);
+    eaipSessionFree(&session);
+    resetSubscriptions();
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_publishWithoutConsumersSkipped);
+    RUN_TEST(test_startEnablesAndStopDisablesStream);
+    RUN_TEST(test_requestersAreCountedById);
+    RUN_TEST(test_unmatchedStopIgnored);
+    RUN_TEST(test_streamsAreTrackedSeparately);
+    RUN_TEST(test_registerBeyondCapacityFails);
+    RUN_TEST(test_duplicateRegisterFails);
+    RUN_TEST(test_consumerEntriesAreReusedAfterUnregister);
+
+    return UNITY_END();
+}
@@ -0,0 +1,205 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "eaip/brokerMock/Broker.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Router.h"
+#include "eaip/protocol/Session.h"
+#include "unity.h"
+
+#define BASE_URL "eaip://local-net"
+#define DEVICE_ID "test-dev"
+
+/* region TEST RUNTIME */
+eaiProtocol_t config = {
+    .subscribe = &subscribe,
+    .unsubscribe = &unsubscribe,
+    .publish = &publish,
+    .baseUrl = BASE_URL,
+    .deviceId = DEVICE_ID,
+};
+eaipSession_t session;
+eaipRouter_t router;
+
+void routeMessage(char *topic, char *message) {
+    eaipRouterDispatch(&router, topic, message);
+}
+
+int calls = 0;
+topic_t receivedType;
+char receivedDataId[32];
+char *receivedMessage = NULL;
+void *receivedUserData = NULL;
+void recordMessage(const eaipTopicView_t *topic, char *message, void *userData) {
+    calls++;
+    receivedType = topic->type;
+    memcpy(receivedDataId, topic->dataId.data, topic->dataId.length);
+    receivedDataId[topic->dataId.length] = '\0';
+    receivedMessage = message;
+    receivedUserData = userData;
+}
+
+static void assertViewEquals(const char *expected, eaipStringView_t view) {
+    TEST_ASSERT_EQUAL(strlen(expected), view.length);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY(expected, view.data, view.length);
+}
+/* endregion TEST RUNTIME */
+
+void test_decodeDataTopic() {
+    char topic[] = BASE_URL "/other-dev/DATA/light";
+    eaipTopicView_t view;
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipDecodeTopic(&session, topic, strlen(topic), &view));
+
+    assertViewEquals("other-dev", view.deviceId);
+    TEST_ASSERT_EQUAL(DATA, view.type);
+    assertViewEquals("light", view.dataId);
+}
+void test_decodeStatusTopic() {
+    char topic[] = BASE_URL "/other-dev/STATUS";
+    eaipTopicView_t view;
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipDecodeTopic(&session, topic, strlen(topic), &view));
+
+    assertViewEquals("other-dev", view.deviceId);
+    TEST_ASSERT_EQUAL(STATUS, view.type);
+    TEST_ASSERT_EQUAL(0, view.dataId.length);
+}
+void test_decodeDistinguishesSimilarTypes() {
+    char start[] = BASE_URL "/dev/START/x";
+    char stop[] = BASE_URL "/dev/STOP/x";
+    char done[] = BASE_URL "/dev/DONE/x";
+    char doCommand[] = BASE_URL "/dev/DO/x";
+    eaipTopicView_t view;
+
+    eaipDecodeTopic(&session, start, strlen(start), &view);
+    TEST_ASSERT_EQUAL(START, view.type);
+    eaipDecodeTopic(&session, stop, strlen(stop), &view);
+    TEST_ASSERT_EQUAL(STOP, view.type);
+    eaipDecodeTopic(&session, done, strlen(done), &view);
+    TEST_ASSERT_EQUAL(DONE, view.type);
+    eaipDecodeTopic(&session, doCommand, strlen(doCommand), &view);
+    TEST_ASSERT_EQUAL(DO, view.type);
+}
+void test_decodeRejectsInvalidTopics() {
+    char *topics[] = {
+        "eaip://other-net/dev/DATA/x", BASE_URL "/dev/UNKNOWN/x", BASE_URL "/dev/DATA",
+        BASE_URL "/dev/DATA/",         BASE_URL "/dev/STATUS/x",  BASE_URL "//DATA/x",
+        BASE_URL "/dev",
+    };
+    eaipTopicView_t view;
+
+    for (size_t index = 0; index < sizeof(topics) / sizeof(topics[0]); index++) {
+        TEST_ASSERT_EQUAL(EAIP_COM_INVALID_TOPIC,
+                          eaipDecodeTopic(&session, topics[index], strlen(topics[index]), &view));
+    }
+}
+
+void test_routerSubscribesOnce() {
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipRouterSubscribe(&router, &routeMessage));
+
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID "/#", subscriptions->subscription->topic);
+    TEST_ASSERT_NULL(subscriptions->next);
+}
+void test_routerDispatchesToRegisteredHandler() {
+    int userData = 42;
+    eaipRouterRegister(&router, START, "light", &recordMessage, &userData);
+    eaipRouterRegister(&router, STOP, "light", &recordMessage, NULL);
+    eaipRouterSubscribe(&router, &routeMessage);
+
+    eaipPubRequest_t request = {.deviceId = DEVICE_ID, .dataId = "light"};
+    eaipSessionPublishStart(&session, request);
+
+    TEST_ASSERT_EQUAL(1, calls);
+    TEST_ASSERT_EQUAL(START, receivedType);
+    TEST_ASSERT_EQUAL_STRING("light", receivedDataId);
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID, receivedMessage);
+    TEST_ASSERT_EQUAL_PTR(&userData, receivedUserData);
+}
+void test_routerIgnoresUnregisteredMessages() {
+    eaipRouterRegister(&router, DO, "reset", &recordMessage, NULL);
+    eaipRouterSubscribe(&router, &routeMessage);
+
+    eaipPubRequest_t request = {.deviceId = DEVICE_ID, .dataId = "measure", .data = "now"};
+    eaipSessionPublishDo(&session, request);
+
+    TEST_ASSERT_EQUAL(0, calls);
+}
+void test_routerRejectsDuplicateRoute() {
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                      eaipRouterRegister(&router, DO, "reset", &recordMessage, NULL));
+    TEST_ASSERT_EQUAL(EAIP_COM_TOPIC_ALREADY_SUBSCRIBED,
+                      eaipRouterRegister(&router, DO, "reset", &recordMessage, NULL));
+}
+void test_routerRejectsRoutesBeyondCapacity() {
+    char dataId[16];
+    for (int index = 0; index < 16; index++) {
+        sprintf(dataId, "source-%d", index);
+        TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                          eaipRouterRegister(&router, START, dataId, &recordMessage, NULL));
+    }
+    TEST_ASSERT_EQUAL(EAIP_COM_OUT_OF_MEMORY,
+                      eaipRouterRegister(&router, STOP, "source-0", &recordMessage, NULL));
+}
+void test_routerUnregisterKeepsOtherRoutes() {
+    char dataId[16];
+    for (int index = 0; index < 16; index++) {
+        sprintf(dataId, "source-%d", index);
+        eaipRouterRegister(&router, START, dataId, &recordMessage, NULL);
+    }
+    for (int index = 0; index < 16; index += 2) {
+        sprintf(dataId, "source-%d", index);
+        eaipRouterUnregister(&router, START, dataId);
+    }
+    TEST_ASSERT_EQUAL(8, router.count);
+
+    for (int index = 0; index < 16; index++) {
+        char topic[64];
+        sprintf(topic, BASE_URL "/" DEVICE_ID "/START/source-%d", index);
+        TEST_ASSERT_EQUAL(index % 2 == 1, eaipRouterDispatch(&router, topic, "requester"));
+    }
+}
+void test_routerDispatchesStatus() {
+    eaipRouterRegister(&router, STATUS, NULL, &recordMessage, NULL);
+    eaipRouterSubscribe(&router, &routeMessage);
+
+    eaipDeviceState_t state = {.deviceState = ONLINE, .deviceType = NODE};
+    eaipSessionPublishStatus(&session, state);
+
+    TEST_ASSERT_EQUAL(1, calls);
+    TEST_ASSERT_EQUAL(STATUS, receivedType);
+}
+
+void setUp() {
+    calls = 0;
+    receivedMessage = NULL;
+    receivedUserData = NULL;
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionInit(&session, config));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipRouterInit(&router, &session, 16));
+}
+
+void tearDown() {
+    eaipRouterFree(&router);
+    eaipSessionFree(&session);
+    resetSubscriptions();
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_decodeDataTopic);
+    RUN_TEST(test_decodeStatusTopic);
+    RUN_TEST(test_decodeDistinguishesSimilarTypes);
+    RUN_TEST(test_decodeRejectsInvalidTopics);
+
+    RUN_TEST(test_routerSubscribesOnce);
+    RUN_TEST(test_routerDispatchesToRegisteredHandler);
+    RUN_TEST(test_routerIgnoresUnregisteredMessages);
+    RUN_TEST(test_routerRejectsDuplicateRoute);
+    RUN_TEST(test_routerRejectsRoutesBeyondCapacity);
+    RUN_TEST(test_routerUnregisterKeepsOtherRoutes);
+    RUN_TEST(test_routerDispatchesStatus);
+
+    return UNITY_END();
+}
@@ -0,0 +1,164 @@
+#include <stdbool.h>
+#include <string.h>
+
+#include "eaip/protocol/Outbox.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Scheduler.h"
+#include "unity.h"
+
+/* together with a topic of 15 characters a quarter of `EAIP_SCHEDULER_QUANTUM` */
+#define MESSAGE "0123456789012345678901234567890123456789012345678"
+
+/* region TEST RUNTIME */
+eaipScheduler_t scheduler;
+size_t sensors;
+size_t logs;
+
+char publishedTopics[64][32];
+size_t published = 0;
+bool publishFails = false;
+bool injectControl = false;
+
+eaipCommunicationErrorCodes recordPublish(char *topic, __attribute__((unused)) char *message,
+                                          __attribute__((unused)) bool retain) {
+    if (publishFails) {
+        return EAIP_COM_BROKER_NOT_REACHABLE;
+    }
+    if (published < 64) {
+        strcpy(publishedTopics[published], topic);
+    }
+    published++;
+
+    if (injectControl) {
+        /* a control message arriving while bulk data is transmitted */
+        injectControl = false;
+        eaipSchedulerPublishControl(&scheduler, "dev/DO/stop", "", false);
+    }
+    return EAIP_COM_NO_ERROR;
+}
+
+eaiProtocol_t config = {.publish = &recordPublish};
+
+static size_t countPublished(const char *topic) {
+    size_t count = 0;
+    for (size_t index = 0; index < published && index < 64; index++) {
+        count += 0 == strcmp(publishedTopics[index], topic);
+    }
+    return count;
+}
+/* endregion TEST RUNTIME */
+
+void test_controlMessagesPublishedFirst() {
+    eaipSchedulerPublishBulk(&scheduler, sensors, "dev/DATA/a", "1");
+    eaipSchedulerPublishBulk(&scheduler, sensors, "dev/DATA/a", "2");
+    eaipSchedulerPublishControl(&scheduler, "dev/STATUS", "ONLINE", true);
+
+    TEST_ASSERT_EQUAL(1, eaipSchedulerDrain(&scheduler, 1));
+    TEST_ASSERT_EQUAL_STRING("dev/STATUS", publishedTopics[0]);
+    TEST_ASSERT_EQUAL(2, eaipSchedulerDrain(&scheduler, 8));
+}
+
+void test_controlMessagePreemptsQueuedBulk() {
+    for (int index = 0; index < 4; index++) {
+        eaipSchedulerPublishBulk(&scheduler, sensors, "dev/DATA/a", "1");
+    }
+    injectControl = true;
+
+    TEST_ASSERT_EQUAL(5, eaipSchedulerDrain(&scheduler, 8));
+    TEST_ASSERT_EQUAL_STRING("dev/DATA/a", publishedTopics[0]);
+    TEST_ASSERT_EQUAL_STRING("dev/DO/stop", publishedTopics[1]);
+}
+
+void test_bulkLanesShareByWeight() {
+    for (int index = 0; index < 30; index++) {
+        eaipSchedulerPublishBulk(&scheduler, sensors, "dev/DATA/sensor", MESSAGE);
+        eaipSchedulerPublishBulk(&scheduler, logs, "dev/DATA/logsss", MESSAGE);
+    }
+
+    TEST_ASSERT_EQUAL(32, eaipSchedulerDrain(&scheduler, 32));
+    TEST_ASSERT_EQUAL(24, countPublished("dev/DATA/sensor"));
+    TEST_ASSERT_EQUAL(8, countPublished("dev/DATA/logsss"));
+}
+
+void test_idleLaneDoesNotSaveUpShare() {
+    for (int index = 0; index < 30; index++) {
+        eaipSchedulerPublishBulk(&scheduler, sensors, "dev/DATA/sensor", MESSAGE);
+    }
+    TEST_ASSERT_EQUAL(30, eaipSchedulerDrain(&scheduler, 30));
+
+    published = 0;
+    for (int index = 0; index < 30; index++) {
+        eaipSchedulerPublishBulk(&scheduler, sensors, "dev/DATA/sensor", MESSAGE);
+        eaipSchedulerPublishBulk(&scheduler, logs, "dev/DATA/logsss", MESSAGE);
+    }
+    TEST_ASSERT_EQUAL(16, eaipSchedulerDrain(&scheduler, 16));
+    TEST_ASSERT_EQUAL(4, countPublished("dev/DATA/logsss"));
+}
+
+void test_drainStopsOnFailingTransport() {
+    eaipSchedulerPublishControl(&scheduler, "dev/STATUS", "ONLINE", true);
+    eaipSchedulerPublishBulk(&scheduler, sensors, "dev/DATA/a", "1");
+
+    publishFails = true;
+    TEST_ASSERT_EQUAL(0, eaipSchedulerDrain(&scheduler, 8));
+    publishFails = false;
+
+    TEST_ASSERT_EQUAL(2, eaipSchedulerDrain(&scheduler, 8));
+    TEST_ASSERT_EQUAL_STRING("dev/STATUS", publishedTopics[0]);
+}
+
+void test_emptySchedulerPublishesNothing() {
+    TEST_ASSERT_EQUAL(0, eaipSchedulerDrain(&scheduler, 8));
+}
+
+void test_bulkLanesBeyondMaximumFail() {
+    size_t lane;
+    for (size_t index = 2; index < EAIP_SCHEDULER_BULK_LANES; index++) {
+        TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                          eaipSchedulerAddBulkLane(&scheduler, 4, 1, EAIP_OVERFLOW_BLOCK, &lane));
+    }
+    TEST_ASSERT_EQUAL(EAIP_COM_OUT_OF_MEMORY,
+                      eaipSchedulerAddBulkLane(&scheduler, 4, 1, EAIP_OVERFLOW_BLOCK, &lane));
+}
+
+void test_publishToUnknownLaneFails() {
+    eaipPubRequest_t request = {.dataId = "a", .data = "1"};
+    TEST_ASSERT_EQUAL(EAIP_COM_GENERIC_ERROR,
+                      eaipSchedulerPublishBulk(&scheduler, logs + 1, "dev/DATA/a", "1"));
+    TEST_ASSERT_EQUAL(EAIP_COM_GENERIC_ERROR,
+                      eaipSchedulerPublishData(&scheduler, logs + 1, NULL, request));
+    TEST_ASSERT_EQUAL(0, eaipSchedulerDrain(&scheduler, 8));
+}
+
+void setUp() {
+    published = 0;
+    publishFails = false;
+    injectControl = false;
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                      eaipSchedulerInit(&scheduler, config, 8, EAIP_OUTBOX_RECORD_SIZE));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSchedulerAddBulkLane(&scheduler, 64, 3,
+                                                                  EAIP_OVERFLOW_DROP_OLDEST,
+                                                                  &sensors));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSchedulerAddBulkLane(&scheduler, 64, 1,
+                                                                  EAIP_OVERFLOW_DROP_NEWEST,
+                                                                  &logs));
+}
+
+void tearDown() {
+    eaipSchedulerFree(&scheduler);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_controlMessagesPublishedFirst);
+    RUN_TEST(test_controlMessagePreemptsQueuedBulk);
+    RUN_TEST(test_bulkLanesShareByWeight);
+    RUN_TEST(test_idleLaneDoesNotSaveUpShare);
+    RUN_TEST(test_drainStopsOnFailingTransport);
+    RUN_TEST(test_emptySchedulerPublishesNothing);
+    RUN_TEST(test_bulkLanesBeyondMaximumFail);
+    RUN_TEST(test_publishToUnknownLaneFails);
+
+    return UNITY_END();
+}
@@ -0,0 +1,353 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/brokerMock/Broker.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Session.h"
+#include "unity.h"
+
+#define BASE_URL "eaip://local-net"
+#define DEVICE_ID "test-dev"
+
+/* region TEST RUNTIME */
+eaiProtocol_t config = {
+    .subscribe = &subscribe,
+    .unsubscribe = &unsubscribe,
+    .publish = &publish,
+    .publishBinary = &publishBinary,
+    .subscribeBinary = &subscribeBinary,
+    .baseUrl = BASE_URL,
+    .deviceId = DEVICE_ID,
+};
+eaipSession_t session;
+
+char *receivedTopic = NULL;
+char *receivedData = NULL;
+void validateTopic(char *topic, char *data) {
+    receivedTopic = calloc(strlen(topic) + 1, sizeof(char));
+    strcpy(receivedTopic, topic);
+    receivedData = calloc(strlen(data) + 1, sizeof(char));
+    strcpy(receivedData, data);
+}
+
+uint8_t receivedPayload[64];
+size_t receivedLength = 0;
+void validatePayload(char *topic, const uint8_t *payload, size_t length) {
+    receivedTopic = calloc(strlen(topic) + 1, sizeof(char));
+    strcpy(receivedTopic, topic);
+    memcpy(receivedPayload, payload, length);
+    receivedLength = length;
+}
+
+size_t receivedCount = 0;
+char lastMessage[128];
+void countMessages(__attribute__((unused)) char *topic, char *data) {
+    receivedCount++;
+    strncpy(lastMessage, data, sizeof(lastMessage) - 1);
+}
+/* endregion TEST RUNTIME */
+
+void test_sessionInitPrecomputesPrefixes() {
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID, session.requester);
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID "/STATUS", session.prefixes[STATUS]);
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID "/DATA/", session.prefixes[DATA]);
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID "/DONE/", session.prefixes[DONE]);
+    TEST_ASSERT_EQUAL(strlen(BASE_URL "/"), session.baseUrlLength);
+}
+
+void test_publishStatusCorrect() {
+    char expectedTopic[] = BASE_URL "/" DEVICE_ID "/STATUS";
+    char expectedMessage[] = "ID:" DEVICE_ID ";TYPE:enV5;STATE:ONLINE;";
+    subscribe(expectedTopic, &validateTopic);
+
+    eaipDeviceState_t state = {.deviceState = ONLINE, .deviceType = NODE};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionPublishStatus(&session, state));
+
+    TEST_ASSERT_EQUAL_STRING(expectedTopic, receivedTopic);
+    TEST_ASSERT_EQUAL_STRING(expectedMessage, receivedData);
+}
+
+void test_publishUnchangedStatusSkipped() {
+    subscribe(BASE_URL "/" DEVICE_ID "/STATUS", &countMessages);
+    receivedCount = 0;
+
+    eaipDeviceState_t state = {.deviceState = ONLINE, .deviceType = NODE};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionPublishStatus(&session, state));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionPublishStatus(&session, state));
+    TEST_ASSERT_EQUAL(1, receivedCount);
+
+    state.deviceState = OFFLINE;
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionPublishStatus(&session, state));
+    TEST_ASSERT_EQUAL(2, receivedCount);
+
+    eaipSessionInvalidateStatus(&session);
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionPublishStatus(&session, state));
+    TEST_ASSERT_EQUAL(3, receivedCount);
+}
+
+void test_updateStatusFieldRepublishesOnChange() {
+    subscribe(BASE_URL "/" DEVICE_ID "/STATUS", &countMessages);
+    receivedCount = 0;
+
+    eaipStateDataField_t field = {.id = "DATA", .data = "a"};
+    eaipDeviceState_t state = {
+        .deviceState = ONLINE, .deviceType = NODE, .additionalFields = &field};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionPublishStatus(&session, state));
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                      eaipSessionUpdateStatusField(&session, state, "DATA", "a"));
+    TEST_ASSERT_EQUAL(1, receivedCount);
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                      eaipSessionUpdateStatusField(&session, state, "DATA", "a,b"));
+    TEST_ASSERT_EQUAL(2, receivedCount);
+    TEST_ASSERT_EQUAL_STRING("ID:" DEVICE_ID ";TYPE:enV5;STATE:ONLINE;DATA:a,b;", lastMessage);
+
+    TEST_ASSERT_EQUAL(EAIP_COM_INVALID_MESSAGE,
+                      eaipSessionUpdateStatusField(&session, state, "MISSING", "x"));
+    TEST_ASSERT_EQUAL(2, receivedCount);
+}
+
+void test_publishDataCorrect() {
+    char expectedTopic[] = BASE_URL "/" DEVICE_ID "/DATA/test-top";
+    subscribe(expectedTopic, &validateTopic);
+
+    eaipPubRequest_t data = {.dataId = "test-top", .data = "0.231F"};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionPublishData(&session, data));
+
+    TEST_ASSERT_EQUAL_STRING(expectedTopic, receivedTopic);
+    TEST_ASSERT_EQUAL_STRING("0.231F", receivedData);
+}
+
+#ifndef EAIP_STACK_BOUNDED
+void test_publishDataVectorExceedingScratchBufferCorrect() {
+    char expectedTopic[] = BASE_URL "/" DEVICE_ID "/DATA/test-top";
+    subscribe(expectedTopic, &validateTopic);
+
+    float values[EAIP_DATA_BUFFER_SIZE / 4];
+    for (size_t index = 0; index < EAIP_DATA_BUFFER_SIZE / 4; index++) {
+        values[index] = -1.25f;
+    }
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionPublishDataVector(&session, "test-top", values,
+                                                                      EAIP_DATA_BUFFER_SIZE / 4));
+
+    float parsed[EAIP_DATA_BUFFER_SIZE / 4];
+    size_t count = 0;
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                      eaipParseDataVector(receivedData, strlen(receivedData), parsed,
+                                          EAIP_DATA_BUFFER_SIZE / 4, &count));
+    TEST_ASSERT_EQUAL(EAIP_DATA_BUFFER_SIZE / 4, count);
+    TEST_ASSERT_EQUAL_MEMORY(values, parsed, sizeof(values));
+}
+#endif
+
+void test_publishDataFloatArrayRoundtrip() {
+    char expectedTopic[] = BASE_URL "/" DEVICE_ID "/DATA/test-top";
+    eaipSubRequest_t request = {
+        .targetId = DEVICE_ID, .dataId = "test-top", .binaryHandler = &validatePayload};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionSubscribeDataBinary(&session, request));
+
+    float values[] = {0.0f, -1.5f, 3.25f, 1e-3f};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                      eaipSessionPublishDataFloatArray(&session, "test-top", values, 4));
+
+    TEST_ASSERT_EQUAL_STRING(expectedTopic, receivedTopic);
+    TEST_ASSERT_EQUAL_size_t(sizeof(values), receivedLength);
+    float received[4];
+    memcpy(received, receivedPayload, sizeof(received));
+    TEST_ASSERT_EQUAL_FLOAT_ARRAY(values, received, 4);
+}
+
+void test_publishDataInt16ArrayRoundtrip() {
+    eaipSubRequest_t request = {
+        .targetId = DEVICE_ID, .dataId = "test-top", .binaryHandler = &validatePayload};
+    eaipSessionSubscribeDataBinary(&session, request);
+
+    int16_t values[] = {0, -1, 256, INT16_MAX};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                      eaipSessionPublishDataInt16Array(&session, "test-top", values, 4));
+
+    TEST_ASSERT_EQUAL_size_t(sizeof(values), receivedLength);
+    int16_t received[4];
+    memcpy(received, receivedPayload, sizeof(received));
+    TEST_ASSERT_EQUAL_INT16_ARRAY(values, received, 4);
+}
+
+void test_publishDataBinaryWithoutSupportFails() {
+    eaipSession_t textOnly;
+    eaiProtocol_t textConfig = config;
+    textConfig.publishBinary = NULL;
+    eaipSessionInit(&textOnly, textConfig);
+
+    float value = 1.0f;
+    TEST_ASSERT_EQUAL(EAIP_COM_NOT_SUPPORTED,
+                      eaipSessionPublishDataFloatArray(&textOnly, "test-top", &value, 1));
+
+    eaipSessionFree(&textOnly);
+}
+
+void test_publishStartRequestCorrect() {
+    char expectedTopic[] = BASE_URL "/test-receiver/START/test-top";
+    subscribe(expectedTopic, &validateTopic);
+
+    eaipPubRequest_t data = {.deviceId = "test-receiver", .dataId = "test-top"};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionPublishStart(&session, data));
+
+    TEST_ASSERT_EQUAL_STRING(expectedTopic, receivedTopic);
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID, receivedData);
+}
+
+void test_publishStopRequestCorrect() {
+    char expectedTopic[] = BASE_URL "/test-receiver/STOP/test-top";
+    subscribe(expectedTopic, &validateTopic);
+
+    eaipPubRequest_t data = {.deviceId = "test-receiver", .dataId = "test-top"};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionPublishStop(&session, data));
+
+    TEST_ASSERT_EQUAL_STRING(expectedTopic, receivedTopic);
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID, receivedData);
+}
+
+void test_publishDoRequestCorrect() {
+    char expectedTopic[] = BASE_URL "/test-receiver/DO/test-com";
+    subscribe(expectedTopic, &validateTopic);
+
+    eaipPubRequest_t data = {.deviceId = "test-receiver", .dataId = "test-com", .data = "settings"};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionPublishDo(&session, data));
+
+    TEST_ASSERT_EQUAL_STRING(expectedTopic, receivedTopic);
+    TEST_ASSERT_EQUAL_STRING("settings", receivedData);
+}
+
+void test_publishDoneMessageCorrect() {
+    char expectedTopic[] = BASE_URL "/" DEVICE_ID "/DONE/test-com";
+    subscribe(expectedTopic, &validateTopic);
+
+    eaipPubRequest_t data = {.dataId = "test-com", .data = "result"};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionPublishDone(&session, data));
+
+    TEST_ASSERT_EQUAL_STRING(expectedTopic, receivedTopic);
+    TEST_ASSERT_EQUAL_STRING("result", receivedData);
+}
+
+void test_subscribeStatusTopicCorrect() {
+    eaipSubRequest_t request = {.targetId = "test-device", .handler = &validateTopic};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionSubscribeStatus(&session, request));
+
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/test-device/STATUS", subscriptions->subscription->topic);
+    TEST_ASSERT_EQUAL_PTR(&validateTopic, subscriptions->subscription->handle);
+}
+
+void test_subscribeDataTopicCorrect() {
+    eaipSubRequest_t request = {.targetId = "test-device", .dataId = "test-data"};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionSubscribeData(&session, request));
+
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/test-device/DATA/test-data",
+                             subscriptions->subscription->topic);
+}
+
+void test_subscribeStartTopicCorrect() {
+    eaipSubRequest_t request = {.dataId = "test-data"};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionSubscribeStart(&session, request));
+
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID "/START/test-data",
+                             subscriptions->subscription->topic);
+}
+
+void test_subscribeStopTopicCorrect() {
+    eaipSubRequest_t request = {.dataId = "test-data"};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionSubscribeStop(&session, request));
+
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID "/STOP/test-data",
+                             subscriptions->subscription->topic);
+}
+
+void test_subscribeDoTopicCorrect() {
+    eaipSubRequest_t request = {.dataId = "test-cmd"};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionSubscribeDo(&session, request));
+
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID "/DO/test-cmd",
+                             subscriptions->subscription->topic);
+}
+
+void test_subscribeDoneTopicCorrect() {
+    eaipSubRequest_t request = {.targetId = "test-device", .dataId = "test-cmd"};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionSubscribeDone(&session, request));
+
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/test-device/DONE/test-cmd",
+                             subscriptions->subscription->topic);
+}
+
+void test_unsubscribeRemovesMatchingTopics() {
+    eaipSubRequest_t foreign = {.targetId = "test-device", .dataId = "test-data"};
+    eaipSubRequest_t own = {.dataId = "test-data"};
+
+    eaipSessionSubscribeStatus(&session, foreign);
+    eaipSessionSubscribeData(&session, foreign);
+    eaipSessionSubscribeDone(&session, foreign);
+    eaipSessionSubscribeStart(&session, own);
+    eaipSessionSubscribeStop(&session, own);
+    eaipSessionSubscribeDo(&session, own);
+    TEST_ASSERT_NOT_NULL(subscriptions);
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionUnsubscribeStatus(&session, foreign));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionUnsubscribeData(&session, foreign));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionUnsubscribeDone(&session, foreign));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionUnsubscribeStart(&session, own));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionUnsubscribeStop(&session, own));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionUnsubscribeDo(&session, own));
+    TEST_ASSERT_NULL(subscriptions);
+}
+
+void setUp() {
+    TEST_ASSERT_NULL(subscriptions);
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionInit(&session, config));
+}
+
+void tearDown() {
+    if (receivedTopic != NULL) {
+        free(receivedTopic);
+        receivedTopic = NULL;
+    }
+
+    if (receivedData != NULL) {
+        free(receivedData);
+        receivedData = NULL;
+    }
+
+    eaipSessionFree(&session);
+    resetSubscriptions();
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sessionInitPrecomputesPrefixes);
+
+    RUN_TEST(test_publishStatusCorrect);
+    RUN_TEST(test_publishUnchangedStatusSkipped);
+    RUN_TEST(test_updateStatusFieldRepublishesOnChange);
+    RUN_TEST(test_publishDataCorrect);
+#ifndef EAIP_STACK_BOUNDED
+    RUN_TEST(test_publishDataVectorExceedingScratchBufferCorrect);
+#endif
+    RUN_TEST(test_publishDataFloatArrayRoundtrip);
+    RUN_TEST(test_publishDataInt16ArrayRoundtrip);
+    RUN_TEST(test_publishDataBinaryWithoutSupportFails);
+    RUN_TEST(test_publishStartRequestCorrect);
+    RUN_TEST(test_publishStopRequestCorrect);
+    RUN_TEST(test_publishDoRequestCorrect);
+    RUN_TEST(test_publishDoneMessageCorrect);
+
+    RUN_TEST(test_subscribeStatusTopicCorrect);
+    RUN_TEST(test_subscribeDataTopicCorrect);
+    RUN_TEST(test_subscribeStartTopicCorrect);
+    RUN_TEST(test_subscribeStopTopicCorrect);
+    RUN_TEST(test_subscribeDoTopicCorrect);
+    RUN_TEST(test_subscribeDoneTopicCorrect);
+
+    RUN_TEST(test_unsubscribeRemovesMatchingTopics);
+
+    return UNITY_END();
+}
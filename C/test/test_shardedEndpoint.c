@@ -0,0 +1,226 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/brokerMock/Broker.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/ShardedEndpoint.h"
+#include "unity.h"
+
+#define BASE_URL "eaip://local-net"
+#define SHARDS 4
+#define STREAMS 8
+#define MESSAGES_PER_STREAM 32
+
+/* region TEST RUNTIME */
+
+/*! @brief connection of a sharded endpoint, counting the calls forwarded to it */
+typedef struct countingShard {
+    brokerClient_t *client;
+    size_t published;
+    size_t subscribed;
+} countingShard_t;
+
+static eaipCommunicationErrorCodes countPublish(void *context, char *topic, char *data,
+                                                bool retain) {
+    countingShard_t *shard = context;
+    shard->published++;
+    return brokerEndpointInterface.publish(shard->client, topic, data, retain);
+}
+
+static eaipCommunicationErrorCodes countSubscribe(void *context, char *topic,
+                                                  void (*handle)(char *topic, char *message)) {
+    countingShard_t *shard = context;
+    shard->subscribed++;
+    return brokerEndpointInterface.subscribe(shard->client, topic, handle);
+}
+
+static eaipCommunicationErrorCodes countUnsubscribe(void *context, char *topic) {
+    countingShard_t *shard = context;
+    shard->subscribed--;
+    return brokerEndpointInterface.unsubscribe(shard->client, topic);
+}
+
+/* without binary variants, like a transport that only carries text */
+const eaipEndpointInterface_t countingInterface = {
+    .publish = &countPublish,
+    .subscribe = &countSubscribe,
+    .unsubscribe = &countUnsubscribe,
+};
+
+broker_t broker;
+brokerClient_t *monitor;
+countingShard_t connections[SHARDS];
+eaipEndpoint_t shards[SHARDS];
+eaipShardedEndpoint_t sharded;
+eaiProtocol_t config = {
+    .baseUrl = BASE_URL,
+    .deviceId = "gateway",
+    .endpoint = {&eaipShardedEndpointInterface, &sharded},
+};
+
+char receivedTopics[STREAMS * MESSAGES_PER_STREAM][64];
+int receivedValues[STREAMS * MESSAGES_PER_STREAM];
+size_t receivedCount;
+
+static void recordMessage(__attribute__((unused)) brokerClient_t *client, char *topic,
+                          const uint8_t *payload, size_t length) {
+    TEST_ASSERT_LESS_THAN(STREAMS * MESSAGES_PER_STREAM, receivedCount);
+    char value[16] = {0};
+    memcpy(value, payload, length < sizeof(value) - 1 ? length : sizeof(value) - 1);
+    strcpy(receivedTopics[receivedCount], topic);
+    receivedValues[receivedCount++] = atoi(value);
+}
+
+static void countMessage(__attribute__((unused)) char *topic,
+                         __attribute__((unused)) char *message) {
+    receivedCount++;
+}
+
+/* endregion TEST RUNTIME */
+
+void test_initRejectsMissingShardsAndBaseUrl() {
+    eaipShardedEndpoint_t invalid;
+    TEST_ASSERT_EQUAL(EAIP_COM_GENERIC_ERROR,
+                      eaipShardedEndpointInit(&invalid, shards, 0, EAIP_SHARD_BY_TOPIC, NULL));
+    TEST_ASSERT_EQUAL(EAIP_COM_GENERIC_ERROR, eaipShardedEndpointInit(&invalid, shards, SHARDS,
+                                                                      EAIP_SHARD_BY_DEVICE, NULL));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR,
+                      eaipShardedEndpointInit(&invalid, shards, SHARDS, EAIP_SHARD_BY_TOPIC, NULL));
+}
+
+void test_topicsAreSpreadOverAllShards() {
+    size_t selected[SHARDS] = {0};
+    char topic[64];
+    for (size_t index = 0; index < 64; index++) {
+        snprintf(topic, sizeof(topic), BASE_URL "/gateway/DATA/sensor-%zu", index);
+        size_t shard = eaipShardedEndpointSelect(&sharded, topic);
+        TEST_ASSERT_LESS_THAN(SHARDS, shard);
+        TEST_ASSERT_EQUAL(shard, eaipShardedEndpointSelect(&sharded, topic));
+        selected[shard]++;
+    }
+    for (size_t shard = 0; shard < SHARDS; shard++) {
+        TEST_ASSERT_GREATER_THAN(0, selected[shard]);
+    }
+}
+
+void test_shardByDeviceKeepsDeviceOnOneShard() {
+    eaipShardedEndpoint_t byDevice;
+    eaipShardedEndpointInit(&byDevice, shards, SHARDS, EAIP_SHARD_BY_DEVICE, BASE_URL);
+    size_t shard = eaipShardedEndpointSelect(&byDevice, BASE_URL "/dev-1/STATUS");
+
+    TEST_ASSERT_EQUAL(shard, eaipShardedEndpointSelect(&byDevice, BASE_URL "/dev-1/DATA/a"));
+    TEST_ASSERT_EQUAL(shard, eaipShardedEndpointSelect(&byDevice, BASE_URL "/dev-1/DATA/b"));
+    TEST_ASSERT_EQUAL(shard, eaipShardedEndpointSelect(&byDevice, BASE_URL "/dev-1/DO/MEASURE"));
+
+    size_t selected[SHARDS] = {0};
+    char topic[64];
+    for (size_t index = 0; index < 64; index++) {
+        snprintf(topic, sizeof(topic), BASE_URL "/dev-%zu/STATUS", index);
+        selected[eaipShardedEndpointSelect(&byDevice, topic)]++;
+    }
+    for (size_t index = 0; index < SHARDS; index++) {
+        TEST_ASSERT_GREATER_THAN(0, selected[index]);
+    }
+}
+
+void test_shardByDeviceHashesTopicsOutsideBaseUrlCompletely() {
+    eaipShardedEndpoint_t byDevice;
+    eaipShardedEndpointInit(&byDevice, shards, SHARDS, EAIP_SHARD_BY_DEVICE, BASE_URL);
+    const char *outside[] = {"eaip://other-net/dev-1/STATUS", BASE_URL "x/dev-1/STATUS",
+                             "dev-1/STATUS", BASE_URL "/"};
+
+    for (size_t index = 0; index < sizeof(outside) / sizeof(outside[0]); index++) {
+        TEST_ASSERT_EQUAL(eaipShardedEndpointSelect(&sharded, outside[index]),
+                          eaipShardedEndpointSelect(&byDevice, outside[index]));
+    }
+}
+
+void test_publishDataIsFannedOutAndKeepsOrderPerTopic() {
+    brokerSubscribe(monitor, BASE_URL "/gateway/DATA/+", &recordMessage);
+
+    char dataId[16];
+    char value[16];
+    for (int message = 0; message < MESSAGES_PER_STREAM; message++) {
+        for (size_t stream = 0; stream < STREAMS; stream++) {
+            snprintf(dataId, sizeof(dataId), "sensor-%zu", stream);
+            snprintf(value, sizeof(value), "%d", message);
+            eaipPubRequest_t request = {.dataId = dataId, .data = value};
+            TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipPublishData(config, request));
+        }
+    }
+
+    TEST_ASSERT_EQUAL(STREAMS * MESSAGES_PER_STREAM, receivedCount);
+    size_t used = 0;
+    for (size_t shard = 0; shard < SHARDS; shard++) {
+        used += connections[shard].published > 0;
+    }
+    TEST_ASSERT_GREATER_THAN(1, used);
+    for (size_t stream = 0; stream < STREAMS; stream++) {
+        char topic[64];
+        int expected = 0;
+        snprintf(topic, sizeof(topic), BASE_URL "/gateway/DATA/sensor-%zu", stream);
+        for (size_t index = 0; index < receivedCount; index++) {
+            if (0 == strcmp(topic, receivedTopics[index])) {
+                TEST_ASSERT_EQUAL(expected++, receivedValues[index]);
+            }
+        }
+        TEST_ASSERT_EQUAL(MESSAGES_PER_STREAM, expected);
+    }
+}
+
+void test_unsubscribeReachesSubscribingShard() {
+    eaipSubRequest_t request = {.targetId = "dev-1", .dataId = "value", .handler = &countMessage};
+    char topic[] = BASE_URL "/dev-1/DATA/value";
+    size_t shard = eaipShardedEndpointSelect(&sharded, topic);
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSubscribeData(config, request));
+    TEST_ASSERT_EQUAL(1, connections[shard].subscribed);
+    brokerPublish(monitor, topic, (const uint8_t *)"1", 1, false);
+    TEST_ASSERT_EQUAL(1, receivedCount);
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipUnsubscribeData(config, request));
+    TEST_ASSERT_EQUAL(0, connections[shard].subscribed);
+    brokerPublish(monitor, topic, (const uint8_t *)"2", 1, false);
+    TEST_ASSERT_EQUAL(1, receivedCount);
+}
+
+void test_binaryIsNotSupportedWithoutShardSupport() {
+    eaipPubRequest_t request = {.dataId = "raw", .data = "\x01\x02", .length = 2};
+    TEST_ASSERT_EQUAL(EAIP_COM_NOT_SUPPORTED, eaipPublishDataBinary(config, request));
+}
+
+void setUp() {
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, brokerInit(&broker));
+    brokerConnect(&broker, "monitor", NULL, &monitor);
+    for (size_t index = 0; index < SHARDS; index++) {
+        char id[16];
+        snprintf(id, sizeof(id), "shard-%zu", index);
+        connections[index] = (countingShard_t){0};
+        brokerConnect(&broker, id, NULL, &connections[index].client);
+        shards[index] = (eaipEndpoint_t){&countingInterface, &connections[index]};
+    }
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipShardedEndpointInit(&sharded, shards, SHARDS,
+                                                                 EAIP_SHARD_BY_TOPIC, BASE_URL));
+    receivedCount = 0;
+}
+
+void tearDown() {
+    brokerFree(&broker);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_initRejectsMissingShardsAndBaseUrl);
+    RUN_TEST(test_topicsAreSpreadOverAllShards);
+    RUN_TEST(test_shardByDeviceKeepsDeviceOnOneShard);
+    RUN_TEST(test_shardByDeviceHashesTopicsOutsideBaseUrlCompletely);
+    RUN_TEST(test_publishDataIsFannedOutAndKeepsOrderPerTopic);
+    RUN_TEST(test_unsubscribeReachesSubscribingShard);
+    RUN_TEST(test_binaryIsNotSupportedWithoutShardSupport);
+
+    return UNITY_END();
+}
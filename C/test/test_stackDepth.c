@@ -0,0 +1,245 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <ucontext.h>
+
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Router.h"
+#include "eaip/protocol/Session.h"
+#include "eaip/protocol/StaticTopic.h"
+#include "unity.h"
+
+#define BASE_URL "eaip://local-net"
+#define DEVICE_ID "test-dev"
+#define DATA_ID "a-rather-long-data-id-as-used-by-some-of-our-sensors"
+
+/*!
+ * Stack depths are measured by running each call on a separate stack painted with a pattern and
+ * counting the bytes that were overwritten afterwards.
+ */
+#define STACK_SIZE (64 * 1024)
+#define STACK_PATTERN 0xA5
+
+/*! generous allowance for libc calls (`sprintf`, `strlen`) and the call frames themselves */
+#define STACK_BUDGET_OVERHEAD 3072
+#define STACK_BUDGET                                                                               \
+    (2 * (EAIP_MAX_TOPIC_LENGTH + 1) + EAIP_STATUS_BUFFER_SIZE + EAIP_DATA_BUFFER_SIZE +          \
+     STACK_BUDGET_OVERHEAD)
+
+/* region TEST RUNTIME */
+static eaipCommunicationErrorCodes stubPublish(__attribute__((unused)) char *topic,
+                                               __attribute__((unused)) char *message,
+                                               __attribute__((unused)) bool retain) {
+    return EAIP_COM_NO_ERROR;
+}
+static eaipCommunicationErrorCodes stubSubscribe(__attribute__((unused)) char *topic,
+                                                 __attribute__((unused))
+                                                 void (*handle)(char *topic, char *message)) {
+    return EAIP_COM_NO_ERROR;
+}
+static eaipCommunicationErrorCodes stubUnsubscribe(__attribute__((unused)) char *topic) {
+    return EAIP_COM_NO_ERROR;
+}
+static void stubHandler(__attribute__((unused)) char *topic,
+                        __attribute__((unused)) char *message) {}
+static void stubRouteHandler(__attribute__((unused)) const eaipTopicView_t *topic,
+                             __attribute__((unused)) char *message,
+                             __attribute__((unused)) void *userData) {}
+
+eaiProtocol_t config = {
+    .subscribe = &stubSubscribe,
+    .unsubscribe = &stubUnsubscribe,
+    .publish = &stubPublish,
+    .baseUrl = BASE_URL,
+    .deviceId = DEVICE_ID,
+};
+eaipSession_t session;
+eaipRouter_t router;
+
+eaipPubRequest_t pubRequest = {.deviceId = "test-device", .dataId = DATA_ID, .data = "0.231"};
+eaipSubRequest_t subRequest = {
+    .targetId = "test-device", .dataId = DATA_ID, .handler = &stubHandler};
+eaipDeviceState_t state = {.deviceState = ONLINE, .deviceType = NODE};
+float vector[32];
+
+static uint8_t stack[STACK_SIZE] __attribute__((aligned(16)));
+static ucontext_t callerContext;
+static ucontext_t measuredContext;
+static void (*measuredFunction)(void);
+
+static void runMeasuredFunction(void) {
+    measuredFunction();
+}
+
+static size_t measureStackDepth(void (*function)(void)) {
+    /* warm up: resolving lazily bound library symbols needs far more stack than the call itself */
+    function();
+    memset(stack, STACK_PATTERN, sizeof(stack));
+
+    getcontext(&measuredContext);
+    measuredContext.uc_stack.ss_sp = stack;
+    measuredContext.uc_stack.ss_size = sizeof(stack);
+    measuredContext.uc_link = &callerContext;
+    measuredFunction = function;
+    makecontext(&measuredContext, runMeasuredFunction, 0);
+    swapcontext(&callerContext, &measuredContext);
+
+    size_t untouched = 0;
+    while (untouched < sizeof(stack) && stack[untouched] == STACK_PATTERN) {
+        untouched++;
+    }
+    return sizeof(stack) - untouched;
+}
+/* endregion TEST RUNTIME */
+
+/* region MEASURED CALLS */
+static void callNothing(void) {}
+static void callPublishStatus(void) {
+    eaipPublishStatus(config, state);
+}
+static void callPublishData(void) {
+    eaipPublishData(config, pubRequest);
+}
+static void callPublishDataVector(void) {
+    eaipPublishDataVector(config, DATA_ID, vector, 32);
+}
+static void callPublishStart(void) {
+    eaipPublishStart(config, pubRequest);
+}
+static void callPublishDo(void) {
+    eaipPublishDo(config, pubRequest);
+}
+static void callSubscribeData(void) {
+    eaipSubscribeData(config, subRequest);
+}
+static void callUnsubscribeDone(void) {
+    eaipUnsubscribeDone(config, subRequest);
+}
+static void callSessionPublishStatus(void) {
+    eaipSessionInvalidateStatus(&session);
+    eaipSessionPublishStatus(&session, state);
+}
+static void callSessionPublishData(void) {
+    eaipSessionPublishData(&session, pubRequest);
+}
+static void callSessionPublishDataFloat(void) {
+    eaipSessionPublishDataFloat(&session, DATA_ID, 0.231f);
+}
+static void callSessionPublishStart(void) {
+    eaipSessionPublishStart(&session, pubRequest);
+}
+static void callSessionSubscribeDone(void) {
+    eaipSessionSubscribeDone(&session, subRequest);
+}
+static void callSessionUnsubscribeData(void) {
+    eaipSessionUnsubscribeData(&session, subRequest);
+}
+static void callPublishStatic(void) {
+    static const eaipStaticTopic_t topic = EAIP_STATIC_TOPIC(BASE_URL, DEVICE_ID, DATA, DATA_ID);
+    eaipPublishStatic(config, topic, "0.231", false);
+}
+static void callParseStatus(void) {
+    char message[] = "ID:test-dev;TYPE:enV5;STATE:ONLINE;DATA:a,b;";
+    eaipStatusField_t fields[4];
+    eaipStatusView_t status = {.additionalFields = fields, .additionalFieldsCapacity = 4};
+    eaipParseStatus(message, sizeof(message) - 1, &status);
+}
+static void callRouterDispatch(void) {
+    char topic[] = BASE_URL "/" DEVICE_ID "/DO/" DATA_ID;
+    eaipRouterDispatch(&router, topic, "42");
+}
+static void callRouterSubscribe(void) {
+    eaipRouterSubscribe(&router, &stubHandler);
+}
+
+typedef struct measuredCall {
+    const char *name;
+    void (*function)(void);
+} measuredCall_t;
+
+static const measuredCall_t measuredCalls[] = {
+    {"eaipPublishStatus", &callPublishStatus},
+    {"eaipPublishData", &callPublishData},
+    {"eaipPublishDataVector", &callPublishDataVector},
+    {"eaipPublishStart", &callPublishStart},
+    {"eaipPublishDo", &callPublishDo},
+    {"eaipSubscribeData", &callSubscribeData},
+    {"eaipUnsubscribeDone", &callUnsubscribeDone},
+    {"eaipSessionPublishStatus", &callSessionPublishStatus},
+    {"eaipSessionPublishData", &callSessionPublishData},
+    {"eaipSessionPublishDataFloat", &callSessionPublishDataFloat},
+    {"eaipSessionPublishStart", &callSessionPublishStart},
+    {"eaipSessionSubscribeDone", &callSessionSubscribeDone},
+    {"eaipSessionUnsubscribeData", &callSessionUnsubscribeData},
+    {"eaipPublishStatic", &callPublishStatic},
+    {"eaipParseStatus", &callParseStatus},
+    {"eaipRouterDispatch", &callRouterDispatch},
+    {"eaipRouterSubscribe", &callRouterSubscribe},
+};
+/* endregion MEASURED CALLS */
+
+void test_reportMaximumStackDepth() {
+    size_t baseline = measureStackDepth(&callNothing);
+    printf("stack depth baseline: %zu bytes\n", baseline);
+
+    for (size_t index = 0; index < sizeof(measuredCalls) / sizeof(measuredCalls[0]); index++) {
+        size_t depth = measureStackDepth(measuredCalls[index].function) - baseline;
+        printf("stack depth %-28s %6zu bytes\n", measuredCalls[index].name, depth);
+
+        TEST_ASSERT_LESS_THAN(STACK_SIZE - baseline, depth);
+#if defined(EAIP_STACK_BOUNDED) && !defined(__SANITIZE_ADDRESS__)
+        TEST_ASSERT_LESS_OR_EQUAL(STACK_BUDGET, depth);
+#endif
+    }
+}
+
+#ifdef EAIP_STACK_BOUNDED
+void test_boundedTopicExceedingLimitFails() {
+    char dataId[EAIP_MAX_TOPIC_LENGTH + 1];
+    memset(dataId, 'x', sizeof(dataId) - 1);
+    dataId[sizeof(dataId) - 1] = '\0';
+
+    eaipPubRequest_t request = {.deviceId = "test-device", .dataId = dataId, .data = "1"};
+    TEST_ASSERT_EQUAL(EAIP_COM_TOPIC_TO_LONG, eaipPublishData(config, request));
+    TEST_ASSERT_EQUAL(EAIP_COM_TOPIC_TO_LONG, eaipSessionPublishData(&session, request));
+    TEST_ASSERT_EQUAL(EAIP_COM_TOPIC_TO_LONG, eaipSessionPublishDo(&session, request));
+}
+
+void test_boundedStatusExceedingScratchBufferFails() {
+    char data[EAIP_STATUS_BUFFER_SIZE];
+    memset(data, 'x', sizeof(data) - 1);
+    data[sizeof(data) - 1] = '\0';
+    eaipStateDataField_t field = {.id = "DATA", .data = data};
+    eaipDeviceState_t extended = {
+        .deviceState = ONLINE, .deviceType = NODE, .additionalFields = &field};
+
+    TEST_ASSERT_EQUAL(EAIP_COM_MESSAGE_TO_LONG, eaipPublishStatus(config, extended));
+    TEST_ASSERT_EQUAL(EAIP_COM_MESSAGE_TO_LONG, eaipSessionPublishStatus(&session, extended));
+}
+#endif
+
+void setUp() {
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSessionInit(&session, config));
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipRouterInit(&router, &session, 4));
+    eaipRouterRegister(&router, DO, DATA_ID, &stubRouteHandler, NULL);
+    for (size_t index = 0; index < 32; index++) {
+        vector[index] = -1.0f / (float)(index + 3);
+    }
+}
+
+void tearDown() {
+    eaipRouterFree(&router);
+    eaipSessionFree(&session);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_reportMaximumStackDepth);
+#ifdef EAIP_STACK_BOUNDED
+    RUN_TEST(test_boundedTopicExceedingLimitFails);
+    RUN_TEST(test_boundedStatusExceedingScratchBufferFails);
+#endif
+
+    return UNITY_END();
+}
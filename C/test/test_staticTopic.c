@@ -0,0 +1,110 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "eaip/brokerMock/Broker.h"
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/StaticTopic.h"
+#include "unity.h"
+
+#define BASE_URL "eaip://local-net"
+#define DEVICE_ID "test-dev"
+
+/* region TEST RUNTIME */
+eaiProtocol_t config = {
+    .subscribe = &subscribe,
+    .unsubscribe = &unsubscribe,
+    .publish = &publish,
+    .baseUrl = BASE_URL,
+    .deviceId = DEVICE_ID,
+};
+
+static const eaipStaticTopic_t statusTopic = EAIP_STATIC_STATUS_TOPIC(BASE_URL, DEVICE_ID);
+static const eaipStaticTopic_t dataTopic = EAIP_STATIC_TOPIC(BASE_URL, DEVICE_ID, DATA, "test-top");
+static const eaipStaticTopic_t startTopic =
+    EAIP_STATIC_TOPIC(BASE_URL, "test-device", START, "test-data");
+
+char *receivedTopic = NULL;
+char *receivedData = NULL;
+void validateTopic(char *topic, char *data) {
+    receivedTopic = calloc(strlen(topic) + 1, sizeof(char));
+    strcpy(receivedTopic, topic);
+    receivedData = calloc(strlen(data) + 1, sizeof(char));
+    strcpy(receivedData, data);
+}
+/* endregion TEST RUNTIME */
+
+void test_staticTopicsAreConstant() {
+    _Static_assert(sizeof(EAIP_TOPIC_LITERAL(BASE_URL, DEVICE_ID, DO, "cmd")) ==
+                       sizeof(BASE_URL "/" DEVICE_ID "/DO/cmd"),
+                   "topic literal has unexpected length");
+
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID "/STATUS", statusTopic.topic);
+    TEST_ASSERT_EQUAL(strlen(statusTopic.topic), statusTopic.length);
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID "/DATA/test-top", dataTopic.topic);
+    TEST_ASSERT_EQUAL(strlen(dataTopic.topic), dataTopic.length);
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/test-device/START/test-data", startTopic.topic);
+}
+
+void test_publishStaticMatchesRuntimeTopic() {
+    eaipSubRequest_t request = {
+        .targetId = DEVICE_ID, .dataId = "test-top", .handler = &validateTopic};
+    eaipSubscribeData(config, request);
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipPublishStatic(config, dataTopic, "0.231", false));
+
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID "/DATA/test-top", receivedTopic);
+    TEST_ASSERT_EQUAL_STRING("0.231", receivedData);
+}
+
+void test_publishStaticStartRequestCorrect() {
+    subscribe(BASE_URL "/test-device/START/test-data", &validateTopic);
+
+    eaipPublishStatic(config, startTopic, EAIP_REQUESTER_LITERAL(BASE_URL, DEVICE_ID), false);
+
+    TEST_ASSERT_EQUAL_STRING(BASE_URL "/" DEVICE_ID, receivedData);
+}
+
+void test_publishStatusStaticCorrect() {
+    subscribe(BASE_URL "/" DEVICE_ID "/STATUS", &validateTopic);
+
+    eaipDeviceState_t state = {.deviceState = ONLINE, .deviceType = NODE};
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipPublishStatusStatic(config, statusTopic, state));
+
+    TEST_ASSERT_EQUAL_STRING("ID:" DEVICE_ID ";TYPE:enV5;STATE:ONLINE;", receivedData);
+}
+
+void test_subscribeStaticAndUnsubscribeStatic() {
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipSubscribeStatic(config, dataTopic, &validateTopic));
+    TEST_ASSERT_EQUAL_STRING(dataTopic.topic, subscriptions->subscription->topic);
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipUnsubscribeStatic(config, dataTopic));
+    TEST_ASSERT_NULL(subscriptions);
+}
+
+void setUp() {}
+
+void tearDown() {
+    if (receivedTopic != NULL) {
+        free(receivedTopic);
+        receivedTopic = NULL;
+    }
+
+    if (receivedData != NULL) {
+        free(receivedData);
+        receivedData = NULL;
+    }
+
+    resetSubscriptions();
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_staticTopicsAreConstant);
+    RUN_TEST(test_publishStaticMatchesRuntimeTopic);
+    RUN_TEST(test_publishStaticStartRequestCorrect);
+    RUN_TEST(test_publishStatusStaticCorrect);
+    RUN_TEST(test_subscribeStaticAndUnsubscribeStatic);
+
+    return UNITY_END();
+}
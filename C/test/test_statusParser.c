@@ -0,0 +1,151 @@
+#include <stdbool.h>
+#include <string.h>
+
+#include "eaip/protocol/Protocol.h"
+#include "unity.h"
+
+#define DEVICE_ID "test-dev"
+
+eaipStatusField_t fields[4];
+eaipStatusView_t status;
+
+static void assertViewEquals(const char *expected, eaipStringView_t view) {
+    TEST_ASSERT_EQUAL(strlen(expected), view.length);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY(expected, view.data, view.length);
+}
+
+void test_iteratorYieldsFields() {
+    char message[] = "ID:" DEVICE_ID ";TYPE:enV5;;FLAG;";
+    eaipStatusIterator_t iterator;
+    eaipStatusField_t field;
+    eaipStatusIteratorInit(&iterator, message, strlen(message));
+
+    TEST_ASSERT_TRUE(eaipStatusIteratorNext(&iterator, &field));
+    assertViewEquals("ID", field.key);
+    assertViewEquals(DEVICE_ID, field.value);
+    TEST_ASSERT_TRUE(eaipStatusIteratorNext(&iterator, &field));
+    assertViewEquals("TYPE", field.key);
+    assertViewEquals("enV5", field.value);
+    TEST_ASSERT_TRUE(eaipStatusIteratorNext(&iterator, &field));
+    assertViewEquals("FLAG", field.key);
+    TEST_ASSERT_EQUAL(0, field.value.length);
+    TEST_ASSERT_FALSE(eaipStatusIteratorNext(&iterator, &field));
+}
+void test_iteratorKeepsColonsInValue() {
+    char message[] = "URL:eaip://local-net";
+    eaipStatusIterator_t iterator;
+    eaipStatusField_t field;
+    eaipStatusIteratorInit(&iterator, message, strlen(message));
+
+    TEST_ASSERT_TRUE(eaipStatusIteratorNext(&iterator, &field));
+    assertViewEquals("URL", field.key);
+    assertViewEquals("eaip://local-net", field.value);
+    TEST_ASSERT_FALSE(eaipStatusIteratorNext(&iterator, &field));
+}
+void test_iteratorRespectsLength() {
+    char message[] = "ID:a;TYPE:enV5;";
+    eaipStatusIterator_t iterator;
+    eaipStatusField_t field;
+    eaipStatusIteratorInit(&iterator, message, 4);
+
+    TEST_ASSERT_TRUE(eaipStatusIteratorNext(&iterator, &field));
+    assertViewEquals("a", field.value);
+    TEST_ASSERT_FALSE(eaipStatusIteratorNext(&iterator, &field));
+}
+
+void test_parseStandardStatus() {
+    char message[] = "ID:" DEVICE_ID ";TYPE:enV5;STATE:ONLINE;";
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipParseStatus(message, strlen(message), &status));
+
+    assertViewEquals(DEVICE_ID, status.deviceId);
+    TEST_ASSERT_EQUAL(NODE, status.deviceType);
+    TEST_ASSERT_EQUAL(ONLINE, status.deviceState);
+    TEST_ASSERT_EQUAL(0, status.additionalFieldsCount);
+}
+void test_parseStatusInArbitraryOrder() {
+    char message[] = "STATE:OFFLINE;DATA:timer,light;TYPE:APP;ID:" DEVICE_ID;
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipParseStatus(message, strlen(message), &status));
+
+    assertViewEquals(DEVICE_ID, status.deviceId);
+    TEST_ASSERT_EQUAL(APPLICATION, status.deviceType);
+    TEST_ASSERT_EQUAL(OFFLINE, status.deviceState);
+    TEST_ASSERT_EQUAL(1, status.additionalFieldsCount);
+    assertViewEquals("DATA", fields[0].key);
+    assertViewEquals("timer,light", fields[0].value);
+}
+void test_parseStatusCountsFieldsExceedingCapacity() {
+    char message[] = "ID:a;TYPE:NODE;STATE:ONLINE;F1:1;F2:2;F3:3;F4:4;F5:5;F6:6;";
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipParseStatus(message, strlen(message), &status));
+
+    TEST_ASSERT_EQUAL(6, status.additionalFieldsCount);
+    assertViewEquals("F4", fields[3].key);
+}
+void test_parseStatusWithoutFieldStorage() {
+    char message[] = "ID:a;TYPE:enV5;STATE:ONLINE;F1:1;";
+    eaipStatusView_t view = {.additionalFields = NULL, .additionalFieldsCapacity = 0};
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipParseStatus(message, strlen(message), &view));
+    TEST_ASSERT_EQUAL(1, view.additionalFieldsCount);
+}
+void test_parseStatusFailsWithMissingField() {
+    char message[] = "ID:" DEVICE_ID ";TYPE:enV5;";
+    TEST_ASSERT_EQUAL(EAIP_COM_INVALID_MESSAGE,
+                      eaipParseStatus(message, strlen(message), &status));
+}
+void test_parseStatusFailsWithUnknownType() {
+    char message[] = "ID:" DEVICE_ID ";TYPE:toaster;STATE:ONLINE;";
+    TEST_ASSERT_EQUAL(EAIP_COM_INVALID_MESSAGE,
+                      eaipParseStatus(message, strlen(message), &status));
+}
+void test_parseStatusFailsWithUnknownState() {
+    char message[] = "ID:" DEVICE_ID ";TYPE:enV5;STATE:SLEEPING;";
+    TEST_ASSERT_EQUAL(EAIP_COM_INVALID_MESSAGE,
+                      eaipParseStatus(message, strlen(message), &status));
+}
+void test_parseSerializedStatus() {
+    char message[128];
+    eaipStateDataField_t additionalField = {.id = "MODEL", .data = "mlp", .next = NULL};
+    eaipDeviceState_t state = {
+        .deviceState = OFFLINE, .deviceType = APPLICATION, .additionalFields = &additionalField};
+    size_t length = eaipSerializeStatus(message, sizeof(message), DEVICE_ID, state, NULL);
+
+    TEST_ASSERT_EQUAL(EAIP_COM_NO_ERROR, eaipParseStatus(message, length, &status));
+
+    assertViewEquals(DEVICE_ID, status.deviceId);
+    TEST_ASSERT_EQUAL(APPLICATION, status.deviceType);
+    TEST_ASSERT_EQUAL(OFFLINE, status.deviceState);
+    TEST_ASSERT_EQUAL(1, status.additionalFieldsCount);
+    assertViewEquals("MODEL", fields[0].key);
+    assertViewEquals("mlp", fields[0].value);
+}
+
+void setUp() {
+    memset(fields, 0, sizeof(fields));
+    memset(&status, 0, sizeof(status));
+    status.additionalFields = fields;
+    status.additionalFieldsCapacity = sizeof(fields) / sizeof(fields[0]);
+}
+
+void tearDown() {}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_iteratorYieldsFields);
+    RUN_TEST(test_iteratorKeepsColonsInValue);
+    RUN_TEST(test_iteratorRespectsLength);
+
+    RUN_TEST(test_parseStandardStatus);
+    RUN_TEST(test_parseStatusInArbitraryOrder);
+    RUN_TEST(test_parseStatusCountsFieldsExceedingCapacity);
+    RUN_TEST(test_parseStatusWithoutFieldStorage);
+    RUN_TEST(test_parseStatusFailsWithMissingField);
+    RUN_TEST(test_parseStatusFailsWithUnknownType);
+    RUN_TEST(test_parseStatusFailsWithUnknownState);
+    RUN_TEST(test_parseSerializedStatus);
+
+    return UNITY_END();
+}
@@ -0,0 +1,130 @@
+#include <regex.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "eaip/brokerMock/TopicValidation.h"
+#include "unity.h"
+
+/* region REFERENCE */
+/* regular expressions previously used by the broker mock */
+#define REGEX_MQTT_SUBSCRIBE                                                                       \
+    "^(\\/?[a-zA-Z0-9_\\!$&'()*+,.:;=?@%~-]*(\\/[a-zA-Z0-9_\\!$&'()*+,.:;=?@%~-]*)*(\\/"           \
+    "\\#)?|\\+)$"
+#define REGEX_MQTT_PUBLISH                                                                         \
+    "^(\\/?[a-zA-Z0-9_\\!$&'()*,.:;=?@%~-]+(\\/[a-zA-Z0-9_\\!$&'()*,.:;=?@%~-]*)*\\/?$)"
+
+regex_t subscribeRegex;
+regex_t publishRegex;
+
+static void assertEquivalent(const char *topic) {
+    size_t length = strlen(topic);
+    bool subscribeExpected = 0 == regexec(&subscribeRegex, topic, 0, NULL, 0);
+    bool publishExpected = 0 == regexec(&publishRegex, topic, 0, NULL, 0);
+
+    if (subscribeExpected != topicIsValidForSubscribe(topic, length)) {
+        TEST_FAIL_MESSAGE(topic);
+    }
+    if (publishExpected != topicIsValidForPublish(topic, length)) {
+        TEST_FAIL_MESSAGE(topic);
+    }
+}
+/* endregion REFERENCE */
+
+/* region CORPUS */
+uint32_t state;
+
+static uint32_t nextRandom(void) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/* characters with a special meaning are drawn more often than others */
+static char nextCharacter(void) {
+    static const char interesting[] = "//////##++aZ09_\\!$&'()*,.:;=?@%~- \"<>[]^`{|}";
+    uint32_t choice = nextRandom();
+    if (choice % 4 == 0) {
+        return (char)(1 + (choice >> 8) % 255);
+    }
+    return interesting[(choice >> 8) % (sizeof(interesting) - 1)];
+}
+/* endregion CORPUS */
+
+void test_knownTopics() {
+    TEST_ASSERT_TRUE(topicIsValidForSubscribe("eaip://+/DATA/#", 15));
+    TEST_ASSERT_TRUE(topicIsValidForSubscribe("+", 1));
+    TEST_ASSERT_FALSE(topicIsValidForSubscribe("eaip://dev/#/DATA", 17));
+    TEST_ASSERT_FALSE(topicIsValidForSubscribe("#", 1));
+    TEST_ASSERT_TRUE(topicIsValidForPublish("eaip://dev/DATA/value", 21));
+    TEST_ASSERT_FALSE(topicIsValidForPublish("eaip://+/DATA", 13));
+    TEST_ASSERT_FALSE(topicIsValidForPublish("//dev", 5));
+}
+
+void test_allShortTopicsMatchRegex() {
+    char topic[3] = {0};
+    assertEquivalent(topic);
+    for (int first = 1; first < 256; first++) {
+        topic[0] = (char)first;
+        topic[1] = '\0';
+        assertEquivalent(topic);
+        for (int second = 1; second < 256; second++) {
+            topic[1] = (char)second;
+            assertEquivalent(topic);
+        }
+    }
+}
+
+void test_generatedTopicsMatchRegex() {
+    char topic[129];
+    for (int sample = 0; sample < 200000; sample++) {
+        size_t length = nextRandom() % 24;
+        for (size_t index = 0; index < length; index++) {
+            topic[index] = nextCharacter();
+        }
+        topic[length] = '\0';
+        assertEquivalent(topic);
+    }
+}
+
+void test_longTopicsWithSingleSpecialCharacterMatchRegex() {
+    static const char special[] = "#+/\" ~\x7f\x80";
+    char topic[129];
+    for (size_t length = 1; length < sizeof(topic); length++) {
+        for (size_t position = 0; position < length; position++) {
+            for (size_t index = 0; index < sizeof(special) - 1; index++) {
+                memset(topic, 'a', length);
+                topic[length] = '\0';
+                topic[position] = special[index];
+                assertEquivalent(topic);
+                if (position > 0) {
+                    topic[position - 1] = '/';
+                    assertEquivalent(topic);
+                }
+            }
+        }
+    }
+}
+
+void setUp() {
+    state = 0x2545F491u;
+    TEST_ASSERT_EQUAL(0, regcomp(&subscribeRegex, REGEX_MQTT_SUBSCRIBE, REG_EXTENDED));
+    TEST_ASSERT_EQUAL(0, regcomp(&publishRegex, REGEX_MQTT_PUBLISH, REG_EXTENDED));
+}
+
+void tearDown() {
+    regfree(&subscribeRegex);
+    regfree(&publishRegex);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_knownTopics);
+    RUN_TEST(test_allShortTopicsMatchRegex);
+    RUN_TEST(test_generatedTopicsMatchRegex);
+    RUN_TEST(test_longTopicsWithSingleSpecialCharacterMatchRegex);
+
+    return UNITY_END();
+}
@@ -0,0 +1,113 @@
+#include <stdbool.h>
+#include <string.h>
+
+#include "eaip/protocol/Protocol.h"
+#include "eaip/protocol/Writer.h"
+#include "unity.h"
+
+#define DEVICE_ID "test-dev"
+
+void test_writerAppendsContent() {
+    char buffer[16];
+    eaipWriter_t writer;
+    eaipWriterInit(&writer, buffer, sizeof(buffer));
+
+    eaipWriterAppendString(&writer, "ID");
+    eaipWriterAppendChar(&writer, ':');
+    eaipWriterAppend(&writer, "value;ignored", 6);
+
+    TEST_ASSERT_FALSE(eaipWriterTruncated(&writer));
+    TEST_ASSERT_EQUAL(9, eaipWriterFinish(&writer));
+    TEST_ASSERT_EQUAL_STRING("ID:value;", buffer);
+}
+void test_writerReportsTruncation() {
+    char buffer[8];
+    eaipWriter_t writer;
+    eaipWriterInit(&writer, buffer, sizeof(buffer));
+
+    eaipWriterAppendString(&writer, "0123456789");
+
+    TEST_ASSERT_TRUE(eaipWriterTruncated(&writer));
+    TEST_ASSERT_EQUAL(10, writer.length);
+    TEST_ASSERT_EQUAL(7, eaipWriterFinish(&writer));
+    TEST_ASSERT_EQUAL_STRING("0123456", buffer);
+}
+void test_writerFillsBufferExactly() {
+    char buffer[5];
+    eaipWriter_t writer;
+    eaipWriterInit(&writer, buffer, sizeof(buffer));
+
+    eaipWriterAppendString(&writer, "012");
+    eaipWriterAppendChar(&writer, '3');
+
+    TEST_ASSERT_FALSE(eaipWriterTruncated(&writer));
+    eaipWriterAppendChar(&writer, '4');
+    TEST_ASSERT_TRUE(eaipWriterTruncated(&writer));
+    TEST_ASSERT_EQUAL(4, eaipWriterFinish(&writer));
+    TEST_ASSERT_EQUAL_STRING("0123", buffer);
+}
+void test_writerCountsWithoutBuffer() {
+    eaipWriter_t writer;
+    eaipWriterInit(&writer, NULL, 0);
+
+    eaipWriterAppendString(&writer, "0123456789");
+
+    TEST_ASSERT_TRUE(eaipWriterTruncated(&writer));
+    TEST_ASSERT_EQUAL(0, eaipWriterFinish(&writer));
+    TEST_ASSERT_EQUAL(10, writer.length);
+}
+
+void test_serializeStandardStatus() {
+    char buffer[64];
+    bool truncated = true;
+    eaipDeviceState_t state = {.deviceState = ONLINE, .deviceType = NODE};
+
+    size_t length = eaipSerializeStatus(buffer, sizeof(buffer), DEVICE_ID, state, &truncated);
+
+    TEST_ASSERT_FALSE(truncated);
+    TEST_ASSERT_EQUAL_STRING("ID:" DEVICE_ID ";TYPE:enV5;STATE:ONLINE;", buffer);
+    TEST_ASSERT_EQUAL(strlen(buffer), length);
+}
+void test_serializeExtendedStatus() {
+    char buffer[128];
+    eaipStateDataField_t additionalField1 = {.id = "DATA", .data = "timer,light", .next = NULL};
+    eaipStateDataField_t additionalField2 = {
+        .id = "MODEL", .data = "mlp", .next = &additionalField1};
+    eaipDeviceState_t state = {
+        .deviceState = OFFLINE, .deviceType = APPLICATION, .additionalFields = &additionalField2};
+
+    eaipSerializeStatus(buffer, sizeof(buffer), DEVICE_ID, state, NULL);
+
+    TEST_ASSERT_EQUAL_STRING(
+        "ID:" DEVICE_ID ";TYPE:APPLICATION;STATE:OFFLINE;MODEL:mlp;DATA:timer,light;", buffer);
+}
+void test_serializeStatusReportsTruncation() {
+    char buffer[16];
+    bool truncated = false;
+    eaipDeviceState_t state = {.deviceState = ONLINE, .deviceType = NODE};
+
+    size_t length = eaipSerializeStatus(buffer, sizeof(buffer), DEVICE_ID, state, &truncated);
+
+    TEST_ASSERT_TRUE(truncated);
+    TEST_ASSERT_EQUAL(sizeof(buffer) - 1, length);
+    TEST_ASSERT_EQUAL_STRING("ID:" DEVICE_ID ";TYP", buffer);
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_writerAppendsContent);
+    RUN_TEST(test_writerReportsTruncation);
+    RUN_TEST(test_writerFillsBufferExactly);
+    RUN_TEST(test_writerCountsWithoutBuffer);
+
+    RUN_TEST(test_serializeStandardStatus);
+    RUN_TEST(test_serializeExtendedStatus);
+    RUN_TEST(test_serializeStatusReportsTruncation);
+
+    return UNITY_END();
+}